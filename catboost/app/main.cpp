@@ -65,6 +65,7 @@ int main(int argc, const char* argv[]) {
         modChooser.AddMode("eval-feature", mode_eval_feature, "evaluate features");
         modChooser.AddMode("metadata", mode_metadata, "get/set/dump metainfo fields from model");
         modChooser.AddMode("model-sum", mode_model_sum, "sum model files");
+        modChooser.AddMode("compact-model", mode_compact_model, "merge duplicate trees and remove unused splits");
         modChooser.AddMode("run-worker", mode_run_worker, "run worker");
         modChooser.AddMode("roc", mode_roc, "evaluate data for roc curve");
         modChooser.AddMode("model-based-eval", mode_model_based_eval, "model-based eval");
@@ -0,0 +1,155 @@
+#include "modes.h"
+
+#include <catboost/libs/data/proceed_pool_in_blocks.h>
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/model/model.h>
+#include <catboost/libs/model/model_compaction.h>
+#include <catboost/libs/model/model_export/model_exporter.h>
+#include <catboost/libs/model/model_reordering.h>
+#include <catboost/private/libs/algo/apply.h>
+#include <catboost/private/libs/options/analytical_mode_params.h>
+#include <catboost/private/libs/options/dataset_reading_params.h>
+#include <catboost/private/libs/data_util/path_with_scheme.h>
+
+#include <library/cpp/getopt/small/last_getopt.h>
+#include <library/cpp/json/json_value.h>
+#include <library/cpp/threading/local_executor/local_executor.h>
+
+#include <util/generic/serialized_enum.h>
+#include <util/generic/xrange.h>
+#include <util/system/hp_timer.h>
+#include <util/system/info.h>
+
+using namespace NCB;
+
+namespace {
+    struct TModeParams {
+        TString ModelFileName;
+        EModelType ModelType = EModelType::CatboostBinary;
+        TString OutputModelFileName;
+        TMaybe<EModelType> OutputModelType;
+        bool MergeTrees = true;
+        bool ReorderForCacheLocality = false;
+        NCatboostOptions::TColumnarPoolFormatParams ColumnarPoolFormatParams;
+        TPathWithScheme PoolPath;
+        int ThreadCount = 1;
+
+        TModeParams(int argc, const char* argv[]) {
+            auto parser = NLastGetopt::TOpts();
+            parser.AddHelpOption();
+            parser.SetFreeArgsNum(0);
+            BindModelFileParams(&parser, &ModelFileName, &ModelType);
+            BindColumnarPoolFormatParams(&parser, &ColumnarPoolFormatParams);
+            parser.AddLongOption('o', "output-path").RequiredArgument("PATH")
+                .Required()
+                .StoreResult(&OutputModelFileName)
+                .Help("Output model path")
+                ;
+            parser.AddLongOption("output-model-format").RequiredArgument("FORMAT")
+                .Handler1T<TStringBuf>([=](auto format){ OutputModelType = FromString<EModelType>(format); })
+                .Help("Output model format, one of " + GetEnumAllNames<EModelType>())
+                ;
+            parser.AddLongOption("no-tree-merging").NoArgument()
+                .StoreValue(&MergeTrees, false)
+                .Help("Don't merge trees with the same splits, the compacted model gives bit-exact predictions unless trees are reordered")
+                ;
+            parser.AddLongOption("reorder-for-cache-locality").NoArgument()
+                .StoreTrue(&ReorderForCacheLocality)
+                .Help("Sort splits of every tree by quantized data bucket and group trees using the same buckets")
+                ;
+            parser.AddLongOption("input-path").RequiredArgument("PATH")
+                .Handler1T<TStringBuf>([=](auto path){ PoolPath = TPathWithScheme(path, "dsv"); })
+                .Help("Pool to compare predictions and apply time of the input and compacted models on")
+                ;
+            parser.AddLongOption('T', "thread-count").RequiredArgument("N")
+                .StoreResult(&ThreadCount)
+                .Help("Worker thread count")
+                .DefaultValue(NSystemInfo::CachedNumberOfCpus())
+                ;
+            NLastGetopt::TOptsParseResult parseResult{&parser, argc, argv};
+        }
+    };
+
+    struct TPredictionsComparison {
+        double MaxAbsDiff = 0;
+        double InputModelApplyTime = 0;
+        double CompactedModelApplyTime = 0;
+    };
+}
+
+static TVector<TVector<double>> ApplyModelTimed(
+    const TFullModel& model,
+    const TObjectsDataProvider& objectsData,
+    NPar::ILocalExecutor* localExecutor,
+    double* applyTime
+) {
+    THPTimer timer;
+    auto approx = ApplyModelMulti(model, objectsData, EPredictionType::RawFormulaVal, 0, 0, localExecutor);
+    *applyTime += timer.Passed();
+    return approx;
+}
+
+static TPredictionsComparison ComparePredictions(
+    const TFullModel& inputModel,
+    const TFullModel& compactedModel,
+    const TModeParams& modeParams,
+    NPar::ILocalExecutor* localExecutor
+) {
+    TPredictionsComparison result;
+    ReadAndProceedPoolInBlocks(
+        NCatboostOptions::TDatasetReadingParams{
+            modeParams.ColumnarPoolFormatParams,
+            modeParams.PoolPath,
+            TVector<NJson::TJsonValue>(),  // ClassLabels
+            TPathWithScheme(),  // PairsFilePath
+            TPathWithScheme(),  // FeatureNamesPath
+            TVector<ui32>(),  // IgnoredFeatures
+        },
+        10000,  // blockSize
+        [&](const TDataProviderPtr datasetPart) {
+            const auto& objectsData = *datasetPart->ObjectsData;
+            const auto inputApprox = ApplyModelTimed(inputModel, objectsData, localExecutor, &result.InputModelApplyTime);
+            const auto compactedApprox = ApplyModelTimed(compactedModel, objectsData, localExecutor, &result.CompactedModelApplyTime);
+            for (auto dim : xrange(inputApprox.size())) {
+                for (auto docIdx : xrange(inputApprox[dim].size())) {
+                    result.MaxAbsDiff = Max(result.MaxAbsDiff, Abs(inputApprox[dim][docIdx] - compactedApprox[dim][docIdx]));
+                }
+            }
+        },
+        localExecutor
+    );
+    return result;
+}
+
+int mode_compact_model(int argc, const char* argv[]) {
+    TModeParams modeParams(argc, argv);
+
+    const TFullModel inputModel = ReadModel(modeParams.ModelFileName, modeParams.ModelType);
+    TFullModel model = inputModel;
+    const auto stats = CompactModel(modeParams.MergeTrees, &model);
+    Cout << "Trees: " << stats.TreeCountBefore << " -> " << stats.TreeCountAfter
+        << " (merged " << stats.MergedTreeCount << ", dropped zero " << stats.DroppedZeroTreeCount << ")" << Endl;
+    Cout << "Splits: " << stats.SplitCountBefore << " -> " << stats.SplitCountAfter
+        << " (pruned " << stats.PrunedSplitCount << ")" << Endl;
+    if (modeParams.ReorderForCacheLocality) {
+        ReorderModelForCacheLocality(/*reorderTrees*/ true, &model);
+    }
+
+    if (modeParams.PoolPath.Inited()) {
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(modeParams.ThreadCount - 1);
+        const auto comparison = ComparePredictions(inputModel, model, modeParams, &localExecutor);
+        Cout << "Max abs prediction difference: " << comparison.MaxAbsDiff << Endl;
+        Cout << "Apply time: " << comparison.InputModelApplyTime << "s -> " << comparison.CompactedModelApplyTime << "s";
+        if (comparison.CompactedModelApplyTime > 0) {
+            Cout << " (speedup " << comparison.InputModelApplyTime / comparison.CompactedModelApplyTime << "x)";
+        }
+        Cout << Endl;
+        CB_ENSURE(
+            modeParams.MergeTrees || modeParams.ReorderForCacheLocality || comparison.MaxAbsDiff == 0,
+            "Compacted model predictions differ from the input model without tree merging and reordering");
+    }
+
+    ExportModel(model, modeParams.OutputModelFileName, modeParams.OutputModelType.GetOrElse(modeParams.ModelType));
+    return 0;
+}
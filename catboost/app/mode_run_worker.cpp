@@ -1,9 +1,11 @@
 #include "modes.h"
 
+#include <catboost/libs/logging/trace.h>
 #include <catboost/private/libs/distributed/worker.h>
 
 #include <library/cpp/getopt/small/last_getopt.h>
 
+#include <util/generic/scope.h>
 #include <util/system/info.h>
 
 
@@ -11,12 +13,16 @@ namespace {
     struct TWorkerParams {
         ui32 NodePort = 0;
         ui32 ThreadCount = NSystemInfo::CachedNumberOfCpus();
+        TString ChromeTraceFile;
 
         void BindParserOpts(NLastGetopt::TOpts& parser) {
             parser.AddLongOption('T', "thread-count", "worker thread count (default: core count)")
                 .StoreResult(&ThreadCount);
             parser.AddLongOption("node-port", "TCP port for this worker; default is 0")
                 .StoreResult(&NodePort);
+            parser.AddLongOption("chrome-trace", "file to write spans of worker jobs in Chrome trace format")
+                .RequiredArgument("file")
+                .StoreResult(&ChromeTraceFile);
         }
     };
 } // anonymous namespace
@@ -30,6 +36,11 @@ int mode_run_worker(int argc, const char* argv[]) {
     parser.SetFreeArgsNum(0);
     NLastGetopt::TOptsParseResult parserResult{&parser, argc, argv};
 
+    NCB::TChromeTraceSink chromeTraceSink(params.ChromeTraceFile);
+    // write the rest of the trace as soon as the worker stops
+    Y_SCOPE_EXIT(&chromeTraceSink) {
+        chromeTraceSink.Finish();
+    };
     RunWorker(params.ThreadCount, params.NodePort);
 
     return 0;
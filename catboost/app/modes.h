@@ -8,5 +8,6 @@ int mode_metadata(int argc, const char* argv[]);
 int mode_run_worker(int argc, const char* argv[]);
 int mode_roc(int argc, const char* argv[]);
 int mode_model_sum(int argc, const char* argv[]);
+int mode_compact_model(int argc, const char* argv[]);
 int mode_model_based_eval(int argc, const char* argv[]);
 int mode_select_features(int argc, const char* argv[]);
@@ -2,6 +2,9 @@ package ai.catboost;
 
 import javax.annotation.Nullable;
 import javax.validation.constraints.NotNull;
+import java.nio.DoubleBuffer;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
 
 class CatBoostJNI {
     final void catBoostHashCatFeature(
@@ -132,4 +135,19 @@ class CatBoostJNI {
             final @NotNull double[] predictions) throws CatBoostError {
         CatBoostJNIImpl.checkCall(CatBoostJNIImpl.catBoostModelPredict(handle, numericFeatures, catFeatureHashes, predictions));
     }
+
+    final void catBoostModelPredictDirect(
+            final long handle,
+            final @Nullable FloatBuffer numericFeatures,
+            final @Nullable IntBuffer catFeatureHashes,
+            final int documentCount,
+            final int numericFeatureCount,
+            final int catFeatureCount,
+            final boolean isColumnMajor,
+            final @NotNull DoubleBuffer predictions,
+            final int threadCount) throws CatBoostError {
+        CatBoostJNIImpl.checkCall(CatBoostJNIImpl.catBoostModelPredictDirect(
+            handle, numericFeatures, catFeatureHashes, documentCount, numericFeatureCount, catFeatureCount,
+            isColumnMajor, predictions, threadCount));
+    }
 }
@@ -119,4 +119,16 @@ class CatBoostJNIImpl {
             @Nullable float[][] numericFeatures,
             @Nullable int[][] catFeatureHashes,
             @NotNull double[] predictions);
+
+    @Nullable
+    final static native String catBoostModelPredictDirect(
+            long handle,
+            @Nullable java.nio.FloatBuffer numericFeatures,
+            @Nullable java.nio.IntBuffer catFeatureHashes,
+            int documentCount,
+            int numericFeatureCount,
+            int catFeatureCount,
+            boolean isColumnMajor,
+            @NotNull java.nio.DoubleBuffer predictions,
+            int threadCount);
 }
@@ -5,6 +5,11 @@ import javax.validation.constraints.NotNull;
 import java.io.ByteArrayOutputStream;
 import java.io.IOException;
 import java.io.InputStream;
+import java.nio.Buffer;
+import java.nio.ByteOrder;
+import java.nio.DoubleBuffer;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
 
 import java.util.ArrayList;
 import java.util.Collections;
@@ -485,6 +490,82 @@ public class CatBoostModel implements AutoCloseable {
         return prediction;
     }
 
+    /**
+     * Apply model to a batch of objects stored in direct buffers without copying them.
+     *
+     * Features are read from the remaining part of each buffer (starting at its position). Buffers must be direct
+     * and use native byte order (e.g. {@code ByteBuffer.allocateDirect(n).order(ByteOrder.nativeOrder())}).
+     *
+     * @param numericFeatures     Numeric features, {@code documentCount * numericFeatureCount} values.
+     * @param numericFeatureCount Number of numeric features per object.
+     * @param catFeatureHashes    Categoric feature hashes computed by {@link #hashCategoricalFeature(String)},
+     *                            {@code documentCount * catFeatureCount} values.
+     * @param catFeatureCount     Number of categoric features per object.
+     * @param documentCount       Number of objects.
+     * @param isColumnMajor       If true, features are stored feature by feature (all values of the first feature,
+     *                            then all values of the second one, etc.), otherwise object by object.
+     * @param predictions         Model predictions, {@code documentCount * getPredictionDimension()} values in
+     *                            object-major order.
+     * @param threadCount         Number of native threads to use, large batches are split between them.
+     * @throws CatBoostError In case of error within native library.
+     */
+    public void predict(
+            final @Nullable FloatBuffer numericFeatures,
+            final int numericFeatureCount,
+            final @Nullable IntBuffer catFeatureHashes,
+            final int catFeatureCount,
+            final int documentCount,
+            final boolean isColumnMajor,
+            final @NotNull DoubleBuffer predictions,
+            final int threadCount) throws CatBoostError {
+        checkDirectBuffer(numericFeatures, numericFeatures == null ? null : numericFeatures.order(), "numericFeatures");
+        checkDirectBuffer(catFeatureHashes, catFeatureHashes == null ? null : catFeatureHashes.order(), "catFeatureHashes");
+        checkDirectBuffer(predictions, predictions.order(), "predictions");
+        implLibrary.catBoostModelPredictDirect(
+            handle,
+            numericFeatures == null ? null : numericFeatures.slice(),
+            catFeatureHashes == null ? null : catFeatureHashes.slice(),
+            documentCount,
+            numericFeatureCount,
+            catFeatureCount,
+            isColumnMajor,
+            predictions.slice(),
+            threadCount);
+    }
+
+    /**
+     * Same as {@link #predict(FloatBuffer, int, IntBuffer, int, int, boolean, DoubleBuffer, int)} for row-major
+     * numeric features only, evaluated in the calling thread.
+     *
+     * @param numericFeatures     Numeric features, {@code documentCount * numericFeatureCount} values.
+     * @param numericFeatureCount Number of numeric features per object.
+     * @param documentCount       Number of objects.
+     * @param predictions         Model predictions.
+     * @throws CatBoostError In case of error within native library.
+     */
+    public void predict(
+            final @NotNull FloatBuffer numericFeatures,
+            final int numericFeatureCount,
+            final int documentCount,
+            final @NotNull DoubleBuffer predictions) throws CatBoostError {
+        predict(numericFeatures, numericFeatureCount, null, 0, documentCount, false, predictions, 1);
+    }
+
+    private static void checkDirectBuffer(
+            final @Nullable Buffer buffer,
+            final @Nullable ByteOrder order,
+            final @NotNull String name) throws CatBoostError {
+        if (buffer == null) {
+            return;
+        }
+        if (!buffer.isDirect()) {
+            throw new CatBoostError("`" + name + "` must be a direct buffer");
+        }
+        if (order != ByteOrder.nativeOrder()) {
+            throw new CatBoostError("`" + name + "` must use native byte order");
+        }
+    }
+
     @Override
     protected void finalize() throws Throwable {
         try {
@@ -4,11 +4,15 @@
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/model/model.h>
 
+#include <library/cpp/threading/local_executor/local_executor.h>
+
 #include <util/generic/cast.h>
 #include <util/generic/scope.h>
 #include <util/generic/singleton.h>
 #include <util/generic/string.h>
+#include <util/generic/ymath.h>
 #include <util/stream/labeled.h>
+#include <util/system/mutex.h>
 #include <util/system/platform.h>
 
 #include <exception>
@@ -58,6 +62,29 @@ static TConstFullModelPtr ToConstFullModelPtr(const jlong handle) {
     return reinterpret_cast<TConstFullModelPtr>(handle);
 }
 
+namespace {
+    // Shared by all direct buffer predictions, grows up to the largest thread count requested so far.
+    class TPredictionThreadPool {
+    public:
+        NPar::TLocalExecutor& GetExecutor(int threadCount) {
+            with_lock(Lock) {
+                const int additionalThreadCount = threadCount - 1 - Executor.GetThreadCount();
+                if (additionalThreadCount > 0) {
+                    Executor.RunAdditionalThreads(additionalThreadCount);
+                }
+            }
+            return Executor;
+        }
+
+    private:
+        TMutex Lock;
+        NPar::TLocalExecutor Executor;
+    };
+}
+
+// Splitting smaller batches between threads costs more than it saves.
+static constexpr size_t MIN_DOCUMENTS_PER_PREDICTION_THREAD = 1024;
+
 static jlong ToHandle(const void* ptr) {
     return reinterpret_cast<jlong>(ptr);
 }
@@ -921,5 +948,176 @@ JNIEXPORT jstring JNICALL Java_ai_catboost_CatBoostJNIImpl_catBoostModelPredict_
     Y_END_JNI_API_CALL();
 }
 
+template <typename T>
+static TArrayRef<T> GetDirectBufferData(JNIEnv* const jenv, const jobject jbuffer, const size_t minSize, const TStringBuf name) {
+    CB_ENSURE(jbuffer, "`" << name << "` is null");
+    T* const data = static_cast<T*>(jenv->GetDirectBufferAddress(jbuffer));
+    CB_ENSURE(data, "`" << name << "` is not a direct buffer");
+    const jlong capacity = jenv->GetDirectBufferCapacity(jbuffer);
+    CB_ENSURE(
+        capacity >= 0 && SafeIntegerCast<size_t>(capacity) >= minSize,
+        "`" << name << "` is too small: " << LabeledOutput(capacity, minSize));
+    return MakeArrayRef(data, capacity);
+}
+
+// Evaluates documents [docBegin, docEnd) reading features directly from direct buffer memory.
+static void PredictFromDirectBuffers(
+    const TFullModel& model,
+    TConstArrayRef<float> numericFeatures,
+    TConstArrayRef<int> catFeatures,
+    const size_t documentCount,
+    const size_t numericFeatureCount,
+    const size_t catFeatureCount,
+    const bool isColumnMajor,
+    const size_t docBegin,
+    const size_t docEnd,
+    TArrayRef<double> predictions) {
+
+    const size_t blockDocCount = docEnd - docBegin;
+    if (!isColumnMajor) {
+        TVector<TConstArrayRef<float>> numericRows;
+        TVector<TConstArrayRef<int>> catRows;
+        if (numericFeatureCount) {
+            numericRows.reserve(blockDocCount);
+            for (size_t docId = docBegin; docId < docEnd; ++docId) {
+                numericRows.push_back(numericFeatures.Slice(docId * numericFeatureCount, numericFeatureCount));
+            }
+        }
+        if (catFeatureCount) {
+            catRows.reserve(blockDocCount);
+            for (size_t docId = docBegin; docId < docEnd; ++docId) {
+                catRows.push_back(catFeatures.Slice(docId * catFeatureCount, catFeatureCount));
+            }
+        }
+        model.Calc(numericRows, catRows, predictions);
+        return;
+    }
+
+    // column-major layout maps directly onto the transposed flat evaluation interface,
+    // categorical hashes are passed as float bit patterns as CalcFlatTransposed expects.
+    // Columns are placed at the positions the evaluator reads, remapped by its feature layout if there is one,
+    // the same way the row-major path reads float and categorical features.
+    const auto evaluator = model.GetCurrentEvaluator();
+    const auto* const featureLayout = evaluator->GetFeatureLayout();
+    const auto getPosition = [featureLayout] (const auto& feature) -> TFeaturePosition {
+        return featureLayout ? featureLayout->GetRemappedPosition(feature) : feature.Position;
+    };
+    size_t columnCount = model.ModelTrees->GetFlatFeatureVectorExpectedSize();
+    for (const auto& floatFeature : model.ModelTrees->GetFloatFeatures()) {
+        columnCount = Max<size_t>(columnCount, getPosition(floatFeature).FlatIndex + 1);
+    }
+    for (const auto& catFeature : model.ModelTrees->GetCatFeatures()) {
+        columnCount = Max<size_t>(columnCount, getPosition(catFeature).FlatIndex + 1);
+    }
+    TVector<TConstArrayRef<float>> columns(columnCount);
+    for (const auto& floatFeature : model.ModelTrees->GetFloatFeatures()) {
+        const TFeaturePosition position = getPosition(floatFeature);
+        const size_t featureIdx = position.Index;
+        if (floatFeature.UsedInModel() && featureIdx < numericFeatureCount) {
+            columns[position.FlatIndex] = numericFeatures.Slice(
+                featureIdx * documentCount + docBegin,
+                blockDocCount);
+        }
+    }
+    for (const auto& catFeature : model.ModelTrees->GetCatFeatures()) {
+        const TFeaturePosition position = getPosition(catFeature);
+        const size_t featureIdx = position.Index;
+        if (catFeature.UsedInModel() && featureIdx < catFeatureCount) {
+            columns[position.FlatIndex] = MakeArrayRef(
+                reinterpret_cast<const float*>(catFeatures.data() + featureIdx * documentCount + docBegin),
+                blockDocCount);
+        }
+    }
+    model.CalcFlatTransposed(columns, 0, model.GetTreeCount(), predictions);
+}
+
+JNIEXPORT jstring JNICALL Java_ai_catboost_CatBoostJNIImpl_catBoostModelPredictDirect
+  (JNIEnv* jenv, jclass, jlong jhandle, jobject jnumericFeatures, jobject jcatFeatures, jint jdocumentCount,
+   jint jnumericFeatureCount, jint jcatFeatureCount, jboolean jisColumnMajor, jobject jpredictions, jint jthreadCount) {
+    Y_BEGIN_JNI_API_CALL();
+
+    const auto* const model = ToConstFullModelPtr(jhandle);
+    CB_ENSURE(model, "got nullptr model pointer");
+    CB_ENSURE(jdocumentCount >= 0, "negative document count: " << jdocumentCount);
+    CB_ENSURE(jnumericFeatureCount >= 0, "negative numeric feature count: " << jnumericFeatureCount);
+    CB_ENSURE(jcatFeatureCount >= 0, "negative categorical feature count: " << jcatFeatureCount);
+
+    const size_t documentCount = jdocumentCount;
+    if (documentCount == 0) {
+        return nullptr;
+    }
+
+    const size_t modelPredictionSize = model->GetDimensionsCount();
+    const size_t minNumericFeatureCount = model->GetNumFloatFeatures();
+    const size_t minCatFeatureCount = model->GetNumCatFeatures();
+    const size_t numericFeatureCount = jnumericFeatureCount;
+    const size_t catFeatureCount = jcatFeatureCount;
+    const bool isColumnMajor = jisColumnMajor == JNI_TRUE;
+
+    CB_ENSURE(
+        numericFeatureCount >= minNumericFeatureCount,
+        LabeledOutput(numericFeatureCount, minNumericFeatureCount));
+
+    CB_ENSURE(
+        catFeatureCount >= minCatFeatureCount,
+        LabeledOutput(catFeatureCount, minCatFeatureCount));
+
+    TConstArrayRef<float> numericFeatures;
+    if (numericFeatureCount) {
+        numericFeatures = GetDirectBufferData<float>(
+            jenv, jnumericFeatures, documentCount * numericFeatureCount, "numericFeatures");
+    }
+    TConstArrayRef<int> catFeatures;
+    if (catFeatureCount) {
+        catFeatures = GetDirectBufferData<int>(
+            jenv, jcatFeatures, documentCount * catFeatureCount, "catFeatureHashes");
+    }
+    const TArrayRef<double> predictions = GetDirectBufferData<double>(
+        jenv, jpredictions, documentCount * modelPredictionSize, "predictions")
+        .first(documentCount * modelPredictionSize);
+
+    const size_t threadCount = Min<size_t>(
+        Max<jint>(jthreadCount, 1),
+        CeilDiv(documentCount, MIN_DOCUMENTS_PER_PREDICTION_THREAD));
+    if (threadCount <= 1) {
+        PredictFromDirectBuffers(
+            *model,
+            numericFeatures,
+            catFeatures,
+            documentCount,
+            numericFeatureCount,
+            catFeatureCount,
+            isColumnMajor,
+            0,
+            documentCount,
+            predictions);
+        return nullptr;
+    }
+
+    const size_t blockSize = CeilDiv(documentCount, threadCount);
+    auto& executor = Singleton<TPredictionThreadPool>()->GetExecutor(threadCount);
+    executor.ExecRangeWithThrow(
+        [&] (int blockId) {
+            const size_t docBegin = blockId * blockSize;
+            const size_t docEnd = Min(docBegin + blockSize, documentCount);
+            PredictFromDirectBuffers(
+                *model,
+                numericFeatures,
+                catFeatures,
+                documentCount,
+                numericFeatureCount,
+                catFeatureCount,
+                isColumnMajor,
+                docBegin,
+                docEnd,
+                predictions.Slice(docBegin * modelPredictionSize, (docEnd - docBegin) * modelPredictionSize));
+        },
+        0,
+        SafeIntegerCast<int>(CeilDiv(documentCount, blockSize)),
+        NPar::TLocalExecutor::WAIT_COMPLETE);
+
+    Y_END_JNI_API_CALL();
+}
+
 #undef Y_BEGIN_JNI_API_CALL
 #undef Y_END_JNI_API_CALL
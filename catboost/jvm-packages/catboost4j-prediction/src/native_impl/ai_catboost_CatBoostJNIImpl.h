@@ -161,6 +161,14 @@ JNIEXPORT jstring JNICALL Java_ai_catboost_CatBoostJNIImpl_catBoostModelPredict_
 JNIEXPORT jstring JNICALL Java_ai_catboost_CatBoostJNIImpl_catBoostModelPredict__J_3_3F_3_3I_3D
   (JNIEnv *, jclass, jlong, jobjectArray, jobjectArray, jdoubleArray);
 
+/*
+ * Class:     ai_catboost_CatBoostJNIImpl
+ * Method:    catBoostModelPredictDirect
+ * Signature: (JLjava/nio/FloatBuffer;Ljava/nio/IntBuffer;IIIZLjava/nio/DoubleBuffer;I)Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_ai_catboost_CatBoostJNIImpl_catBoostModelPredictDirect
+  (JNIEnv *, jclass, jlong, jobject, jobject, jint, jint, jint, jboolean, jobject, jint);
+
 #ifdef __cplusplus
 }
 #endif
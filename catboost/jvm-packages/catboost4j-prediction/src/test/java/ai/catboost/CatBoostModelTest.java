@@ -6,6 +6,11 @@ import org.junit.Test;
 
 import javax.validation.constraints.NotNull;
 import java.io.*;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.DoubleBuffer;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
 
 import static org.junit.Assert.fail;
 
@@ -45,6 +50,28 @@ public class CatBoostModelTest {
         }
     }
 
+    static FloatBuffer allocateDirectFloats(@NotNull float[] values) {
+        final FloatBuffer buffer = ByteBuffer.allocateDirect(values.length * 4).order(ByteOrder.nativeOrder()).asFloatBuffer();
+        buffer.put(values).rewind();
+        return buffer;
+    }
+
+    static IntBuffer allocateDirectInts(@NotNull int[] values) {
+        final IntBuffer buffer = ByteBuffer.allocateDirect(values.length * 4).order(ByteOrder.nativeOrder()).asIntBuffer();
+        buffer.put(values).rewind();
+        return buffer;
+    }
+
+    static DoubleBuffer allocateDirectDoubles(int size) {
+        return ByteBuffer.allocateDirect(size * 8).order(ByteOrder.nativeOrder()).asDoubleBuffer();
+    }
+
+    static void assertEqual(@NotNull CatBoostPredictions expected, @NotNull DoubleBuffer actual) {
+        final double[] actualValues = new double[expected.getObjectCount() * expected.getPredictionDimension()];
+        actual.get(actualValues);
+        assertEqual(expected, new CatBoostPredictions(expected.getObjectCount(), expected.getPredictionDimension(), actualValues));
+    }
+
     static CatBoostModel loadNumericOnlyTestModel() throws CatBoostError {
         try {
             return CatBoostModel.loadModel(ClassLoader.getSystemResourceAsStream("models/numeric_only_model.cbm"));
@@ -891,4 +918,103 @@ public class CatBoostModelTest {
             assertEqual(expected, model.predict(numericFeatures, catFeatures));
         }
     }
+
+    @Test
+    public void testSuccessfulPredictDirectBufferNumericOnly() throws CatBoostError {
+        try(final CatBoostModel model = loadNumericOnlyTestModel()) {
+            final CatBoostPredictions expected = new CatBoostPredictions(3, 1, new double[]{
+                    0.03547209874741901,
+                    0.008157865240661602,
+                    0.009992472030400074});
+
+            final FloatBuffer rows = allocateDirectFloats(new float[]{
+                    0.5f, 1.5f, -2.5f,
+                    0.7f, 6.4f, 2.4f,
+                    -2.0f, -1.0f, +6.0f});
+            final DoubleBuffer rowsPrediction = allocateDirectDoubles(3);
+            model.predict(rows, 3, 3, rowsPrediction);
+            assertEqual(expected, rowsPrediction);
+
+            final FloatBuffer columns = allocateDirectFloats(new float[]{
+                    0.5f, 0.7f, -2.0f,
+                    1.5f, 6.4f, -1.0f,
+                    -2.5f, 2.4f, +6.0f});
+            final DoubleBuffer columnsPrediction = allocateDirectDoubles(3);
+            model.predict(columns, 3, null, 0, 3, true, columnsPrediction, 4);
+            assertEqual(expected, columnsPrediction);
+        }
+    }
+
+    @Test
+    public void testSuccessfulPredictDirectBufferHashes() throws CatBoostError {
+        try(final CatBoostModel model = loadTestModel()) {
+            final CatBoostPredictions expected = new CatBoostPredictions(3, 1, new double[]{
+                    0.04666924366060905,
+                    0.026244613740247648,
+                    0.03094452158737013});
+
+            final FloatBuffer numericRows = allocateDirectFloats(new float[]{
+                    0.5f, 1.5f,
+                    0.7f, 6.4f,
+                    -2.0f, -1.0f});
+            final IntBuffer catRows = allocateDirectInts(new int[]{
+                    -805065478, 2136526169, 785836961,
+                    1982436109, 1400211492, 1076941191,
+                    -1883343840, -1452597217, 2122455585});
+            final DoubleBuffer rowsPrediction = allocateDirectDoubles(3);
+            model.predict(numericRows, 2, catRows, 3, 3, false, rowsPrediction, 1);
+            assertEqual(expected, rowsPrediction);
+
+            final FloatBuffer numericColumns = allocateDirectFloats(new float[]{
+                    0.5f, 0.7f, -2.0f,
+                    1.5f, 6.4f, -1.0f});
+            final IntBuffer catColumns = allocateDirectInts(new int[]{
+                    -805065478, 1982436109, -1883343840,
+                    2136526169, 1400211492, -1452597217,
+                    785836961, 1076941191, 2122455585});
+            final DoubleBuffer columnsPrediction = allocateDirectDoubles(3);
+            model.predict(numericColumns, 2, catColumns, 3, 3, true, columnsPrediction, 1);
+            assertEqual(expected, columnsPrediction);
+        }
+    }
+
+    @Test
+    public void testSuccessfulPredictDirectBufferMultiThreaded() throws CatBoostError {
+        try(final CatBoostModel model = loadNumericOnlyTestModel()) {
+            final int documentCount = 10000;
+            final float[][] features = new float[documentCount][];
+            final float[] flatFeatures = new float[documentCount * 3];
+            for (int i = 0; i < documentCount; ++i) {
+                features[i] = new float[]{(i % 7) - 3.0f, (i % 11) * 0.5f, (i % 13) - 6.5f};
+                System.arraycopy(features[i], 0, flatFeatures, i * 3, 3);
+            }
+            final CatBoostPredictions expected = model.predict(features, (String[][]) null);
+
+            final DoubleBuffer prediction = allocateDirectDoubles(documentCount);
+            model.predict(allocateDirectFloats(flatFeatures), 3, null, 0, documentCount, false, prediction, 4);
+            assertEqual(expected, prediction);
+        }
+    }
+
+    @Test
+    public void testFailPredictDirectBufferNotDirect() throws CatBoostError {
+        try(final CatBoostModel model = loadNumericOnlyTestModel()) {
+            try {
+                model.predict(FloatBuffer.wrap(new float[]{0.f, 0.f, 0.f}), 3, 1, allocateDirectDoubles(1));
+                fail();
+            } catch (CatBoostError e) {
+            }
+        }
+    }
+
+    @Test
+    public void testFailPredictDirectBufferInsufficientPredictionSize() throws CatBoostError {
+        try(final CatBoostModel model = loadNumericOnlyTestModel()) {
+            try {
+                model.predict(allocateDirectFloats(new float[6]), 3, 2, allocateDirectDoubles(1));
+                fail();
+            } catch (CatBoostError e) {
+            }
+        }
+    }
 }
@@ -0,0 +1,576 @@
+#include "arrow_loader.h"
+#include "baseline.h"
+
+#include <catboost/libs/column_description/cd_parser.h>
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/helpers/polymorphic_type_containers.h>
+#include <catboost/private/libs/data_types/groupid.h>
+#include <catboost/private/libs/data_util/exists_checker.h>
+#include <catboost/private/libs/labels/helpers.h>
+
+#include <library/cpp/object_factory/object_factory.h>
+
+#include <util/generic/cast.h>
+#include <util/generic/strbuf.h>
+#include <util/generic/xrange.h>
+#include <util/string/cast.h>
+
+#include <functional>
+#include <limits>
+
+
+namespace NCB {
+
+    namespace {
+        // part of a record batch column that belongs to the loaded subset of objects
+        struct TArraySlice {
+            const TArrowArray* Array = nullptr;
+            ui64 Begin = 0; // in Array
+            ui64 End = 0;
+            ui32 ObjectOffset = 0; // of Begin in the loaded subset
+        };
+
+        class TArrowColumn {
+        public:
+            TArrowColumn(const TArrowIpcReader& reader, ui32 columnIdx, ui64 objectOffset, ui32 objectCount)
+                : Field(reader.GetFields()[columnIdx])
+                , Dictionary(Field.DictionaryIndexType ? &reader.GetDictionary(columnIdx) : nullptr)
+            {
+                const ui64 objectEnd = objectOffset + objectCount;
+                ui64 batchOffset = 0;
+                for (auto recordBatchIdx : xrange(reader.GetRecordBatchCount())) {
+                    const TArrowArray& array = reader.GetColumn(recordBatchIdx, columnIdx);
+                    const ui64 begin = Max(batchOffset, objectOffset);
+                    const ui64 end = Min(batchOffset + array.Length, objectEnd);
+                    if (begin < end) {
+                        Slices.push_back(
+                            TArraySlice{&array, begin - batchOffset, end - batchOffset, ui32(begin - objectOffset)}
+                        );
+                    }
+                    batchOffset += array.Length;
+                }
+            }
+
+            const TString& GetName() const {
+                return Field.Name;
+            }
+
+            // for dictionary-encoded columns this is the type of dictionary values
+            EArrowValueType GetValueType() const {
+                return Field.Type;
+            }
+
+            const TArrowArray* GetDictionary() const {
+                return Dictionary;
+            }
+
+            TConstArrayRef<TArraySlice> GetSlices() const {
+                return Slices;
+            }
+
+            ui64 GetDictionaryIdx(const TArrowArray& indices, ui64 idx) const {
+                const i64 dictionaryIdx = indices.GetInteger(idx);
+                CB_ENSURE(
+                    (dictionaryIdx >= 0) && ((ui64)dictionaryIdx < Dictionary->Length),
+                    "Arrow column '" << Field.Name << "': dictionary index " << dictionaryIdx << " is out of range"
+                );
+                return dictionaryIdx;
+            }
+
+            /* f(const TArrowArray* values, ui64 valueIdx, ui32 objectIdx) is called for each loaded object,
+             * dictionary encoding is resolved, values is nullptr for nulls
+             */
+            template <class TFunc>
+            void ForEachValue(TFunc&& f) const {
+                for (const auto& slice : Slices) {
+                    const TArrowArray& array = *slice.Array;
+                    for (auto i : xrange(slice.Begin, slice.End)) {
+                        const ui32 objectIdx = slice.ObjectOffset + ui32(i - slice.Begin);
+                        if (array.IsNull(i)) {
+                            f(nullptr, 0, objectIdx);
+                        } else if (Dictionary) {
+                            const ui64 dictionaryIdx = GetDictionaryIdx(array, i);
+                            f(Dictionary->IsNull(dictionaryIdx) ? nullptr : Dictionary, dictionaryIdx, objectIdx);
+                        } else {
+                            f(&array, i, objectIdx);
+                        }
+                    }
+                }
+            }
+
+        private:
+            const TArrowField& Field;
+            const TArrowArray* Dictionary;
+            TVector<TArraySlice> Slices;
+        };
+    }
+
+
+    static TString ValueToString(const TArrowArray& values, ui64 idx) {
+        switch (values.Type) {
+            case EArrowValueType::String:
+            case EArrowValueType::LargeString:
+                return TString(values.GetString(idx));
+            case EArrowValueType::Float32:
+                return ToString(values.GetPrimitive<float>(idx));
+            case EArrowValueType::Float64:
+                return ToString(values.GetPrimitive<double>(idx));
+            case EArrowValueType::UInt64:
+                return ToString(values.GetPrimitive<ui64>(idx));
+            default:
+                return ToString(values.GetInteger(idx));
+        }
+    }
+
+    static TVector<float> ReadFloatColumn(
+        const TArrowColumn& column,
+        ui32 objectCount,
+        bool allowNulls,
+        TStringBuf role
+    ) {
+        TVector<float> result;
+        result.yresize(objectCount);
+        column.ForEachValue(
+            [&] (const TArrowArray* values, ui64 valueIdx, ui32 objectIdx) {
+                if (!values) {
+                    CB_ENSURE(
+                        allowNulls,
+                        "Arrow column '" << column.GetName() << "': null values are not supported for " << role
+                    );
+                    result[objectIdx] = std::numeric_limits<float>::quiet_NaN();
+                } else if (IsArrowStringType(values->Type)) {
+                    const TStringBuf value = values->GetString(valueIdx);
+                    CB_ENSURE(
+                        TryParseFloatFeatureValue(value, &result[objectIdx]),
+                        "Arrow column '" << column.GetName() << "': value '" << value << "' cannot be parsed as float"
+                    );
+                } else {
+                    result[objectIdx] = (float)values->GetNumber(valueIdx);
+                }
+            }
+        );
+        return result;
+    }
+
+    template <class T>
+    static ITypedSequencePtr<float> MakeNonCopyingFloatColumn(
+        const TArraySlice& slice,
+        TIntrusivePtr<IResourceHolder> resourceHolder
+    ) {
+        const ui8* data = slice.Array->Values.data();
+        if (reinterpret_cast<uintptr_t>(data) % alignof(T)) {
+            return nullptr;
+        }
+        const T* values = reinterpret_cast<const T*>(data);
+        return MakeTypeCastArrayHolder<float, T>(
+            TMaybeOwningConstArrayHolder<T>::CreateOwning(
+                TConstArrayRef<T>(values + slice.Begin, values + slice.End),
+                std::move(resourceHolder)
+            )
+        );
+    }
+
+    // values of a single record batch without nulls are cast to float on access
+    static ITypedSequencePtr<float> MakeFloatColumn(
+        const TArrowColumn& column,
+        ui32 objectCount,
+        bool allowNulls,
+        TStringBuf role,
+        const TIntrusivePtr<IResourceHolder>& resourceHolder
+    ) {
+        const auto slices = column.GetSlices();
+        if (!column.GetDictionary() && (slices.size() == 1) && !slices[0].Array->NullCount) {
+            ITypedSequencePtr<float> result;
+            switch (slices[0].Array->Type) {
+                case EArrowValueType::Float32:
+                    result = MakeNonCopyingFloatColumn<float>(slices[0], resourceHolder);
+                    break;
+                case EArrowValueType::Float64:
+                    result = MakeNonCopyingFloatColumn<double>(slices[0], resourceHolder);
+                    break;
+                case EArrowValueType::Int8:
+                    result = MakeNonCopyingFloatColumn<i8>(slices[0], resourceHolder);
+                    break;
+                case EArrowValueType::Int16:
+                    result = MakeNonCopyingFloatColumn<i16>(slices[0], resourceHolder);
+                    break;
+                case EArrowValueType::Int32:
+                    result = MakeNonCopyingFloatColumn<i32>(slices[0], resourceHolder);
+                    break;
+                case EArrowValueType::Int64:
+                    result = MakeNonCopyingFloatColumn<i64>(slices[0], resourceHolder);
+                    break;
+                case EArrowValueType::UInt8:
+                    result = MakeNonCopyingFloatColumn<ui8>(slices[0], resourceHolder);
+                    break;
+                case EArrowValueType::UInt16:
+                    result = MakeNonCopyingFloatColumn<ui16>(slices[0], resourceHolder);
+                    break;
+                case EArrowValueType::UInt32:
+                    result = MakeNonCopyingFloatColumn<ui32>(slices[0], resourceHolder);
+                    break;
+                case EArrowValueType::UInt64:
+                    result = MakeNonCopyingFloatColumn<ui64>(slices[0], resourceHolder);
+                    break;
+                default: // bool values are bit-packed, strings have to be parsed
+                    break;
+            }
+            if (result) {
+                return result;
+            }
+        }
+        return MakeTypeCastArrayHolder<float, float>(
+            TMaybeOwningConstArrayHolder<float>::CreateOwning(ReadFloatColumn(column, objectCount, allowNulls, role))
+        );
+    }
+
+    static TVector<TString> ReadStringColumn(
+        const TArrowColumn& column,
+        ui32 objectCount,
+        bool allowNulls,
+        TStringBuf role
+    ) {
+        TVector<TString> result(objectCount);
+        column.ForEachValue(
+            [&] (const TArrowArray* values, ui64 valueIdx, ui32 objectIdx) {
+                if (values) {
+                    result[objectIdx] = ValueToString(*values, valueIdx);
+                } else {
+                    CB_ENSURE(
+                        allowNulls,
+                        "Arrow column '" << column.GetName() << "': null values are not supported for " << role
+                    );
+                }
+            }
+        );
+        return result;
+    }
+
+    // null values are treated as empty strings
+    static void AddCatFeature(
+        const TArrowColumn& column,
+        ui32 flatFeatureIdx,
+        ui32 objectCount,
+        IRawFeaturesOrderDataVisitor* visitor
+    ) {
+        if (const TArrowArray* dictionary = column.GetDictionary()) {
+            // each used dictionary value is hashed only once
+            TVector<TMaybe<ui32>> dictionaryHashes(dictionary->Length);
+            TMaybe<ui32> nullHash;
+            TVector<ui32> hashes;
+            hashes.yresize(objectCount);
+            column.ForEachValue(
+                [&] (const TArrowArray* values, ui64 valueIdx, ui32 objectIdx) {
+                    TMaybe<ui32>& hash = values ? dictionaryHashes[valueIdx] : nullHash;
+                    if (!hash) {
+                        hash = visitor->GetCatFeatureValue(
+                            flatFeatureIdx,
+                            values ? ValueToString(*values, valueIdx) : TString()
+                        );
+                    }
+                    hashes[objectIdx] = *hash;
+                }
+            );
+            visitor->AddCatFeature(flatFeatureIdx, TMaybeOwningConstArrayHolder<ui32>::CreateOwning(std::move(hashes)));
+        } else if (IsArrowStringType(column.GetValueType())) {
+            // values point to the mapped file
+            TVector<TStringBuf> values(objectCount);
+            column.ForEachValue(
+                [&] (const TArrowArray* array, ui64 valueIdx, ui32 objectIdx) {
+                    if (array) {
+                        values[objectIdx] = array->GetString(valueIdx);
+                    }
+                }
+            );
+            visitor->AddCatFeature(flatFeatureIdx, TConstArrayRef<TStringBuf>(values));
+        } else {
+            const TVector<TString> values = ReadStringColumn(column, objectCount, /*allowNulls*/ true, "Categ");
+            visitor->AddCatFeature(flatFeatureIdx, TConstArrayRef<TString>(values));
+        }
+    }
+
+    template <class TId>
+    static void AddIds(
+        const TArrowColumn& column,
+        TStringBuf role,
+        const std::function<TId(TStringBuf)>& calcId,
+        const std::function<void(ui32, TId)>& addId
+    ) {
+        column.ForEachValue(
+            [&] (const TArrowArray* values, ui64 valueIdx, ui32 objectIdx) {
+                CB_ENSURE(values, "Arrow column '" << column.GetName() << "': null values are not supported for " << role);
+                if (IsArrowStringType(values->Type)) {
+                    addId(objectIdx, calcId(values->GetString(valueIdx)));
+                } else {
+                    addId(objectIdx, calcId(ValueToString(*values, valueIdx)));
+                }
+            }
+        );
+    }
+
+
+    TArrowDataLoader::TArrowDataLoader(TDatasetLoaderPullArgs&& args)
+        : Args(std::move(args.CommonArgs))
+        , Reader(MakeIntrusive<TArrowIpcReader>(args.PoolPath.Path))
+    {
+        CB_ENSURE(!Args.PairsFilePath.Inited() || CheckExists(Args.PairsFilePath),
+                  "TArrowDataLoader:PairsFilePath does not exist");
+        CB_ENSURE(!Args.GroupWeightsFilePath.Inited() || CheckExists(Args.GroupWeightsFilePath),
+                  "TArrowDataLoader:GroupWeightsFilePath does not exist");
+        CB_ENSURE(!Args.BaselineFilePath.Inited() || CheckExists(Args.BaselineFilePath),
+                  "TArrowDataLoader:BaselineFilePath does not exist");
+        CB_ENSURE(!Args.TimestampsFilePath.Inited() || CheckExists(Args.TimestampsFilePath),
+                  "TArrowDataLoader:TimestampsFilePath does not exist");
+        CB_ENSURE(!Args.FeatureNamesPath.Inited() || CheckExists(Args.FeatureNamesPath),
+                  "TArrowDataLoader:FeatureNamesPath does not exist");
+
+        const ui64 rowCount = Reader->GetRowCount();
+        CB_ENSURE(
+            rowCount <= Max<ui32>(),
+            "CatBoost does not support datasets with more than " << Max<ui32>() << " objects"
+        );
+        const auto& range = Args.DatasetSubset.Range;
+        ObjectOffset = Min<ui64>(range.Begin, rowCount);
+        ObjectCount = ui32(Min<ui64>(range.End, rowCount) - ObjectOffset);
+
+        const auto& fields = Reader->GetFields();
+        TVector<TString> headerColumns;
+        for (const auto& field : fields) {
+            headerColumns.push_back(field.Name);
+        }
+
+        auto columnsDescription = TDataColumnsMetaInfo{ Args.CdProvider->GetColumnsDescription(fields.size()) };
+        CB_ENSURE(
+            columnsDescription.Columns.size() == fields.size(),
+            "Column description does not match Arrow schema with " << fields.size() << " fields"
+        );
+
+        bool hasStringLabels = false;
+        bool hasFloatLabels = false;
+        for (auto columnIdx : xrange(fields.size())) {
+            const auto& field = fields[columnIdx];
+            const EArrowValueType valueType = field.Type;
+            switch (columnsDescription.Columns[columnIdx].Type) {
+                case EColumn::Label:
+                    hasStringLabels |= IsArrowStringType(valueType);
+                    hasFloatLabels |= IsArrowFloatingPointType(valueType);
+                    break;
+                case EColumn::Categ:
+                case EColumn::GroupId:
+                case EColumn::SubgroupId:
+                    CB_ENSURE(
+                        !IsArrowFloatingPointType(valueType),
+                        "Arrow column '" << field.Name << "' of floating point type cannot be used as "
+                        << columnsDescription.Columns[columnIdx].Type
+                    );
+                    break;
+                case EColumn::Text:
+                    CB_ENSURE(
+                        IsArrowStringType(valueType),
+                        "Arrow column '" << field.Name << "' must have string type to be used as Text"
+                    );
+                    break;
+                case EColumn::Timestamp:
+                    CB_ENSURE(
+                        IsArrowIntegerType(valueType) && !field.DictionaryIndexType,
+                        "Arrow column '" << field.Name << "' must have integer type to be used as Timestamp"
+                    );
+                    break;
+                case EColumn::NumVector:
+                case EColumn::Sparse:
+                    CB_ENSURE(
+                        false,
+                        "Column type " << columnsDescription.Columns[columnIdx].Type
+                        << " is not supported for Arrow data"
+                    );
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        const ERawTargetType targetType = !columnsDescription.CountColumns(EColumn::Label) ?
+            ERawTargetType::None :
+            (hasStringLabels ?
+                ERawTargetType::String :
+                (hasFloatLabels ? ERawTargetType::Float : ERawTargetType::Integer));
+
+        TMaybe<ui32> baselineCount = TBaselineReader(
+            Args.BaselineFilePath,
+            ClassLabelsToStrings(Args.ClassLabels)
+        ).GetBaselineCount();
+        CB_ENSURE(
+            !baselineCount || !columnsDescription.CountColumns(EColumn::Baseline),
+            "Baseline is specified both in Arrow data and in a separate file"
+        );
+
+        const TVector<TString> featureNames = GetFeatureNames(
+            columnsDescription,
+            headerColumns,
+            Args.FeatureNamesPath
+        );
+
+        DataMetaInfo = TDataMetaInfo(
+            std::move(columnsDescription),
+            targetType,
+            Args.GroupWeightsFilePath.Inited(),
+            Args.TimestampsFilePath.Inited(),
+            Args.PairsFilePath.Inited(),
+            baselineCount,
+            &featureNames,
+            Args.ClassLabels
+        );
+
+        ProcessIgnoredFeaturesList(
+            Args.IgnoredFeatures,
+            /*allFeaturesIgnoredMessage*/ Nothing(),
+            &DataMetaInfo,
+            &FeatureIgnored
+        );
+    }
+
+    void TArrowDataLoader::Do(IRawFeaturesOrderDataVisitor* visitor) {
+        visitor->Start(DataMetaInfo, ObjectCount, Args.ObjectsOrder, {Reader});
+
+        const auto& columnsDescription = DataMetaInfo.ColumnsInfo->Columns;
+        const ui32 columnCount = columnsDescription.size();
+
+        TVector<TMaybe<ui32>> flatFeatureIndices(columnCount); // [columnIdx], defined for used features
+        ui32 flatFeatureIdx = 0;
+        for (auto columnIdx : xrange(columnCount)) {
+            if (IsFactorColumn(columnsDescription[columnIdx].Type)) {
+                if (!FeatureIgnored[flatFeatureIdx]) {
+                    flatFeatureIndices[columnIdx] = flatFeatureIdx;
+                }
+                ++flatFeatureIdx;
+            }
+        }
+
+        // numeric features are the bulk of data in most cases, convert them in parallel
+        TVector<ITypedSequencePtr<float>> floatFeatures(columnCount); // [columnIdx]
+        Args.LocalExecutor->ExecRangeWithThrow(
+            [&] (int columnIdx) {
+                if ((columnsDescription[columnIdx].Type == EColumn::Num) && flatFeatureIndices[columnIdx]) {
+                    floatFeatures[columnIdx] = MakeFloatColumn(
+                        TArrowColumn(*Reader, columnIdx, ObjectOffset, ObjectCount),
+                        ObjectCount,
+                        /*allowNulls*/ true,
+                        "Num",
+                        Reader
+                    );
+                }
+            },
+            0,
+            SafeIntegerCast<int>(columnCount),
+            NPar::TLocalExecutor::WAIT_COMPLETE
+        );
+
+        ui32 targetIdx = 0;
+        ui32 baselineIdx = 0;
+        for (auto columnIdx : xrange(columnCount)) {
+            const EColumn columnType = columnsDescription[columnIdx].Type;
+            const TArrowColumn column(*Reader, columnIdx, ObjectOffset, ObjectCount);
+            switch (columnType) {
+                case EColumn::Num:
+                    if (flatFeatureIndices[columnIdx]) {
+                        visitor->AddFloatFeature(*flatFeatureIndices[columnIdx], std::move(floatFeatures[columnIdx]));
+                    }
+                    break;
+                case EColumn::Categ:
+                    if (flatFeatureIndices[columnIdx]) {
+                        AddCatFeature(column, *flatFeatureIndices[columnIdx], ObjectCount, visitor);
+                    }
+                    break;
+                case EColumn::Text:
+                    if (flatFeatureIndices[columnIdx]) {
+                        visitor->AddTextFeature(
+                            *flatFeatureIndices[columnIdx],
+                            TMaybeOwningConstArrayHolder<TString>::CreateOwning(
+                                ReadStringColumn(column, ObjectCount, /*allowNulls*/ true, "Text")
+                            )
+                        );
+                    }
+                    break;
+                case EColumn::Label:
+                    if (DataMetaInfo.TargetType == ERawTargetType::String) {
+                        visitor->AddTarget(
+                            targetIdx,
+                            ReadStringColumn(column, ObjectCount, /*allowNulls*/ false, "Label")
+                        );
+                    } else {
+                        visitor->AddTarget(
+                            targetIdx,
+                            MakeFloatColumn(column, ObjectCount, /*allowNulls*/ false, "Label", Reader)
+                        );
+                    }
+                    ++targetIdx;
+                    break;
+                case EColumn::Weight:
+                    visitor->AddWeights(ReadFloatColumn(column, ObjectCount, /*allowNulls*/ false, "Weight"));
+                    break;
+                case EColumn::GroupWeight:
+                    visitor->AddGroupWeights(
+                        ReadFloatColumn(column, ObjectCount, /*allowNulls*/ false, "GroupWeight")
+                    );
+                    break;
+                case EColumn::Baseline:
+                    visitor->AddBaseline(
+                        baselineIdx,
+                        ReadFloatColumn(column, ObjectCount, /*allowNulls*/ false, "Baseline")
+                    );
+                    ++baselineIdx;
+                    break;
+                case EColumn::GroupId:
+                    AddIds<TGroupId>(
+                        column,
+                        "GroupId",
+                        CalcGroupIdFor,
+                        [visitor] (ui32 objectIdx, TGroupId groupId) { visitor->AddGroupId(objectIdx, groupId); }
+                    );
+                    break;
+                case EColumn::SubgroupId:
+                    AddIds<TSubgroupId>(
+                        column,
+                        "SubgroupId",
+                        CalcSubgroupIdFor,
+                        [visitor] (ui32 objectIdx, TSubgroupId subgroupId) {
+                            visitor->AddSubgroupId(objectIdx, subgroupId);
+                        }
+                    );
+                    break;
+                case EColumn::Timestamp:
+                    column.ForEachValue(
+                        [&] (const TArrowArray* values, ui64 valueIdx, ui32 objectIdx) {
+                            CB_ENSURE(
+                                values && (values->GetInteger(valueIdx) >= 0),
+                                "Arrow column '" << column.GetName() << "': Timestamp values must be non-negative"
+                            );
+                            visitor->AddTimestamp(objectIdx, (ui64)values->GetInteger(valueIdx));
+                        }
+                    );
+                    break;
+                default: // Auxiliary, SampleId
+                    break;
+            }
+        }
+
+        SetBaseline(
+            Args.BaselineFilePath,
+            ObjectCount,
+            Args.DatasetSubset,
+            ClassLabelsToStrings(Args.ClassLabels),
+            visitor
+        );
+        SetGroupWeights(Args.GroupWeightsFilePath, ObjectCount, Args.DatasetSubset, visitor);
+        SetPairs(Args.PairsFilePath, Args.DatasetSubset, visitor->GetGroupIds(), visitor);
+        SetTimestamps(Args.TimestampsFilePath, ObjectCount, Args.DatasetSubset, visitor);
+
+        visitor->Finish();
+    }
+
+
+    namespace {
+        TExistsCheckerFactory::TRegistrator<TFSExistsChecker> ArrowExistsCheckerReg("arrow");
+        TDatasetLoaderFactory::TRegistrator<TArrowDataLoader> ArrowDataLoaderReg("arrow");
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "arrow_reader.h"
+#include "loader.h"
+
+#include <util/generic/ptr.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+
+namespace NCB {
+
+    /* Loader for "arrow://" paths: Apache Arrow IPC files (Feather V2) and streams.
+     *
+     * Columns roles are specified by the column description as for dsv, Arrow field names are used
+     * as a header. Numeric feature columns that are not split into several record batches and have
+     * no nulls are passed to the visitor without copying (the file stays memory mapped),
+     * dictionary-encoded categorical columns are hashed once per dictionary value.
+     */
+    class TArrowDataLoader : public IRawFeaturesOrderDatasetLoader {
+    public:
+        explicit TArrowDataLoader(TDatasetLoaderPullArgs&& args);
+
+        void Do(IRawFeaturesOrderDataVisitor* visitor) override;
+
+    private:
+        TDatasetLoaderCommonArgs Args;
+        TIntrusivePtr<TArrowIpcReader> Reader;
+
+        // loaded subset of objects
+        ui64 ObjectOffset = 0;
+        ui32 ObjectCount = 0;
+
+        TDataMetaInfo DataMetaInfo;
+        TVector<bool> FeatureIgnored; // [flatFeatureIdx]
+    };
+
+}
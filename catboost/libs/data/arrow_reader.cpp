@@ -0,0 +1,498 @@
+#include "arrow_reader.h"
+
+#include <catboost/idl/arrow/File.fbs.h>
+#include <catboost/idl/arrow/Message.fbs.h>
+#include <catboost/idl/arrow/Schema.fbs.h>
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+
+
+namespace NArrowFbs = org::apache::arrow::flatbuf;
+
+
+namespace NCB {
+
+    static constexpr TStringBuf ARROW_FILE_MAGIC = "ARROW1";
+
+    // file format: magic padded to 8 bytes, stream messages, footer, footer length, magic
+    static constexpr size_t ARROW_FILE_HEADER_SIZE = 8;
+    static constexpr size_t ARROW_FILE_TRAILER_SIZE = sizeof(i32) + ARROW_FILE_MAGIC.size();
+
+    static constexpr ui32 ARROW_CONTINUATION_MARKER = 0xFFFFFFFF;
+
+
+    bool IsArrowIntegerType(EArrowValueType type) {
+        switch (type) {
+            case EArrowValueType::Int8:
+            case EArrowValueType::Int16:
+            case EArrowValueType::Int32:
+            case EArrowValueType::Int64:
+            case EArrowValueType::UInt8:
+            case EArrowValueType::UInt16:
+            case EArrowValueType::UInt32:
+            case EArrowValueType::UInt64:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    bool IsArrowFloatingPointType(EArrowValueType type) {
+        return (type == EArrowValueType::Float32) || (type == EArrowValueType::Float64);
+    }
+
+    bool IsArrowStringType(EArrowValueType type) {
+        return (type == EArrowValueType::String) || (type == EArrowValueType::LargeString);
+    }
+
+    // 0 for bit-packed and variable length types
+    static size_t GetByteWidth(EArrowValueType type) {
+        switch (type) {
+            case EArrowValueType::Int8:
+            case EArrowValueType::UInt8:
+                return 1;
+            case EArrowValueType::Int16:
+            case EArrowValueType::UInt16:
+                return 2;
+            case EArrowValueType::Int32:
+            case EArrowValueType::UInt32:
+            case EArrowValueType::Float32:
+                return 4;
+            case EArrowValueType::Int64:
+            case EArrowValueType::UInt64:
+            case EArrowValueType::Float64:
+                return 8;
+            default:
+                return 0;
+        }
+    }
+
+
+    double TArrowArray::GetNumber(ui64 idx) const {
+        switch (Type) {
+            case EArrowValueType::Float32:
+                return GetPrimitive<float>(idx);
+            case EArrowValueType::Float64:
+                return GetPrimitive<double>(idx);
+            case EArrowValueType::UInt64:
+                return GetPrimitive<ui64>(idx);
+            default:
+                return GetInteger(idx);
+        }
+    }
+
+    i64 TArrowArray::GetInteger(ui64 idx) const {
+        switch (Type) {
+            case EArrowValueType::Bool:
+                return (Values[idx >> 3] >> (idx & 7)) & 1;
+            case EArrowValueType::Int8:
+                return GetPrimitive<i8>(idx);
+            case EArrowValueType::Int16:
+                return GetPrimitive<i16>(idx);
+            case EArrowValueType::Int32:
+                return GetPrimitive<i32>(idx);
+            case EArrowValueType::Int64:
+                return GetPrimitive<i64>(idx);
+            case EArrowValueType::UInt8:
+                return GetPrimitive<ui8>(idx);
+            case EArrowValueType::UInt16:
+                return GetPrimitive<ui16>(idx);
+            case EArrowValueType::UInt32:
+                return GetPrimitive<ui32>(idx);
+            case EArrowValueType::UInt64:
+                return (i64)GetPrimitive<ui64>(idx);
+            default:
+                CB_ENSURE_INTERNAL(false, "Arrow array of type " << (int)Type << " is not integer");
+        }
+    }
+
+    TStringBuf TArrowArray::GetString(ui64 idx) const {
+        ui64 begin;
+        ui64 end;
+        if (Type == EArrowValueType::String) {
+            begin = ReadUnaligned<i32>(Offsets.data() + idx * sizeof(i32));
+            end = ReadUnaligned<i32>(Offsets.data() + (idx + 1) * sizeof(i32));
+        } else {
+            Y_ASSERT(Type == EArrowValueType::LargeString);
+            begin = ReadUnaligned<i64>(Offsets.data() + idx * sizeof(i64));
+            end = ReadUnaligned<i64>(Offsets.data() + (idx + 1) * sizeof(i64));
+        }
+        return TStringBuf((const char*)Values.data() + begin, end - begin);
+    }
+
+
+    static EArrowValueType GetIntegerType(const NArrowFbs::Int* intType, const TString& fieldName) {
+        CB_ENSURE(intType, "Arrow field '" << fieldName << "': integer type parameters are missing");
+        switch (intType->bitWidth()) {
+            case 8:
+                return intType->is_signed() ? EArrowValueType::Int8 : EArrowValueType::UInt8;
+            case 16:
+                return intType->is_signed() ? EArrowValueType::Int16 : EArrowValueType::UInt16;
+            case 32:
+                return intType->is_signed() ? EArrowValueType::Int32 : EArrowValueType::UInt32;
+            case 64:
+                return intType->is_signed() ? EArrowValueType::Int64 : EArrowValueType::UInt64;
+            default:
+                CB_ENSURE(
+                    false,
+                    "Arrow field '" << fieldName << "': unsupported integer bit width " << intType->bitWidth()
+                );
+        }
+    }
+
+    static EArrowValueType GetValueType(const NArrowFbs::Field& field, const TString& fieldName) {
+        switch (field.type_type()) {
+            case NArrowFbs::Type_Bool:
+                return EArrowValueType::Bool;
+            case NArrowFbs::Type_Int:
+                return GetIntegerType(field.type_as_Int(), fieldName);
+            case NArrowFbs::Type_FloatingPoint: {
+                const auto* floatingPointType = field.type_as_FloatingPoint();
+                CB_ENSURE(floatingPointType, "Arrow field '" << fieldName << "': type parameters are missing");
+                switch (floatingPointType->precision()) {
+                    case NArrowFbs::Precision_SINGLE:
+                        return EArrowValueType::Float32;
+                    case NArrowFbs::Precision_DOUBLE:
+                        return EArrowValueType::Float64;
+                    default:
+                        CB_ENSURE(false, "Arrow field '" << fieldName << "': half precision floats are not supported");
+                }
+            }
+            case NArrowFbs::Type_Utf8:
+            case NArrowFbs::Type_Binary:
+                return EArrowValueType::String;
+            case NArrowFbs::Type_LargeUtf8:
+            case NArrowFbs::Type_LargeBinary:
+                return EArrowValueType::LargeString;
+
+            // temporal types are read as their integer storage
+            case NArrowFbs::Type_Date: {
+                const auto* dateType = field.type_as_Date();
+                return (dateType && (dateType->unit() == NArrowFbs::DateUnit_DAY)) ?
+                    EArrowValueType::Int32 : EArrowValueType::Int64;
+            }
+            case NArrowFbs::Type_Time: {
+                const auto* timeType = field.type_as_Time();
+                return (timeType && (timeType->bitWidth() == 32)) ? EArrowValueType::Int32 : EArrowValueType::Int64;
+            }
+            case NArrowFbs::Type_Timestamp:
+            case NArrowFbs::Type_Duration:
+                return EArrowValueType::Int64;
+            default:
+                CB_ENSURE(
+                    false,
+                    "Arrow field '" << fieldName << "' has unsupported type "
+                    << NArrowFbs::EnumNameType(field.type_type())
+                );
+        }
+    }
+
+    static TConstArrayRef<ui8> GetBodyBuffer(
+        const flatbuffers::Vector<const NArrowFbs::Buffer*>& buffers,
+        size_t* bufferIdx, // inout
+        TConstArrayRef<ui8> body,
+        const TString& fieldName
+    ) {
+        CB_ENSURE(*bufferIdx < buffers.size(), "Arrow field '" << fieldName << "': not enough buffers in message");
+        const NArrowFbs::Buffer* buffer = buffers.Get((*bufferIdx)++);
+        CB_ENSURE(
+            (buffer->offset() >= 0) && (buffer->length() >= 0)
+                && ((ui64)buffer->offset() + (ui64)buffer->length() <= body.size()),
+            "Arrow field '" << fieldName << "': buffer is out of message body bounds"
+        );
+        return body.Slice(buffer->offset(), buffer->length());
+    }
+
+    template <class TOffset>
+    static void CheckOffsets(const TArrowArray& array, const TString& fieldName) {
+        CB_ENSURE(
+            array.Offsets.size() >= (array.Length + 1) * sizeof(TOffset),
+            "Arrow field '" << fieldName << "': offsets buffer is too small"
+        );
+        TOffset prevOffset = 0;
+        for (auto i : xrange(array.Length + 1)) {
+            const TOffset offset = ReadUnaligned<TOffset>(array.Offsets.data() + i * sizeof(TOffset));
+            CB_ENSURE(
+                (offset >= prevOffset) && ((ui64)offset <= array.Values.size()),
+                "Arrow field '" << fieldName << "': offsets are inconsistent"
+            );
+            prevOffset = offset;
+        }
+    }
+
+    static TArrowArray ReadArray(
+        EArrowValueType type,
+        const NArrowFbs::FieldNode& fieldNode,
+        const flatbuffers::Vector<const NArrowFbs::Buffer*>& buffers,
+        size_t* bufferIdx, // inout
+        TConstArrayRef<ui8> body,
+        const TString& fieldName
+    ) {
+        CB_ENSURE(
+            (fieldNode.length() >= 0) && (fieldNode.null_count() >= 0)
+                && (fieldNode.null_count() <= fieldNode.length()),
+            "Arrow field '" << fieldName << "': wrong length or null count"
+        );
+
+        TArrowArray array;
+        array.Type = type;
+        array.Length = fieldNode.length();
+        array.NullCount = fieldNode.null_count();
+
+        array.Validity = GetBodyBuffer(buffers, bufferIdx, body, fieldName);
+        if (array.NullCount) {
+            CB_ENSURE(
+                array.Validity.size() * 8 >= array.Length,
+                "Arrow field '" << fieldName << "': validity buffer is too small"
+            );
+        } else {
+            array.Validity = {};
+        }
+
+        if (IsArrowStringType(type)) {
+            array.Offsets = GetBodyBuffer(buffers, bufferIdx, body, fieldName);
+            array.Values = GetBodyBuffer(buffers, bufferIdx, body, fieldName);
+            if (array.Length) {
+                if (type == EArrowValueType::String) {
+                    CheckOffsets<i32>(array, fieldName);
+                } else {
+                    CheckOffsets<i64>(array, fieldName);
+                }
+            }
+        } else {
+            array.Values = GetBodyBuffer(buffers, bufferIdx, body, fieldName);
+            const size_t byteWidth = GetByteWidth(type);
+            const ui64 requiredSize = byteWidth ? (array.Length * byteWidth) : ((array.Length + 7) / 8);
+            CB_ENSURE(
+                array.Values.size() >= requiredSize,
+                "Arrow field '" << fieldName << "': values buffer is too small"
+            );
+        }
+        return array;
+    }
+
+
+    TArrowIpcReader::TArrowIpcReader(const TString& path)
+        : Path(path)
+        , Data(TBlob::FromFile(path))
+    {
+        const TStringBuf data(Data.AsCharPtr(), Data.Size());
+        if (data.StartsWith(ARROW_FILE_MAGIC)) {
+            ReadFileFormat();
+        } else {
+            ReadStreamFormat();
+        }
+    }
+
+    const TArrowArray& TArrowIpcReader::GetDictionary(size_t fieldIdx) const {
+        const auto& field = Fields[fieldIdx];
+        CB_ENSURE_INTERNAL(field.DictionaryIndexType, "Arrow field '" << field.Name << "' is not dictionary-encoded");
+        for (const auto& [id, dictionary] : Dictionaries) {
+            if (id == field.DictionaryId) {
+                return dictionary;
+            }
+        }
+        CB_ENSURE(false, Path << ": no dictionary for Arrow field '" << field.Name << "'");
+    }
+
+    void TArrowIpcReader::ReadFileFormat() {
+        const ui8* data = (const ui8*)Data.Data();
+        const size_t size = Data.Size();
+
+        CB_ENSURE(
+            (size >= ARROW_FILE_HEADER_SIZE + ARROW_FILE_TRAILER_SIZE)
+                && TStringBuf(Data.AsCharPtr(), size).EndsWith(ARROW_FILE_MAGIC),
+            Path << ": Arrow file is truncated"
+        );
+        const i32 footerLength = ReadUnaligned<i32>(data + size - ARROW_FILE_TRAILER_SIZE);
+        CB_ENSURE(
+            (footerLength > 0) && ((size_t)footerLength <= size - ARROW_FILE_HEADER_SIZE - ARROW_FILE_TRAILER_SIZE),
+            Path << ": wrong Arrow file footer length"
+        );
+        const ui8* footerData = data + size - ARROW_FILE_TRAILER_SIZE - footerLength;
+
+        flatbuffers::Verifier verifier(footerData, footerLength, 64 /* max depth */, 256000000 /* max tables */);
+        CB_ENSURE(NArrowFbs::VerifyFooterBuffer(verifier), Path << ": Arrow file footer is corrupted");
+        const NArrowFbs::Footer* footer = NArrowFbs::GetFooter(footerData);
+
+        CB_ENSURE(footer->schema(), Path << ": Arrow file footer has no schema");
+        ReadSchema(*footer->schema());
+
+        auto readBlocks = [&] (const flatbuffers::Vector<const NArrowFbs::Block*>* blocks) {
+            if (!blocks) {
+                return;
+            }
+            for (const NArrowFbs::Block* block : *blocks) {
+                CB_ENSURE(block->offset() >= 0, Path << ": wrong Arrow file block offset");
+                ui64 nextOffset;
+                CB_ENSURE(ReadMessage(block->offset(), &nextOffset), Path << ": empty Arrow file block");
+            }
+        };
+        // dictionaries must be known before the record batches that reference them
+        readBlocks(footer->dictionaries());
+        readBlocks(footer->recordBatches());
+    }
+
+    void TArrowIpcReader::ReadStreamFormat() {
+        ui64 offset = 0;
+        while ((offset < Data.Size()) && ReadMessage(offset, &offset)) {
+        }
+        CB_ENSURE(HasSchema, Path << ": no schema in Arrow stream");
+    }
+
+    bool TArrowIpcReader::ReadMessage(ui64 offset, ui64* nextOffset) {
+        const ui8* data = (const ui8*)Data.Data();
+        const ui64 size = Data.Size();
+
+        auto readLength = [&] () -> ui32 {
+            CB_ENSURE(offset + sizeof(ui32) <= size, Path << ": unexpected end of Arrow data");
+            const ui32 value = ReadUnaligned<ui32>(data + offset);
+            offset += sizeof(ui32);
+            return value;
+        };
+
+        // messages written before Arrow 0.15 have no continuation marker
+        ui32 metadataLength = readLength();
+        if (metadataLength == ARROW_CONTINUATION_MARKER) {
+            metadataLength = readLength();
+        }
+        if (metadataLength == 0) {
+            return false;
+        }
+        CB_ENSURE(metadataLength <= size - offset, Path << ": unexpected end of Arrow data");
+
+        flatbuffers::Verifier verifier(data + offset, metadataLength, 64 /* max depth */, 256000000 /* max tables */);
+        CB_ENSURE(NArrowFbs::VerifyMessageBuffer(verifier), Path << ": Arrow message metadata is corrupted");
+        const NArrowFbs::Message* message = NArrowFbs::GetMessage(data + offset);
+        offset += metadataLength;
+
+        CB_ENSURE(
+            message->version() >= NArrowFbs::MetadataVersion_V4,
+            Path << ": Arrow metadata versions before V4 are not supported"
+        );
+        CB_ENSURE(
+            (message->bodyLength() >= 0) && ((ui64)message->bodyLength() <= size - offset),
+            Path << ": Arrow message body is out of data bounds"
+        );
+        const TConstArrayRef<ui8> body(data + offset, message->bodyLength());
+
+        switch (message->header_type()) {
+            case NArrowFbs::MessageHeader_Schema:
+                CB_ENSURE(!HasSchema, Path << ": several schemas in Arrow data");
+                ReadSchema(*message->header_as_Schema());
+                break;
+            case NArrowFbs::MessageHeader_DictionaryBatch:
+                CB_ENSURE(HasSchema, Path << ": Arrow dictionary batch before schema");
+                ReadDictionaryBatch(*message->header_as_DictionaryBatch(), body);
+                break;
+            case NArrowFbs::MessageHeader_RecordBatch:
+                CB_ENSURE(HasSchema, Path << ": Arrow record batch before schema");
+                ReadRecordBatch(*message->header_as_RecordBatch(), body);
+                break;
+            default:
+                CB_ENSURE(
+                    false,
+                    Path << ": unsupported Arrow message type "
+                    << NArrowFbs::EnumNameMessageHeader(message->header_type())
+                );
+        }
+
+        *nextOffset = offset + body.size();
+        return true;
+    }
+
+    void TArrowIpcReader::ReadSchema(const NArrowFbs::Schema& schema) {
+        CB_ENSURE(
+            schema.endianness() == NArrowFbs::Endianness_Little,
+            Path << ": big-endian Arrow data is not supported"
+        );
+        CB_ENSURE(schema.fields() && schema.fields()->size(), Path << ": Arrow schema has no fields");
+
+        for (const NArrowFbs::Field* fbsField : *schema.fields()) {
+            TArrowField field;
+            if (fbsField->name()) {
+                field.Name = fbsField->name()->str();
+            }
+            field.Type = GetValueType(*fbsField, field.Name);
+            if (const auto* dictionaryEncoding = fbsField->dictionary()) {
+                // index type is int32 if not specified
+                field.DictionaryIndexType = dictionaryEncoding->indexType() ?
+                    GetIntegerType(dictionaryEncoding->indexType(), field.Name) : EArrowValueType::Int32;
+                field.DictionaryId = dictionaryEncoding->id();
+            }
+            Fields.push_back(std::move(field));
+        }
+        HasSchema = true;
+    }
+
+    void TArrowIpcReader::ReadDictionaryBatch(
+        const NArrowFbs::DictionaryBatch& dictionaryBatch,
+        TConstArrayRef<ui8> body
+    ) {
+        const i64 id = dictionaryBatch.id();
+        const TArrowField* field = FindIfPtr(
+            Fields,
+            [id] (const TArrowField& field) { return field.DictionaryIndexType && (field.DictionaryId == id); }
+        );
+        CB_ENSURE(field, Path << ": Arrow dictionary batch with unknown id " << id);
+        CB_ENSURE(!dictionaryBatch.isDelta(), Path << ": Arrow delta dictionaries are not supported");
+        CB_ENSURE(
+            !FindIfPtr(Dictionaries, [id] (const auto& idAndDictionary) { return idAndDictionary.first == id; }),
+            Path << ": Arrow dictionary replacement is not supported"
+        );
+
+        const NArrowFbs::RecordBatch* data = dictionaryBatch.data();
+        CB_ENSURE(
+            data && data->nodes() && (data->nodes()->size() == 1) && data->buffers(),
+            Path << ": Arrow dictionary batch for field '" << field->Name << "' is malformed"
+        );
+        CB_ENSURE(
+            !data->compression(),
+            Path << ": compressed Arrow data is not supported, write it with compression='uncompressed'"
+        );
+        size_t bufferIdx = 0;
+        Dictionaries.emplace_back(
+            id,
+            ReadArray(field->Type, *data->nodes()->Get(0), *data->buffers(), &bufferIdx, body, field->Name)
+        );
+    }
+
+    void TArrowIpcReader::ReadRecordBatch(const NArrowFbs::RecordBatch& recordBatch, TConstArrayRef<ui8> body) {
+        CB_ENSURE(
+            !recordBatch.compression(),
+            Path << ": compressed Arrow data is not supported, write it with compression='uncompressed'"
+        );
+        CB_ENSURE(
+            recordBatch.nodes() && (recordBatch.nodes()->size() == Fields.size()) && recordBatch.buffers(),
+            Path << ": Arrow record batch does not match schema"
+        );
+        CB_ENSURE(recordBatch.length() >= 0, Path << ": wrong Arrow record batch length");
+
+        TVector<TArrowArray> columns;
+        columns.reserve(Fields.size());
+        size_t bufferIdx = 0;
+        for (auto fieldIdx : xrange(Fields.size())) {
+            const auto& field = Fields[fieldIdx];
+            columns.push_back(
+                ReadArray(
+                    field.DictionaryIndexType ? *field.DictionaryIndexType : field.Type,
+                    *recordBatch.nodes()->Get(fieldIdx),
+                    *recordBatch.buffers(),
+                    &bufferIdx,
+                    body,
+                    field.Name
+                )
+            );
+            CB_ENSURE(
+                columns.back().Length == (ui64)recordBatch.length(),
+                Path << ": Arrow field '" << field.Name << "' length differs from record batch length"
+            );
+        }
+        RowCount += recordBatch.length();
+        RecordBatches.push_back(std::move(columns));
+    }
+
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <catboost/libs/helpers/resource_holder.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/maybe.h>
+#include <util/generic/strbuf.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/memory/blob.h>
+#include <util/system/types.h>
+#include <util/system/unaligned_mem.h>
+
+
+namespace org::apache::arrow::flatbuf {
+    struct DictionaryBatch;
+    struct RecordBatch;
+    struct Schema;
+}
+
+
+namespace NCB {
+
+    // physical types of Arrow arrays supported by TArrowIpcReader
+    enum class EArrowValueType {
+        Bool,
+        Int8,
+        Int16,
+        Int32,
+        Int64,
+        UInt8,
+        UInt16,
+        UInt32,
+        UInt64,
+        Float32,
+        Float64,
+        String,     // Utf8 and Binary, 32-bit offsets
+        LargeString // LargeUtf8 and LargeBinary, 64-bit offsets
+    };
+
+    bool IsArrowIntegerType(EArrowValueType type);
+    bool IsArrowFloatingPointType(EArrowValueType type);
+    bool IsArrowStringType(EArrowValueType type);
+
+
+    /* Buffers of a single column of a record batch (or of a dictionary), they point to the mapped file.
+     * Values are converted to the caller's type on access, only little-endian data is supported.
+     */
+    struct TArrowArray {
+        EArrowValueType Type = EArrowValueType::Int32;
+        ui64 Length = 0;
+        ui64 NullCount = 0;
+        TConstArrayRef<ui8> Validity; // empty if NullCount == 0
+        TConstArrayRef<ui8> Offsets;  // for string types only
+        TConstArrayRef<ui8> Values;
+
+    public:
+        bool IsNull(ui64 idx) const {
+            return NullCount && !((Validity[idx >> 3] >> (idx & 7)) & 1);
+        }
+
+        template <class T>
+        T GetPrimitive(ui64 idx) const {
+            return ReadUnaligned<T>(Values.data() + idx * sizeof(T));
+        }
+
+        // for integer, floating point and bool types
+        double GetNumber(ui64 idx) const;
+
+        // for integer and bool types
+        i64 GetInteger(ui64 idx) const;
+
+        // for string types
+        TStringBuf GetString(ui64 idx) const;
+
+        // returns true if values can be used as float[] directly
+        bool IsFloatArray() const {
+            return (Type == EArrowValueType::Float32) && !NullCount;
+        }
+    };
+
+
+    struct TArrowField {
+        TString Name;
+
+        // for dictionary-encoded fields: type of dictionary values
+        EArrowValueType Type = EArrowValueType::Int32;
+
+        // defined for dictionary-encoded fields, column arrays contain indices of this type then
+        TMaybe<EArrowValueType> DictionaryIndexType;
+        i64 DictionaryId = 0;
+    };
+
+
+    /* Reader of Apache Arrow IPC data: both the file format (Feather V2) and the streaming format.
+     *
+     * The file is memory mapped and all arrays point to the mapping, so nothing is copied
+     * and the reader (that is a resource holder) must outlive the arrays.
+     * Supported are little-endian data with uncompressed bodies, columns of flat types
+     * (see EArrowValueType, temporal types are read as their integer storage) and dictionary-encoded
+     * columns of these types (without delta dictionaries).
+     */
+    class TArrowIpcReader : public IResourceHolder {
+    public:
+        explicit TArrowIpcReader(const TString& path);
+
+        const TVector<TArrowField>& GetFields() const {
+            return Fields;
+        }
+
+        ui64 GetRowCount() const {
+            return RowCount;
+        }
+
+        size_t GetRecordBatchCount() const {
+            return RecordBatches.size();
+        }
+
+        // for dictionary-encoded fields contains dictionary indices
+        const TArrowArray& GetColumn(size_t recordBatchIdx, size_t fieldIdx) const {
+            return RecordBatches[recordBatchIdx][fieldIdx];
+        }
+
+        // for dictionary-encoded fields only
+        const TArrowArray& GetDictionary(size_t fieldIdx) const;
+
+    private:
+        void ReadFileFormat();
+        void ReadStreamFormat();
+
+        // returns false at the end of stream marker
+        bool ReadMessage(ui64 offset, ui64* nextOffset);
+
+        void ReadSchema(const org::apache::arrow::flatbuf::Schema& schema);
+        void ReadDictionaryBatch(
+            const org::apache::arrow::flatbuf::DictionaryBatch& dictionaryBatch,
+            TConstArrayRef<ui8> body
+        );
+        void ReadRecordBatch(const org::apache::arrow::flatbuf::RecordBatch& recordBatch, TConstArrayRef<ui8> body);
+
+    private:
+        TString Path;
+        TBlob Data;
+
+        bool HasSchema = false;
+        TVector<TArrowField> Fields;
+        ui64 RowCount = 0;
+        TVector<TVector<TArrowArray>> RecordBatches; // [recordBatchIdx][fieldIdx]
+        TVector<std::pair<i64, TArrowArray>> Dictionaries;
+    };
+
+}
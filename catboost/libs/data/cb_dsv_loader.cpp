@@ -9,11 +9,13 @@
 #include <library/cpp/object_factory/object_factory.h>
 #include <library/cpp/string_utils/csv/csv.h>
 
+#include <util/generic/cast.h>
 #include <util/generic/strbuf.h>
 #include <util/generic/vector.h>
 #include <util/generic/xrange.h>
 #include <util/stream/file.h>
 #include <util/string/split.h>
+#include <util/system/file.h>
 #include <util/system/guard.h>
 #include <util/system/types.h>
 
@@ -23,7 +25,7 @@ namespace NCB {
     TCBDsvDataLoader::TCBDsvDataLoader(TDatasetLoaderPullArgs&& args)
         : TCBDsvDataLoader(
             TLineDataLoaderPushArgs {
-                GetLineDataReader(args.PoolPath, args.CommonArgs.PoolFormat),
+                GetLineDataReader(args.PoolPath, args.CommonArgs.PoolFormat, args.CommonArgs.LocalExecutor),
                 std::move(args.CommonArgs)
             }
         )
@@ -88,20 +90,50 @@ namespace NCB {
             &FeatureIgnored
         );
 
+        // baseline file is read in sync with data blocks, so it requires sequential reading
+        FileLineDataReader = dynamic_cast<const TFileLineDataReader*>(LineDataReader.Get());
+        if (!FileLineDataReader || BaselineReader.Inited()) {
+            FileLineDataReader = nullptr;
+            StartAsyncReading();
+        }
+    }
+
+    void TCBDsvDataLoader::StartAsyncReading() {
         AsyncRowProcessor.ReadBlockAsync(GetReadFunc());
         if (BaselineReader.Inited()) {
             AsyncBaselineRowProcessor.ReadBlockAsync(GetReadBaselineFunc());
         }
+        AsyncReadingStarted = true;
     }
 
     TVector<TColumn> TCBDsvDataLoader::CreateColumnsDescription(ui32 columnsCount) {
         return Args.CdProvider->GetColumnsDescription(columnsCount);
     }
 
+    // several ranges per thread to balance the load, but not too large to keep visitor blocks moderate
+    static ui64 GetLineRangeSize(const TString& path, int threadCount) {
+        const ui64 fileSize = GetFileLength(path);
+        return Max<ui64>(1 << 20, Min<ui64>(64 << 20, fileSize / (4 * threadCount) + 1));
+    }
+
     ui32 TCBDsvDataLoader::GetObjectCountSynchronized() {
         TGuard g(ObjectCountMutex);
         if (!ObjectCount) {
-            const ui64 dataLineCount = LineDataReader->GetDataLineCount();
+            ui64 dataLineCount = 0;
+            if (FileLineDataReader) {
+                const auto& readerArgs = FileLineDataReader->GetArgs();
+                LineRanges = SplitFileIntoLineRanges(
+                    readerArgs.PathWithScheme.Path,
+                    readerArgs.Format.HasHeader,
+                    GetLineRangeSize(readerArgs.PathWithScheme.Path, Args.LocalExecutor->GetThreadCount() + 1),
+                    Args.LocalExecutor
+                );
+                for (const auto& range : LineRanges) {
+                    dataLineCount += range.LineCount;
+                }
+            } else {
+                dataLineCount = LineDataReader->GetDataLineCount();
+            }
             CB_ENSURE(
                 dataLineCount <= Max<ui32>(), "CatBoost does not support datasets with more than "
                 << Max<ui32>() << " objects"
@@ -112,6 +144,47 @@ namespace NCB {
         return *ObjectCount;
     }
 
+    void TCBDsvDataLoader::DoInLineRanges(IRawObjectsOrderDataVisitor* visitor) {
+        StartBuilder(false, GetObjectCountSynchronized(), 0, visitor);
+
+        const TString& path = FileLineDataReader->GetArgs().PathWithScheme.Path;
+        const size_t rangesPerBlock = Args.LocalExecutor->GetThreadCount() + 1;
+        ui64 linesProcessed = 0;
+        for (size_t blockStart = 0; blockStart < LineRanges.size(); blockStart += rangesPerBlock) {
+            const size_t blockEnd = Min(blockStart + rangesPerBlock, LineRanges.size());
+
+            TVector<ui32> rangeOffsetsInBlock;
+            ui32 blockSize = 0;
+            for (auto rangeIdx : xrange(blockStart, blockEnd)) {
+                rangeOffsetsInBlock.push_back(blockSize);
+                blockSize += LineRanges[rangeIdx].LineCount;
+            }
+
+            visitor->StartNextBlock(blockSize);
+            Args.LocalExecutor->ExecRangeWithThrow(
+                [&] (int rangeIdxInBlock) {
+                    const auto& range = LineRanges[blockStart + rangeIdxInBlock];
+                    const ui32 rangeEnd = rangeOffsetsInBlock[rangeIdxInBlock] + range.LineCount;
+
+                    TFileLineRangeReader reader(path, range);
+                    TString line;
+                    ui32 inBlockIdx = rangeOffsetsInBlock[rangeIdxInBlock];
+                    for (; reader.ReadLine(&line); ++inBlockIdx) {
+                        CB_ENSURE(inBlockIdx < rangeEnd, "Pool file " << path << " has been changed during loading");
+                        ProcessLine(line, inBlockIdx, linesProcessed, visitor);
+                    }
+                    CB_ENSURE(inBlockIdx == rangeEnd, "Pool file " << path << " has been changed during loading");
+                },
+                0,
+                SafeIntegerCast<int>(blockEnd - blockStart),
+                NPar::TLocalExecutor::WAIT_COMPLETE
+            );
+            linesProcessed += blockSize;
+        }
+
+        FinalizeBuilder(false, visitor);
+    }
+
     void TCBDsvDataLoader::StartBuilder(bool inBlock,
                                           ui32 objectCount, ui32 /*offset*/,
                                           IRawObjectsOrderDataVisitor* visitor)
@@ -144,170 +217,178 @@ namespace NCB {
         return result;
     }
 
-    void TCBDsvDataLoader::ProcessBlock(IRawObjectsOrderDataVisitor* visitor) {
-        visitor->StartNextBlock(AsyncRowProcessor.GetParseBufferSize());
-
-        auto& columnsDescription = DataMetaInfo.ColumnsInfo->Columns;
-
-        auto parseBlock = [&](TString& line, int lineIdx) {
-            const auto& featuresLayout = *DataMetaInfo.FeaturesLayout;
-
-            ui32 featureId = 0;
-            ui32 targetId = 0;
-            ui32 baselineIdx = 0;
-
-            TVector<float> floatFeatures;
-            floatFeatures.yresize(featuresLayout.GetFloatFeatureCount());
-
-            TVector<ui32> catFeatures;
-            catFeatures.yresize(featuresLayout.GetCatFeatureCount());
-
-            TVector<TString> textFeatures;
-            textFeatures.yresize(featuresLayout.GetTextFeatureCount());
-
-            TVector<TVector<float>> embeddingFeatures;
-            embeddingFeatures.yresize(featuresLayout.GetEmbeddingFeatureCount());
-
-            size_t tokenIdx = 0;
-            try {
-                const bool floatFeaturesOnly = catFeatures.empty() && textFeatures.empty();
-                auto splitter = NCsvFormat::CsvSplitter(line, FieldDelimiter, floatFeaturesOnly ? '\0' : CsvSplitterQuote);
-                do {
-                    TStringBuf token = splitter.Consume();
-                    CB_ENSURE(
-                        tokenIdx < columnsDescription.size(),
-                        "wrong column count: found more than " << columnsDescription.ysize() << " values"
-                    );
-                    try {
-                        switch (columnsDescription[tokenIdx].Type) {
-                            case EColumn::Categ: {
-                                if (!FeatureIgnored[featureId]) {
-                                    const ui32 catFeatureIdx = featuresLayout.GetInternalFeatureIdx(featureId);
-                                    catFeatures[catFeatureIdx] = visitor->GetCatFeatureValue(lineIdx, featureId, token);
-                                }
-                                ++featureId;
-                                break;
-                            }
-                            case EColumn::Num: {
-                                if (!FeatureIgnored[featureId]) {
-                                    if (!TryParseFloatFeatureValue(
-                                            token,
-                                            &floatFeatures[featuresLayout.GetInternalFeatureIdx(featureId)]
-                                         ))
-                                    {
-                                        CB_ENSURE(
-                                            false,
-                                            "Factor " << featureId << " cannot be parsed as float."
-                                            " Try correcting column description file."
-                                        );
-                                    }
-                                }
-                                ++featureId;
-                                break;
-                            }
-                            case EColumn::Text: {
-                                if (!FeatureIgnored[featureId]) {
-                                    const ui32 textFeatureIdx = featuresLayout.GetInternalFeatureIdx(featureId);
-                                    textFeatures[textFeatureIdx] = TString(token);
-                                }
-                                ++featureId;
-                                break;
+    void TCBDsvDataLoader::ProcessLine(
+        TString& line,
+        ui32 inBlockIdx,
+        ui64 blockFirstLineIdx,
+        IRawObjectsOrderDataVisitor* visitor
+    ) {
+        const auto& columnsDescription = DataMetaInfo.ColumnsInfo->Columns;
+        const auto& featuresLayout = *DataMetaInfo.FeaturesLayout;
+
+        ui32 featureId = 0;
+        ui32 targetId = 0;
+        ui32 baselineIdx = 0;
+
+        TVector<float> floatFeatures;
+        floatFeatures.yresize(featuresLayout.GetFloatFeatureCount());
+
+        TVector<ui32> catFeatures;
+        catFeatures.yresize(featuresLayout.GetCatFeatureCount());
+
+        TVector<TString> textFeatures;
+        textFeatures.yresize(featuresLayout.GetTextFeatureCount());
+
+        TVector<TVector<float>> embeddingFeatures;
+        embeddingFeatures.yresize(featuresLayout.GetEmbeddingFeatureCount());
+
+        size_t tokenIdx = 0;
+        try {
+            const bool floatFeaturesOnly = catFeatures.empty() && textFeatures.empty();
+            auto splitter = NCsvFormat::CsvSplitter(line, FieldDelimiter, floatFeaturesOnly ? '\0' : CsvSplitterQuote);
+            do {
+                TStringBuf token = splitter.Consume();
+                CB_ENSURE(
+                    tokenIdx < columnsDescription.size(),
+                    "wrong column count: found more than " << columnsDescription.ysize() << " values"
+                );
+                try {
+                    switch (columnsDescription[tokenIdx].Type) {
+                        case EColumn::Categ: {
+                            if (!FeatureIgnored[featureId]) {
+                                const ui32 catFeatureIdx = featuresLayout.GetInternalFeatureIdx(featureId);
+                                catFeatures[catFeatureIdx] = visitor->GetCatFeatureValue(inBlockIdx, featureId, token);
                             }
-                            case EColumn::NumVector: {
-                                if (!FeatureIgnored[featureId]) {
-                                    const ui32 embeddingFeatureIdx
-                                        = featuresLayout.GetInternalFeatureIdx(featureId);
-                                    embeddingFeatures[embeddingFeatureIdx] = ProcessNumVector(
+                            ++featureId;
+                            break;
+                        }
+                        case EColumn::Num: {
+                            if (!FeatureIgnored[featureId]) {
+                                if (!TryParseFloatFeatureValue(
                                         token,
-                                        NumVectorDelimiter,
-                                        featureId
+                                        &floatFeatures[featuresLayout.GetInternalFeatureIdx(featureId)]
+                                     ))
+                                {
+                                    CB_ENSURE(
+                                        false,
+                                        "Factor " << featureId << " cannot be parsed as float."
+                                        " Try correcting column description file."
                                     );
                                 }
-                                ++featureId;
-                                break;
                             }
-                            case EColumn::Label: {
-                                CB_ENSURE(token.length() != 0, "empty values not supported for Label");
-                                visitor->AddTarget(targetId, lineIdx, TString(token));
-                                ++targetId;
+                            ++featureId;
                             break;
+                        }
+                        case EColumn::Text: {
+                            if (!FeatureIgnored[featureId]) {
+                                const ui32 textFeatureIdx = featuresLayout.GetInternalFeatureIdx(featureId);
+                                textFeatures[textFeatureIdx] = TString(token);
                             }
-                            case EColumn::Weight: {
-                                CB_ENSURE(token.length() != 0, "empty values not supported for weight");
-                                visitor->AddWeight(lineIdx, FromString<float>(token));
-                                break;
-                            }
-                            case EColumn::Auxiliary: {
-                                break;
-                            }
-                            case EColumn::GroupId: {
-                                CB_ENSURE(token.length() != 0, "empty values not supported for GroupId");
-                                visitor->AddGroupId(lineIdx, CalcGroupIdFor(token));
-                                break;
-                            }
-                            case EColumn::GroupWeight: {
-                                CB_ENSURE(token.length() != 0, "empty values not supported for GroupWeight");
-                                visitor->AddGroupWeight(lineIdx, FromString<float>(token));
-                                break;
-                            }
-                            case EColumn::SubgroupId: {
-                                CB_ENSURE(token.length() != 0, "empty values not supported for SubgroupId");
-                                visitor->AddSubgroupId(lineIdx, CalcSubgroupIdFor(token));
-                                break;
-                            }
-                            case EColumn::Baseline: {
-                                CB_ENSURE(token.length() != 0, "empty values not supported for Baseline");
-                                visitor->AddBaseline(lineIdx, baselineIdx, FromString<float>(token));
-                                ++baselineIdx;
-                                break;
-                            }
-                            case EColumn::SampleId: {
-                                break;
-                            }
-                            case EColumn::Timestamp: {
-                                CB_ENSURE(token.length() != 0, "empty values not supported for Timestamp");
-                                visitor->AddTimestamp(lineIdx, FromString<ui64>(token));
-                                break;
-                            }
-                            default: {
-                                CB_ENSURE(false, "wrong column type");
+                            ++featureId;
+                            break;
+                        }
+                        case EColumn::NumVector: {
+                            if (!FeatureIgnored[featureId]) {
+                                const ui32 embeddingFeatureIdx
+                                    = featuresLayout.GetInternalFeatureIdx(featureId);
+                                embeddingFeatures[embeddingFeatureIdx] = ProcessNumVector(
+                                    token,
+                                    NumVectorDelimiter,
+                                    featureId
+                                );
                             }
+                            ++featureId;
+                            break;
+                        }
+                        case EColumn::Label: {
+                            CB_ENSURE(token.length() != 0, "empty values not supported for Label");
+                            visitor->AddTarget(targetId, inBlockIdx, TString(token));
+                            ++targetId;
+                        break;
+                        }
+                        case EColumn::Weight: {
+                            CB_ENSURE(token.length() != 0, "empty values not supported for weight");
+                            visitor->AddWeight(inBlockIdx, FromString<float>(token));
+                            break;
+                        }
+                        case EColumn::Auxiliary: {
+                            break;
+                        }
+                        case EColumn::GroupId: {
+                            CB_ENSURE(token.length() != 0, "empty values not supported for GroupId");
+                            visitor->AddGroupId(inBlockIdx, CalcGroupIdFor(token));
+                            break;
+                        }
+                        case EColumn::GroupWeight: {
+                            CB_ENSURE(token.length() != 0, "empty values not supported for GroupWeight");
+                            visitor->AddGroupWeight(inBlockIdx, FromString<float>(token));
+                            break;
+                        }
+                        case EColumn::SubgroupId: {
+                            CB_ENSURE(token.length() != 0, "empty values not supported for SubgroupId");
+                            visitor->AddSubgroupId(inBlockIdx, CalcSubgroupIdFor(token));
+                            break;
+                        }
+                        case EColumn::Baseline: {
+                            CB_ENSURE(token.length() != 0, "empty values not supported for Baseline");
+                            visitor->AddBaseline(inBlockIdx, baselineIdx, FromString<float>(token));
+                            ++baselineIdx;
+                            break;
+                        }
+                        case EColumn::SampleId: {
+                            break;
+                        }
+                        case EColumn::Timestamp: {
+                            CB_ENSURE(token.length() != 0, "empty values not supported for Timestamp");
+                            visitor->AddTimestamp(inBlockIdx, FromString<ui64>(token));
+                            break;
+                        }
+                        default: {
+                            CB_ENSURE(false, "wrong column type");
                         }
-                    } catch (yexception& e) {
-                        throw TCatBoostException() << "Column " << tokenIdx << " (type "
-                            << columnsDescription[tokenIdx].Type << ", value = \"" << token
-                            << "\"): " << e.what();
                     }
-                    ++tokenIdx;
-                } while (splitter.Step());
-                CB_ENSURE(
-                    tokenIdx == columnsDescription.size(),
-                    "wrong column count: expected " << columnsDescription.ysize() << ", found " << tokenIdx
-                );
-                if (!floatFeatures.empty()) {
-                    visitor->AddAllFloatFeatures(lineIdx, floatFeatures);
-                }
-                if (!catFeatures.empty()) {
-                    visitor->AddAllCatFeatures(lineIdx, catFeatures);
+                } catch (yexception& e) {
+                    throw TCatBoostException() << "Column " << tokenIdx << " (type "
+                        << columnsDescription[tokenIdx].Type << ", value = \"" << token
+                        << "\"): " << e.what();
                 }
-                if (!textFeatures.empty()) {
-                    visitor->AddAllTextFeatures(lineIdx, textFeatures);
-                }
-                if (!embeddingFeatures.empty()) {
-                    for (auto embeddingFeatureIdx : xrange(embeddingFeatures.size())) {
-                        visitor->AddEmbeddingFeature(
-                            lineIdx,
-                            featuresLayout.GetEmbeddingFeatureInternalIdxToExternalIdx()[embeddingFeatureIdx],
-                            TMaybeOwningConstArrayHolder<float>::CreateOwning(
-                                std::move(embeddingFeatures[embeddingFeatureIdx])
-                            )
-                        );
-                    }
+                ++tokenIdx;
+            } while (splitter.Step());
+            CB_ENSURE(
+                tokenIdx == columnsDescription.size(),
+                "wrong column count: expected " << columnsDescription.ysize() << ", found " << tokenIdx
+            );
+            if (!floatFeatures.empty()) {
+                visitor->AddAllFloatFeatures(inBlockIdx, floatFeatures);
+            }
+            if (!catFeatures.empty()) {
+                visitor->AddAllCatFeatures(inBlockIdx, catFeatures);
+            }
+            if (!textFeatures.empty()) {
+                visitor->AddAllTextFeatures(inBlockIdx, textFeatures);
+            }
+            if (!embeddingFeatures.empty()) {
+                for (auto embeddingFeatureIdx : xrange(embeddingFeatures.size())) {
+                    visitor->AddEmbeddingFeature(
+                        inBlockIdx,
+                        featuresLayout.GetEmbeddingFeatureInternalIdxToExternalIdx()[embeddingFeatureIdx],
+                        TMaybeOwningConstArrayHolder<float>::CreateOwning(
+                            std::move(embeddingFeatures[embeddingFeatureIdx])
+                        )
+                    );
                 }
-            } catch (yexception& e) {
-                throw TCatBoostException() << "Error in dsv data. Line " <<
-                    AsyncRowProcessor.GetLinesProcessed() + lineIdx + 1 << ": " << e.what();
             }
+        } catch (yexception& e) {
+            throw TCatBoostException() << "Error in dsv data. Line " <<
+                blockFirstLineIdx + inBlockIdx + 1 << ": " << e.what();
+        }
+    }
+
+    void TCBDsvDataLoader::ProcessBlock(IRawObjectsOrderDataVisitor* visitor) {
+        visitor->StartNextBlock(AsyncRowProcessor.GetParseBufferSize());
+
+        auto parseBlock = [&](TString& line, int lineIdx) {
+            ProcessLine(line, lineIdx, AsyncRowProcessor.GetLinesProcessed(), visitor);
         };
 
         AsyncRowProcessor.ProcessBlock(parseBlock);
@@ -330,6 +411,9 @@ namespace NCB {
     namespace {
         TDatasetLoaderFactory::TRegistrator<TCBDsvDataLoader> DefDataLoaderReg("");
         TDatasetLoaderFactory::TRegistrator<TCBDsvDataLoader> CBDsvDataLoaderReg("dsv");
+        TDatasetLoaderFactory::TRegistrator<TCBDsvDataLoader> CBDsvGzipDataLoaderReg("dsv+gzip");
+        TDatasetLoaderFactory::TRegistrator<TCBDsvDataLoader> CBDsvZstdDataLoaderReg("dsv+zstd");
+        TDatasetLoaderFactory::TRegistrator<TCBDsvDataLoader> CBDsvLz4DataLoaderReg("dsv+lz4");
     }
 }
 
@@ -48,10 +48,17 @@ namespace NCB {
         }
 
         void Do(IRawObjectsOrderDataVisitor* visitor) override {
-            TBase::Do(GetReadFunc(), GetReadBaselineFunc(), visitor);
+            if (FileLineDataReader) {
+                DoInLineRanges(visitor);
+            } else {
+                TBase::Do(GetReadFunc(), GetReadBaselineFunc(), visitor);
+            }
         }
 
         bool DoBlock(IRawObjectsOrderDataVisitor* visitor) override {
+            if (!AsyncReadingStarted) {
+                StartAsyncReading();
+            }
             return TBase::DoBlock(GetReadFunc(), GetReadBaselineFunc(), visitor);
         }
 
@@ -68,6 +75,22 @@ namespace NCB {
 
         void ProcessBlock(IRawObjectsOrderDataVisitor* visitor) override;
 
+    protected:
+        void StartAsyncReading();
+
+        /* Plain files are split into line aligned byte ranges that are parsed concurrently,
+           object count is obtained from the same pass that splits the file.
+        */
+        void DoInLineRanges(IRawObjectsOrderDataVisitor* visitor);
+
+        // blockFirstLineIdx is used only for error messages
+        void ProcessLine(
+            TString& line,
+            ui32 inBlockIdx,
+            ui64 blockFirstLineIdx,
+            IRawObjectsOrderDataVisitor* visitor
+        );
+
     protected:
         TVector<bool> FeatureIgnored; // init in process
         char FieldDelimiter;
@@ -76,9 +99,14 @@ namespace NCB {
         THolder<NCB::ILineDataReader> LineDataReader;
         TBaselineReader BaselineReader;
 
+        // set if the data is a plain file that can be read in line ranges
+        const NCB::TFileLineDataReader* FileLineDataReader = nullptr;
+        bool AsyncReadingStarted = false;
+
         // cached
         TMutex ObjectCountMutex;
         TMaybe<ui32> ObjectCount;
+        TVector<TFileLineRange> LineRanges;
     };
 
 }
@@ -3,6 +3,7 @@
 #include "features_layout.h"
 
 #include <catboost/libs/column_description/cd_parser.h>
+#include <catboost/private/libs/data_util/compressed_line_data_reader.h>
 #include <catboost/private/libs/data_util/exists_checker.h>
 #include <catboost/private/libs/data_util/line_data_reader.h>
 #include <catboost/private/libs/labels/helpers.h>
@@ -64,7 +65,7 @@ namespace NCB {
     TLibSvmDataLoader::TLibSvmDataLoader(TDatasetLoaderPullArgs&& args)
         : TLibSvmDataLoader(
             TLineDataLoaderPushArgs {
-                GetLineDataReader(args.PoolPath, args.CommonArgs.PoolFormat),
+                GetLineDataReader(args.PoolPath, args.CommonArgs.PoolFormat, args.CommonArgs.LocalExecutor),
                 std::move(args.CommonArgs)
             }
         )
@@ -408,6 +409,18 @@ namespace NCB {
         TExistsCheckerFactory::TRegistrator<TFSExistsChecker> LibSvmExistsCheckerReg("libsvm");
         TLineDataReaderFactory::TRegistrator<TFileLineDataReader> LibSvmLineDataReaderReg("libsvm");
         TDatasetLoaderFactory::TRegistrator<TLibSvmDataLoader> LibSvmDataLoaderReg("libsvm");
+
+        TExistsCheckerFactory::TRegistrator<TFSExistsChecker> LibSvmGzipExistsCheckerReg("libsvm+gzip");
+        TLineDataReaderFactory::TRegistrator<TCompressedFileLineDataReader> LibSvmGzipLineDataReaderReg("libsvm+gzip");
+        TDatasetLoaderFactory::TRegistrator<TLibSvmDataLoader> LibSvmGzipDataLoaderReg("libsvm+gzip");
+
+        TExistsCheckerFactory::TRegistrator<TFSExistsChecker> LibSvmZstdExistsCheckerReg("libsvm+zstd");
+        TLineDataReaderFactory::TRegistrator<TCompressedFileLineDataReader> LibSvmZstdLineDataReaderReg("libsvm+zstd");
+        TDatasetLoaderFactory::TRegistrator<TLibSvmDataLoader> LibSvmZstdDataLoaderReg("libsvm+zstd");
+
+        TExistsCheckerFactory::TRegistrator<TFSExistsChecker> LibSvmLz4ExistsCheckerReg("libsvm+lz4");
+        TLineDataReaderFactory::TRegistrator<TCompressedFileLineDataReader> LibSvmLz4LineDataReaderReg("libsvm+lz4");
+        TDatasetLoaderFactory::TRegistrator<TLibSvmDataLoader> LibSvmLz4DataLoaderReg("libsvm+lz4");
     }
 }
 
@@ -3,28 +3,30 @@
 #include "baseline.h"
 #include "cat_feature_perfect_hash.h"
 #include "data_provider_builders.h"
-#include "proceed_pool_in_blocks.h"
 #include "quantization.h"
 #include "util.h"
 #include "visitor.h"
 
 #include <catboost/libs/column_description/cd_parser.h>
 #include <catboost/libs/helpers/array_subset.h>
+#include <catboost/libs/helpers/compression.h>
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/helpers/maybe.h>
+#include <catboost/libs/helpers/mem_usage.h>
 #include <catboost/libs/logging/logging.h>
 #include <catboost/private/libs/data_types/pair.h>
 #include <catboost/private/libs/data_util/path_with_scheme.h>
-#include <catboost/private/libs/options/dataset_reading_params.h>
 #include <catboost/private/libs/options/load_options.h>
 #include <catboost/private/libs/options/plain_options_helper.h>
 #include <catboost/private/libs/quantization/utils.h>
 
 #include <library/cpp/threading/local_executor/local_executor.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/vector.h>
 #include <util/generic/xrange.h>
 #include <util/generic/ylimits.h>
+#include <util/stream/format.h>
 
 using namespace NCB;
 
@@ -130,6 +132,12 @@ namespace {
             }
             SampleCount = SampleSubset.Size();
 
+            CATBOOST_INFO_LOG << "Building borders on a sample of " << SampleCount << " objects, sample size: "
+                << HumanReadableSize(
+                    (ui64)SampleCount * metaInfo.FeaturesLayout->GetFloatFeatureCount() * sizeof(float),
+                    SF_BYTES)
+                << Endl;
+
             Cursor = NotSet;
             NextCursor = 0;
 
@@ -459,37 +467,58 @@ namespace {
         TUnsampledData UnsampledData;
     };
 
-    template <class T, class ValuesHolder>
-    TMaybeOwningConstArrayHolder<ui8> ExtractValuesForQuantizedVisitor(
-        const ValuesHolder& srcValues,
-        NPar::ILocalExecutor* localExecutor) {
-
-        TMaybeOwningConstArrayHolder<T> values =
-            TMaybeOwningConstArrayHolder<T>::CreateOwning(srcValues.template ExtractValues<T>(localExecutor));
-        return TMaybeOwningConstArrayHolder<ui8>::CreateOwningReinterpretCast(values);
+    // size of preallocated quantized storage for all objects
+    ui64 EstimateQuantizedDataSize(
+        const TQuantizedFeaturesInfo& quantizedFeaturesInfo,
+        const TDataMetaInfo& metaInfo,
+        ui32 objectCount) {
+
+        ui64 result = 0;
+        const auto& featuresLayout = *quantizedFeaturesInfo.GetFeaturesLayout();
+        featuresLayout.IterateOverAvailableFeatures<EFeatureType::Float>(
+            [&] (TFloatFeatureIdx floatFeatureIdx) {
+                TIndexHelper<ui64> indexHelper(
+                    CalcHistogramWidthForBorders(quantizedFeaturesInfo.GetBorders(floatFeatureIdx).size()));
+                result += indexHelper.CompressedSize(objectCount) * sizeof(ui64);
+            });
+
+        ui64 perObjectSize = sizeof(float) * (
+            metaInfo.BaselineCount + (ui64)metaInfo.HasWeights + (ui64)metaInfo.HasGroupWeight);
+        perObjectSize += metaInfo.TargetCount
+            * ((metaInfo.TargetType == ERawTargetType::String) ? sizeof(TString) : sizeof(float));
+        if (metaInfo.HasGroupId) {
+            perObjectSize += sizeof(TGroupId);
+        }
+        if (metaInfo.HasSubgroupIds) {
+            perObjectSize += sizeof(TSubgroupId);
+        }
+        if (metaInfo.HasTimestamp) {
+            perObjectSize += sizeof(ui64);
+        }
+        return result + perObjectSize * objectCount;
     }
 
-    class TQuantizationSecondPassBlockConsumer {
+    /* Second pass: objects are parsed block by block and float feature values are binarized right away
+     * into small per-block buffers that are appended to the quantized storage, so raw float columns
+     * are never materialized and memory usage is the quantized data size plus the buffers for one block.
+     */
+    class TRawObjectsOrderQuantizationSecondPassVisitor final : public IRawObjectsOrderDataVisitor {
     public:
-        TQuantizationSecondPassBlockConsumer(
+        TRawObjectsOrderQuantizationSecondPassVisitor(
             TQuantizationFirstPassResult firstPassResult,
             TDatasetSubset loadSubset,
             EObjectsOrder objectsOrder,
-            TRestorableFastRng64* rand,
             NPar::ILocalExecutor* localExecutor)
-            : LocalExecutor(localExecutor)
-            , FirstPassResult(std::move(firstPassResult))
+            : FirstPassResult(std::move(firstPassResult))
             , QuantizedDataBuilder(
                   CreateDataProviderBuilder(
                       EDatasetVisitorType::QuantizedFeatures,
                       NCB::TDataProviderBuilderOptions{},
                       loadSubset,
-                      LocalExecutor))
+                      localExecutor))
             , QuantizedDataVisitor(
                   dynamic_cast<NCB::IQuantizedFeaturesDataVisitor*>(QuantizedDataBuilder.Get()))
             , ObjectsOrder(objectsOrder)
-            , ObjectOffset(0)
-            , Rand(rand)
         {
             CB_ENSURE_INTERNAL(
                 QuantizedDataBuilder,
@@ -510,231 +539,446 @@ namespace {
                 }
             }
 
+            FloatFeatures.resize(featuresLayout->GetFloatFeatureCount());
+            featuresLayout->IterateOverAvailableFeatures<EFeatureType::Float>(
+                [&] (TFloatFeatureIdx floatFeatureIdx) {
+                    CB_ENSURE_INTERNAL(
+                        quantizedFeaturesInfo.HasBorders(floatFeatureIdx),
+                        "There is no borders for available float feature " << *floatFeatureIdx);
+
+                    auto& feature = FloatFeatures[*floatFeatureIdx];
+                    feature.IsAvailable = true;
+                    feature.FlatFeatureIdx
+                        = featuresLayout->GetExternalFeatureIdx(*floatFeatureIdx, EFeatureType::Float);
+                    feature.NanMode = quantizedFeaturesInfo.GetNanMode(floatFeatureIdx);
+                    feature.AllowNans = (feature.NanMode != ENanMode::Forbidden) ||
+                        quantizedFeaturesInfo.GetFloatFeaturesAllowNansInTestOnly();
+                    feature.Borders = quantizedFeaturesInfo.GetBorders(floatFeatureIdx);
+                    feature.BitsPerKey = CalcHistogramWidthForBorders(feature.Borders.size());
+                    feature.ZeroBin = feature.Quantize<ui32>(0.0f);
+                });
+        }
+
+        TVector<ui32> GetIgnoredFeatures() const {
+            return IgnoredFeatures;
+        }
+
+        void Start(
+            bool inBlock,
+            const TDataMetaInfo& metaInfo,
+            bool haveUnknownNumberOfSparseFeatures,
+            ui32 objectCount,
+            EObjectsOrder /*objectsOrder*/,
+
+            // keep necessary resources for data to be available (memory mapping for a file for example)
+            TVector<TIntrusivePtr<IResourceHolder>> resourceHolders) override {
+
+            CB_ENSURE(!inBlock, "block read is not supported in the second pass of quantization");
+            CB_ENSURE_INTERNAL(!haveUnknownNumberOfSparseFeatures, "features layout must be fixed after the first pass");
+            CB_ENSURE(
+                objectCount == FirstPassResult.ObjectCount,
+                "Pool has been changed during loading: object count " << objectCount
+                << " differs from the one on the first pass " << FirstPassResult.ObjectCount);
+
+            /* metaInfo of this pass is used only for data that is present in the main data source,
+             * data from external sources has been already loaded in the first pass
+             */
+            const auto& columnsInfo = metaInfo.ColumnsInfo;
+            TargetCount = metaInfo.TargetCount;
+            HasStringTarget = (FirstPassResult.MetaInfo.TargetType == ERawTargetType::String);
+            HasWeights = metaInfo.HasWeights;
+            HasGroupWeightsColumn = columnsInfo && columnsInfo->CountColumns(EColumn::GroupWeight);
+            BaselineCount = metaInfo.BaselineCount;
+            HasGroupId = metaInfo.HasGroupId;
+            HasSubgroupIds = metaInfo.HasSubgroupIds;
+            HasTimestampColumn = columnsInfo && columnsInfo->CountColumns(EColumn::Timestamp);
+
+            ResourceHolders = std::move(resourceHolders);
+
+            const ui64 quantizedDataSize = EstimateQuantizedDataSize(
+                *FirstPassResult.QuantizedFeaturesInfo,
+                FirstPassResult.MetaInfo,
+                objectCount);
+            CATBOOST_INFO_LOG << "Quantizing " << objectCount << " objects while loading, quantized data size: "
+                << HumanReadableSize(quantizedDataSize, SF_BYTES) << Endl;
+            OutputWarningIfCpuRamUsageOverLimit(quantizedDataSize, FirstPassResult.QuantizationOptions.CpuRamLimit);
+
             QuantizedDataVisitor->Start(
                 FirstPassResult.MetaInfo,
                 FirstPassResult.ObjectCount,
                 ObjectsOrder,
                 /*resourceHolders*/ {},
-                GetPoolQuantizationSchema(quantizedFeaturesInfo, /*classLabels*/ {}),
+                GetPoolQuantizationSchema(*FirstPassResult.QuantizedFeaturesInfo, /*classLabels*/ {}),
                 /*wholeColumns*/ false);
         }
 
-        TVector<ui32> GetIgnoredFeatures() {
-            return IgnoredFeatures;
+        void StartNextBlock(ui32 blockSize) override {
+            FlushBlock();
+
+            BlockSize = blockSize;
+
+            for (auto& feature : FloatFeatures) {
+                if (feature.IsAvailable) {
+                    feature.BlockBins.yresize(blockSize * (feature.BitsPerKey / CHAR_BIT));
+                    feature.FillBlock(feature.ZeroBin);
+                }
+            }
+            ResizeBlockColumns(TargetCount, blockSize, HasStringTarget ? &StringTargets : nullptr);
+            ResizeBlockColumns(TargetCount, blockSize, HasStringTarget ? nullptr : &FloatTargets);
+            ResizeBlockColumns(BaselineCount, blockSize, &Baselines);
+            ResizeBlockColumn(HasWeights, blockSize, &Weights);
+            ResizeBlockColumn(HasGroupWeightsColumn, blockSize, &GroupWeights);
+            ResizeBlockColumn(HasGroupId, blockSize, &GroupIds);
+            ResizeBlockColumn(HasSubgroupIds, blockSize, &SubgroupIds);
+            ResizeBlockColumn(HasTimestampColumn, blockSize, &Timestamps);
+
+            ui64 blockBuffersSize = 0;
+            for (const auto& feature : FloatFeatures) {
+                blockBuffersSize += feature.BlockBins.capacity();
+            }
+            blockBuffersSize += (ui64)blockSize * (
+                TargetCount * (HasStringTarget ? sizeof(TString) : sizeof(float))
+                + sizeof(float) * (BaselineCount + (ui64)HasWeights + (ui64)HasGroupWeightsColumn)
+                + (HasGroupId ? sizeof(TGroupId) : 0)
+                + (HasSubgroupIds ? sizeof(TSubgroupId) : 0)
+                + (HasTimestampColumn ? sizeof(ui64) : 0));
+            MaxBlockBuffersSize = Max(MaxBlockBuffersSize, blockBuffersSize);
         }
 
-        void ProcessBlock(TDataProviderPtr dataBlock) {
-            TRawDataProviderPtr rawDataBlock = dataBlock->CastMoveTo<TRawObjectsDataProvider>();
-            dataBlock.Drop();
-            CB_ENSURE_INTERNAL(rawDataBlock, "failed cast of TDataProvider to TRawDataProvider");
+        // TCommonObjectsData
+        void AddGroupId(ui32 localObjectIdx, TGroupId value) override {
+            GroupIds[localObjectIdx] = value;
+        }
 
-            TQuantizedObjectsDataProviderPtr quantizedObjectsData = Quantize(
-                FirstPassResult.QuantizationOptions,
-                std::move(rawDataBlock->ObjectsData),
-                FirstPassResult.QuantizedFeaturesInfo,
-                Rand,
-                LocalExecutor);
+        void AddSubgroupId(ui32 localObjectIdx, TSubgroupId value) override {
+            SubgroupIds[localObjectIdx] = value;
+        }
 
-            auto groupIds = quantizedObjectsData->GetGroupIds();
-            if (groupIds) {
-                QuantizedDataVisitor->AddGroupIdPart(ObjectOffset, TUnalignedArrayBuf<TGroupId>(*groupIds));
-            }
+        void AddTimestamp(ui32 localObjectIdx, ui64 value) override {
+            Timestamps[localObjectIdx] = value;
+        }
 
-            auto subgroupIds = quantizedObjectsData->GetSubgroupIds();
-            if (subgroupIds) {
-                QuantizedDataVisitor->AddSubgroupIdPart(
-                    ObjectOffset,
-                    TUnalignedArrayBuf<TSubgroupId>(*subgroupIds));
-            }
+        // TRawObjectsData
+        void AddFloatFeature(ui32 localObjectIdx, ui32 flatFeatureIdx, float feature) override {
+            const auto floatFeatureIdx = FirstPassResult.QuantizedFeaturesInfo->GetFeaturesLayout()
+                ->GetInternalFeatureIdx<EFeatureType::Float>(flatFeatureIdx);
+            FloatFeatures[*floatFeatureIdx].Set(localObjectIdx, feature);
+        }
 
-            auto timestamps = quantizedObjectsData->GetTimestamp();
-            if (timestamps) {
-                QuantizedDataVisitor->AddTimestampPart(ObjectOffset, TUnalignedArrayBuf<ui64>(*timestamps));
+        void AddAllFloatFeatures(ui32 localObjectIdx, TConstArrayRef<float> features) override {
+            for (auto floatFeatureIdx : xrange(features.size())) {
+                FloatFeatures[floatFeatureIdx].Set(localObjectIdx, features[floatFeatureIdx]);
             }
+        }
 
-            const auto quantizedFeaturesInfo = quantizedObjectsData->GetQuantizedFeaturesInfo();
-            const auto featuresLayout = quantizedFeaturesInfo->GetFeaturesLayout();
-            for (auto flatFeatureIdx : xrange(featuresLayout->GetExternalFeatureCount())) {
-                const auto featureMetaInfo = featuresLayout->GetExternalFeatureMetaInfo(flatFeatureIdx);
+        void AddAllFloatFeatures(
+            ui32 localObjectIdx,
+            TConstPolymorphicValuesSparseArray<float, ui32> features) override {
 
-                if (!featureMetaInfo.IsAvailable) {
-                    continue;
+            const float defaultValue = features.GetDefaultValue();
+            if (defaultValue != 0.0f) {
+                // blocks are prefilled with bins of zeros
+                for (auto& feature : FloatFeatures) {
+                    feature.Set(localObjectIdx, defaultValue);
                 }
+            }
+            features.ForEachNonDefault(
+                [&] (ui32 floatFeatureIdx, float value) {
+                    CB_ENSURE(
+                        floatFeatureIdx < FloatFeatures.size(),
+                        "Pool has been changed during loading: float feature index " << floatFeatureIdx
+                        << " is out of features layout");
+                    FloatFeatures[floatFeatureIdx].Set(localObjectIdx, value);
+                });
+        }
 
-                if (featureMetaInfo.Type == EFeatureType::Float) {
-                    const auto floatFeatureIdx =
-                        featuresLayout->GetInternalFeatureIdx<EFeatureType::Float>(flatFeatureIdx);
+        ui32 GetCatFeatureValue(ui32 /*flatFeatureIdx*/, TStringBuf /*feature*/) override {
+            CB_ENSURE_INTERNAL(false, "Categorical features are not supported in block quantization");
+            return 0;
+        }
 
-                    TMaybeData<const IQuantizedFloatValuesHolder*> feature =
-                        quantizedObjectsData->GetFloatFeature(*floatFeatureIdx);
+        void AddCatFeature(ui32 /*localObjectIdx*/, ui32 /*flatFeatureIdx*/, TStringBuf /*feature*/) override {
+            CB_ENSURE_INTERNAL(false, "Categorical features are not supported in block quantization");
+        }
 
-                    CB_ENSURE_INTERNAL(
-                        feature,
-                        "GetFloatFeature returned nothing for available feature " << flatFeatureIdx);
-                    CB_ENSURE_INTERNAL(
-                        feature.GetRef(),
-                        "GetFloatFeature returned nullptr for available feature " << flatFeatureIdx);
-                    CB_ENSURE_INTERNAL(
-                        quantizedFeaturesInfo->HasBorders(floatFeatureIdx),
-                        "There is no borders for available feature " << flatFeatureIdx);
-
-                    TMaybeOwningConstArrayHolder<ui8> values;
-                    const ui8 bitsPerKey = CalcHistogramWidthForBorders(
-                        quantizedFeaturesInfo->GetBorders(floatFeatureIdx).size());
-                    switch (bitsPerKey) {
-                        case 8:
-                            values = ExtractValuesForQuantizedVisitor<ui8>(**feature, LocalExecutor);
-                            break;
-                        case 16:
-                            values = ExtractValuesForQuantizedVisitor<ui16>(**feature, LocalExecutor);
-                            break;
-                        default:
-                            CB_ENSURE_INTERNAL(false, "unexpected bitsPerKey: " << bitsPerKey);
-                    }
-                    QuantizedDataVisitor->AddFloatFeaturePart(
-                        flatFeatureIdx,
-                        ObjectOffset,
-                        bitsPerKey,
-                        values);
-                } else if (featureMetaInfo.Type == EFeatureType::Categorical) {
-                    const auto catFeatureIdx =
-                        featuresLayout->GetInternalFeatureIdx<EFeatureType::Categorical>(flatFeatureIdx);
+        void AddAllCatFeatures(ui32 /*localObjectIdx*/, TConstArrayRef<ui32> /*features*/) override {
+            CB_ENSURE_INTERNAL(false, "Categorical features are not supported in block quantization");
+        }
 
-                    TMaybeData<const IQuantizedCatValuesHolder*> feature =
-                        quantizedObjectsData->GetCatFeature(*catFeatureIdx);
+        void AddAllCatFeatures(
+            ui32 /*localObjectIdx*/,
+            TConstPolymorphicValuesSparseArray<ui32, ui32> /*features*/) override {
 
-                    CB_ENSURE_INTERNAL(
-                        feature,
-                        "GetCatFeature returned nothing for available feature" << flatFeatureIdx);
-                    CB_ENSURE_INTERNAL(
-                        feature.GetRef(),
-                        "GetCatFeature returned nullptr for available feature " << flatFeatureIdx);
-
-                    TMaybeOwningConstArrayHolder<ui8> values;
-                    const ui8 bitsPerKey = CalcHistogramWidthForUniqueValuesCount(
-                        quantizedFeaturesInfo->GetUniqueValuesCounts(catFeatureIdx).OnAll);
-                    switch (bitsPerKey) {
-                        case 8:
-                            values = ExtractValuesForQuantizedVisitor<ui8>(**feature, LocalExecutor);
-                            break;
-                        case 16:
-                            values = ExtractValuesForQuantizedVisitor<ui16>(**feature, LocalExecutor);
-                            break;
-                        case 32:
-                            values = ExtractValuesForQuantizedVisitor<ui32>(**feature, LocalExecutor);
-                            break;
-                        default:
-                            CB_ENSURE_INTERNAL(false, "unexpected bitsPerKey: " << bitsPerKey);
-                    }
-                    QuantizedDataVisitor->AddCatFeaturePart(
-                        flatFeatureIdx,
-                        ObjectOffset,
-                        sizeof(IQuantizedCatValuesHolder::TValueType) * 8,
-                        TMaybeOwningConstArrayHolder<ui8>::CreateOwningReinterpretCast(values));
-                } else {
-                    CB_ENSURE_INTERNAL(
-                        false,
-                        "building quantization results is supported only for numerical and categorical features");
-                }
+            CB_ENSURE_INTERNAL(false, "Categorical features are not supported in block quantization");
+        }
+
+        void AddCatFeatureDefaultValue(ui32 /*flatFeatureIdx*/, TStringBuf /*feature*/) override {
+            CB_ENSURE_INTERNAL(false, "Categorical features are not supported in block quantization");
+        }
+
+        void AddTextFeature(ui32 /*localObjectIdx*/, ui32 /*flatFeatureIdx*/, TStringBuf /*feature*/) override {
+            CB_ENSURE_INTERNAL(false, "Text features are not supported in block quantization");
+        }
+
+        void AddTextFeature(ui32 /*localObjectIdx*/, ui32 /*flatFeatureIdx*/, const TString& /*feature*/) override {
+            CB_ENSURE_INTERNAL(false, "Text features are not supported in block quantization");
+        }
+
+        void AddAllTextFeatures(ui32 /*localObjectIdx*/, TConstArrayRef<TString> /*features*/) override {
+            CB_ENSURE_INTERNAL(false, "Text features are not supported in block quantization");
+        }
+
+        void AddAllTextFeatures(
+            ui32 /*localObjectIdx*/,
+            TConstPolymorphicValuesSparseArray<TString, ui32> /*features*/) override {
+
+            CB_ENSURE_INTERNAL(false, "Text features are not supported in block quantization");
+        }
+
+        void AddEmbeddingFeature(
+            ui32 /*localObjectIdx*/,
+            ui32 /*flatFeatureIdx*/,
+            TMaybeOwningConstArrayHolder<float> /*feature*/) override {
+
+            CB_ENSURE_INTERNAL(false, "Embedding features are not supported in block quantization");
+        }
+
+        // TRawTargetData
+        void AddTarget(ui32 localObjectIdx, const TString& value) override {
+            AddTarget(0, localObjectIdx, value);
+        }
+
+        void AddTarget(ui32 localObjectIdx, float value) override {
+            AddTarget(0, localObjectIdx, value);
+        }
+
+        void AddTarget(ui32 flatTargetIdx, ui32 localObjectIdx, const TString& value) override {
+            Y_ASSERT(HasStringTarget);
+            StringTargets[flatTargetIdx][localObjectIdx] = value;
+        }
+
+        void AddTarget(ui32 flatTargetIdx, ui32 localObjectIdx, float value) override {
+            Y_ASSERT(!HasStringTarget);
+            FloatTargets[flatTargetIdx][localObjectIdx] = value;
+        }
+
+        void AddBaseline(ui32 localObjectIdx, ui32 baselineIdx, float value) override {
+            Baselines[baselineIdx][localObjectIdx] = value;
+        }
+
+        void AddWeight(ui32 localObjectIdx, float value) override {
+            Weights[localObjectIdx] = value;
+        }
+
+        void AddGroupWeight(ui32 localObjectIdx, float value) override {
+            GroupWeights[localObjectIdx] = value;
+        }
+
+        // data from external sources has been loaded in the first pass
+        void SetGroupWeights(TVector<float>&& /*groupWeights*/) override {
+        }
+
+        void SetBaseline(TVector<TVector<float>>&& /*multidimBaseline*/) override {
+        }
+
+        void SetPairs(TRawPairsData&& /*pairs*/) override {
+        }
+
+        void SetTimestamps(TVector<ui64>&& /*timestamps*/) override {
+        }
+
+        TMaybeData<TConstArrayRef<TGroupId>> GetGroupIds() const override {
+            return Nothing();
+        }
+
+        void Finish() override {
+            FlushBlock();
+
+            CB_ENSURE(
+                ObjectOffset == FirstPassResult.ObjectCount,
+                "Pool has been changed during loading: " << ObjectOffset << " objects read on the second pass"
+                " instead of " << FirstPassResult.ObjectCount);
+
+            auto& unsampledData = FirstPassResult.UnsampledData;
+            if (unsampledData.GroupWeights) {
+                QuantizedDataVisitor->SetGroupWeights(std::move(*unsampledData.GroupWeights));
+            }
+            if (unsampledData.MultidimBaseline) {
+                QuantizedDataVisitor->SetBaseline(std::move(*unsampledData.MultidimBaseline));
+            }
+            if (unsampledData.Pairs) {
+                QuantizedDataVisitor->SetPairs(std::move(*unsampledData.Pairs));
+            }
+            if (unsampledData.Timestamps) {
+                QuantizedDataVisitor->SetTimestamps(std::move(*unsampledData.Timestamps));
+            }
+            QuantizedDataVisitor->Finish();
+
+            CATBOOST_INFO_LOG << "Quantization while loading: max block buffers size: "
+                << HumanReadableSize(MaxBlockBuffersSize, SF_BYTES) << Endl;
+            DumpMemUsage("After second pass of quantization");
+        }
+
+        TDataProviderPtr GetResult() {
+            CB_ENSURE_INTERNAL(
+                !ResultsTaken,
+                "TRawObjectsOrderQuantizationSecondPassVisitor::GetResult called twice");
+            ResultsTaken = true;
+
+            return QuantizedDataBuilder->GetResult();
+        }
+
+    private:
+        struct TFloatFeatureQuantizer {
+            bool IsAvailable = false;
+            ui32 FlatFeatureIdx = 0;
+            ENanMode NanMode = ENanMode::Forbidden;
+            bool AllowNans = false;
+            TConstArrayRef<float> Borders; // owned by QuantizedFeaturesInfo
+            ui8 BitsPerKey = 8;
+            ui32 ZeroBin = 0;
+
+            // [localObjectIdx], BitsPerKey bits per object
+            TVector<ui8> BlockBins;
+
+        public:
+            template <class TBin>
+            TBin Quantize(float value) const {
+                return NCB::Quantize<TBin>(FlatFeatureIdx, AllowNans, NanMode, Borders, value);
             }
 
-            const auto targetDimension = rawDataBlock->RawTargetData.GetTargetDimension();
-            switch (rawDataBlock->RawTargetData.GetTargetType()) {
-                case ERawTargetType::Integer:
-                case ERawTargetType::Float: {
-                    TVector<TVector<float>> targetNumeric(targetDimension);
-                    TVector<TArrayRef<float>> targetNumericRefs(targetDimension);
-                    for (auto targetIdx : xrange(targetDimension)) {
-                        targetNumeric[targetIdx].yresize(rawDataBlock->RawTargetData.GetObjectCount());
-                        targetNumericRefs[targetIdx] = targetNumeric[targetIdx];
-                    }
-                    rawDataBlock->RawTargetData.GetNumericTarget(targetNumericRefs);
-                    for (auto targetIdx : xrange(targetDimension)) {
-                        QuantizedDataVisitor->AddTargetPart(
-                            targetIdx,
-                            ObjectOffset,
-                            TUnalignedArrayBuf<float>(targetNumericRefs[targetIdx]));
-                    }
-                    break;
+            void Set(ui32 localObjectIdx, float value) {
+                if (!IsAvailable) {
+                    return;
                 }
-                case ERawTargetType::String: {
-                    TVector<TConstArrayRef<TString>> targetStrings;
-                    rawDataBlock->RawTargetData.GetStringTargetRef(&targetStrings);
-                    for (auto targetIdx : xrange(targetDimension)) {
-                        QuantizedDataVisitor->AddTargetPart(
-                            targetIdx,
-                            ObjectOffset,
-                            TMaybeOwningConstArrayHolder<TString>::CreateNonOwning(targetStrings[targetIdx]));
-                    }
-                    break;
+                if (BitsPerKey == 8) {
+                    BlockBins[localObjectIdx] = Quantize<ui8>(value);
+                } else {
+                    reinterpret_cast<ui16*>(BlockBins.data())[localObjectIdx] = Quantize<ui16>(value);
                 }
-                case ERawTargetType::None:
-                    break;
             }
 
-            const auto& maybeBaseline = rawDataBlock->RawTargetData.GetBaseline();
-            if (maybeBaseline) {
-                const auto& baseline = *maybeBaseline;
-                for (size_t baselineIdx : xrange(baseline.size())) {
-                    QuantizedDataVisitor->AddBaselinePart(
-                        ObjectOffset,
-                        baselineIdx,
-                        TUnalignedArrayBuf<float>(baseline[baselineIdx]));
+            void FillBlock(ui32 bin) {
+                if (BitsPerKey == 8) {
+                    Fill(BlockBins.begin(), BlockBins.end(), (ui8)bin);
+                } else {
+                    auto* begin = reinterpret_cast<ui16*>(BlockBins.data());
+                    Fill(begin, begin + BlockBins.size() / sizeof(ui16), (ui16)bin);
                 }
             }
+        };
 
-            const auto& weights = rawDataBlock->RawTargetData.GetWeights();
-            if (!weights.IsTrivial()) {
-                QuantizedDataVisitor->AddWeightPart(
-                    ObjectOffset,
-                    TUnalignedArrayBuf<float>(weights.GetNonTrivialData()));
+    private:
+        template <class T>
+        static void ResizeBlockColumn(bool hasColumn, ui32 blockSize, TVector<T>* column) {
+            if (hasColumn) {
+                column->yresize(blockSize);
             }
+        }
 
-            const auto& groupWeights = rawDataBlock->RawTargetData.GetGroupWeights();
-            if (!groupWeights.IsTrivial()) {
-                QuantizedDataVisitor->AddGroupWeightPart(
-                    ObjectOffset,
-                    TUnalignedArrayBuf<float>(groupWeights.GetNonTrivialData()));
+        template <class T>
+        static void ResizeBlockColumns(size_t columnCount, ui32 blockSize, TVector<TVector<T>>* columns) {
+            if (columns) {
+                columns->resize(columnCount);
+                for (auto& column : *columns) {
+                    column.yresize(blockSize);
+                }
             }
-
-            ObjectOffset += rawDataBlock->GetObjectCount();
         }
 
-        TDataProviderPtr GetResult() {
-            CB_ENSURE_INTERNAL(!ResultsTaken, "TQuantizationSecondPassBlockConsumer::GetResult called twice");
-            ResultsTaken = true;
+        void FlushBlock() {
+            if (!BlockSize) {
+                return;
+            }
 
-            if (FirstPassResult.UnsampledData.GroupWeights) {
-                QuantizedDataVisitor->SetGroupWeights(std::move(*FirstPassResult.UnsampledData.GroupWeights));
+            for (const auto& feature : FloatFeatures) {
+                if (feature.IsAvailable) {
+                    QuantizedDataVisitor->AddFloatFeaturePart(
+                        feature.FlatFeatureIdx,
+                        ObjectOffset,
+                        feature.BitsPerKey,
+                        TMaybeOwningConstArrayHolder<ui8>::CreateNonOwning(feature.BlockBins));
+                }
+            }
+            if (HasStringTarget) {
+                for (auto targetIdx : xrange(TargetCount)) {
+                    QuantizedDataVisitor->AddTargetPart(
+                        targetIdx,
+                        ObjectOffset,
+                        TMaybeOwningConstArrayHolder<TString>::CreateNonOwning(StringTargets[targetIdx]));
+                }
+            } else {
+                for (auto targetIdx : xrange(TargetCount)) {
+                    QuantizedDataVisitor->AddTargetPart(
+                        targetIdx,
+                        ObjectOffset,
+                        TUnalignedArrayBuf<float>(FloatTargets[targetIdx]));
+                }
             }
-            if (FirstPassResult.UnsampledData.MultidimBaseline) {
-                QuantizedDataVisitor->SetBaseline(std::move(*FirstPassResult.UnsampledData.MultidimBaseline));
+            for (auto baselineIdx : xrange(BaselineCount)) {
+                QuantizedDataVisitor->AddBaselinePart(
+                    ObjectOffset,
+                    baselineIdx,
+                    TUnalignedArrayBuf<float>(Baselines[baselineIdx]));
             }
-            if (FirstPassResult.UnsampledData.Pairs) {
-                QuantizedDataVisitor->SetPairs(std::move(*FirstPassResult.UnsampledData.Pairs));
+            if (HasWeights) {
+                QuantizedDataVisitor->AddWeightPart(ObjectOffset, TUnalignedArrayBuf<float>(Weights));
             }
-            if (FirstPassResult.UnsampledData.Timestamps) {
-                QuantizedDataVisitor->SetTimestamps(std::move(*FirstPassResult.UnsampledData.Timestamps));
+            if (HasGroupWeightsColumn) {
+                QuantizedDataVisitor->AddGroupWeightPart(ObjectOffset, TUnalignedArrayBuf<float>(GroupWeights));
             }
-            QuantizedDataVisitor->Finish();
-            return QuantizedDataBuilder->GetResult();
+            if (HasGroupId) {
+                QuantizedDataVisitor->AddGroupIdPart(ObjectOffset, TUnalignedArrayBuf<TGroupId>(GroupIds));
+            }
+            if (HasSubgroupIds) {
+                QuantizedDataVisitor->AddSubgroupIdPart(
+                    ObjectOffset,
+                    TUnalignedArrayBuf<TSubgroupId>(SubgroupIds));
+            }
+            if (HasTimestampColumn) {
+                QuantizedDataVisitor->AddTimestampPart(ObjectOffset, TUnalignedArrayBuf<ui64>(Timestamps));
+            }
+
+            ObjectOffset += BlockSize;
+            BlockSize = 0;
         }
 
     private:
         bool ResultsTaken = false;
 
-        NPar::ILocalExecutor* LocalExecutor;
-
         TQuantizationFirstPassResult FirstPassResult;
         THolder<IDataProviderBuilder> QuantizedDataBuilder;
         IQuantizedFeaturesDataVisitor* QuantizedDataVisitor;
 
         EObjectsOrder ObjectsOrder;
-        ui32 ObjectOffset;
+        TVector<TIntrusivePtr<IResourceHolder>> ResourceHolders;
 
         TVector<ui32> IgnoredFeatures;
 
-        TRestorableFastRng64* Rand;
+        // what is present in the main data source
+        ui32 TargetCount = 0;
+        bool HasStringTarget = false;
+        bool HasWeights = false;
+        bool HasGroupWeightsColumn = false;
+        ui32 BaselineCount = 0;
+        bool HasGroupId = false;
+        bool HasSubgroupIds = false;
+        bool HasTimestampColumn = false;
+
+        ui32 ObjectOffset = 0;
+        ui32 BlockSize = 0;
+        ui64 MaxBlockBuffersSize = 0;
+
+        // block buffers
+        TVector<TFloatFeatureQuantizer> FloatFeatures; // [floatFeatureIdx]
+        TVector<TVector<float>> FloatTargets;
+        TVector<TVector<TString>> StringTargets;
+        TVector<TVector<float>> Baselines;
+        TVector<float> Weights;
+        TVector<float> GroupWeights;
+        TVector<TGroupId> GroupIds;
+        TVector<TSubgroupId> SubgroupIds;
+        TVector<ui64> Timestamps;
     };
 
 } // anonymous namespace
@@ -794,9 +1038,9 @@ TDataProviderPtr NCB::ReadAndQuantizeDataset(
     CB_ENSURE(
         EDatasetVisitorType::QuantizedFeatures != datasetLoader->GetVisitorType(),
         "Data is already quantized");
-    CB_ENSURE_INTERNAL(
+    CB_ENSURE(
         datasetLoader->GetVisitorType() == EDatasetVisitorType::RawObjectsOrder,
-        "dataset should be loaded by RawObjectsOrder loader");
+        "Quantization while loading is supported only for datasets in objects order formats (dsv, libsvm)");
 
     NJson::TJsonValue jsonParams;
     NJson::TJsonValue outputJsonParams;
@@ -826,26 +1070,38 @@ TDataProviderPtr NCB::ReadAndQuantizeDataset(
         localExecutor);
     datasetLoader->DoIfCompatible(&firstPassVisitor);
 
-    TQuantizationSecondPassBlockConsumer secondPassQuantizer(
+    TRawObjectsOrderQuantizationSecondPassVisitor secondPassVisitor(
         firstPassVisitor.GetFirstPassResult(),
         loadSubset,
         objectsOrder,
-        &rand,
         localExecutor);
+    datasetLoader.Reset();
+    DumpMemUsage("After first pass of quantization");
 
-    NCatboostOptions::TDatasetReadingParams params;
-    params.ColumnarPoolFormatParams = columnarPoolFormatParams;
-    params.PoolPath = poolPath;
-    params.FeatureNamesPath = featureNamesPath;
-    params.ClassLabels = **classLabels;
-    params.IgnoredFeatures = secondPassQuantizer.GetIgnoredFeatures();
-    ReadAndProceedPoolInBlocks(
-        params,
-        *blockSize,
-        [&](TDataProviderPtr dataBlock) { secondPassQuantizer.ProcessBlock(std::move(dataBlock)); },
-        localExecutor);
+    /* data from external sources except baseline has been loaded in the first pass,
+     * baseline is read in sync with objects
+     */
+    auto secondPassDatasetLoader = GetProcessor<IDatasetLoader>(
+        poolPath,
+        TDatasetLoaderPullArgs{
+            poolPath,
+            TDatasetLoaderCommonArgs{
+                /*PairsFilePath*/ TPathWithScheme(),
+                /*GroupWeightsFilePath*/ TPathWithScheme(),
+                baselineFilePath,
+                /*TimestampsFilePath*/ TPathWithScheme(),
+                featureNamesPath,
+                **classLabels,
+                columnarPoolFormatParams.DsvFormat,
+                MakeCdProviderFromFile(columnarPoolFormatParams.CdFilePath),
+                secondPassVisitor.GetIgnoredFeatures(),
+                objectsOrder,
+                *blockSize,
+                loadSubset,
+                localExecutor}});
+    secondPassDatasetLoader->DoIfCompatible(&secondPassVisitor);
 
-    return secondPassQuantizer.GetResult();
+    return secondPassVisitor.GetResult();
 }
 
 TDataProviderPtr NCB::ReadAndQuantizeDataset(
@@ -0,0 +1,118 @@
+#include <catboost/libs/data/load_and_quantize_data.h>
+#include <catboost/libs/data/load_data.h>
+#include <catboost/libs/data/quantization.h>
+
+#include <catboost/libs/data/ut/lib/for_loader.h>
+
+#include <library/cpp/json/json_value.h>
+#include <library/cpp/threading/local_executor/local_executor.h>
+
+#include <util/generic/xrange.h>
+
+#include <library/cpp/testing/unittest/registar.h>
+
+
+using namespace NCB;
+using namespace NCB::NDataNewUT;
+
+
+Y_UNIT_TEST_SUITE(LoadAndQuantizeData) {
+    Y_UNIT_TEST(SameAsQuantizationAfterLoading) {
+        TSrcData srcData;
+        srcData.Scheme = "dsv";
+        srcData.CdFileData = TStringBuf(
+            "0\tLabel\n"
+            "1\tWeight\n"
+            "2\tGroupId\n"
+            "3\tNum\n"
+            "4\tNum\n"
+            "5\tNum\n");
+        srcData.DatasetFileData = TStringBuf(
+            "0.1\t1.0\tquery0\t0.5\t10\t1\n"
+            "0.9\t0.5\tquery0\t-1.2\t12\t0\n"
+            "0.3\t1.0\tquery1\tnan\t11\t1\n"
+            "0.0\t2.0\tquery1\t3.5\t10\t0\n"
+            "1.0\t1.0\tquery1\t0.0\t17\t1\n"
+            "0.5\t0.2\tquery2\t2.2\t13\t1\n"
+            "0.7\t1.0\tquery2\tnan\t15\t0\n"
+            "0.2\t1.0\tquery3\t-0.1\t10\t0\n");
+
+        TReadDatasetMainParams readDatasetMainParams;
+        TVector<THolder<TTempFile>> srcDataFiles;
+        SaveSrcData(srcData, &readDatasetMainParams, &srcDataFiles);
+
+        NJson::TJsonValue plainJsonParams;
+        plainJsonParams["border_count"] = 4;
+
+        TDataProviderPtr quantizedWhileLoading = ReadAndQuantizeDataset(
+            readDatasetMainParams.PoolPath,
+            /*pairsFilePath*/ TPathWithScheme(),
+            /*groupWeightsFilePath*/ TPathWithScheme(),
+            /*timestampsFilePath*/ TPathWithScheme(),
+            /*baselineFilePath*/ TPathWithScheme(),
+            /*featureNamesPath*/ TPathWithScheme(),
+            /*inputBordersPath*/ TPathWithScheme(),
+            readDatasetMainParams.ColumnarPoolFormatParams,
+            /*ignoredFeatures*/ {},
+            EObjectsOrder::Undefined,
+            plainJsonParams,
+            /*blockSize*/ 3,
+            /*quantizedFeaturesInfo*/ nullptr,
+            /*threadCount*/ 2,
+            /*verbose*/ false);
+
+        TDataProviderPtr rawData = ReadDataset(
+            /*taskType*/ Nothing(),
+            readDatasetMainParams.PoolPath,
+            /*pairsFilePath*/ TPathWithScheme(),
+            /*groupWeightsFilePath*/ TPathWithScheme(),
+            /*timestampsFilePath*/ TPathWithScheme(),
+            /*baselineFilePath*/ TPathWithScheme(),
+            /*featureNamesPath*/ TPathWithScheme(),
+            readDatasetMainParams.ColumnarPoolFormatParams,
+            /*ignoredFeatures*/ {},
+            EObjectsOrder::Undefined,
+            /*threadCount*/ 2,
+            /*verbose*/ false);
+        const TVector<float> expectedWeights(
+            rawData->RawTargetData.GetWeights().GetNonTrivialData().begin(),
+            rawData->RawTargetData.GetWeights().GetNonTrivialData().end());
+        const TVector<TGroupId> expectedGroupIds(
+            rawData->ObjectsData->GetGroupIds()->begin(),
+            rawData->ObjectsData->GetGroupIds()->end());
+
+        TQuantizedObjectsDataProviderPtr expectedObjectsData
+            = ConstructQuantizedPoolFromRawPool(rawData, plainJsonParams, /*quantizedFeaturesInfo*/ nullptr);
+
+        auto* objectsData
+            = dynamic_cast<TQuantizedObjectsDataProvider*>(quantizedWhileLoading->ObjectsData.Get());
+        UNIT_ASSERT(objectsData);
+        UNIT_ASSERT_VALUES_EQUAL(objectsData->GetObjectCount(), 8);
+
+        NPar::TLocalExecutor localExecutor;
+
+        const auto& quantizedFeaturesInfo = *objectsData->GetQuantizedFeaturesInfo();
+        const auto& expectedQuantizedFeaturesInfo = *expectedObjectsData->GetQuantizedFeaturesInfo();
+        for (auto floatFeatureIdx : xrange(3)) {
+            const TFloatFeatureIdx idx(floatFeatureIdx);
+            UNIT_ASSERT_EQUAL(
+                quantizedFeaturesInfo.GetBorders(idx),
+                expectedQuantizedFeaturesInfo.GetBorders(idx));
+            UNIT_ASSERT_EQUAL(quantizedFeaturesInfo.GetNanMode(idx), expectedQuantizedFeaturesInfo.GetNanMode(idx));
+
+            UNIT_ASSERT_EQUAL(
+                (*objectsData->GetFloatFeature(floatFeatureIdx))->ExtractValues<ui8>(&localExecutor),
+                (*expectedObjectsData->GetFloatFeature(floatFeatureIdx))->ExtractValues<ui8>(&localExecutor));
+        }
+
+        const auto& weights = quantizedWhileLoading->RawTargetData.GetWeights();
+        UNIT_ASSERT(!weights.IsTrivial());
+        UNIT_ASSERT_EQUAL(
+            TVector<float>(weights.GetNonTrivialData().begin(), weights.GetNonTrivialData().end()),
+            expectedWeights);
+
+        const auto groupIds = objectsData->GetGroupIds();
+        UNIT_ASSERT(groupIds);
+        UNIT_ASSERT_EQUAL(TVector<TGroupId>(groupIds->begin(), groupIds->end()), expectedGroupIds);
+    }
+}
@@ -0,0 +1,480 @@
+#include <catboost/libs/data/ut/lib/for_loader.h>
+
+#include <catboost/idl/arrow/File.fbs.h>
+#include <catboost/idl/arrow/Message.fbs.h>
+#include <catboost/idl/arrow/Schema.fbs.h>
+
+#include <library/cpp/testing/unittest/registar.h>
+
+#include <util/generic/maybe.h>
+#include <util/generic/xrange.h>
+#include <util/system/align.h>
+
+#include <limits>
+
+
+using namespace NCB;
+using namespace NCB::NDataNewUT;
+
+namespace NArrowFbs = org::apache::arrow::flatbuf;
+
+
+namespace {
+    // writes Arrow IPC data the same way pyarrow does (without compression)
+    class TArrowTestDataWriter {
+    public:
+        void AddFloatColumn(const TString& name, TVector<TMaybe<float>> values) {
+            TColumn column;
+            column.Name = name;
+            column.Type = NArrowFbs::Type_FloatingPoint;
+            column.Floats = std::move(values);
+            AddColumn(std::move(column));
+        }
+
+        void AddDoubleColumn(const TString& name, TVector<double> values) {
+            TColumn column;
+            column.Name = name;
+            column.Type = NArrowFbs::Type_FloatingPoint;
+            column.IsDouble = true;
+            column.Doubles = std::move(values);
+            AddColumn(std::move(column));
+        }
+
+        void AddInt64Column(const TString& name, TVector<i64> values) {
+            TColumn column;
+            column.Name = name;
+            column.Type = NArrowFbs::Type_Int;
+            column.Ints = std::move(values);
+            AddColumn(std::move(column));
+        }
+
+        void AddStringColumn(const TString& name, TVector<TMaybe<TString>> values) {
+            TColumn column;
+            column.Name = name;
+            column.Type = NArrowFbs::Type_Utf8;
+            column.Strings = std::move(values);
+            AddColumn(std::move(column));
+        }
+
+        void AddDictionaryColumn(const TString& name, TVector<TString> dictionary, TVector<TMaybe<i32>> indices) {
+            TColumn column;
+            column.Name = name;
+            column.Type = NArrowFbs::Type_Utf8;
+            column.DictionaryId = DictionaryCount++;
+            for (const auto& value : dictionary) {
+                column.Strings.push_back(value);
+            }
+            column.Indices = std::move(indices);
+            AddColumn(std::move(column));
+        }
+
+        TString Write(bool fileFormat, size_t recordBatchSize) const {
+            TString result;
+            if (fileFormat) {
+                result.append("ARROW1\0\0", 8);
+            }
+            WriteMessage(BuildSchemaMessage(), &result);
+
+            TVector<NArrowFbs::Block> dictionaryBlocks;
+            TVector<NArrowFbs::Block> recordBatchBlocks;
+            for (const auto& column : Columns) {
+                if (column.DictionaryId) {
+                    dictionaryBlocks.push_back(WriteDictionaryBatch(column, &result));
+                }
+            }
+            for (size_t begin = 0; begin < RowCount; begin += recordBatchSize) {
+                recordBatchBlocks.push_back(WriteRecordBatch(begin, Min(begin + recordBatchSize, RowCount), &result));
+            }
+
+            // end of stream marker
+            const ui32 endOfStream[] = {0xFFFFFFFF, 0};
+            result.append((const char*)endOfStream, sizeof(endOfStream));
+
+            if (fileFormat) {
+                flatbuffers::FlatBufferBuilder builder;
+                const auto schema = BuildSchema(&builder);
+                const auto dictionaries = builder.CreateVectorOfStructs(dictionaryBlocks.data(), dictionaryBlocks.size());
+                const auto recordBatches = builder.CreateVectorOfStructs(
+                    recordBatchBlocks.data(),
+                    recordBatchBlocks.size()
+                );
+                builder.Finish(
+                    NArrowFbs::CreateFooter(builder, NArrowFbs::MetadataVersion_V5, schema, dictionaries, recordBatches)
+                );
+                result.append((const char*)builder.GetBufferPointer(), builder.GetSize());
+                const i32 footerSize = builder.GetSize();
+                result.append((const char*)&footerSize, sizeof(footerSize));
+                result.append("ARROW1");
+            }
+            return result;
+        }
+
+    private:
+        struct TColumn {
+            TString Name;
+            NArrowFbs::Type Type = NArrowFbs::Type_NONE;
+            bool IsDouble = false;
+            TMaybe<i64> DictionaryId;
+            TVector<TMaybe<float>> Floats;
+            TVector<double> Doubles;
+            TVector<i64> Ints;
+            TVector<TMaybe<TString>> Strings; // values or dictionary
+            TVector<TMaybe<i32>> Indices;
+        };
+
+        class TBodyWriter {
+        public:
+            void AddBuffer(const void* data, size_t size) {
+                Buffers.emplace_back(Body.size(), size);
+                if (size) {
+                    Body.append((const char*)data, size);
+                }
+                Body.resize(AlignUp<size_t>(Body.size(), 8), '\0');
+            }
+
+            template <class TIsValid>
+            void AddValidity(size_t begin, size_t end, TIsValid&& isValid) {
+                TVector<ui8> validity((end - begin + 7) / 8, 0);
+                size_t nullCount = 0;
+                for (auto i : xrange(begin, end)) {
+                    if (isValid(i)) {
+                        validity[(i - begin) / 8] |= 1 << ((i - begin) % 8);
+                    } else {
+                        ++nullCount;
+                    }
+                }
+                Nodes.emplace_back(end - begin, nullCount);
+                if (nullCount) {
+                    AddBuffer(validity.data(), validity.size());
+                } else {
+                    AddBuffer(nullptr, 0);
+                }
+            }
+
+            void AddStrings(TConstArrayRef<TMaybe<TString>> strings) {
+                TVector<i32> offsets = {0};
+                TString data;
+                for (const auto& value : strings) {
+                    if (value) {
+                        data += *value;
+                    }
+                    offsets.push_back(data.size());
+                }
+                AddBuffer(offsets.data(), offsets.size() * sizeof(i32));
+                AddBuffer(data.data(), data.size());
+            }
+
+            flatbuffers::Offset<NArrowFbs::RecordBatch> Finish(flatbuffers::FlatBufferBuilder* builder, size_t length) {
+                const auto nodes = builder->CreateVectorOfStructs(Nodes.data(), Nodes.size());
+                const auto buffers = builder->CreateVectorOfStructs(Buffers.data(), Buffers.size());
+                return NArrowFbs::CreateRecordBatch(*builder, length, nodes, buffers);
+            }
+
+        public:
+            TString Body;
+
+        private:
+            TVector<NArrowFbs::FieldNode> Nodes;
+            TVector<NArrowFbs::Buffer> Buffers;
+        };
+
+    private:
+        void AddColumn(TColumn&& column) {
+            const size_t size = Max(
+                Max(column.Floats.size(), column.Doubles.size()),
+                Max(column.Ints.size(), column.DictionaryId ? column.Indices.size() : column.Strings.size())
+            );
+            UNIT_ASSERT(Columns.empty() || (size == RowCount));
+            RowCount = size;
+            Columns.push_back(std::move(column));
+        }
+
+        flatbuffers::Offset<NArrowFbs::Schema> BuildSchema(flatbuffers::FlatBufferBuilder* builder) const {
+            TVector<flatbuffers::Offset<NArrowFbs::Field>> fields;
+            for (const auto& column : Columns) {
+                const auto name = builder->CreateString(column.Name.data(), column.Name.size());
+                flatbuffers::Offset<void> type;
+                switch (column.Type) {
+                    case NArrowFbs::Type_FloatingPoint:
+                        type = NArrowFbs::CreateFloatingPoint(
+                            *builder,
+                            column.IsDouble ? NArrowFbs::Precision_DOUBLE : NArrowFbs::Precision_SINGLE
+                        ).Union();
+                        break;
+                    case NArrowFbs::Type_Int:
+                        type = NArrowFbs::CreateInt(*builder, 64, true).Union();
+                        break;
+                    default:
+                        type = NArrowFbs::CreateUtf8(*builder).Union();
+                }
+                flatbuffers::Offset<NArrowFbs::DictionaryEncoding> dictionary;
+                if (column.DictionaryId) {
+                    dictionary = NArrowFbs::CreateDictionaryEncoding(
+                        *builder,
+                        *column.DictionaryId,
+                        NArrowFbs::CreateInt(*builder, 32, true)
+                    );
+                }
+                const auto children = builder->CreateVector(TVector<flatbuffers::Offset<NArrowFbs::Field>>());
+                fields.push_back(
+                    NArrowFbs::CreateField(*builder, name, /*nullable*/ true, column.Type, type, dictionary, children)
+                );
+            }
+            return NArrowFbs::CreateSchema(*builder, NArrowFbs::Endianness_Little, builder->CreateVector(fields));
+        }
+
+        std::pair<TString, TString> BuildSchemaMessage() const {
+            flatbuffers::FlatBufferBuilder builder;
+            const auto schema = BuildSchema(&builder);
+            builder.Finish(
+                NArrowFbs::CreateMessage(
+                    builder,
+                    NArrowFbs::MetadataVersion_V5,
+                    NArrowFbs::MessageHeader_Schema,
+                    schema.Union()
+                )
+            );
+            return {TString((const char*)builder.GetBufferPointer(), builder.GetSize()), TString()};
+        }
+
+        // returns block of the message
+        static NArrowFbs::Block WriteMessage(const std::pair<TString, TString>& metadataAndBody, TString* result) {
+            const auto& [metadata, body] = metadataAndBody;
+            const size_t offset = result->size();
+            const ui32 paddedMetadataSize = AlignUp<size_t>(metadata.size() + 8, 8) - 8;
+            const ui32 prefix[] = {0xFFFFFFFF, paddedMetadataSize};
+            result->append((const char*)prefix, sizeof(prefix));
+            result->append(metadata);
+            result->append(paddedMetadataSize - metadata.size(), '\0');
+            result->append(body);
+            return NArrowFbs::Block(offset, sizeof(prefix) + paddedMetadataSize, body.size());
+        }
+
+        static std::pair<TString, TString> FinishMessage(
+            flatbuffers::FlatBufferBuilder* builder,
+            NArrowFbs::MessageHeader headerType,
+            flatbuffers::Offset<void> header,
+            const TString& body
+        ) {
+            builder->Finish(
+                NArrowFbs::CreateMessage(*builder, NArrowFbs::MetadataVersion_V5, headerType, header, body.size())
+            );
+            return {TString((const char*)builder->GetBufferPointer(), builder->GetSize()), body};
+        }
+
+        NArrowFbs::Block WriteDictionaryBatch(const TColumn& column, TString* result) const {
+            TBodyWriter bodyWriter;
+            bodyWriter.AddValidity(0, column.Strings.size(), [] (size_t) { return true; });
+            bodyWriter.AddStrings(column.Strings);
+
+            flatbuffers::FlatBufferBuilder builder;
+            const auto data = bodyWriter.Finish(&builder, column.Strings.size());
+            const auto dictionaryBatch = NArrowFbs::CreateDictionaryBatch(builder, *column.DictionaryId, data);
+            return WriteMessage(
+                FinishMessage(&builder, NArrowFbs::MessageHeader_DictionaryBatch, dictionaryBatch.Union(), bodyWriter.Body),
+                result
+            );
+        }
+
+        NArrowFbs::Block WriteRecordBatch(size_t begin, size_t end, TString* result) const {
+            TBodyWriter bodyWriter;
+            for (const auto& column : Columns) {
+                if (column.DictionaryId) {
+                    bodyWriter.AddValidity(begin, end, [&] (size_t i) { return column.Indices[i].Defined(); });
+                    TVector<i32> indices;
+                    for (auto i : xrange(begin, end)) {
+                        indices.push_back(column.Indices[i].GetOrElse(0));
+                    }
+                    bodyWriter.AddBuffer(indices.data(), indices.size() * sizeof(i32));
+                } else if (column.Type == NArrowFbs::Type_Utf8) {
+                    bodyWriter.AddValidity(begin, end, [&] (size_t i) { return column.Strings[i].Defined(); });
+                    bodyWriter.AddStrings(TConstArrayRef<TMaybe<TString>>(column.Strings).Slice(begin, end - begin));
+                } else if (column.Type == NArrowFbs::Type_Int) {
+                    bodyWriter.AddValidity(begin, end, [] (size_t) { return true; });
+                    bodyWriter.AddBuffer(column.Ints.data() + begin, (end - begin) * sizeof(i64));
+                } else if (column.IsDouble) {
+                    bodyWriter.AddValidity(begin, end, [] (size_t) { return true; });
+                    bodyWriter.AddBuffer(column.Doubles.data() + begin, (end - begin) * sizeof(double));
+                } else {
+                    bodyWriter.AddValidity(begin, end, [&] (size_t i) { return column.Floats[i].Defined(); });
+                    TVector<float> values;
+                    for (auto i : xrange(begin, end)) {
+                        values.push_back(column.Floats[i].GetOrElse(0.0f));
+                    }
+                    bodyWriter.AddBuffer(values.data(), values.size() * sizeof(float));
+                }
+            }
+
+            flatbuffers::FlatBufferBuilder builder;
+            const auto recordBatch = bodyWriter.Finish(&builder, end - begin);
+            return WriteMessage(
+                FinishMessage(&builder, NArrowFbs::MessageHeader_RecordBatch, recordBatch.Union(), bodyWriter.Body),
+                result
+            );
+        }
+
+    private:
+        TVector<TColumn> Columns;
+        size_t RowCount = 0;
+        i64 DictionaryCount = 0;
+    };
+}
+
+
+Y_UNIT_TEST_SUITE(LoadDataFromArrow) {
+
+    Y_UNIT_TEST(ReadDataset) {
+        const float nanValue = std::numeric_limits<float>::quiet_NaN();
+
+        TArrowTestDataWriter writer;
+        writer.AddDoubleColumn("Target", {0.0, 1.0, 1.0, 0.0, 1.0});
+        writer.AddFloatColumn("f0", {0.1f, Nothing(), 0.3f, 0.4f, 0.5f});
+        writer.AddDictionaryColumn("Country", {"Germany", "USA", "UK"}, {1, 0, Nothing(), 1, 2});
+        writer.AddInt64Column("f1", {7, -1, 0, 3, 12});
+        writer.AddStringColumn("Review", {TString("good"), TString("bad"), Nothing(), TString("ok"), TString("")});
+        writer.AddStringColumn("Query", {TString("q0"), TString("q0"), TString("q1"), TString("q1"), TString("q1")});
+        writer.AddInt64Column("Aux", {1, 2, 3, 4, 5});
+
+        // stream with several record batches and file with a single one that is used without copying
+        for (bool fileFormat : {false, true}) {
+            const TString data = writer.Write(fileFormat, fileFormat ? 5 : 2);
+
+            TReadDatasetTestCase testCase;
+            TSrcData srcData;
+            srcData.Scheme = "arrow";
+            srcData.CdFileData = AsStringBuf(
+                "0\tTarget\n"
+                "2\tCateg\n"
+                "4\tText\n"
+                "5\tGroupId\n"
+                "6\tAuxiliary\n"
+            );
+            srcData.DatasetFileData = data;
+            testCase.SrcData = std::move(srcData);
+
+            TExpectedRawData expectedData;
+
+            TDataColumnsMetaInfo dataColumnsMetaInfo;
+            dataColumnsMetaInfo.Columns = {
+                {EColumn::Label, ""},
+                {EColumn::Num, ""},
+                {EColumn::Categ, ""},
+                {EColumn::Num, ""},
+                {EColumn::Text, ""},
+                {EColumn::GroupId, ""},
+                {EColumn::Auxiliary, ""}
+            };
+
+            TVector<TString> featureId = {"f0", "Country", "f1", "Review"};
+
+            expectedData.MetaInfo = TDataMetaInfo(
+                std::move(dataColumnsMetaInfo),
+                ERawTargetType::Float,
+                false,
+                false,
+                false,
+                /* additionalBaselineCount */ Nothing(),
+                &featureId
+            );
+            expectedData.Objects.GroupIds = TVector<TStringBuf>{"q0", "q0", "q1", "q1", "q1"};
+            expectedData.Objects.FloatFeatures = {
+                TVector<float>{0.1f, nanValue, 0.3f, 0.4f, 0.5f},
+                TVector<float>{7.0f, -1.0f, 0.0f, 3.0f, 12.0f}
+            };
+            expectedData.Objects.CatFeatures = {
+                TVector<TStringBuf>{"USA", "Germany", "", "USA", "UK"}
+            };
+            expectedData.Objects.TextFeatures = {
+                TVector<TStringBuf>{"good", "bad", "", "ok", ""}
+            };
+
+            expectedData.ObjectsGrouping = TObjectsGrouping(TVector<TGroupBounds>{{0, 2}, {2, 5}});
+            expectedData.Target.TargetType = ERawTargetType::Float;
+            TVector<TVector<TString>> rawTarget{{"0", "1", "1", "0", "1"}};
+            expectedData.Target.Target.assign(rawTarget.begin(), rawTarget.end());
+            expectedData.Target.Weights = TWeights<float>(5);
+            expectedData.Target.GroupWeights = TWeights<float>(5);
+
+            testCase.ExpectedData = std::move(expectedData);
+
+            TestReadDataset(testCase);
+        }
+    }
+
+    Y_UNIT_TEST(ReadDatasetWithStringTarget) {
+        TArrowTestDataWriter writer;
+        writer.AddDictionaryColumn("Class", {"cat", "dog"}, {0, 1, 1});
+        writer.AddFloatColumn("f0", {0.5f, 0.25f, 0.125f});
+
+        TReadDatasetTestCase testCase;
+        TSrcData srcData;
+        srcData.Scheme = "arrow";
+        const TString data = writer.Write(/*fileFormat*/ true, 2);
+        srcData.DatasetFileData = data;
+        testCase.SrcData = std::move(srcData);
+
+        TExpectedRawData expectedData;
+
+        TDataColumnsMetaInfo dataColumnsMetaInfo;
+        dataColumnsMetaInfo.Columns = {
+            {EColumn::Label, ""},
+            {EColumn::Num, ""}
+        };
+
+        TVector<TString> featureId = {"f0"};
+
+        expectedData.MetaInfo = TDataMetaInfo(
+            std::move(dataColumnsMetaInfo),
+            ERawTargetType::String,
+            false,
+            false,
+            false,
+            /* additionalBaselineCount */ Nothing(),
+            &featureId
+        );
+        expectedData.Objects.FloatFeatures = {
+            TVector<float>{0.5f, 0.25f, 0.125f}
+        };
+
+        expectedData.ObjectsGrouping = TObjectsGrouping(3);
+        expectedData.Target.TargetType = ERawTargetType::String;
+        TVector<TVector<TString>> rawTarget{{"cat", "dog", "dog"}};
+        expectedData.Target.Target.assign(rawTarget.begin(), rawTarget.end());
+        expectedData.Target.Weights = TWeights<float>(3);
+        expectedData.Target.GroupWeights = TWeights<float>(3);
+
+        testCase.ExpectedData = std::move(expectedData);
+
+        TestReadDataset(testCase);
+    }
+
+    Y_UNIT_TEST(ReadDatasetErrors) {
+        TVector<TString> datasets;
+        {
+            // null target
+            TArrowTestDataWriter writer;
+            writer.AddFloatColumn("Target", {0.0f, Nothing()});
+            writer.AddFloatColumn("f0", {0.5f, 0.25f});
+            datasets.push_back(writer.Write(/*fileFormat*/ false, 2));
+        }
+        {
+            // truncated data
+            TArrowTestDataWriter writer;
+            writer.AddFloatColumn("Target", {0.0f, 1.0f});
+            writer.AddFloatColumn("f0", {0.5f, 0.25f});
+            const TString data = writer.Write(/*fileFormat*/ true, 2);
+            datasets.push_back(data.substr(0, data.size() - 40));
+        }
+
+        for (const auto& data : datasets) {
+            TReadDatasetTestCase testCase;
+            TSrcData srcData;
+            srcData.Scheme = "arrow";
+            srcData.DatasetFileData = data;
+            testCase.SrcData = std::move(srcData);
+            testCase.ExpectedReadError = true;
+
+            TestReadDataset(testCase);
+        }
+    }
+}
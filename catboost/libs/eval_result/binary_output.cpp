@@ -0,0 +1,305 @@
+#include "binary_output.h"
+
+#include <catboost/idl/arrow/File.fbs.h>
+#include <catboost/idl/arrow/Message.fbs.h>
+#include <catboost/idl/arrow/Schema.fbs.h>
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/cast.h>
+#include <util/generic/xrange.h>
+#include <util/stream/file.h>
+#include <util/string/builder.h>
+#include <util/system/align.h>
+#include <util/system/byteorder.h>
+
+#include <type_traits>
+
+
+namespace NArrowFbs = org::apache::arrow::flatbuf;
+
+
+namespace NCB {
+
+    // magic, version 1.0 and header length are followed by the header dict padded to this size
+    static constexpr size_t NpyHeaderSize = 128;
+    static constexpr TStringBuf NpyMagic = "\x93NUMPY";
+
+    // Arrow file starts with the magic padded to 8 bytes and ends with the footer, its length and the magic
+    static constexpr TStringBuf ArrowFileMagic = "ARROW1";
+    static constexpr ui32 ArrowContinuationMarker = 0xFFFFFFFF;
+
+    bool IsBinaryEvalResultScheme(TStringBuf scheme) {
+        return (scheme == "npy") || (scheme == "raw-f32") || (scheme == "raw-f64") || (scheme == "arrow");
+    }
+
+    static flatbuffers::Offset<NArrowFbs::Schema> BuildArrowSchema(
+        TConstArrayRef<TString> headers,
+        flatbuffers::FlatBufferBuilder* builder) {
+
+        TVector<flatbuffers::Offset<NArrowFbs::Field>> fields;
+        for (const auto& header : headers) {
+            const auto name = builder->CreateString(header.data(), header.size());
+            const auto type = NArrowFbs::CreateFloatingPoint(*builder, NArrowFbs::Precision_DOUBLE).Union();
+            const auto children = builder->CreateVector(TVector<flatbuffers::Offset<NArrowFbs::Field>>());
+            fields.push_back(
+                NArrowFbs::CreateField(
+                    *builder,
+                    name,
+                    /*nullable*/ false,
+                    NArrowFbs::Type_FloatingPoint,
+                    type,
+                    /*dictionary*/ 0,
+                    children));
+        }
+#if defined(_little_endian_)
+        const auto endianness = NArrowFbs::Endianness_Little;
+#else
+        const auto endianness = NArrowFbs::Endianness_Big;
+#endif
+        return NArrowFbs::CreateSchema(*builder, endianness, builder->CreateVector(fields));
+    }
+
+    // writes the prefix and the metadata padded to 8 bytes, returns their size
+    static i32 WriteArrowMessageMetadata(const flatbuffers::FlatBufferBuilder& builder, TFile* file) {
+        const ui32 metadataSize = SafeIntegerCast<ui32>(builder.GetSize());
+        const ui32 paddedMetadataSize = AlignUp<ui32>(metadataSize + 2 * sizeof(ui32), 8) - 2 * sizeof(ui32);
+        const ui32 prefix[] = {ArrowContinuationMarker, paddedMetadataSize};
+        file->Write(prefix, sizeof(prefix));
+        file->Write(builder.GetBufferPointer(), metadataSize);
+        const char padding[8] = {};
+        file->Write(padding, paddedMetadataSize - metadataSize);
+        return sizeof(prefix) + paddedMetadataSize;
+    }
+
+    TBinaryEvalResultWriter::TBinaryEvalResultWriter(const TPathWithScheme& outputPath)
+        : Path(outputPath.Path)
+    {
+        if (outputPath.Scheme == "npy") {
+            Format = EFormat::Npy;
+        } else if (outputPath.Scheme == "raw-f32") {
+            Format = EFormat::RawFloat;
+        } else if (outputPath.Scheme == "raw-f64") {
+            Format = EFormat::RawDouble;
+        } else {
+            CB_ENSURE(
+                outputPath.Scheme == "arrow",
+                "Unsupported binary output scheme: " << outputPath.Scheme);
+            Format = EFormat::Arrow;
+        }
+        if (Format == EFormat::Npy) {
+            File.ConstructInPlace(Path, CreateAlways | WrOnly);
+            // reserve space for the header, it is written by Finish when the shape is known
+            File->Resize(NpyHeaderSize);
+            File->Seek(NpyHeaderSize, sSet);
+        } else if (Format == EFormat::Arrow) {
+            File.ConstructInPlace(Path, CreateAlways | WrOnly);
+            const char magic[8] = {'A', 'R', 'R', 'O', 'W', '1', '\0', '\0'};
+            File->Write(magic, sizeof(magic));
+        }
+    }
+
+    void TBinaryEvalResultWriter::AddBlock(
+        TConstArrayRef<TString> headers,
+        TConstArrayRef<TVector<double>> columns,
+        NPar::ILocalExecutor* executor) {
+
+        CB_ENSURE_INTERNAL(headers.size() == columns.size(), "Binary output: headers and columns count mismatch");
+        if (!Headers) {
+            Headers.ConstructInPlace(headers.begin(), headers.end());
+            if (Format == EFormat::Arrow) {
+                WriteArrowSchema();
+            } else if (Format != EFormat::Npy) {
+                for (auto columnIdx : xrange(headers.size())) {
+                    ColumnFiles.emplace_back(TStringBuilder() << Path << '.' << columnIdx, CreateAlways | WrOnly);
+                }
+            }
+        } else {
+            CB_ENSURE(
+                TConstArrayRef<TString>(*Headers) == headers,
+                "Binary output: columns differ between blocks of data");
+        }
+        if (columns.empty()) {
+            return;
+        }
+        const size_t docCount = columns[0].size();
+        for (const auto& column : columns) {
+            CB_ENSURE_INTERNAL(column.size() == docCount, "Binary output: columns have different sizes");
+        }
+
+        switch (Format) {
+            case EFormat::Npy: {
+                const size_t columnCount = columns.size();
+                TVector<float> rows;
+                rows.yresize(docCount * columnCount);
+                executor->ExecRangeBlockedWithThrow(
+                    [&] (int docIdx) {
+                        float* row = rows.data() + static_cast<size_t>(docIdx) * columnCount;
+                        for (auto columnIdx : xrange(columnCount)) {
+                            row[columnIdx] = static_cast<float>(columns[columnIdx][docIdx]);
+                        }
+                    },
+                    0,
+                    SafeIntegerCast<int>(docCount),
+                    /*batchSizeOrZeroForAutoBatchSize*/ 0,
+                    NPar::TLocalExecutor::WAIT_COMPLETE);
+                File->Write(rows.data(), rows.size() * sizeof(float));
+                break;
+            }
+            case EFormat::RawFloat:
+                WriteColumns<float>(columns, executor);
+                break;
+            case EFormat::RawDouble:
+                WriteColumns<double>(columns, executor);
+                break;
+            case EFormat::Arrow:
+                WriteArrowRecordBatch(columns, docCount);
+                break;
+        }
+        DocCount += docCount;
+    }
+
+    template <class T>
+    void TBinaryEvalResultWriter::WriteColumns(
+        TConstArrayRef<TVector<double>> columns,
+        NPar::ILocalExecutor* executor) {
+
+        // each column goes to its own file, so columns are converted and written concurrently
+        executor->ExecRangeWithThrow(
+            [&] (int columnIdx) {
+                const auto& column = columns[columnIdx];
+                if constexpr (std::is_same_v<T, double>) {
+                    ColumnFiles[columnIdx].Write(column.data(), column.size() * sizeof(double));
+                } else {
+                    TVector<T> values(column.begin(), column.end());
+                    ColumnFiles[columnIdx].Write(values.data(), values.size() * sizeof(T));
+                }
+            },
+            0,
+            SafeIntegerCast<int>(columns.size()),
+            NPar::TLocalExecutor::WAIT_COMPLETE);
+    }
+
+    void TBinaryEvalResultWriter::WriteNpyHeader() {
+        const size_t columnCount = Headers ? Headers->size() : 0;
+        TString dict = TStringBuilder()
+            << "{'descr': '<f4', 'fortran_order': False, 'shape': (" << DocCount << ", " << columnCount << "), }";
+        const size_t dictSize = NpyHeaderSize - NpyMagic.size() - 2 * sizeof(ui8) - sizeof(ui16);
+        CB_ENSURE_INTERNAL(dict.size() < dictSize, "npy header is too long");
+        dict.append(dictSize - dict.size() - 1, ' ');
+        dict.push_back('\n');
+
+        TString header;
+        header.reserve(NpyHeaderSize);
+        header.append(NpyMagic);
+        header.push_back('\x01');
+        header.push_back('\x00');
+        const ui16 dictSizeLE = HostToLittle(static_cast<ui16>(dictSize));
+        header.append(reinterpret_cast<const char*>(&dictSizeLE), sizeof(dictSizeLE));
+        header.append(dict);
+        Y_ASSERT(header.size() == NpyHeaderSize);
+        File->Pwrite(header.data(), header.size(), 0);
+    }
+
+    void TBinaryEvalResultWriter::WriteArrowSchema() {
+        flatbuffers::FlatBufferBuilder builder;
+        const auto schema = BuildArrowSchema(*Headers, &builder);
+        builder.Finish(
+            NArrowFbs::CreateMessage(
+                builder,
+                NArrowFbs::MetadataVersion_V5,
+                NArrowFbs::MessageHeader_Schema,
+                schema.Union()));
+        WriteArrowMessageMetadata(builder, File.Get());
+    }
+
+    void TBinaryEvalResultWriter::WriteArrowRecordBatch(TConstArrayRef<TVector<double>> columns, size_t docCount) {
+        // columns follow each other in the body, their sizes are multiples of 8 so no padding is needed
+        const i64 columnSize = docCount * sizeof(double);
+        TVector<NArrowFbs::FieldNode> nodes;
+        TVector<NArrowFbs::Buffer> buffers;
+        for (auto columnIdx : xrange(columns.size())) {
+            nodes.emplace_back(docCount, /*null_count*/ 0);
+            buffers.emplace_back(/*offset*/ 0, /*length*/ 0); // no validity bitmap
+            buffers.emplace_back(columnIdx * columnSize, columnSize);
+        }
+        const i64 bodyLength = columns.size() * columnSize;
+
+        flatbuffers::FlatBufferBuilder builder;
+        const auto nodesOffset = builder.CreateVectorOfStructs(nodes.data(), nodes.size());
+        const auto buffersOffset = builder.CreateVectorOfStructs(buffers.data(), buffers.size());
+        const auto recordBatch = NArrowFbs::CreateRecordBatch(builder, docCount, nodesOffset, buffersOffset);
+        builder.Finish(
+            NArrowFbs::CreateMessage(
+                builder,
+                NArrowFbs::MetadataVersion_V5,
+                NArrowFbs::MessageHeader_RecordBatch,
+                recordBatch.Union(),
+                bodyLength));
+
+        TArrowBlock block;
+        block.Offset = File->GetPosition();
+        block.MetaDataLength = WriteArrowMessageMetadata(builder, File.Get());
+        block.BodyLength = bodyLength;
+        for (const auto& column : columns) {
+            File->Write(column.data(), columnSize);
+        }
+        ArrowRecordBatches.push_back(block);
+    }
+
+    void TBinaryEvalResultWriter::FinishArrow() {
+        if (!Headers) {
+            Headers.ConstructInPlace();
+            WriteArrowSchema();
+        }
+        const ui32 endOfStream[] = {ArrowContinuationMarker, 0};
+        File->Write(endOfStream, sizeof(endOfStream));
+
+        TVector<NArrowFbs::Block> recordBatches;
+        for (const auto& block : ArrowRecordBatches) {
+            recordBatches.emplace_back(block.Offset, block.MetaDataLength, block.BodyLength);
+        }
+        const TVector<NArrowFbs::Block> dictionaries;
+
+        flatbuffers::FlatBufferBuilder builder;
+        const auto schema = BuildArrowSchema(*Headers, &builder);
+        const auto dictionariesOffset = builder.CreateVectorOfStructs(dictionaries.data(), dictionaries.size());
+        const auto recordBatchesOffset = builder.CreateVectorOfStructs(recordBatches.data(), recordBatches.size());
+        builder.Finish(
+            NArrowFbs::CreateFooter(
+                builder,
+                NArrowFbs::MetadataVersion_V5,
+                schema,
+                dictionariesOffset,
+                recordBatchesOffset));
+        File->Write(builder.GetBufferPointer(), builder.GetSize());
+        const i32 footerSize = SafeIntegerCast<i32>(builder.GetSize());
+        File->Write(&footerSize, sizeof(footerSize));
+        File->Write(ArrowFileMagic.data(), ArrowFileMagic.size());
+        File->Close();
+    }
+
+    void TBinaryEvalResultWriter::Finish() {
+        if (Format == EFormat::Arrow) {
+            // column names are stored in the schema
+            FinishArrow();
+            return;
+        }
+        if (Format == EFormat::Npy) {
+            WriteNpyHeader();
+            File->Close();
+        } else {
+            for (auto& columnFile : ColumnFiles) {
+                columnFile.Close();
+            }
+        }
+        TFileOutput headersOutput(Path + ".columns");
+        if (Headers) {
+            for (const auto& header : *Headers) {
+                headersOutput << header << '\n';
+            }
+        }
+        headersOutput.Finish();
+    }
+
+}
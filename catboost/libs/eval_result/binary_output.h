@@ -0,0 +1,79 @@
+#pragma once
+
+#include <catboost/private/libs/data_util/path_with_scheme.h>
+
+#include <library/cpp/threading/local_executor/local_executor.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/maybe.h>
+#include <util/generic/string.h>
+#include <util/generic/strbuf.h>
+#include <util/generic/vector.h>
+#include <util/system/file.h>
+#include <util/system/types.h>
+
+
+namespace NCB {
+
+    bool IsBinaryEvalResultScheme(TStringBuf scheme);
+
+    /* Writes numeric output columns in binary form, data is appended by blocks of documents.
+     * Supported schemes:
+     *   npy://path      - .npy file with float32 array of shape (documentCount, columnCount) in C order,
+     *                     the shape in the header is updated by Finish
+     *   raw-f32://path,
+     *   raw-f64://path  - a file 'path.<columnIdx>' per column with contiguous values in native byte order
+     *   arrow://path    - Arrow IPC file (Feather V2) with a float64 column per output column,
+     *                     a record batch per block of documents
+     * For npy and raw formats column names are written to 'path.columns', one per line,
+     * Arrow columns are named by them.
+     */
+    class TBinaryEvalResultWriter {
+    public:
+        explicit TBinaryEvalResultWriter(const TPathWithScheme& outputPath);
+
+        // columns are [columnIdx][docIdx], headers and their order must be the same for all blocks
+        void AddBlock(
+            TConstArrayRef<TString> headers,
+            TConstArrayRef<TVector<double>> columns,
+            NPar::ILocalExecutor* executor);
+
+        void Finish();
+
+    private:
+        enum class EFormat {
+            Npy,
+            RawFloat,
+            RawDouble,
+            Arrow
+        };
+
+        // location of an Arrow IPC message in the file
+        struct TArrowBlock {
+            i64 Offset = 0;
+            i32 MetaDataLength = 0; // with the prefix and padding
+            i64 BodyLength = 0;
+        };
+
+    private:
+        void WriteNpyHeader();
+
+        void WriteArrowSchema();
+        void WriteArrowRecordBatch(TConstArrayRef<TVector<double>> columns, size_t docCount);
+        void FinishArrow();
+
+        template <class T>
+        void WriteColumns(TConstArrayRef<TVector<double>> columns, NPar::ILocalExecutor* executor);
+
+    private:
+        EFormat Format;
+        TString Path;
+        TMaybe<TVector<TString>> Headers; // defined after the first block
+        ui64 DocCount = 0;
+
+        TMaybe<TFile> File; // for npy and arrow formats
+        TVector<TFile> ColumnFiles; // [columnIdx], for raw formats
+        TVector<TArrowBlock> ArrowRecordBatches;
+    };
+
+}
@@ -68,6 +68,28 @@ namespace NCB {
         }
     }
 
+    bool TEvalPrinter::OutputNumericColumns(
+        size_t docCount,
+        TVector<TString>* headers,
+        TVector<TVector<double>>* columns) {
+
+        // class names are not numeric in general
+        if (PredictionType == EPredictionType::Class) {
+            return false;
+        }
+        size_t columnCount = 0;
+        for (const auto& approxes : Approxes) {
+            for (const auto& approx : approxes) {
+                Y_ASSERT(docCount <= approx.size());
+                columns->emplace_back(approx.begin(), approx.begin() + docCount);
+                ++columnCount;
+            }
+        }
+        CB_ENSURE_INTERNAL(columnCount == Header.size(), "Eval columns count mismatch with header");
+        headers->insert(headers->end(), Header.begin(), Header.end());
+        return true;
+    }
+
     void TEvalPrinter::OutputHeader(IOutputStream* outStream) {
         for (int idx = 0; idx < Header.ysize(); ++idx) {
             if (idx > 0) {
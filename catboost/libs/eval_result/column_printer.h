@@ -17,10 +17,13 @@
 #include <util/generic/ptr.h>
 #include <util/generic/string.h>
 #include <util/generic/vector.h>
+#include <util/generic/xrange.h>
 #include <util/stream/output.h>
+#include <util/string/cast.h>
 #include <util/system/compiler.h>
 #include <util/system/types.h>
 
+#include <type_traits>
 #include <utility>
 
 
@@ -33,6 +36,24 @@ namespace NCB {
         virtual TString GetAfterColumnDelimiter() const {
             return "\t";
         }
+
+        // true if OutputValue can be called for documents in any order and from several threads at once
+        virtual bool IsRandomAccess() const {
+            return true;
+        }
+
+        /* Appends values of all printed columns for documents [0, docCount) to columns and their names to headers,
+         * used for binary output. Returns false if values are not numeric.
+         */
+        virtual bool OutputNumericColumns(
+            size_t docCount,
+            TVector<TString>* headers,
+            TVector<TVector<double>>* columns) {
+
+            Y_UNUSED(docCount, headers, columns);
+            return false;
+        }
+
         virtual ~IColumnPrinter() = default;
     };
 
@@ -66,6 +87,22 @@ namespace NCB {
             *outStream << Header;
         }
 
+        bool OutputNumericColumns(
+            size_t docCount,
+            TVector<TString>* headers,
+            TVector<TVector<double>>* columns) override {
+
+            if constexpr (std::is_arithmetic_v<T>) {
+                Y_ASSERT(docCount <= (*Array).size());
+                headers->push_back(Header);
+                columns->emplace_back((*Array).begin(), (*Array).begin() + docCount);
+                return true;
+            } else {
+                Y_UNUSED(docCount, headers, columns);
+                return false;
+            }
+        }
+
     private:
         const NCB::TMaybeOwningConstArrayHolder<T> Array;
         const TString Header;
@@ -87,6 +124,20 @@ namespace NCB {
             *outStream << Header;
         }
 
+        bool OutputNumericColumns(
+            size_t docCount,
+            TVector<TString>* headers,
+            TVector<TVector<double>>* columns) override {
+
+            headers->push_back(Header);
+            auto& column = columns->emplace_back();
+            column.yresize(docCount);
+            for (auto docIndex : xrange(docCount)) {
+                column[docIndex] = Weights[docIndex];
+            }
+            return true;
+        }
+
     private:
         const TWeights<float>& Weights;
         const TString Header;
@@ -116,6 +167,20 @@ namespace NCB {
             return Delimiter;
         }
 
+        bool OutputNumericColumns(
+            size_t docCount,
+            TVector<TString>* headers,
+            TVector<TVector<double>>* columns) override {
+
+            double value;
+            if (!TryFromString<double>(Prefix, value)) {
+                return false;
+            }
+            headers->push_back(Header);
+            columns->emplace_back(docCount, value);
+            return true;
+        }
+
     private:
         const TString Prefix;
         const TString Header;
@@ -142,6 +207,10 @@ namespace NCB {
             *outStream << ColumnName;
         }
 
+        bool IsRandomAccess() const override {
+            return false;
+        }
+
     private:
         TIntrusivePtr<IPoolColumnsPrinter> PrinterPtr;
         int ColumnId;
@@ -190,6 +259,10 @@ namespace NCB {
             TMaybe<std::pair<size_t, size_t>> evalParameters = TMaybe<std::pair<size_t, size_t>>());
         void OutputValue(IOutputStream* outStream, size_t docIndex) override;
         void OutputHeader(IOutputStream* outStream) override;
+        bool OutputNumericColumns(
+            size_t docCount,
+            TVector<TString>* headers,
+            TVector<TVector<double>>* columns) override;
 
     private:
         EPredictionType PredictionType;
@@ -224,6 +297,10 @@ namespace NCB {
             PrinterPtr->OutputColumnByType(outStream, DocIdOffset + docIndex, ColumnType);
         }
 
+        bool IsRandomAccess() const override {
+            return false;
+        }
+
     private:
         TIntrusivePtr<IPoolColumnsPrinter> PrinterPtr;
         EColumn ColumnType;
@@ -255,6 +332,27 @@ namespace NCB {
             }
         }
 
+        bool IsRandomAccess() const override {
+            return NeedToGenerate;
+        }
+
+        bool OutputNumericColumns(
+            size_t docCount,
+            TVector<TString>* headers,
+            TVector<TVector<double>>* columns) override {
+
+            if (!NeedToGenerate) {
+                return false;
+            }
+            headers->push_back(Header);
+            auto& column = columns->emplace_back();
+            column.yresize(docCount);
+            for (auto docIndex : xrange(docCount)) {
+                column[docIndex] = DocIdOffset + docIndex;
+            }
+            return true;
+        }
+
     private:
         TIntrusivePtr<IPoolColumnsPrinter> PrinterPtr;
         bool NeedToGenerate;
@@ -5,8 +5,12 @@
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/logging/logging.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/hash_set.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
 #include <util/stream/fwd.h>
+#include <util/stream/str.h>
 #include <util/string/builder.h>
 #include <util/string/cast.h>
 
@@ -16,6 +20,9 @@ using namespace NCB;
 
 const TString BaselinePrefix = "Baseline#";
 
+// size of a block of rows formatted by one task
+static constexpr ui32 FormatBlockSize = 1000;
+
 namespace {
     struct TFeatureDesc {
         size_t Index;
@@ -156,17 +163,15 @@ namespace NCB {
         return poolColumnsPrinter;
     }
 
-    void OutputEvalResultToFile(
+    static TVector<THolder<IColumnPrinter>> CreateColumnPrinters(
         const TEvalResult& evalResult,
         NPar::ILocalExecutor* executor,
         const TVector<TString>& outputColumns,
         const TString& lossFunctionName,
         const TExternalLabelsHelper& visibleLabelsHelper,
         const TDataProvider& pool,
-        IOutputStream* outputStream,
         TIntrusivePtr<IPoolColumnsPrinter> poolColumnsPrinter,
         std::pair<int, int> testFileWhichOf,
-        bool writeHeader,
         ui64 docIdOffset,
         TMaybe<std::pair<size_t, size_t>> evalParameters) {
 
@@ -310,6 +315,53 @@ namespace NCB {
                 }
             }
         }
+        return columnPrinter;
+    }
+
+    static void OutputRows(
+        TConstArrayRef<THolder<IColumnPrinter>> columnPrinter,
+        TConstArrayRef<TString> delimiters,
+        ui32 docBegin,
+        ui32 docEnd,
+        IOutputStream* outputStream) {
+
+        for (ui32 docId = docBegin; docId < docEnd; ++docId) {
+            for (auto printerIdx : xrange(columnPrinter.size())) {
+                if (printerIdx) {
+                    *outputStream << delimiters[printerIdx - 1];
+                }
+                columnPrinter[printerIdx]->OutputValue(outputStream, docId);
+            }
+            *outputStream << '\n';
+        }
+    }
+
+    void OutputEvalResultToFile(
+        const TEvalResult& evalResult,
+        NPar::ILocalExecutor* executor,
+        const TVector<TString>& outputColumns,
+        const TString& lossFunctionName,
+        const TExternalLabelsHelper& visibleLabelsHelper,
+        const TDataProvider& pool,
+        IOutputStream* outputStream,
+        TIntrusivePtr<IPoolColumnsPrinter> poolColumnsPrinter,
+        std::pair<int, int> testFileWhichOf,
+        bool writeHeader,
+        ui64 docIdOffset,
+        TMaybe<std::pair<size_t, size_t>> evalParameters) {
+
+        TVector<THolder<IColumnPrinter>> columnPrinter = CreateColumnPrinters(
+            evalResult,
+            executor,
+            outputColumns,
+            lossFunctionName,
+            visibleLabelsHelper,
+            pool,
+            poolColumnsPrinter,
+            testFileWhichOf,
+            docIdOffset,
+            evalParameters);
+
         if (writeHeader) {
             TString delimiter = "";
             for (auto& printer : columnPrinter) {
@@ -319,15 +371,86 @@ namespace NCB {
             }
             *outputStream << Endl;
         }
-        for (ui32 docId = 0; docId < pool.ObjectsGrouping->GetObjectCount(); ++docId) {
-            TString delimiter = "";
-            for (auto& printer : columnPrinter) {
-                *outputStream << delimiter;
-                printer->OutputValue(outputStream, docId);
-                delimiter = printer->GetAfterColumnDelimiter();
+
+        TVector<TString> delimiters;
+        for (const auto& printer : columnPrinter) {
+            delimiters.push_back(printer->GetAfterColumnDelimiter());
+        }
+
+        const ui32 docCount = pool.ObjectsGrouping->GetObjectCount();
+        const bool canFormatInParallel = AllOf(
+            columnPrinter,
+            [] (const auto& printer) { return printer->IsRandomAccess(); });
+        if (!canFormatInParallel || (executor->GetThreadCount() == 0) || (docCount <= FormatBlockSize)) {
+            OutputRows(columnPrinter, delimiters, 0, docCount, outputStream);
+            outputStream->Flush();
+            return;
+        }
+
+        // blocks of rows are formatted in parallel, at most one block per thread is kept in memory
+        const ui32 blockCount = CeilDiv(docCount, FormatBlockSize);
+        const ui32 blocksPerStep = executor->GetThreadCount() + 1;
+        TVector<TString> formattedBlocks(blocksPerStep);
+        for (ui32 stepBlockBegin = 0; stepBlockBegin < blockCount; stepBlockBegin += blocksPerStep) {
+            const ui32 stepBlockEnd = Min(stepBlockBegin + blocksPerStep, blockCount);
+            executor->ExecRangeWithThrow(
+                [&] (int blockIdx) {
+                    TString& formattedBlock = formattedBlocks[blockIdx - stepBlockBegin];
+                    formattedBlock.clear();
+                    TStringOutput blockOutput(formattedBlock);
+                    OutputRows(
+                        columnPrinter,
+                        delimiters,
+                        blockIdx * FormatBlockSize,
+                        Min((blockIdx + 1) * FormatBlockSize, docCount),
+                        &blockOutput);
+                },
+                stepBlockBegin,
+                stepBlockEnd,
+                NPar::TLocalExecutor::WAIT_COMPLETE);
+            for (auto blockIdx : xrange(stepBlockBegin, stepBlockEnd)) {
+                *outputStream << formattedBlocks[blockIdx - stepBlockBegin];
+            }
+        }
+        outputStream->Flush();
+    }
+
+    void OutputEvalResultToBinaryWriter(
+        const TEvalResult& evalResult,
+        NPar::ILocalExecutor* executor,
+        const TVector<TString>& outputColumns,
+        const TString& lossFunctionName,
+        const TExternalLabelsHelper& visibleLabelsHelper,
+        const TDataProvider& pool,
+        TBinaryEvalResultWriter* writer,
+        TIntrusivePtr<IPoolColumnsPrinter> poolColumnsPrinter,
+        std::pair<int, int> testFileWhichOf,
+        ui64 docIdOffset,
+        TMaybe<std::pair<size_t, size_t>> evalParameters) {
+
+        TVector<THolder<IColumnPrinter>> columnPrinter = CreateColumnPrinters(
+            evalResult,
+            executor,
+            outputColumns,
+            lossFunctionName,
+            visibleLabelsHelper,
+            pool,
+            poolColumnsPrinter,
+            testFileWhichOf,
+            docIdOffset,
+            evalParameters);
+
+        const ui32 docCount = pool.ObjectsGrouping->GetObjectCount();
+        TVector<TString> headers;
+        TVector<TVector<double>> columns;
+        for (auto& printer : columnPrinter) {
+            if (!printer->OutputNumericColumns(docCount, &headers, &columns)) {
+                TStringStream header;
+                printer->OutputHeader(&header);
+                CB_ENSURE(false, "Output column " << header.Str() << " is not numeric, binary output is not possible");
             }
-            *outputStream << Endl;
         }
+        writer->AddBlock(headers, columns, executor);
     }
 
     void OutputEvalResultToFile(
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "binary_output.h"
 #include "column_printer.h"
 #include "pool_printer.h"
 
@@ -63,6 +64,23 @@ namespace NCB {
         ui64 docIdOffset = 0,
         TMaybe<std::pair<size_t, size_t>> evalParameters = TMaybe<std::pair<size_t, size_t>>());
 
+    /* Writes numeric output columns of a block of documents to writer.
+     * Columns with non-numeric values (class names, string ids, categorical features, source pool columns)
+     * are not supported.
+     */
+    void OutputEvalResultToBinaryWriter(
+        const TEvalResult& evalResult,
+        NPar::ILocalExecutor* executor,
+        const TVector<TString>& outputColumns,
+        const TString& lossFunctionName,
+        const TExternalLabelsHelper& visibleLabelsHelper,
+        const TDataProvider& pool,
+        TBinaryEvalResultWriter* writer,
+        TIntrusivePtr<IPoolColumnsPrinter> poolColumnsPrinter,
+        std::pair<int, int> testFileWhichOf,
+        ui64 docIdOffset = 0,
+        TMaybe<std::pair<size_t, size_t>> evalParameters = TMaybe<std::pair<size_t, size_t>>());
+
     void OutputEvalResultToFile(
         const TEvalResult& evalResult,
         NPar::ILocalExecutor* executor,
@@ -0,0 +1,184 @@
+#include <library/cpp/testing/unittest/registar.h>
+
+#include <catboost/libs/data/arrow_reader.h>
+#include <catboost/libs/eval_result/binary_output.h>
+#include <catboost/libs/helpers/exception.h>
+
+#include <library/cpp/threading/local_executor/local_executor.h>
+
+#include <util/generic/xrange.h>
+#include <util/stream/file.h>
+#include <util/string/builder.h>
+#include <util/system/fs.h>
+#include <util/system/mktemp.h>
+#include <util/system/tempfile.h>
+#include <util/system/unaligned_mem.h>
+
+#include <cstring>
+
+
+using namespace NCB;
+
+
+static const TVector<TString> Headers = {"RawFormulaVal", "Label"};
+
+// two blocks of 3 and 2 documents
+static const TVector<TVector<TVector<double>>> Blocks = {
+    {{0.5, -1.25, 3.0}, {1.0, 0.0, 1.0}},
+    {{1e10, -0.125}, {0.0, 2.0}}
+};
+
+static void WriteBlocks(const TPathWithScheme& path, NPar::ILocalExecutor* executor) {
+    TBinaryEvalResultWriter writer(path);
+    for (const auto& block : Blocks) {
+        writer.AddBlock(Headers, block, executor);
+    }
+    writer.Finish();
+}
+
+template <class T>
+static TVector<T> ReadValues(const TString& path) {
+    const TString data = TIFStream(path).ReadAll();
+    UNIT_ASSERT_VALUES_EQUAL(data.size() % sizeof(T), 0);
+    TVector<T> values(data.size() / sizeof(T));
+    std::memcpy(values.data(), data.data(), data.size());
+    return values;
+}
+
+static void CheckColumnsFile(const TString& path) {
+    UNIT_ASSERT_VALUES_EQUAL(TIFStream(path + ".columns").ReadAll(), "RawFormulaVal\nLabel\n");
+}
+
+Y_UNIT_TEST_SUITE(TBinaryEvalResultWriter) {
+    Y_UNIT_TEST(Npy) {
+        NPar::TLocalExecutor executor;
+        executor.RunAdditionalThreads(3);
+
+        const TTempFile file(MakeTempName());
+        const TTempFile columnsFile(file.Name() + ".columns");
+        WriteBlocks(TPathWithScheme("npy://" + file.Name()), &executor);
+
+        const TString data = TIFStream(file.Name()).ReadAll();
+        UNIT_ASSERT(data.size() >= 128);
+        UNIT_ASSERT_VALUES_EQUAL(TStringBuf(data).Head(6), "\x93NUMPY");
+        UNIT_ASSERT_VALUES_EQUAL(data[6], '\x01');
+        UNIT_ASSERT_VALUES_EQUAL(data[7], '\x00');
+        const ui16 headerDictSize = ReadUnaligned<ui16>(data.data() + 8);
+        // the total header size has to be a multiple of 64
+        UNIT_ASSERT_VALUES_EQUAL(10 + headerDictSize, 128);
+        const TStringBuf headerDict = TStringBuf(data).SubStr(10, headerDictSize);
+        UNIT_ASSERT_VALUES_EQUAL(headerDict.back(), '\n');
+        UNIT_ASSERT_STRING_CONTAINS(headerDict, "'descr': '<f4'");
+        UNIT_ASSERT_STRING_CONTAINS(headerDict, "'fortran_order': False");
+        UNIT_ASSERT_STRING_CONTAINS(headerDict, "'shape': (5, 2)");
+
+        const TVector<float> expected = {0.5f, 1.0f, -1.25f, 0.0f, 3.0f, 1.0f, 1e10f, 0.0f, -0.125f, 2.0f};
+        UNIT_ASSERT_VALUES_EQUAL(data.size(), 128 + expected.size() * sizeof(float));
+        TVector<float> values(expected.size());
+        std::memcpy(values.data(), data.data() + 128, values.size() * sizeof(float));
+        UNIT_ASSERT_VALUES_EQUAL(values, expected);
+
+        CheckColumnsFile(file.Name());
+    }
+
+    Y_UNIT_TEST(NpyWithoutBlocks) {
+        const TTempFile file(MakeTempName());
+        const TTempFile columnsFile(file.Name() + ".columns");
+        {
+            TBinaryEvalResultWriter writer(TPathWithScheme("npy://" + file.Name()));
+            writer.Finish();
+        }
+        const TString data = TIFStream(file.Name()).ReadAll();
+        UNIT_ASSERT_VALUES_EQUAL(data.size(), 128);
+        UNIT_ASSERT_STRING_CONTAINS(data, "'shape': (0, 0)");
+        UNIT_ASSERT_VALUES_EQUAL(TIFStream(file.Name() + ".columns").ReadAll(), "");
+    }
+
+    Y_UNIT_TEST(Raw) {
+        NPar::TLocalExecutor executor;
+        executor.RunAdditionalThreads(3);
+
+        for (TStringBuf scheme : {"raw-f32", "raw-f64"}) {
+            const TTempFile file(MakeTempName());
+            const TTempFile columnsFile(file.Name() + ".columns");
+            const TTempFile column0File(file.Name() + ".0");
+            const TTempFile column1File(file.Name() + ".1");
+            WriteBlocks(TPathWithScheme(TStringBuilder() << scheme << "://" << file.Name()), &executor);
+
+            for (auto columnIdx : xrange(Headers.size())) {
+                TVector<double> expected;
+                for (const auto& block : Blocks) {
+                    expected.insert(expected.end(), block[columnIdx].begin(), block[columnIdx].end());
+                }
+                const TString columnPath = TStringBuilder() << file.Name() << '.' << columnIdx;
+                if (scheme == "raw-f32") {
+                    const TVector<float> expectedFloat(expected.begin(), expected.end());
+                    UNIT_ASSERT_VALUES_EQUAL(ReadValues<float>(columnPath), expectedFloat);
+                } else {
+                    UNIT_ASSERT_VALUES_EQUAL(ReadValues<double>(columnPath), expected);
+                }
+            }
+            UNIT_ASSERT(!NFs::Exists(file.Name() + ".2"));
+            CheckColumnsFile(file.Name());
+        }
+    }
+
+    Y_UNIT_TEST(Arrow) {
+        NPar::TLocalExecutor executor;
+        executor.RunAdditionalThreads(3);
+
+        const TTempFile file(MakeTempName());
+        WriteBlocks(TPathWithScheme("arrow://" + file.Name()), &executor);
+        UNIT_ASSERT(!NFs::Exists(file.Name() + ".columns"));
+
+        const TArrowIpcReader reader(file.Name());
+        UNIT_ASSERT_VALUES_EQUAL(reader.GetFields().size(), Headers.size());
+        for (auto columnIdx : xrange(Headers.size())) {
+            UNIT_ASSERT_VALUES_EQUAL(reader.GetFields()[columnIdx].Name, Headers[columnIdx]);
+            UNIT_ASSERT_EQUAL(reader.GetFields()[columnIdx].Type, EArrowValueType::Float64);
+            UNIT_ASSERT(!reader.GetFields()[columnIdx].DictionaryIndexType);
+        }
+        UNIT_ASSERT_VALUES_EQUAL(reader.GetRowCount(), 5);
+        UNIT_ASSERT_VALUES_EQUAL(reader.GetRecordBatchCount(), Blocks.size());
+        for (auto blockIdx : xrange(Blocks.size())) {
+            for (auto columnIdx : xrange(Headers.size())) {
+                const TArrowArray& array = reader.GetColumn(blockIdx, columnIdx);
+                const auto& expected = Blocks[blockIdx][columnIdx];
+                UNIT_ASSERT_VALUES_EQUAL(array.Length, expected.size());
+                UNIT_ASSERT_VALUES_EQUAL(array.NullCount, 0);
+                for (auto docIdx : xrange(expected.size())) {
+                    UNIT_ASSERT_VALUES_EQUAL(array.GetPrimitive<double>(docIdx), expected[docIdx]);
+                }
+            }
+        }
+    }
+
+    Y_UNIT_TEST(ArrowWithoutBlocks) {
+        const TTempFile file(MakeTempName());
+        {
+            TBinaryEvalResultWriter writer(TPathWithScheme("arrow://" + file.Name()));
+            writer.Finish();
+        }
+        const TString data = TIFStream(file.Name()).ReadAll();
+        UNIT_ASSERT(TStringBuf(data).StartsWith(TStringBuf("ARROW1\0\0", 8)));
+        UNIT_ASSERT(TStringBuf(data).EndsWith("ARROW1"));
+        // the footer is valid, but the dataset reader requires fields
+        UNIT_ASSERT_EXCEPTION_CONTAINS(TArrowIpcReader(file.Name()), TCatBoostException, "Arrow schema has no fields");
+    }
+
+    Y_UNIT_TEST(DifferentColumnsInBlocks) {
+        NPar::TLocalExecutor executor;
+        const TTempFile file(MakeTempName());
+        const TTempFile column0File(file.Name() + ".0");
+        const TTempFile column1File(file.Name() + ".1");
+
+        TBinaryEvalResultWriter writer(TPathWithScheme("raw-f64://" + file.Name()));
+        writer.AddBlock(Headers, Blocks[0], &executor);
+        const TVector<TString> otherHeaders = {"Label", "RawFormulaVal"};
+        UNIT_ASSERT_EXCEPTION(writer.AddBlock(otherHeaders, Blocks[1], &executor), TCatBoostException);
+    }
+
+    Y_UNIT_TEST(UnsupportedScheme) {
+        UNIT_ASSERT_EXCEPTION(TBinaryEvalResultWriter(TPathWithScheme("dsv://unused")), TCatBoostException);
+    }
+}
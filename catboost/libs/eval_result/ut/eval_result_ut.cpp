@@ -0,0 +1,199 @@
+#include <library/cpp/testing/unittest/registar.h>
+
+#include <catboost/libs/data/data_provider_builders.h>
+#include <catboost/libs/eval_result/eval_result.h>
+#include <catboost/libs/helpers/exception.h>
+
+#include <library/cpp/threading/local_executor/local_executor.h>
+
+#include <util/generic/xrange.h>
+#include <util/stream/file.h>
+#include <util/stream/str.h>
+#include <util/string/builder.h>
+#include <util/string/split.h>
+#include <util/system/mktemp.h>
+#include <util/system/tempfile.h>
+
+#include <cstring>
+
+
+using namespace NCB;
+
+
+// more than one block of rows formatted in parallel
+static constexpr ui32 DocCount = 2500;
+
+// float feature "f0", categorical feature "c1", weights
+static TDataProviderPtr CreatePool() {
+    return CreateDataProvider(
+        [&] (IRawFeaturesOrderDataVisitor* visitor) {
+            TDataMetaInfo metaInfo;
+            metaInfo.TargetType = ERawTargetType::Float;
+            metaInfo.TargetCount = 1;
+            metaInfo.HasWeights = true;
+            metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                (ui32)2,
+                TVector<ui32>{1},
+                TVector<ui32>{},
+                TVector<ui32>{},
+                TVector<TString>{"f0", "c1"});
+
+            visitor->Start(metaInfo, DocCount, EObjectsOrder::Undefined, {});
+
+            TVector<float> floatFeature;
+            TVector<TString> catFeature;
+            TVector<float> target;
+            TVector<float> weights;
+            for (auto docIdx : xrange(DocCount)) {
+                floatFeature.push_back(docIdx * 0.25f);
+                catFeature.push_back(ToString(docIdx % 7));
+                target.push_back(docIdx % 2);
+                weights.push_back(1.0f + docIdx % 3);
+            }
+            visitor->AddFloatFeature(0, MakeIntrusive<TTypeCastArrayHolder<float, float>>(std::move(floatFeature)));
+            visitor->AddCatFeature(1, TConstArrayRef<TString>(catFeature));
+            visitor->AddTarget(MakeIntrusive<TTypeCastArrayHolder<float, float>>(std::move(target)));
+            visitor->AddWeights(weights);
+
+            visitor->Finish();
+        }
+    );
+}
+
+static TEvalResult CreateEvalResult() {
+    TVector<TVector<double>> rawValues(1);
+    for (auto docIdx : xrange(DocCount)) {
+        rawValues[0].push_back((docIdx % 11) * 0.5 - 2.0);
+    }
+    TEvalResult evalResult;
+    evalResult.SetRawValuesByMove(rawValues);
+    return evalResult;
+}
+
+static TString OutputText(
+    const TEvalResult& evalResult,
+    const TDataProvider& pool,
+    const TVector<TString>& outputColumns,
+    NPar::ILocalExecutor* executor) {
+
+    TStringStream output;
+    OutputEvalResultToFile(
+        evalResult,
+        executor,
+        outputColumns,
+        "Logloss",
+        TExternalLabelsHelper(),
+        pool,
+        &output,
+        /*poolColumnsPrinter*/ nullptr,
+        /*testFileWhichOf*/ {0, 1});
+    return output.Str();
+}
+
+static void OutputBinary(
+    const TEvalResult& evalResult,
+    const TDataProvider& pool,
+    const TVector<TString>& outputColumns,
+    NPar::ILocalExecutor* executor,
+    const TString& path) {
+
+    TBinaryEvalResultWriter writer(TPathWithScheme("raw-f64://" + path));
+    OutputEvalResultToBinaryWriter(
+        evalResult,
+        executor,
+        outputColumns,
+        "Logloss",
+        TExternalLabelsHelper(),
+        pool,
+        &writer,
+        /*poolColumnsPrinter*/ nullptr,
+        /*testFileWhichOf*/ {0, 1});
+    writer.Finish();
+}
+
+static TVector<double> ReadRawColumn(const TString& path) {
+    const TString data = TIFStream(path).ReadAll();
+    TVector<double> values(data.size() / sizeof(double));
+    std::memcpy(values.data(), data.data(), values.size() * sizeof(double));
+    return values;
+}
+
+Y_UNIT_TEST_SUITE(TEvalResultOutput) {
+    Y_UNIT_TEST(TextOutputIsSameInParallel) {
+        const auto pool = CreatePool();
+        const auto evalResult = CreateEvalResult();
+        const TVector<TString> outputColumns = {"SampleId", "RawFormulaVal", "Probability", "Label", "Weight", "f0", "c1"};
+
+        NPar::TLocalExecutor serialExecutor;
+        const TString serialOutput = OutputText(evalResult, *pool, outputColumns, &serialExecutor);
+
+        const TVector<TStringBuf> lines = StringSplitter(serialOutput).Split('\n');
+        UNIT_ASSERT_VALUES_EQUAL(lines.size(), DocCount + 2); // header and an empty string after the last line end
+        UNIT_ASSERT_VALUES_EQUAL(lines[0], "SampleId\tRawFormulaVal\tProbability\tLabel\tWeight\tf0\tc1");
+        UNIT_ASSERT(lines.back().empty());
+        for (auto docIdx : xrange(DocCount)) {
+            const TVector<TString> values = StringSplitter(lines[docIdx + 1]).Split('\t');
+            UNIT_ASSERT_VALUES_EQUAL(values.size(), outputColumns.size());
+            UNIT_ASSERT_VALUES_EQUAL(values[0], ToString(docIdx));
+            UNIT_ASSERT_VALUES_EQUAL(values[1], ToString((docIdx % 11) * 0.5 - 2.0));
+            UNIT_ASSERT_VALUES_EQUAL(values[3], ToString(docIdx % 2));
+            UNIT_ASSERT_VALUES_EQUAL(values[4], ToString(1.0f + docIdx % 3));
+            UNIT_ASSERT_VALUES_EQUAL(values[5], ToString(docIdx * 0.25f));
+            UNIT_ASSERT_VALUES_EQUAL(values[6], ToString(docIdx % 7));
+        }
+
+        NPar::TLocalExecutor parallelExecutor;
+        parallelExecutor.RunAdditionalThreads(3);
+        UNIT_ASSERT_VALUES_EQUAL(OutputText(evalResult, *pool, outputColumns, &parallelExecutor), serialOutput);
+    }
+
+    Y_UNIT_TEST(BinaryOutput) {
+        const auto pool = CreatePool();
+        const auto evalResult = CreateEvalResult();
+        const TVector<TString> outputColumns = {"SampleId", "RawFormulaVal", "Label", "Weight", "f0"};
+
+        NPar::TLocalExecutor executor;
+        executor.RunAdditionalThreads(3);
+
+        const TTempFile file(MakeTempName());
+        const TTempFile columnsFile(file.Name() + ".columns");
+        TVector<TTempFile> columnFiles;
+        columnFiles.reserve(outputColumns.size());
+        for (auto columnIdx : xrange(outputColumns.size())) {
+            columnFiles.emplace_back(TStringBuilder() << file.Name() << '.' << columnIdx);
+        }
+        OutputBinary(evalResult, *pool, outputColumns, &executor, file.Name());
+
+        UNIT_ASSERT_VALUES_EQUAL(
+            TIFStream(columnsFile.Name()).ReadAll(),
+            "SampleId\nRawFormulaVal\nLabel\nWeight\nf0\n");
+        TVector<TVector<double>> columns;
+        for (const auto& columnFile : columnFiles) {
+            columns.push_back(ReadRawColumn(columnFile.Name()));
+            UNIT_ASSERT_VALUES_EQUAL(columns.back().size(), DocCount);
+        }
+        for (auto docIdx : xrange(DocCount)) {
+            UNIT_ASSERT_VALUES_EQUAL(columns[0][docIdx], docIdx);
+            UNIT_ASSERT_VALUES_EQUAL(columns[1][docIdx], (docIdx % 11) * 0.5 - 2.0);
+            UNIT_ASSERT_VALUES_EQUAL(columns[2][docIdx], docIdx % 2);
+            UNIT_ASSERT_VALUES_EQUAL(columns[3][docIdx], 1.0f + docIdx % 3);
+            UNIT_ASSERT_VALUES_EQUAL(columns[4][docIdx], docIdx * 0.25f);
+        }
+    }
+
+    Y_UNIT_TEST(BinaryOutputRejectsNonNumericColumns) {
+        const auto pool = CreatePool();
+        const auto evalResult = CreateEvalResult();
+
+        NPar::TLocalExecutor executor;
+        // class names, categorical features and columns of the source pool
+        for (TString column : {"Class", "c1", "#0", "GroupId"}) {
+            const TTempFile file(MakeTempName());
+            const TTempFile columnsFile(file.Name() + ".columns");
+            UNIT_ASSERT_EXCEPTION_CONTAINS(
+                OutputBinary(evalResult, *pool, {"RawFormulaVal", column}, &executor, file.Name()),
+                TCatBoostException,
+                "is not numeric");
+        }
+    }
+}
@@ -23,6 +23,8 @@ namespace NCB {
      *   should be able to handle empty index range (return valid blockOutput in this case)
      * mergeFunc(dst, addVector) adds addVector data to dst, it can modify addVector as it is no
      *   longer used after this call
+     * if localExecutor is nullptr blocks are processed sequentially by the calling thread,
+     *   blocks and merge order are the same, so is the result
      */
     template <class TOutput, class TMapFunc, class TMergeFunc>
     void MapMerge(
@@ -41,17 +43,19 @@ namespace NCB {
         } else {
             TVector<TOutput> mapOutputs(blockCount - 1); // w/o first, first is reused from 'output' param
 
-            localExecutor->ExecRange(
-                [&](int blockId) {
-                    mapFunc(
-                        indexRangesGenerator.GetRange(blockId),
-                        (blockId == 0) ? output : &(mapOutputs[blockId - 1])
-                    );
-                },
-                0,
-                blockCount,
-                NPar::TLocalExecutor::WAIT_COMPLETE
-            );
+            const auto mapBlock = [&](int blockId) {
+                mapFunc(
+                    indexRangesGenerator.GetRange(blockId),
+                    (blockId == 0) ? output : &(mapOutputs[blockId - 1])
+                );
+            };
+            if (localExecutor) {
+                localExecutor->ExecRange(mapBlock, 0, blockCount, NPar::TLocalExecutor::WAIT_COMPLETE);
+            } else {
+                for (int blockId = 0; blockId < blockCount; ++blockId) {
+                    mapBlock(blockId);
+                }
+            }
 
             mergeFunc(output, std::move(mapOutputs));
         }
@@ -0,0 +1,228 @@
+#include "trace.h"
+
+#include <library/cpp/chromium_trace/consumer.h>
+#include <library/cpp/chromium_trace/global.h>
+#include <library/cpp/chromium_trace/json.h>
+
+#include <util/generic/hash_set.h>
+#include <util/generic/vector.h>
+#include <util/stream/file.h>
+#include <util/system/guard.h>
+#include <util/system/mutex.h>
+#include <util/system/spinlock.h>
+
+#include <atomic>
+#include <type_traits>
+
+
+using namespace NChromiumTrace;
+
+
+static const TStringBuf TraceCategory = "catboost";
+
+// a thread writes its events to the file by itself when it has buffered this many
+static constexpr size_t MaxBufferedEventsPerThread = 1 << 14;
+
+// set while a TChromeTraceSink is active
+static std::atomic<bool> IsTraceEnabled = false;
+
+static NChromiumTrace::TEventArgs MakeCounterArgs(i64 rows, i64 bytes) {
+    NChromiumTrace::TEventArgs args;
+    if (rows >= 0) {
+        args.Add("rows", rows);
+    }
+    if (bytes >= 0) {
+        args.Add("bytes", bytes);
+    }
+    return args;
+}
+
+NCB::TTraceScope::TTraceScope(TStringBuf name) noexcept
+    : Args()
+    , Guard(NChromiumTrace::GetGlobalTracer(), name, TraceCategory)
+{
+}
+
+NCB::TTraceScope::TTraceScope(TStringBuf name, i64 rows, i64 bytes) noexcept
+    : Args(
+        IsTraceEnabled.load(std::memory_order_relaxed)
+        ? MakeMaybe(MakeCounterArgs(rows, bytes))
+        : Nothing())
+    , Guard(NChromiumTrace::GetGlobalTracer(), name, TraceCategory, Args.Get())
+{
+}
+
+
+namespace {
+    // Events of one thread with copies of the strings they refer to.
+    struct TThreadTraceBuffer {
+        // not contended: taken by the owning thread and by TBufferedTraceConsumer::Flush only
+        TAdaptiveLock Lock;
+        TVector<TEventWithArgs> Events;
+        THashSet<TString> Strings;
+
+    public:
+        TStringBuf Intern(TStringBuf str) {
+            return *Strings.insert(TString(str)).first;
+        }
+
+        void Clear() {
+            Events.clear();
+            Strings.clear();
+        }
+    };
+}
+
+
+namespace NCB::NPrivate {
+
+    /* Buffers events per thread so that traced threads do not serialize on a global lock,
+     * events are written to the output when a thread buffer gets full and on Flush.
+     * Events of each thread keep their order.
+     */
+    class TBufferedTraceConsumer final : public ITraceConsumer {
+    public:
+        explicit TBufferedTraceConsumer(IOutputStream* output)
+            : Id(++LastId)
+            , Json(output)
+        {
+        }
+
+        void AddEvent(const TDurationBeginEvent& event, const TEventArgs* args) override {
+            Buffer(event, args);
+        }
+
+        void AddEvent(const TDurationEndEvent& event, const TEventArgs* args) override {
+            Buffer(event, args);
+        }
+
+        void AddEvent(const TDurationCompleteEvent& event, const TEventArgs* args) override {
+            Buffer(event, args);
+        }
+
+        void AddEvent(const TCounterEvent& event, const TEventArgs* args) override {
+            Buffer(event, args);
+        }
+
+        void AddEvent(const TMetadataEvent& event, const TEventArgs* args) override {
+            Buffer(event, args);
+        }
+
+        void Flush() {
+            with_lock (BuffersLock) {
+                for (auto& buffer : Buffers) {
+                    with_lock (buffer->Lock) {
+                        WriteEvents(buffer.Get());
+                    }
+                }
+            }
+        }
+
+    private:
+        TThreadTraceBuffer* GetThreadBuffer() {
+            // consumers are told apart by Id as a new consumer can be allocated at the address of a destroyed one
+            thread_local ui64 bufferOwnerId = 0;
+            thread_local TThreadTraceBuffer* buffer = nullptr;
+            if (bufferOwnerId != Id) {
+                with_lock (BuffersLock) {
+                    Buffers.push_back(MakeHolder<TThreadTraceBuffer>());
+                    buffer = Buffers.back().Get();
+                }
+                bufferOwnerId = Id;
+            }
+            return buffer;
+        }
+
+        template <class TEvent>
+        void Buffer(TEvent event, const TEventArgs* args) {
+            TThreadTraceBuffer* buffer = GetThreadBuffer();
+            with_lock (buffer->Lock) {
+                if constexpr (!std::is_same_v<TEvent, TDurationEndEvent>) {
+                    event.Name = buffer->Intern(event.Name);
+                }
+                if constexpr (!std::is_same_v<TEvent, TDurationEndEvent> && !std::is_same_v<TEvent, TMetadataEvent>) {
+                    event.Categories = buffer->Intern(event.Categories);
+                }
+                TEventArgs argsCopy;
+                if (args) {
+                    for (const auto& arg : args->Items) {
+                        auto& argCopy = argsCopy.Items.emplace_back(arg);
+                        argCopy.Name = buffer->Intern(arg.Name);
+                        if (const TStringBuf* value = GetIf<TStringBuf>(&arg.Value)) {
+                            argCopy.Value = buffer->Intern(*value);
+                        }
+                    }
+                }
+                buffer->Events.emplace_back(event, argsCopy);
+                if (buffer->Events.size() >= MaxBufferedEventsPerThread) {
+                    WriteEvents(buffer);
+                }
+            }
+        }
+
+        // call with buffer->Lock taken
+        void WriteEvents(TThreadTraceBuffer* buffer) {
+            with_lock (OutputLock) {
+                for (const auto& event : buffer->Events) {
+                    Visit(
+                        [&] (const auto& typedEvent) {
+                            using TEvent = std::decay_t<decltype(typedEvent)>;
+                            if constexpr (
+                                !std::is_same_v<TEvent, TInstantEvent> && !std::is_same_v<TEvent, TAsyncEvent>)
+                            {
+                                Json.AddEvent(typedEvent, &event.Args);
+                            }
+                        },
+                        event.Event);
+                }
+            }
+            buffer->Clear();
+        }
+
+    private:
+        static std::atomic<ui64> LastId;
+
+        const ui64 Id;
+
+        TMutex BuffersLock;
+        TVector<THolder<TThreadTraceBuffer>> Buffers;
+
+        TMutex OutputLock;
+        TJsonTraceConsumer Json;
+    };
+
+    std::atomic<ui64> TBufferedTraceConsumer::LastId = 0;
+
+}
+
+
+NCB::TChromeTraceSink::TChromeTraceSink(const TString& filePath) {
+    if (filePath.empty()) {
+        return;
+    }
+    File = MakeHolder<TFileOutput>(filePath);
+    Consumer = MakeHolder<NPrivate::TBufferedTraceConsumer>(File.Get());
+    NChromiumTrace::GetGlobalTracer()->SetOutput(Consumer.Get());
+    NChromiumTrace::GetGlobalTracer()->AddCurrentProcessName("catboost");
+    NChromiumTrace::GetGlobalTracer()->AddCurrentThreadName("main");
+    IsTraceEnabled = true;
+}
+
+NCB::TChromeTraceSink::~TChromeTraceSink() {
+    try {
+        Finish();
+    } catch (...) {
+    }
+}
+
+void NCB::TChromeTraceSink::Finish() {
+    if (!Consumer) {
+        return;
+    }
+    IsTraceEnabled = false;
+    NChromiumTrace::GetGlobalTracer()->SetOutput(nullptr);
+    Consumer->Flush();
+    Consumer.Destroy(); // closes the list of events
+    File->Finish();
+    File.Destroy();
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <library/cpp/chromium_trace/guard.h>
+
+#include <util/generic/maybe.h>
+#include <util/generic/ptr.h>
+#include <util/generic/strbuf.h>
+#include <util/generic/string.h>
+#include <util/stream/file.h>
+#include <util/system/defaults.h>
+#include <util/system/types.h>
+
+namespace NCB::NPrivate {
+    class TBufferedTraceConsumer;
+}
+
+namespace NCB {
+
+    /*
+     * Nested span of training work recorded in Chrome trace format (chrome://tracing, Perfetto).
+     * Spans are attributed to the calling thread, so spans opened inside local executor jobs show
+     * how work is spread among threads. Costs one branch if no TChromeTraceSink is active.
+     *
+     * name must stay alive until the scope ends.
+     */
+    class TTraceScope {
+    public:
+        explicit TTraceScope(TStringBuf name) noexcept;
+
+        // rows and bytes are shown as span arguments, negative values are omitted,
+        // the arguments are not built if no TChromeTraceSink is active
+        TTraceScope(TStringBuf name, i64 rows, i64 bytes) noexcept;
+
+    private:
+        TMaybe<NChromiumTrace::TEventArgs> Args;
+        NChromiumTrace::TCompleteEventGuard Guard;
+    };
+
+
+    /* Writes all spans to filePath while alive, does nothing if filePath is empty.
+     * Spans are buffered per thread and written in chunks, so the file is complete only after Finish.
+     */
+    class TChromeTraceSink {
+    public:
+        explicit TChromeTraceSink(const TString& filePath);
+        ~TChromeTraceSink();
+
+        // stops recording and writes the buffered spans, called by the destructor if it has not been called
+        void Finish();
+
+    private:
+        THolder<TFileOutput> File;
+        THolder<NPrivate::TBufferedTraceConsumer> Consumer;
+    };
+}
+
+#define CB_TRACE_SCOPE(name) \
+    ::NCB::TTraceScope Y_GENERATE_UNIQUE_ID(cbTraceScope)(name)
+
+#define CB_TRACE_SCOPE_WITH_COUNTERS(name, rows, bytes) \
+    ::NCB::TTraceScope Y_GENERATE_UNIQUE_ID(cbTraceScope)((name), (rows), (bytes))
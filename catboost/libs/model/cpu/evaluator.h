@@ -2,6 +2,7 @@
 
 #include "quantization.h"
 
+#include <util/generic/scope.h>
 #include <util/generic/utility.h>
 #include <util/generic/vector.h>
 
@@ -42,6 +43,31 @@ namespace NCB::NModelEvaluation {
         return val;
     }
 
+    // buffers of ProcessDocsInBlocks, their capacity is kept between evaluations
+    struct TEvaluatorBlockBuffers {
+        TVector<ui8> QuantizedData; // only for blocks that don't fit the stack
+        TVector<ui32> TransposedHash;
+        TVector<float> Ctrs;
+        TVector<float> EstimatedFeatures;
+        TTextProcessingBlockBuffers TextProcessing;
+        bool InUse = false;
+    };
+
+    /* While the scope exists evaluations in the current thread use its buffers instead of allocating them.
+     * Nested evaluations and evaluations in other threads (for example in executor tasks) allocate their own.
+     */
+    class TEvaluatorBlockBuffersScope {
+    public:
+        explicit TEvaluatorBlockBuffersScope(TEvaluatorBlockBuffers* buffers);
+        ~TEvaluatorBlockBuffersScope();
+
+        // nullptr if there is no scope in the current thread
+        static TEvaluatorBlockBuffers* GetCurrent();
+
+    private:
+        TEvaluatorBlockBuffers* Previous;
+    };
+
     template <
         typename TFloatFeatureAccessor,
         typename TCatFeatureAccessor,
@@ -108,19 +134,31 @@ namespace NCB::NModelEvaluation {
     ) {
         const size_t binSlots = blockSize * trees.GetEffectiveBinaryFeaturesBucketsCount();
 
+        TEvaluatorBlockBuffers localBuffers;
+        TEvaluatorBlockBuffers* buffers = TEvaluatorBlockBuffersScope::GetCurrent();
+        if (!buffers || buffers->InUse) {
+            buffers = &localBuffers;
+        }
+        buffers->InUse = true;
+        Y_DEFER {
+            buffers->InUse = false;
+        };
+
         TCPUEvaluatorQuantizedData quantizedData;
         if (binSlots < 65536) { // 65KB of stack maximum
             quantizedData.QuantizedData = NCB::TMaybeOwningArrayHolder<ui8>::CreateNonOwning(
                 MakeArrayRef(GetAligned((ui8*)(alloca(binSlots + 0x20))), binSlots));
         } else {
-            TVector<ui8> binFeaturesHolder;
-            binFeaturesHolder.yresize(binSlots);
-            quantizedData.QuantizedData = NCB::TMaybeOwningArrayHolder<ui8>::CreateOwning(std::move(binFeaturesHolder));
+            buffers->QuantizedData.yresize(binSlots);
+            quantizedData.QuantizedData = NCB::TMaybeOwningArrayHolder<ui8>::CreateNonOwning(
+                MakeArrayRef(buffers->QuantizedData));
         }
 
         auto applyData = trees.GetApplyData();
-        TVector<ui32> transposedHash(blockSize * applyData->UsedCatFeaturesCount);
-        TVector<float> ctrs(applyData->UsedModelCtrs.size() * blockSize);
+        auto& transposedHash = buffers->TransposedHash;
+        transposedHash.assign(blockSize * applyData->UsedCatFeaturesCount, 0);
+        auto& ctrs = buffers->Ctrs;
+        ctrs.assign(applyData->UsedModelCtrs.size() * blockSize, 0.0f);
         ui32 estimatedFeaturesNum = 0;
         if (textProcessingCollection) {
             estimatedFeaturesNum += textProcessingCollection->TotalNumberOfOutputFeatures();
@@ -128,7 +166,8 @@ namespace NCB::NModelEvaluation {
         if (embeddingProcessingCollection) {
             estimatedFeaturesNum += embeddingProcessingCollection->TotalNumberOfOutputFeatures();
         }
-        TVector<float> estimatedFeatures(estimatedFeaturesNum * blockSize);
+        auto& estimatedFeatures = buffers->EstimatedFeatures;
+        estimatedFeatures.assign(estimatedFeaturesNum * blockSize, 0.0f);
 
         for (size_t blockStart = 0; blockStart < docCount; blockStart += blockSize) {
             const auto docCountInBlock = Min(blockSize, docCount - blockStart);
@@ -148,7 +187,8 @@ namespace NCB::NModelEvaluation {
                 transposedHash,
                 ctrs,
                 estimatedFeatures,
-                featureInfo
+                featureInfo,
+                &buffers->TextProcessing
             );
             callback(docCountInBlock, &quantizedData);
         }
@@ -10,6 +10,22 @@
 
 namespace NCB::NModelEvaluation {
 
+    static thread_local TEvaluatorBlockBuffers* CurrentBlockBuffers = nullptr;
+
+    TEvaluatorBlockBuffersScope::TEvaluatorBlockBuffersScope(TEvaluatorBlockBuffers* buffers)
+        : Previous(CurrentBlockBuffers)
+    {
+        CurrentBlockBuffers = buffers;
+    }
+
+    TEvaluatorBlockBuffersScope::~TEvaluatorBlockBuffersScope() {
+        CurrentBlockBuffers = Previous;
+    }
+
+    TEvaluatorBlockBuffers* TEvaluatorBlockBuffersScope::GetCurrent() {
+        return CurrentBlockBuffers;
+    }
+
     constexpr size_t SSE_BLOCK_SIZE = 16;
     static_assert(SSE_BLOCK_SIZE * 8 == FORMULA_EVALUATION_BLOCK_SIZE);
 
@@ -2,6 +2,7 @@
 #include <catboost/libs/model/model.h>
 
 #include "evaluator.h"
+#include "single_doc_evaluator.h"
 
 namespace NCB::NModelEvaluation {
     namespace NDetail {
@@ -88,7 +89,11 @@ namespace NCB::NModelEvaluation {
                 , CtrProvider(fullModel.CtrProvider)
                 , TextProcessingCollection(fullModel.TextProcessingCollection)
                 , EmbeddingProcessingCollection(fullModel.EmbeddingProcessingCollection)
-            {}
+            {
+                if (TSingleDocFloatEvaluator::IsApplicable(*ModelTrees)) {
+                    SingleDocEvaluator = MakeAtomicShared<TSingleDocFloatEvaluator>(*ModelTrees);
+                }
+            }
 
             void SetPredictionType(EPredictionType type) override {
                 PredictionType = type;
@@ -102,6 +107,10 @@ namespace NCB::NModelEvaluation {
                 ExtFeatureLayout = featureLayout;
             }
 
+            const TFeatureLayout* GetFeatureLayout() const override {
+                return ExtFeatureLayout.Get();
+            }
+
             size_t GetTreeCount() const {
                 return ModelTrees->GetTreeCount();
             }
@@ -245,6 +254,21 @@ namespace NCB::NModelEvaluation {
                     ModelTrees->GetFlatFeatureVectorExpectedSize() <= features.size(),
                     "Not enough features provided"
                 );
+                if (SingleDocEvaluator && !featureInfo) {
+                    TEvalResultProcessor resultProcessor(
+                        1,
+                        results,
+                        PredictionType,
+                        ModelTrees->GetScaleAndBias(),
+                        ModelTrees->GetDimensionsCount(),
+                        1
+                    );
+                    auto rawResults = resultProcessor.GetViewForRawEvaluation(0);
+                    Fill(rawResults.begin(), rawResults.end(), 0.0);
+                    SingleDocEvaluator->CalcRaw(*ModelTrees, features, treeStart, treeEnd, rawResults);
+                    resultProcessor.PostprocessBlock(0, treeStart);
+                    return;
+                }
                 CalcGeneric(
                     *ModelTrees,
                     *ApplyData,
@@ -674,6 +698,7 @@ namespace NCB::NModelEvaluation {
             const TIntrusivePtr<TEmbeddingProcessingCollection> EmbeddingProcessingCollection;
             EPredictionType PredictionType = EPredictionType::RawFormulaVal;
             TMaybe<TFeatureLayout> ExtFeatureLayout;
+            TAtomicSharedPtr<const TSingleDocFloatEvaluator> SingleDocEvaluator;
         };
     }
 
@@ -10,6 +10,7 @@
 
 #include <util/generic/array_ref.h>
 #include <util/generic/hash.h>
+#include <util/generic/maybe.h>
 #include <util/generic/ymath.h>
 
 namespace NCB::NModelEvaluation {
@@ -279,7 +280,8 @@ namespace NCB::NModelEvaluation {
         TArrayRef<ui32> transposedHash,
         TArrayRef<float> ctrs,
         TArrayRef<float> estimatedFeatures,
-        const TFeatureLayout* featureInfo = nullptr
+        const TFeatureLayout* featureInfo = nullptr,
+        TTextProcessingBlockBuffers* textProcessingBuffers = nullptr
     ) {
         const auto fullDocCount = end - start;
         auto result = *(cpuEvaluatorQuantizedData->QuantizedData);
@@ -291,6 +293,27 @@ namespace NCB::NModelEvaluation {
         cpuEvaluatorQuantizedData->ObjectsCount = fullDocCount;
         ui8* resultPtr = result.data();
         std::fill(result.begin(), result.begin() + expectedQuantizedFeaturesLen, 0);
+
+        TVector<ui32> textFeatureIds;
+        THashMap<ui32, ui32> textFeatureIdToFlatIndex;
+        TMaybe<TTextProcessingBlockBuffers> localTextProcessingBuffers;
+        if (applyData.UsedTextFeaturesCount > 0 && applyData.UsedEstimatedFeaturesCount > 0) {
+            for (const auto& textFeature : trees.GetTextFeatures()) {
+                if (!textFeature.UsedInModel()) {
+                    continue;
+                }
+                TFeaturePosition position = textFeature.Position;
+                if (featureInfo) {
+                    position = featureInfo->GetRemappedPosition(textFeature);
+                }
+                textFeatureIds.push_back(position.Index);
+                textFeatureIdToFlatIndex[position.Index] = position.FlatIndex;
+            }
+            if (!textProcessingBuffers) {
+                textProcessingBuffers = &localTextProcessingBuffers.ConstructInPlace();
+            }
+        }
+
         for (; start < end; start += FORMULA_EVALUATION_BLOCK_SIZE) {
             ui8* resultPtrForBlockStart = resultPtr;
             ++cpuEvaluatorQuantizedData->BlocksCount;
@@ -346,40 +369,21 @@ namespace NCB::NModelEvaluation {
                     "Fail to apply with text features: TextProcessingCollection must present in FullModel"
                 );
 
-                TVector<TStringBuf> texts;
-                texts.yresize(docCount);
-
-                {
-                    TVector<ui32> textFeatureIds;
-                    THashMap<ui32, ui32> textFeatureIdToFlatIndex;
-                    // TODO(d-kruchinin) Check out how index recalculation affects the speed
-                    for (const auto& textFeature : trees.GetTextFeatures()) {
-                        if (!textFeature.UsedInModel()) {
-                            continue;
-                        }
-                        TFeaturePosition position = textFeature.Position;
-                        if (featureInfo) {
-                            position = featureInfo->GetRemappedPosition(textFeature);
-                        }
-                        textFeatureIds.push_back(position.Index);
-                        textFeatureIdToFlatIndex[position.Index] = position.FlatIndex;
-                    }
-
-                    textProcessingCollection->CalcFeatures(
-                        [start, &textFeatureAccessor, &textFeatureIdToFlatIndex](ui32 textFeatureId, ui32 docId) {
-                            return textFeatureAccessor(
-                                TFeaturePosition{
-                                    SafeIntegerCast<int>(textFeatureId),
-                                    SafeIntegerCast<int>(textFeatureIdToFlatIndex[textFeatureId])
-                                },
-                                start + docId
-                            );
-                        },
-                        MakeConstArrayRef(textFeatureIds),
-                        docCount,
-                        estimatedFeatures
-                    );
-                }
+                textProcessingCollection->CalcFeatures(
+                    [start, &textFeatureAccessor, &textFeatureIdToFlatIndex](ui32 textFeatureId, ui32 docId) {
+                        return textFeatureAccessor(
+                            TFeaturePosition{
+                                SafeIntegerCast<int>(textFeatureId),
+                                SafeIntegerCast<int>(textFeatureIdToFlatIndex.at(textFeatureId))
+                            },
+                            start + docId
+                        );
+                    },
+                    MakeConstArrayRef(textFeatureIds),
+                    docCount,
+                    estimatedFeatures,
+                    textProcessingBuffers
+                );
 
                 for (const auto& estimatedFeature : trees.GetEstimatedFeatures()) {
                     if (estimatedFeature.ModelEstimatedFeature.SourceFeatureType != EEstimatedSourceFeatureType::Text) {
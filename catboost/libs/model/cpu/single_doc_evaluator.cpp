@@ -0,0 +1,168 @@
+#include "single_doc_evaluator.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace NCB::NModelEvaluation {
+    bool TSingleDocFloatEvaluator::IsApplicable(const TModelTrees& trees) {
+        if (!trees.IsOblivious() || trees.GetTreeCount() == 0) {
+            return false;
+        }
+        const auto applyData = trees.GetApplyData();
+        return applyData->UsedCatFeaturesCount == 0
+            && applyData->UsedTextFeaturesCount == 0
+            && applyData->UsedEmbeddingFeaturesCount == 0
+            && applyData->UsedEstimatedFeaturesCount == 0
+            && applyData->UsedModelCtrs.empty()
+            && trees.GetOneHotFeatures().empty();
+    }
+
+    TSingleDocFloatEvaluator::TSingleDocFloatEvaluator(const TModelTrees& trees) {
+        CB_ENSURE_INTERNAL(IsApplicable(trees), "Single document evaluator is not applicable to this model");
+
+        BucketCount = trees.GetEffectiveBinaryFeaturesBucketsCount();
+        TVector<bool> isBucketUsed(BucketCount, false);
+        for (const auto& split : trees.GetRepackedBins()) {
+            isBucketUsed[split.FeatureIndex] = true;
+        }
+
+        // float features occupy the first buckets in the same order as in quantization.h
+        const float infinity = std::numeric_limits<float>::infinity();
+        ui32 bucketIndex = 0;
+        for (const auto& floatFeature : trees.GetFloatFeatures()) {
+            if (!floatFeature.UsedInModel()) {
+                continue;
+            }
+            const auto& featureBorders = floatFeature.Borders;
+            for (size_t chunkStart = 0; chunkStart < featureBorders.size(); chunkStart += MAX_VALUES_PER_BIN, ++bucketIndex) {
+                if (!isBucketUsed[bucketIndex]) {
+                    continue;
+                }
+                const size_t chunkEnd = Min(chunkStart + MAX_VALUES_PER_BIN, featureBorders.size());
+                TUsedBucket& bucket = UsedBuckets.emplace_back();
+                bucket.BucketIndex = bucketIndex;
+                bucket.FlatFeatureIndex = floatFeature.Position.FlatIndex;
+                bucket.BordersBegin = Borders.size();
+                Borders.insert(Borders.end(), featureBorders.begin() + chunkStart, featureBorders.begin() + chunkEnd);
+                bucket.BordersEnd = Borders.size();
+                if (floatFeature.HasNans) {
+                    if (floatFeature.NanValueTreatment == TFloatFeature::ENanValueTreatment::AsFalse) {
+                        bucket.SubstituteNan = true;
+                        bucket.NanSubstitution = -infinity;
+                    } else if (floatFeature.NanValueTreatment == TFloatFeature::ENanValueTreatment::AsTrue) {
+                        bucket.SubstituteNan = true;
+                        bucket.NanSubstitution = infinity;
+                    }
+                }
+            }
+        }
+        CB_ENSURE_INTERNAL(bucketIndex == BucketCount, "Unexpected binary features bucket count");
+    }
+
+    template <int Depth>
+    static Y_FORCE_INLINE TCalcerIndexType CalcLeafIndex(const ui8* __restrict bins, const TRepackedBin* __restrict splits) {
+        TCalcerIndexType index = 0;
+        // trip count is known at compile time, so the loop is fully unrolled
+        for (int depth = 0; depth < Depth; ++depth) {
+            index |= (bins[splits[depth].FeatureIndex] >= splits[depth].SplitIdx) << depth;
+        }
+        return index;
+    }
+
+    static Y_FORCE_INLINE TCalcerIndexType CalcLeafIndex(
+        const ui8* __restrict bins,
+        const TRepackedBin* __restrict splits,
+        int treeSize
+    ) {
+        TCalcerIndexType index = 0;
+        for (int depth = 0; depth < treeSize; ++depth) {
+            index |= (bins[splits[depth].FeatureIndex] >= splits[depth].SplitIdx) << depth;
+        }
+        return index;
+    }
+
+    template <bool IsSingleClassModel>
+    static void CalcObliviousTrees(
+        const TModelTrees& trees,
+        const ui8* __restrict bins,
+        size_t treeStart,
+        size_t treeEnd,
+        double* __restrict results
+    ) {
+        const auto treeSizes = trees.GetModelTreeData()->GetTreeSizes();
+        const size_t dimension = trees.GetDimensionsCount();
+        const TRepackedBin* treeSplitsPtr =
+            trees.GetRepackedBins().data() + trees.GetModelTreeData()->GetTreeStartOffsets()[treeStart];
+        const double* treeLeafPtr = trees.GetFirstLeafPtrForTree(treeStart);
+        for (size_t treeId = treeStart; treeId < treeEnd; ++treeId) {
+            const int treeSize = treeSizes[treeId];
+            TCalcerIndexType index;
+            switch (treeSize) {
+                case 1: index = CalcLeafIndex<1>(bins, treeSplitsPtr); break;
+                case 2: index = CalcLeafIndex<2>(bins, treeSplitsPtr); break;
+                case 3: index = CalcLeafIndex<3>(bins, treeSplitsPtr); break;
+                case 4: index = CalcLeafIndex<4>(bins, treeSplitsPtr); break;
+                case 5: index = CalcLeafIndex<5>(bins, treeSplitsPtr); break;
+                case 6: index = CalcLeafIndex<6>(bins, treeSplitsPtr); break;
+                case 7: index = CalcLeafIndex<7>(bins, treeSplitsPtr); break;
+                case 8: index = CalcLeafIndex<8>(bins, treeSplitsPtr); break;
+                default: index = CalcLeafIndex(bins, treeSplitsPtr, treeSize);
+            }
+            if constexpr (IsSingleClassModel) {
+                results[0] += treeLeafPtr[index];
+            } else {
+                const double* leafValuePtr = treeLeafPtr + index * dimension;
+                for (size_t dim = 0; dim < dimension; ++dim) {
+                    results[dim] += leafValuePtr[dim];
+                }
+            }
+            treeLeafPtr += (1ull << treeSize) * dimension;
+            treeSplitsPtr += treeSize;
+        }
+    }
+
+    void TSingleDocFloatEvaluator::CalcRaw(
+        const TModelTrees& trees,
+        TConstArrayRef<float> features,
+        size_t treeStart,
+        size_t treeEnd,
+        TArrayRef<double> results
+    ) const {
+        Y_ASSERT(results.size() == trees.GetDimensionsCount());
+        if (treeStart >= treeEnd) {
+            return;
+        }
+
+        // reused between calls, so steady state evaluation does not allocate
+        static thread_local TVector<ui8> binsBuffer;
+        if (binsBuffer.size() < BucketCount) {
+            binsBuffer.yresize(BucketCount);
+        }
+        ui8* bins = binsBuffer.data();
+        const float* borders = Borders.data();
+        for (const auto& bucket : UsedBuckets) {
+            float value = features[bucket.FlatFeatureIndex];
+            if (bucket.SubstituteNan && std::isnan(value)) {
+                value = bucket.NanSubstitution;
+            }
+            // number of borders less than value, NaN without substitution gets 0 as in BinarizeFloats
+            bins[bucket.BucketIndex] = std::lower_bound(
+                borders + bucket.BordersBegin,
+                borders + bucket.BordersEnd,
+                value
+            ) - (borders + bucket.BordersBegin);
+        }
+
+        if (trees.GetDimensionsCount() == 1) {
+            CalcObliviousTrees<true>(trees, bins, treeStart, treeEnd, results.data());
+        } else {
+            CalcObliviousTrees<false>(trees, bins, treeStart, treeEnd, results.data());
+        }
+    }
+}
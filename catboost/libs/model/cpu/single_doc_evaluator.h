@@ -0,0 +1,49 @@
+#pragma once
+
+#include <catboost/libs/model/model.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+namespace NCB::NModelEvaluation {
+    /**
+     * Latency oriented evaluation of a single object for oblivious models which use only float features.
+     * Everything that depends on the model only is prepared once at construction: a call binarizes
+     * just the buckets referenced by tree splits (binary search over borders instead of a full scan)
+     * into a per-thread buffer and walks trees with depth specialized code.
+     */
+    class TSingleDocFloatEvaluator {
+    public:
+        static bool IsApplicable(const TModelTrees& trees);
+
+        explicit TSingleDocFloatEvaluator(const TModelTrees& trees);
+
+        /**
+         * Adds raw approxes of trees [treeStart, treeEnd) to results (of size trees.GetDimensionsCount()).
+         * trees must be the same object the evaluator was built from.
+         */
+        void CalcRaw(
+            const TModelTrees& trees,
+            TConstArrayRef<float> features,
+            size_t treeStart,
+            size_t treeEnd,
+            TArrayRef<double> results
+        ) const;
+
+    private:
+        struct TUsedBucket {
+            ui32 BucketIndex = 0;
+            ui32 FlatFeatureIndex = 0;
+            ui32 BordersBegin = 0;
+            ui32 BordersEnd = 0;
+            bool SubstituteNan = false;
+            float NanSubstitution = 0.0f;
+        };
+
+    private:
+        ui32 BucketCount = 0;
+        TVector<TUsedBucket> UsedBuckets;
+        TVector<float> Borders;
+    };
+}
@@ -85,6 +85,10 @@ namespace NCB::NModelEvaluation {
                 ExtFeatureLayout = featureLayout;
             }
 
+            const TFeatureLayout* GetFeatureLayout() const override {
+                return ExtFeatureLayout.Get();
+            }
+
             size_t GetTreeCount() const override {
                 return ModelTrees->GetTreeCount();
             }
@@ -78,6 +78,8 @@ namespace NCB {  // split due to CUDA-compiler inability to parse nested namespa
             virtual size_t GetTreeCount() const = 0;
 
             virtual void SetFeatureLayout(const TFeatureLayout& featureLayout) = 0;
+            // nullptr if features are read at their model positions
+            virtual const TFeatureLayout* GetFeatureLayout() const = 0;
 
             virtual void SetProperty(const TStringBuf propName, const TStringBuf propValue) = 0;
 
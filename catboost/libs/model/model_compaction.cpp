@@ -0,0 +1,203 @@
+#include "model_compaction.h"
+
+#include "model_build_helper.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/map.h>
+#include <util/generic/maybe.h>
+#include <util/generic/xrange.h>
+
+
+namespace {
+    struct TObliviousTreeData {
+        TVector<TModelSplit> Splits;
+        TVector<double> LeafValues; // [leafIdx * approxDimension + dim]
+        TVector<double> LeafWeights; // [leafIdx], empty if model has no leaf weights
+    };
+}
+
+static TVector<TObliviousTreeData> GetTrees(const TModelTrees& trees) {
+    const auto& data = trees.GetModelTreeData();
+    const auto& binFeatures = trees.GetBinFeatures();
+    const auto& leafOffsets = trees.GetApplyData()->TreeFirstLeafOffsets;
+    const size_t approxDimension = trees.GetDimensionsCount();
+    const bool hasLeafWeights = !data->GetLeafWeights().empty();
+
+    TVector<TObliviousTreeData> result(trees.GetTreeCount());
+    for (auto treeIdx : xrange(result.size())) {
+        auto& tree = result[treeIdx];
+        const int treeSize = data->GetTreeSizes()[treeIdx];
+        const int treeStart = data->GetTreeStartOffsets()[treeIdx];
+        for (auto splitIdx : xrange(treeStart, treeStart + treeSize)) {
+            tree.Splits.push_back(binFeatures[data->GetTreeSplits()[splitIdx]]);
+        }
+        const size_t leafCount = size_t(1) << treeSize;
+        const auto leafValuesBegin = data->GetLeafValues().begin() + leafOffsets[treeIdx];
+        tree.LeafValues.assign(leafValuesBegin, leafValuesBegin + leafCount * approxDimension);
+        if (hasLeafWeights) {
+            const auto leafWeightsBegin = data->GetLeafWeights().begin() + leafOffsets[treeIdx] / approxDimension;
+            tree.LeafWeights.assign(leafWeightsBegin, leafWeightsBegin + leafCount);
+        }
+    }
+    return result;
+}
+
+/* Removes split at depth. If sameSplitDepth (< depth) is defined, the split at depth repeats it and only
+ * leaves with equal bits at both depths are reachable, otherwise leaves differing in the bit at depth
+ * have equal values and their weights are summed.
+ */
+static void RemoveSplit(size_t depth, TMaybe<size_t> sameSplitDepth, size_t approxDimension, TObliviousTreeData* tree) {
+    Y_ASSERT(!sameSplitDepth || *sameSplitDepth < depth);
+    const size_t newLeafCount = size_t(1) << (tree->Splits.size() - 1);
+    const size_t lowBitsMask = (size_t(1) << depth) - 1;
+
+    TVector<double> leafValues(newLeafCount * approxDimension);
+    TVector<double> leafWeights(tree->LeafWeights.empty() ? 0 : newLeafCount);
+    for (auto newLeaf : xrange(newLeafCount)) {
+        const size_t removedBit = sameSplitDepth ? ((newLeaf >> *sameSplitDepth) & 1) : 0;
+        const size_t oldLeaf = ((newLeaf & ~lowBitsMask) << 1) | (removedBit << depth) | (newLeaf & lowBitsMask);
+        Copy(
+            tree->LeafValues.begin() + oldLeaf * approxDimension,
+            tree->LeafValues.begin() + (oldLeaf + 1) * approxDimension,
+            leafValues.begin() + newLeaf * approxDimension);
+        if (!leafWeights.empty()) {
+            leafWeights[newLeaf] = tree->LeafWeights[oldLeaf];
+            if (!sameSplitDepth) {
+                leafWeights[newLeaf] += tree->LeafWeights[oldLeaf ^ (size_t(1) << depth)];
+            }
+        }
+    }
+    tree->Splits.erase(tree->Splits.begin() + depth);
+    tree->LeafValues = std::move(leafValues);
+    tree->LeafWeights = std::move(leafWeights);
+}
+
+static bool IsDeadSplit(const TObliviousTreeData& tree, size_t depth, size_t approxDimension) {
+    const size_t depthBit = size_t(1) << depth;
+    for (auto leaf : xrange(size_t(1) << tree.Splits.size())) {
+        if (leaf & depthBit) {
+            continue;
+        }
+        for (auto dim : xrange(approxDimension)) {
+            if (tree.LeafValues[leaf * approxDimension + dim] != tree.LeafValues[(leaf | depthBit) * approxDimension + dim]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// returns count of removed splits
+static size_t PruneSplits(size_t approxDimension, TObliviousTreeData* tree) {
+    size_t prunedCount = 0;
+    // removal of a repeated split drops unreachable leaves, so other splits can become dead
+    for (bool pruned = true; pruned;) {
+        pruned = false;
+        for (size_t depth = tree->Splits.size(); depth-- > 0;) {
+            const auto sameSplit = Find(tree->Splits.begin(), tree->Splits.begin() + depth, tree->Splits[depth]);
+            if (sameSplit != tree->Splits.begin() + depth) {
+                RemoveSplit(depth, sameSplit - tree->Splits.begin(), approxDimension, tree);
+                pruned = true;
+            } else if (IsDeadSplit(*tree, depth, approxDimension)) {
+                RemoveSplit(depth, Nothing(), approxDimension, tree);
+                pruned = true;
+            } else {
+                continue;
+            }
+            ++prunedCount;
+        }
+    }
+    return prunedCount;
+}
+
+static void SortSplits(size_t approxDimension, TObliviousTreeData* tree) {
+    const size_t depth = tree->Splits.size();
+    TVector<size_t> order(depth);
+    Iota(order.begin(), order.end(), 0);
+    StableSortBy(order, [&] (size_t splitIdx) { return tree->Splits[splitIdx]; });
+    if (IsSorted(order.begin(), order.end())) {
+        return;
+    }
+
+    TObliviousTreeData sorted;
+    for (auto splitIdx : order) {
+        sorted.Splits.push_back(tree->Splits[splitIdx]);
+    }
+    const size_t leafCount = size_t(1) << depth;
+    sorted.LeafValues.yresize(tree->LeafValues.size());
+    sorted.LeafWeights.yresize(tree->LeafWeights.size());
+    for (auto newLeaf : xrange(leafCount)) {
+        size_t oldLeaf = 0;
+        for (auto newDepth : xrange(depth)) {
+            oldLeaf |= ((newLeaf >> newDepth) & 1) << order[newDepth];
+        }
+        Copy(
+            tree->LeafValues.begin() + oldLeaf * approxDimension,
+            tree->LeafValues.begin() + (oldLeaf + 1) * approxDimension,
+            sorted.LeafValues.begin() + newLeaf * approxDimension);
+        if (!tree->LeafWeights.empty()) {
+            sorted.LeafWeights[newLeaf] = tree->LeafWeights[oldLeaf];
+        }
+    }
+    *tree = std::move(sorted);
+}
+
+TModelCompactionStats CompactModel(bool mergeTrees, TFullModel* model) {
+    const TModelTrees& modelTrees = *model->ModelTrees;
+    //TODO: support non symmetric trees
+    CB_ENSURE(modelTrees.IsOblivious(), "Model compaction is supported only for symmetric trees");
+    const size_t approxDimension = modelTrees.GetDimensionsCount();
+
+    TModelCompactionStats stats;
+    stats.TreeCountBefore = modelTrees.GetTreeCount();
+    stats.SplitCountBefore = modelTrees.GetModelTreeData()->GetTreeSplits().size();
+
+    TVector<TObliviousTreeData> trees = GetTrees(modelTrees);
+    TVector<TObliviousTreeData> compactedTrees;
+    TMap<TVector<TModelSplit>, size_t> treeIdxBySplits;
+    for (auto& tree : trees) {
+        stats.PrunedSplitCount += PruneSplits(approxDimension, &tree);
+        SortSplits(approxDimension, &tree);
+        if (mergeTrees) {
+            const auto [it, inserted] = treeIdxBySplits.emplace(tree.Splits, compactedTrees.size());
+            if (!inserted) {
+                auto& mergedLeafValues = compactedTrees[it->second].LeafValues;
+                for (auto idx : xrange(mergedLeafValues.size())) {
+                    mergedLeafValues[idx] += tree.LeafValues[idx];
+                }
+                ++stats.MergedTreeCount;
+                continue;
+            }
+        }
+        compactedTrees.push_back(std::move(tree));
+    }
+
+    TObliviousTreeBuilder builder(
+        TVector<TFloatFeature>(modelTrees.GetFloatFeatures().begin(), modelTrees.GetFloatFeatures().end()),
+        TVector<TCatFeature>(modelTrees.GetCatFeatures().begin(), modelTrees.GetCatFeatures().end()),
+        TVector<TTextFeature>(modelTrees.GetTextFeatures().begin(), modelTrees.GetTextFeatures().end()),
+        TVector<TEmbeddingFeature>(modelTrees.GetEmbeddingFeatures().begin(), modelTrees.GetEmbeddingFeatures().end()),
+        approxDimension);
+    for (const auto& tree : compactedTrees) {
+        if (AllOf(tree.LeafValues, [] (double value) { return value == 0.0; })) {
+            ++stats.DroppedZeroTreeCount;
+            continue;
+        }
+        builder.AddTree(tree.Splits, tree.LeafValues, tree.LeafWeights);
+        stats.SplitCountAfter += tree.Splits.size();
+    }
+    const auto scaleAndBias = model->GetScaleAndBias();
+    builder.Build(model->ModelTrees.GetMutable());
+    model->SetScaleAndBias(scaleAndBias);
+    model->UpdateDynamicData();
+    if (model->CtrProvider) {
+        // the provider can be shared with copies of the model, they still need all the tables
+        model->CtrProvider = model->CtrProvider->Clone();
+        model->CtrProvider->DropUnusedTables(model->ModelTrees->GetApplyData()->GetUsedModelCtrBases());
+        model->UpdateDynamicData();
+    }
+    stats.TreeCountAfter = model->GetTreeCount();
+    return stats;
+}
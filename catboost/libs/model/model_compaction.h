@@ -0,0 +1,31 @@
+#pragma once
+
+#include "model.h"
+
+#include <util/system/types.h>
+
+
+struct TModelCompactionStats {
+    size_t TreeCountBefore = 0;
+    size_t TreeCountAfter = 0;
+    size_t SplitCountBefore = 0;
+    size_t SplitCountAfter = 0;
+
+    //! Splits that don't change leaf values or repeat another split of the same tree
+    size_t PrunedSplitCount = 0;
+    //! Trees added to a preceding tree with the same set of splits
+    size_t MergedTreeCount = 0;
+    //! Trees with all leaf values equal to zero
+    size_t DroppedZeroTreeCount = 0;
+};
+
+/**
+ * Compacts symmetric trees of the model:
+ *  - removes splits whose leaf pairs have equal values and splits repeated in a tree,
+ *  - sorts splits of every tree and, if mergeTrees is set, merges trees with the same splits by summing their leaves,
+ *  - drops trees with zero leaf values.
+ * Predictions are bit-exact without tree merging, merging changes the order of floating point additions.
+ * Leaf weights of merged trees are taken from the first of them (they are the same for trees of the same
+ * structure built on the same learn data).
+ */
+TModelCompactionStats CompactModel(bool mergeTrees, TFullModel* model);
@@ -0,0 +1,80 @@
+#include "model_reordering.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+
+
+void ReorderModelForCacheLocality(bool reorderTrees, TFullModel* model) {
+    const TModelTrees& trees = *model->ModelTrees;
+    //TODO: support non symmetric trees
+    CB_ENSURE(trees.IsOblivious(), "Cache locality reordering is supported only for symmetric trees");
+    const size_t approxDimension = trees.GetDimensionsCount();
+    const size_t treeCount = trees.GetTreeCount();
+    const auto treeSplits = trees.GetModelTreeData()->GetTreeSplits();
+    const auto treeSizes = trees.GetModelTreeData()->GetTreeSizes();
+    const auto treeStartOffsets = trees.GetModelTreeData()->GetTreeStartOffsets();
+    const auto leafValues = trees.GetModelTreeData()->GetLeafValues();
+    const auto leafWeights = trees.GetModelTreeData()->GetLeafWeights();
+    const auto& leafOffsets = trees.GetApplyData()->TreeFirstLeafOffsets;
+
+    // binary features are enumerated bucket by bucket, so their order is the order of buckets in quantized data
+    TVector<TVector<int>> splitOrders(treeCount); // [treeIdx][newDepth] -> depth
+    TVector<TVector<int>> sortedSplits(treeCount);
+    for (auto treeIdx : xrange(treeCount)) {
+        const auto splits = treeSplits.subspan(treeStartOffsets[treeIdx], treeSizes[treeIdx]);
+        auto& order = splitOrders[treeIdx];
+        order.resize(splits.size());
+        Iota(order.begin(), order.end(), 0);
+        StableSortBy(order, [&] (int depth) { return splits[depth]; });
+        for (auto depth : order) {
+            sortedSplits[treeIdx].push_back(splits[depth]);
+        }
+    }
+
+    TVector<size_t> treeOrder(treeCount);
+    Iota(treeOrder.begin(), treeOrder.end(), 0);
+    if (reorderTrees) {
+        StableSort(
+            treeOrder,
+            [&] (size_t lhs, size_t rhs) { return sortedSplits[lhs] < sortedSplits[rhs]; });
+    }
+
+    TVector<int> newTreeSplits;
+    TVector<int> newTreeSizes;
+    TVector<int> newTreeStartOffsets;
+    TVector<double> newLeafValues;
+    TVector<double> newLeafWeights;
+    newTreeSplits.reserve(treeSplits.size());
+    newLeafValues.reserve(leafValues.size());
+    newLeafWeights.reserve(leafWeights.size());
+    for (auto treeIdx : treeOrder) {
+        const auto& order = splitOrders[treeIdx];
+        newTreeStartOffsets.push_back(newTreeSplits.size());
+        newTreeSizes.push_back(treeSizes[treeIdx]);
+        newTreeSplits.insert(newTreeSplits.end(), sortedSplits[treeIdx].begin(), sortedSplits[treeIdx].end());
+        for (auto newLeaf : xrange(size_t(1) << order.size())) {
+            size_t oldLeaf = 0;
+            for (auto newDepth : xrange(order.size())) {
+                oldLeaf |= ((newLeaf >> newDepth) & 1) << order[newDepth];
+            }
+            const size_t oldLeafOffset = leafOffsets[treeIdx] + oldLeaf * approxDimension;
+            newLeafValues.insert(
+                newLeafValues.end(),
+                leafValues.begin() + oldLeafOffset,
+                leafValues.begin() + oldLeafOffset + approxDimension);
+            if (!leafWeights.empty()) {
+                newLeafWeights.push_back(leafWeights[oldLeafOffset / approxDimension]);
+            }
+        }
+    }
+
+    TModelTrees* mutableTrees = model->ModelTrees.GetMutable();
+    mutableTrees->SetTreeSplits(newTreeSplits);
+    mutableTrees->SetTreeSizes(newTreeSizes);
+    mutableTrees->SetTreeStartOffsets(newTreeStartOffsets);
+    mutableTrees->SetLeafValues(newLeafValues);
+    mutableTrees->SetLeafWeights(newLeafWeights);
+    model->UpdateDynamicData();
+}
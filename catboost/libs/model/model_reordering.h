@@ -0,0 +1,15 @@
+#pragma once
+
+#include "model.h"
+
+
+/**
+ * Reorders symmetric trees of the model for better cache locality of the quantized data
+ * (TCPUEvaluatorQuantizedData stores a row of bytes per binary features bucket):
+ *  - splits of every tree are sorted by their bucket, so a tree reads bucket rows in the increasing address order,
+ *    leaves are permuted accordingly and predictions don't change,
+ *  - if reorderTrees is set, trees are sorted by their sorted sets of binary features, so trees sharing
+ *    the first buckets are evaluated one after another. This changes the order of leaf values summation.
+ * Buckets themselves are laid out in the features order by the quantizer, so they are not reordered.
+ */
+void ReorderModelForCacheLocality(bool reorderTrees, TFullModel* model);
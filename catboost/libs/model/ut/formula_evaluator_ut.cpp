@@ -143,6 +143,33 @@ Y_UNIT_TEST_SUITE(TObliviousTreeModel) {
         CheckFlatCalcResult(model, expectedPredicts, xrange(4), features);
     }
 
+    Y_UNIT_TEST(TestFlatCalcSingleMatchesBatch) {
+        const auto model = TrainFloatCatboostModel(20);
+        const auto& floatFeatures = model.ModelTrees->GetFloatFeatures();
+        TVector<TVector<float>> data;
+        for (const auto& floatFeature : floatFeatures) {
+            for (float border : floatFeature.Borders) {
+                TVector<float> sample(floatFeatures.size(), 0.5f);
+                sample[floatFeature.Position.FlatIndex] = border;
+                data.push_back(sample);
+                sample[floatFeature.Position.FlatIndex] = std::nextafter(border, 2.0f);
+                data.push_back(std::move(sample));
+            }
+            TVector<float> sample(floatFeatures.size(), 0.5f);
+            sample[floatFeature.Position.FlatIndex] = std::numeric_limits<float>::quiet_NaN();
+            data.push_back(std::move(sample));
+        }
+        const auto features = GetFeatureRef(data);
+
+        TVector<double> predicts(features.size());
+        model.CalcFlat(features, predicts);
+        for (size_t sampleIndex : xrange(features.size())) {
+            TVector<double> samplePredict(1);
+            model.CalcFlatSingle(features[sampleIndex], samplePredict);
+            UNIT_ASSERT_VALUES_EQUAL(predicts[sampleIndex], samplePredict[0]);
+        }
+    }
+
     Y_UNIT_TEST(TestCatOnlyModel) {
         const auto model = TrainCatOnlyModel();
 
@@ -161,6 +188,25 @@ Y_UNIT_TEST_SUITE(TObliviousTreeModel) {
         UNIT_ASSERT_NO_EXCEPTION(applyBatch());
     }
 
+    Y_UNIT_TEST(TestCatOnlyModelWithBlockBuffersScope) {
+        const auto model = TrainCatOnlyModel();
+        const TVector<TStringBuf> f[] = {{"a", "b", "c"}, {"d", "e", "f"}, {"g", "h", "k"}};
+        TVector<double> expectedResults(3);
+        model.Calc({}, f, expectedResults);
+
+        TEvaluatorBlockBuffers buffers;
+        const TEvaluatorBlockBuffersScope buffersScope(&buffers);
+        UNIT_ASSERT_EQUAL(TEvaluatorBlockBuffersScope::GetCurrent(), &buffers);
+        for (auto iteration : xrange(2)) {
+            Y_UNUSED(iteration);
+            TVector<double> results(3);
+            model.Calc({}, f, results);
+            UNIT_ASSERT_VALUES_EQUAL(results, expectedResults);
+            UNIT_ASSERT(!buffers.TransposedHash.empty());
+            UNIT_ASSERT(!buffers.InUse);
+        }
+    }
+
     static void CheckCalcTextResult(
         const TFullModel& model,
         TConstArrayRef<TVector<TStringBuf>> transposedTextFeatures,
@@ -0,0 +1,144 @@
+#include <catboost/libs/model/ut/lib/model_test_helpers.h>
+
+#include <catboost/libs/model/model_compaction.h>
+#include <catboost/private/libs/algo/apply.h>
+#include <catboost/libs/train_lib/train_model.h>
+
+#include <library/cpp/testing/unittest/registar.h>
+
+using namespace NCB;
+
+
+static TFullModel ThreeFloatFeaturesModel(const TVector<std::pair<TVector<int>, TVector<double>>>& binTrees) {
+    TFullModel model;
+    TModelTrees* trees = model.ModelTrees.GetMutable();
+    trees->SetFloatFeatures(
+        {
+            TFloatFeature{false, 0, 0, {0.5f}, ""}, // bin split 0
+            TFloatFeature{false, 1, 1, {0.5f}, ""}, // bin split 1
+            TFloatFeature{false, 2, 2, {0.5f}, ""}  // bin split 2
+        }
+    );
+    for (const auto& [splits, leafValues] : binTrees) {
+        trees->AddBinTree(splits);
+        for (auto leafValue : leafValues) {
+            trees->AddLeafValue(leafValue);
+        }
+    }
+    model.UpdateDynamicData();
+    return model;
+}
+
+static TVector<double> CalcOnAllBins(const TFullModel& model) {
+    TVector<TVector<float>> data;
+    for (ui32 mask : xrange(8)) {
+        data.push_back({float(mask & 1), float((mask >> 1) & 1), float((mask >> 2) & 1)});
+    }
+    TVector<TConstArrayRef<float>> features(data.begin(), data.end());
+    TVector<double> predictions(data.size());
+    model.CalcFlat(features, predictions);
+    return predictions;
+}
+
+Y_UNIT_TEST_SUITE(TModelCompaction) {
+    Y_UNIT_TEST(TestRedundantTrees) {
+        TFullModel model = ThreeFloatFeaturesModel({
+            {{0, 1}, {1.0, 2.0, 1.0, 2.0}}, // split 1 is dead
+            {{1, 0}, {3.0, 4.0, 5.0, 6.0}},
+            {{0}, {10.0, 20.0}}, // merged with the first tree
+            {{2}, {0.0, 0.0}}, // dead split, becomes a constant tree
+            {{0, 1, 0}, {0.25, 0.5, 0.75, 1.0, 1.25, 1.5, 1.75, 2.0}}, // repeated split, merged with the second tree
+            {{0, 1}, {0.5, 0.5, 0.5, 0.5}} // both splits are dead, merged with the fourth tree
+        });
+        const auto expectedPredictions = CalcOnAllBins(model);
+
+        const auto stats = CompactModel(/*mergeTrees*/ true, &model);
+        UNIT_ASSERT_VALUES_EQUAL(stats.TreeCountBefore, 6);
+        UNIT_ASSERT_VALUES_EQUAL(stats.SplitCountBefore, 11);
+        UNIT_ASSERT_VALUES_EQUAL(stats.PrunedSplitCount, 5);
+        UNIT_ASSERT_VALUES_EQUAL(stats.MergedTreeCount, 3);
+        UNIT_ASSERT_VALUES_EQUAL(stats.DroppedZeroTreeCount, 0);
+        UNIT_ASSERT_VALUES_EQUAL(stats.TreeCountAfter, 3);
+        UNIT_ASSERT_VALUES_EQUAL(stats.SplitCountAfter, 3);
+        UNIT_ASSERT_VALUES_EQUAL(model.GetTreeCount(), 3);
+
+        const auto predictions = CalcOnAllBins(model);
+        for (auto idx : xrange(predictions.size())) {
+            UNIT_ASSERT_DOUBLES_EQUAL(predictions[idx], expectedPredictions[idx], 1e-12);
+        }
+    }
+
+    Y_UNIT_TEST(TestZeroTrees) {
+        TFullModel model = ThreeFloatFeaturesModel({
+            {{0}, {1.0, 2.0}},
+            {{1, 2}, {0.0, 0.0, 0.0, 0.0}}
+        });
+        const auto expectedPredictions = CalcOnAllBins(model);
+
+        const auto stats = CompactModel(/*mergeTrees*/ false, &model);
+        UNIT_ASSERT_VALUES_EQUAL(stats.PrunedSplitCount, 2);
+        UNIT_ASSERT_VALUES_EQUAL(stats.MergedTreeCount, 0);
+        UNIT_ASSERT_VALUES_EQUAL(stats.DroppedZeroTreeCount, 1);
+        UNIT_ASSERT_VALUES_EQUAL(stats.TreeCountAfter, 1);
+        UNIT_ASSERT_VALUES_EQUAL(CalcOnAllBins(model), expectedPredictions);
+    }
+
+    Y_UNIT_TEST(TestTrainedModel) {
+        NJson::TJsonValue params;
+        params.InsertValue("learning_rate", 0.01);
+        params.InsertValue("iterations", 100);
+        params.InsertValue("depth", 4);
+        params.InsertValue("random_seed", 1);
+        TFullModel model;
+        TEvalResult evalResult;
+
+        TDataProviderPtr pool = GetAdultPool();
+        TrainModel(
+            params,
+            nullptr,
+            Nothing(),
+            Nothing(),
+            TDataProviders{pool, {pool}},
+            /*initModel*/ Nothing(),
+            /*initLearnProgress*/ nullptr,
+            "",
+            &model,
+            {&evalResult});
+        const auto expectedPredictions = ApplyModelMulti(model, *pool->ObjectsData)[0];
+
+        TFullModel exactModel = model;
+        CompactModel(/*mergeTrees*/ false, &exactModel);
+        UNIT_ASSERT_VALUES_EQUAL(ApplyModelMulti(exactModel, *pool->ObjectsData)[0], expectedPredictions);
+
+        const auto stats = CompactModel(/*mergeTrees*/ true, &model);
+        UNIT_ASSERT(stats.TreeCountAfter <= stats.TreeCountBefore);
+        const auto predictions = ApplyModelMulti(model, *pool->ObjectsData)[0];
+        UNIT_ASSERT_VALUES_EQUAL(predictions.size(), expectedPredictions.size());
+        for (auto idx : xrange(predictions.size())) {
+            UNIT_ASSERT_DOUBLES_EQUAL(predictions[idx], expectedPredictions[idx], 1e-9);
+        }
+    }
+
+    Y_UNIT_TEST(TestCopyWithCtrsIsNotChanged) {
+        const TFullModel model = TrainCatOnlyNoOneHotModel();
+        UNIT_ASSERT(model.CtrProvider);
+        UNIT_ASSERT(!model.ModelTrees->GetCtrFeatures().empty());
+
+        const TVector<TVector<TStringBuf>> catFeatures = {{"a", "d", "e"}, {"a", "c", "f"}, {"b", "d", "f"}};
+        const TVector<TConstArrayRef<float>> floatFeatures(catFeatures.size());
+        TVector<double> expectedPredictions(catFeatures.size());
+        model.Calc(floatFeatures, catFeatures, expectedPredictions);
+
+        // all trees of the copy are dropped and so are all ctr tables it uses
+        TFullModel compactedModel = model;
+        compactedModel.ModelTrees.GetMutable()->SetLeafValues(
+            TVector<double>(model.ModelTrees->GetModelTreeData()->GetLeafValues().size(), 0.0));
+        compactedModel.UpdateDynamicData();
+        const auto stats = CompactModel(/*mergeTrees*/ false, &compactedModel);
+        UNIT_ASSERT_VALUES_EQUAL(stats.TreeCountAfter, 0);
+
+        TVector<double> predictions(catFeatures.size());
+        model.Calc(floatFeatures, catFeatures, predictions);
+        UNIT_ASSERT_VALUES_EQUAL(predictions, expectedPredictions);
+    }
+}
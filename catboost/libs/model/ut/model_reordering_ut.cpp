@@ -0,0 +1,70 @@
+#include <catboost/libs/model/ut/lib/model_test_helpers.h>
+
+#include <catboost/libs/model/model_reordering.h>
+#include <catboost/private/libs/algo/apply.h>
+#include <catboost/libs/train_lib/train_model.h>
+
+#include <library/cpp/testing/unittest/registar.h>
+
+using namespace NCB;
+
+
+static TFullModel TrainAdultModel(TDataProviderPtr pool) {
+    NJson::TJsonValue params;
+    params.InsertValue("learning_rate", 0.1);
+    params.InsertValue("iterations", 50);
+    params.InsertValue("random_seed", 1);
+    TFullModel model;
+    TEvalResult evalResult;
+    TrainModel(
+        params,
+        nullptr,
+        Nothing(),
+        Nothing(),
+        TDataProviders{pool, {pool}},
+        /*initModel*/ Nothing(),
+        /*initLearnProgress*/ nullptr,
+        "",
+        &model,
+        {&evalResult});
+    return model;
+}
+
+static TVector<int> GetTreeSplits(const TFullModel& model, size_t treeIdx) {
+    const auto& data = *model.ModelTrees->GetModelTreeData();
+    const auto splits = data.GetTreeSplits().subspan(data.GetTreeStartOffsets()[treeIdx], data.GetTreeSizes()[treeIdx]);
+    return TVector<int>(splits.begin(), splits.end());
+}
+
+Y_UNIT_TEST_SUITE(TModelReordering) {
+    Y_UNIT_TEST(TestSplitsReorderingIsExact) {
+        TDataProviderPtr pool = GetAdultPool();
+        TFullModel model = TrainAdultModel(pool);
+        const auto expectedPredictions = ApplyModelMulti(model, *pool->ObjectsData)[0];
+        const auto treeCount = model.GetTreeCount();
+
+        ReorderModelForCacheLocality(/*reorderTrees*/ false, &model);
+        UNIT_ASSERT_VALUES_EQUAL(model.GetTreeCount(), treeCount);
+        for (auto treeIdx : xrange(treeCount)) {
+            const auto splits = GetTreeSplits(model, treeIdx);
+            UNIT_ASSERT(IsSorted(splits.begin(), splits.end()));
+        }
+        UNIT_ASSERT_VALUES_EQUAL(ApplyModelMulti(model, *pool->ObjectsData)[0], expectedPredictions);
+    }
+
+    Y_UNIT_TEST(TestTreesReordering) {
+        TDataProviderPtr pool = GetAdultPool();
+        TFullModel model = TrainAdultModel(pool);
+        const auto expectedPredictions = ApplyModelMulti(model, *pool->ObjectsData)[0];
+
+        ReorderModelForCacheLocality(/*reorderTrees*/ true, &model);
+        for (auto treeIdx : xrange<size_t>(1, model.GetTreeCount())) {
+            UNIT_ASSERT(GetTreeSplits(model, treeIdx - 1) <= GetTreeSplits(model, treeIdx));
+        }
+        const auto predictions = ApplyModelMulti(model, *pool->ObjectsData)[0];
+        UNIT_ASSERT_VALUES_EQUAL(predictions.size(), expectedPredictions.size());
+        for (auto idx : xrange(predictions.size())) {
+            UNIT_ASSERT_DOUBLES_EQUAL(predictions[idx], expectedPredictions[idx], 1e-9);
+        }
+    }
+}
@@ -1,23 +1,91 @@
 #include "c_api.h"
 
 #include <catboost/libs/cat_feature/cat_feature.h>
+#include <catboost/libs/model/cpu/evaluator.h>
+#include <catboost/libs/model/cpu/quantization.h>
 #include <catboost/libs/model/model.h>
 
+#include <library/cpp/threading/hot_swap/hot_swap.h>
+#include <library/cpp/threading/thread_local/thread_local.h>
+
 #include <util/generic/singleton.h>
 #include <util/stream/file.h>
 #include <util/string/builder.h>
+#include <util/system/guard.h>
+#include <util/system/mutex.h>
 
-#define FULL_MODEL_PTR(x) ((TFullModel*)(x))
+#define CALCER_PTR(x) ((TModelCalcerHandle*)(x))
 
 
 struct TErrorMessageHolder {
     TString Message;
 };
 
+namespace {
+    // feature views passed to the model and evaluator buffers, reused between calls of the same thread
+    struct TCalcerScratch {
+        TVector<TConstArrayRef<float>> FloatFeatures;
+        TVector<TVector<TStringBuf>> CatFeatures;
+        TVector<TVector<TStringBuf>> TextFeatures;
+        TVector<TConstArrayRef<int>> HashedCatFeatures;
+        NCB::NModelEvaluation::TEvaluatorBlockBuffers EvaluatorBuffers;
+    };
+
+    struct TModelCalcerState : public TAtomicRefCount<TModelCalcerState> {
+        TFullModel Model;
+        NThreading::TThreadLocalValue<TCalcerScratch> Scratch;
+
+    public:
+        explicit TModelCalcerState(TFullModel&& model)
+            : Model(std::move(model))
+        {}
+
+        TCalcerScratch& GetScratch() const {
+            return Scratch.GetRef();
+        }
+    };
+
+    /* Model is replaced RCU-style: every call works with the state loaded at its start,
+     * the previous state (with its per-thread scratch) is destroyed when the last call using it finishes.
+     */
+    struct TModelCalcerHandle {
+        THotSwap<TModelCalcerState> State{MakeIntrusive<TModelCalcerState>(TFullModel())};
+        TMutex UpdateLock; // serializes updates, calculations don't take it
+
+    public:
+        TIntrusivePtr<TModelCalcerState> Load() const {
+            return State.AtomicLoad();
+        }
+
+        void Store(TFullModel&& model) {
+            with_lock (UpdateLock) {
+                State.AtomicStore(MakeIntrusive<TModelCalcerState>(std::move(model)));
+            }
+        }
+
+        // modifies a copy of the current model, no other update can happen in between
+        template <class TUpdate>
+        void Update(TUpdate&& update) {
+            with_lock (UpdateLock) {
+                TFullModel model = State.AtomicLoad()->Model;
+                update(&model);
+                State.AtomicStore(MakeIntrusive<TModelCalcerState>(std::move(model)));
+            }
+        }
+    };
+}
+
+static void ResizeStringFeatures(size_t docCount, size_t featureCount, TVector<TVector<TStringBuf>>* features) {
+    features->resize(docCount);
+    for (auto& docFeatures : *features) {
+        docFeatures.resize(featureCount);
+    }
+}
+
 extern "C" {
 CATBOOST_API ModelCalcerHandle* ModelCalcerCreate() {
     try {
-        return new TFullModel;
+        return new TModelCalcerHandle;
     } catch (...) {
         Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
     }
@@ -31,13 +99,13 @@ CATBOOST_API const char* GetErrorString() {
 
 CATBOOST_API void ModelCalcerDelete(ModelCalcerHandle* modelHandle) {
     if (modelHandle != nullptr) {
-        delete FULL_MODEL_PTR(modelHandle);
+        delete CALCER_PTR(modelHandle);
     }
 }
 
 CATBOOST_API bool LoadFullModelFromFile(ModelCalcerHandle* modelHandle, const char* filename) {
     try {
-        *FULL_MODEL_PTR(modelHandle) = ReadModel(filename);
+        CALCER_PTR(modelHandle)->Store(ReadModel(filename));
     } catch (...) {
         Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
         return false;
@@ -48,7 +116,7 @@ CATBOOST_API bool LoadFullModelFromFile(ModelCalcerHandle* modelHandle, const ch
 
 CATBOOST_API bool LoadFullModelFromBuffer(ModelCalcerHandle* modelHandle, const void* binaryBuffer, size_t binaryBufferSize) {
     try {
-        *FULL_MODEL_PTR(modelHandle) = ReadModel(binaryBuffer, binaryBufferSize);
+        CALCER_PTR(modelHandle)->Store(ReadModel(binaryBuffer, binaryBufferSize));
     } catch (...) {
         Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
         return false;
@@ -61,7 +129,11 @@ CATBOOST_API bool EnableGPUEvaluation(ModelCalcerHandle* modelHandle, int device
     try {
         //TODO(kirillovs): fix this after adding set evaluator props interface
         CB_ENSURE(deviceId == 0, "FIXME: Only device 0 is supported for now");
-        FULL_MODEL_PTR(modelHandle)->SetEvaluatorType(EFormulaEvaluatorType::GPU);
+        // calls in flight keep using the current model, so the evaluator is switched on a copy
+        CALCER_PTR(modelHandle)->Update(
+            [] (TFullModel* model) {
+                model->SetEvaluatorType(EFormulaEvaluatorType::GPU);
+            });
     } catch (...) {
         Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
         return false;
@@ -71,14 +143,18 @@ CATBOOST_API bool EnableGPUEvaluation(ModelCalcerHandle* modelHandle, int device
 
 CATBOOST_API bool CalcModelPredictionFlat(ModelCalcerHandle* modelHandle, size_t docCount, const float** floatFeatures, size_t floatFeaturesSize, double* result, size_t resultSize) {
     try {
+        const auto state = CALCER_PTR(modelHandle)->Load();
+        auto& scratch = state->GetScratch();
+        const NCB::NModelEvaluation::TEvaluatorBlockBuffersScope buffersScope(&scratch.EvaluatorBuffers);
         if (docCount == 1) {
-            FULL_MODEL_PTR(modelHandle)->CalcFlatSingle(TConstArrayRef<float>(*floatFeatures, floatFeaturesSize), TArrayRef<double>(result, resultSize));
+            state->Model.CalcFlatSingle(TConstArrayRef<float>(*floatFeatures, floatFeaturesSize), TArrayRef<double>(result, resultSize));
         } else {
-            TVector<TConstArrayRef<float>> featuresVec(docCount);
+            auto& featuresVec = scratch.FloatFeatures;
+            featuresVec.resize(docCount);
             for (size_t i = 0; i < docCount; ++i) {
                 featuresVec[i] = TConstArrayRef<float>(floatFeatures[i], floatFeaturesSize);
             }
-            FULL_MODEL_PTR(modelHandle)->CalcFlat(featuresVec, TArrayRef<double>(result, resultSize));
+            state->Model.CalcFlat(featuresVec, TArrayRef<double>(result, resultSize));
         }
     } catch (...) {
         Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
@@ -94,15 +170,20 @@ CATBOOST_API bool CalcModelPrediction(
         const char*** catFeatures, size_t catFeaturesSize,
         double* result, size_t resultSize) {
     try {
-        TVector<TConstArrayRef<float>> floatFeaturesVec(docCount);
-        TVector<TVector<TStringBuf>> catFeaturesVec(docCount, TVector<TStringBuf>(catFeaturesSize));
+        const auto state = CALCER_PTR(modelHandle)->Load();
+        auto& scratch = state->GetScratch();
+        const NCB::NModelEvaluation::TEvaluatorBlockBuffersScope buffersScope(&scratch.EvaluatorBuffers);
+        auto& floatFeaturesVec = scratch.FloatFeatures;
+        auto& catFeaturesVec = scratch.CatFeatures;
+        floatFeaturesVec.resize(docCount);
+        ResizeStringFeatures(docCount, catFeaturesSize, &catFeaturesVec);
         for (size_t i = 0; i < docCount; ++i) {
             floatFeaturesVec[i] = TConstArrayRef<float>(floatFeatures[i], floatFeaturesSize);
             for (size_t catFeatureIdx = 0; catFeatureIdx < catFeaturesSize; ++catFeatureIdx) {
                 catFeaturesVec[i][catFeatureIdx] = catFeatures[i][catFeatureIdx];
             }
         }
-        FULL_MODEL_PTR(modelHandle)->Calc(floatFeaturesVec, catFeaturesVec, TArrayRef<double>(result, resultSize));
+        state->Model.Calc(floatFeaturesVec, catFeaturesVec, TArrayRef<double>(result, resultSize));
     } catch (...) {
         Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
         return false;
@@ -118,9 +199,15 @@ CATBOOST_API bool CalcModelPredictionText(
         const char*** textFeatures, size_t textFeaturesSize,
         double* result, size_t resultSize) {
     try {
-        TVector<TConstArrayRef<float>> floatFeaturesVec(docCount);
-        TVector<TVector<TStringBuf>> catFeaturesVec(docCount, TVector<TStringBuf>(catFeaturesSize));
-        TVector<TVector<TStringBuf>> textFeaturesVec(docCount, TVector<TStringBuf>(textFeaturesSize));
+        const auto state = CALCER_PTR(modelHandle)->Load();
+        auto& scratch = state->GetScratch();
+        const NCB::NModelEvaluation::TEvaluatorBlockBuffersScope buffersScope(&scratch.EvaluatorBuffers);
+        auto& floatFeaturesVec = scratch.FloatFeatures;
+        auto& catFeaturesVec = scratch.CatFeatures;
+        auto& textFeaturesVec = scratch.TextFeatures;
+        floatFeaturesVec.resize(docCount);
+        ResizeStringFeatures(docCount, catFeaturesSize, &catFeaturesVec);
+        ResizeStringFeatures(docCount, textFeaturesSize, &textFeaturesVec);
         for (size_t i = 0; i < docCount; ++i) {
             floatFeaturesVec[i] = TConstArrayRef<float>(floatFeatures[i], floatFeaturesSize);
             for (size_t catFeatureIdx = 0; catFeatureIdx < catFeaturesSize; ++catFeatureIdx) {
@@ -130,7 +217,7 @@ CATBOOST_API bool CalcModelPredictionText(
                 textFeaturesVec[i][textFeatureIdx] = textFeatures[i][textFeatureIdx];
             }
         }
-        FULL_MODEL_PTR(modelHandle)->Calc(floatFeaturesVec, catFeaturesVec, textFeaturesVec, TArrayRef<double>(result, resultSize));
+        state->Model.Calc(floatFeaturesVec, catFeaturesVec, textFeaturesVec, TArrayRef<double>(result, resultSize));
     } catch (...) {
         Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
         return false;
@@ -144,13 +231,18 @@ CATBOOST_API bool CalcModelPredictionSingle(
         const char** catFeatures, size_t catFeaturesSize,
         double* result, size_t resultSize) {
     try {
-        TVector<TConstArrayRef<float>> floatFeaturesVec(1);
-        TVector<TVector<TStringBuf>> catFeaturesVec(1, TVector<TStringBuf>(catFeaturesSize));
+        const auto state = CALCER_PTR(modelHandle)->Load();
+        auto& scratch = state->GetScratch();
+        const NCB::NModelEvaluation::TEvaluatorBlockBuffersScope buffersScope(&scratch.EvaluatorBuffers);
+        auto& floatFeaturesVec = scratch.FloatFeatures;
+        auto& catFeaturesVec = scratch.CatFeatures;
+        floatFeaturesVec.resize(1);
+        ResizeStringFeatures(1, catFeaturesSize, &catFeaturesVec);
         floatFeaturesVec[0] = TConstArrayRef<float>(floatFeatures, floatFeaturesSize);
         for (size_t catFeatureIdx = 0; catFeatureIdx < catFeaturesSize; ++catFeatureIdx) {
             catFeaturesVec[0][catFeatureIdx] = catFeatures[catFeatureIdx];
         }
-        FULL_MODEL_PTR(modelHandle)->Calc(floatFeaturesVec, catFeaturesVec, TArrayRef<double>(result, resultSize));
+        state->Model.Calc(floatFeaturesVec, catFeaturesVec, TArrayRef<double>(result, resultSize));
     } catch (...) {
         Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
         return false;
@@ -163,13 +255,18 @@ CATBOOST_API bool CalcModelPredictionWithHashedCatFeatures(ModelCalcerHandle* mo
                                                      const int** catFeatures, size_t catFeaturesSize,
                                                      double* result, size_t resultSize) {
     try {
-        TVector<TConstArrayRef<float>> floatFeaturesVec(docCount);
-        TVector<TConstArrayRef<int>> catFeaturesVec(docCount);
+        const auto state = CALCER_PTR(modelHandle)->Load();
+        auto& scratch = state->GetScratch();
+        const NCB::NModelEvaluation::TEvaluatorBlockBuffersScope buffersScope(&scratch.EvaluatorBuffers);
+        auto& floatFeaturesVec = scratch.FloatFeatures;
+        auto& catFeaturesVec = scratch.HashedCatFeatures;
+        floatFeaturesVec.resize(docCount);
+        catFeaturesVec.resize(docCount);
         for (size_t i = 0; i < docCount; ++i) {
             floatFeaturesVec[i] = TConstArrayRef<float>(floatFeatures[i], floatFeaturesSize);
             catFeaturesVec[i] = TConstArrayRef<int>(catFeatures[i], catFeaturesSize);
         }
-        FULL_MODEL_PTR(modelHandle)->Calc(floatFeaturesVec, catFeaturesVec, TArrayRef<double>(result, resultSize));
+        state->Model.Calc(floatFeaturesVec, catFeaturesVec, TArrayRef<double>(result, resultSize));
     } catch (...) {
         Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
         return false;
@@ -188,39 +285,47 @@ CATBOOST_API int GetIntegerCatFeatureHash(long long val) {
 }
 
 CATBOOST_API size_t GetFloatFeaturesCount(ModelCalcerHandle* modelHandle) {
-    return FULL_MODEL_PTR(modelHandle)->GetNumFloatFeatures();
+    return CALCER_PTR(modelHandle)->Load()->Model.GetNumFloatFeatures();
 }
 
 CATBOOST_API size_t GetCatFeaturesCount(ModelCalcerHandle* modelHandle) {
-    return FULL_MODEL_PTR(modelHandle)->GetNumCatFeatures();
+    return CALCER_PTR(modelHandle)->Load()->Model.GetNumCatFeatures();
 }
 
 CATBOOST_API size_t GetTreeCount(ModelCalcerHandle* modelHandle) {
-    return FULL_MODEL_PTR(modelHandle)->GetTreeCount();
+    return CALCER_PTR(modelHandle)->Load()->Model.GetTreeCount();
 }
 
 CATBOOST_API size_t GetDimensionsCount(ModelCalcerHandle* modelHandle) {
-    return FULL_MODEL_PTR(modelHandle)->GetDimensionsCount();
+    return CALCER_PTR(modelHandle)->Load()->Model.GetDimensionsCount();
 }
 
 CATBOOST_API bool CheckModelMetadataHasKey(ModelCalcerHandle* modelHandle, const char* keyPtr, size_t keySize) {
-    return FULL_MODEL_PTR(modelHandle)->ModelInfo.contains(TStringBuf(keyPtr, keySize));
+    return CALCER_PTR(modelHandle)->Load()->Model.ModelInfo.contains(TStringBuf(keyPtr, keySize));
 }
 
 CATBOOST_API size_t GetModelInfoValueSize(ModelCalcerHandle* modelHandle, const char* keyPtr, size_t keySize) {
     TStringBuf key(keyPtr, keySize);
-    if (!FULL_MODEL_PTR(modelHandle)->ModelInfo.contains(key)) {
+    const auto state = CALCER_PTR(modelHandle)->Load();
+    if (!state->Model.ModelInfo.contains(key)) {
         return 0;
     }
-    return FULL_MODEL_PTR(modelHandle)->ModelInfo.at(key).size();
+    return state->Model.ModelInfo.at(key).size();
 }
 
 CATBOOST_API const char* GetModelInfoValue(ModelCalcerHandle* modelHandle, const char* keyPtr, size_t keySize) {
     TStringBuf key(keyPtr, keySize);
-    if (!FULL_MODEL_PTR(modelHandle)->ModelInfo.contains(key)) {
+    const auto state = CALCER_PTR(modelHandle)->Load();
+    if (!state->Model.ModelInfo.contains(key)) {
         return nullptr;
     }
-    return FULL_MODEL_PTR(modelHandle)->ModelInfo.at(key).c_str();
+    return state->Model.ModelInfo.at(key).c_str();
+}
+
+CATBOOST_API size_t GetPredictionBatchSizeHint(ModelCalcerHandle* modelHandle) {
+    // block size of the CPU evaluator does not depend on the model
+    Y_UNUSED(modelHandle);
+    return NCB::NModelEvaluation::FORMULA_EVALUATION_BLOCK_SIZE;
 }
 
 }
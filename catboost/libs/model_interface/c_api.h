@@ -40,7 +40,9 @@ CATBOOST_API void ModelCalcerDelete(ModelCalcerHandle* modelHandle);
 CATBOOST_API const char* GetErrorString();
 
 /**
- * Load model from file into given model handle
+ * Load model from file into given model handle.
+ * Model can be reloaded while other threads calculate predictions with the same handle: they finish with
+ * the previous model, which is released after the last of such calls.
  * @param calcer
  * @param filename
  * @return false if error occured
@@ -50,7 +52,8 @@ CATBOOST_API bool LoadFullModelFromFile(
     const char* filename);
 
 /**
- * Load model from memory buffer into given model handle
+ * Load model from memory buffer into given model handle, can be called concurrently with predictions
+ * (see LoadFullModelFromFile)
  * @param calcer
  * @param binaryBuffer pointer to a memory buffer where model file is mapped
  * @param binaryBufferSize size of the buffer in bytes
@@ -226,10 +229,22 @@ CATBOOST_API size_t GetModelInfoValueSize(ModelCalcerHandle* modelHandle, const
 
 /**
  * Get model metainfo for some key. Returns const char* pointer to inner string. If key is missing in model metainfo storage this method will return nullptr
+ * The pointer is valid until the model in the handle is reloaded.
  * @param calcer model handle
  */
 CATBOOST_API const char* GetModelInfoValue(ModelCalcerHandle* modelHandle, const char* keyPtr, size_t keySize);
 
+/**
+ * Get preferred number of objects for CalcModelPrediction* calls.
+ * The CPU evaluator processes objects in blocks of this size, so batches of a multiple of it have no partially
+ * filled blocks. The value is the same for all models and is not meaningful for GPU evaluation.
+ * Vectors of feature views passed to the model and evaluator buffers for binarized features, ctrs and estimated
+ * features are allocated once per thread and model, so repeated calls of the same thread with batches up to
+ * the same size don't allocate them again. Only the leaf indices of one block are still allocated by each call.
+ * @param calcer model handle
+ */
+CATBOOST_API size_t GetPredictionBatchSizeHint(ModelCalcerHandle* modelHandle);
+
 #if defined(__cplusplus)
 }
 #endif
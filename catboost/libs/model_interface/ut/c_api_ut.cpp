@@ -0,0 +1,124 @@
+#include <catboost/libs/model/ut/lib/model_test_helpers.h>
+
+#include <catboost/libs/model_interface/c_api.h>
+#include <catboost/libs/model/model.h>
+
+#include <library/cpp/testing/unittest/registar.h>
+#include <library/cpp/threading/local_executor/local_executor.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+
+#include <atomic>
+
+
+static TVector<TVector<float>> MakeFeatures(size_t docCount) {
+    TVector<TVector<float>> features;
+    for (auto docIdx : xrange(docCount)) {
+        features.push_back({-300.0f + docIdx * 1.5f, float(docIdx % 2), float((docIdx / 2) % 2)});
+    }
+    return features;
+}
+
+static TVector<double> CalcExpected(const TFullModel& model, const TVector<TVector<float>>& features) {
+    TVector<TConstArrayRef<float>> featureRefs(features.begin(), features.end());
+    TVector<double> result(features.size());
+    model.CalcFlat(featureRefs, result);
+    return result;
+}
+
+Y_UNIT_TEST_SUITE(TModelCalcerCApi) {
+    Y_UNIT_TEST(ReloadDuringCalculation) {
+        const TVector<TFullModel> models = {SimpleFloatModel(1), SimpleFloatModel(3)};
+        TVector<TString> serializedModels;
+        for (const auto& model : models) {
+            serializedModels.push_back(SerializeModel(model));
+        }
+
+        const auto features = MakeFeatures(400);
+        TVector<const float*> featurePtrs;
+        for (const auto& docFeatures : features) {
+            featurePtrs.push_back(docFeatures.data());
+        }
+        TVector<TVector<double>> expected;
+        for (const auto& model : models) {
+            expected.push_back(CalcExpected(model, features));
+        }
+        UNIT_ASSERT(expected[0] != expected[1]);
+
+        ModelCalcerHandle* handle = ModelCalcerCreate();
+        UNIT_ASSERT(LoadFullModelFromBuffer(handle, serializedModels[0].data(), serializedModels[0].size()));
+
+        const int calcThreadCount = 3;
+        const int reloadCount = 200;
+        std::atomic<bool> reloadsFinished = false;
+        std::atomic<int> failedCalls = 0;
+        std::atomic<int> unexpectedResults = 0;
+
+        NPar::TLocalExecutor executor;
+        executor.RunAdditionalThreads(calcThreadCount);
+        executor.ExecRangeWithThrow(
+            [&] (int threadIdx) {
+                if (threadIdx == 0) {
+                    for (auto reloadIdx : xrange(reloadCount)) {
+                        const auto& serializedModel = serializedModels[(reloadIdx + 1) % 2];
+                        if (!LoadFullModelFromBuffer(handle, serializedModel.data(), serializedModel.size())) {
+                            ++failedCalls;
+                        }
+                    }
+                    reloadsFinished = true;
+                    return;
+                }
+                // batches of different sizes, including single objects
+                const size_t docCount = features.size() / threadIdx;
+                TVector<double> result(docCount);
+                do {
+                    if (!CalcModelPredictionFlat(
+                            handle,
+                            docCount,
+                            featurePtrs.data(),
+                            features[0].size(),
+                            result.data(),
+                            result.size()))
+                    {
+                        ++failedCalls;
+                        continue;
+                    }
+                    // every call is done with one of the models entirely
+                    const bool isExpected = AnyOf(
+                        expected,
+                        [&] (const auto& modelExpected) {
+                            return TConstArrayRef<double>(modelExpected.data(), docCount) == TConstArrayRef<double>(result);
+                        });
+                    if (!isExpected) {
+                        ++unexpectedResults;
+                    }
+                    double singleResult = 0.0;
+                    if (!CalcModelPredictionFlat(handle, 1, featurePtrs.data(), features[0].size(), &singleResult, 1)) {
+                        ++failedCalls;
+                    } else if ((singleResult != expected[0][0]) && (singleResult != expected[1][0])) {
+                        ++unexpectedResults;
+                    }
+                } while (!reloadsFinished);
+            },
+            0,
+            calcThreadCount + 1,
+            NPar::TLocalExecutor::WAIT_COMPLETE);
+
+        UNIT_ASSERT_VALUES_EQUAL(failedCalls.load(), 0);
+        UNIT_ASSERT_VALUES_EQUAL(unexpectedResults.load(), 0);
+
+        // the last loaded model is used after all reloads
+        TVector<double> result(features.size());
+        UNIT_ASSERT(CalcModelPredictionFlat(
+            handle,
+            features.size(),
+            featurePtrs.data(),
+            features[0].size(),
+            result.data(),
+            result.size()));
+        UNIT_ASSERT_VALUES_EQUAL(result, expected[reloadCount % 2]);
+
+        ModelCalcerDelete(handle);
+    }
+}
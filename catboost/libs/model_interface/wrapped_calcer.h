@@ -296,6 +296,10 @@ public:
         return ::GetCatFeaturesCount(CalcerHolder.get());
     }
 
+    size_t GetBatchSizeHint() const {
+        return ::GetPredictionBatchSizeHint(CalcerHolder.get());
+    }
+
     bool CheckMetadataHasKey(const std::string& key) const {
         return ::CheckModelMetadataHasKey(CalcerHolder.get(), key.c_str(), key.size());
     }
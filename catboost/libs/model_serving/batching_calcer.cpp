@@ -0,0 +1,177 @@
+#include "batching_calcer.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/xrange.h>
+#include <util/system/guard.h>
+
+
+namespace NCB {
+
+    TBatchingModelCalcer::TBatchingModelCalcer(TFullModel model, const TBatchingCalcerOptions& options)
+        : Model(std::move(model))
+        , Options(options)
+    {
+        CB_ENSURE(Options.MaxBatchSize > 0, "Batch size should be positive");
+        CB_ENSURE(Options.ThreadCount > 0, "Thread count should be positive");
+        // not CreateThreadPool: for a single thread it runs tasks inline, that would block the dispatcher
+        EvaluationPool = MakeHolder<TThreadPool>();
+        EvaluationPool->Start(Options.ThreadCount);
+        Dispatcher = MakeHolder<TThread>([this] () { DispatchLoop(); });
+        Dispatcher->Start();
+    }
+
+    TBatchingModelCalcer::~TBatchingModelCalcer() {
+        with_lock (Mutex) {
+            Stopped = true;
+        }
+        QueueChanged.Signal();
+        Dispatcher->Join();
+        // waits for the evaluation of the dispatched batches
+        EvaluationPool->Stop();
+    }
+
+    NThreading::TFuture<TVector<double>> TBatchingModelCalcer::Calc(
+        TVector<TVector<float>> floatFeatures,
+        TVector<TVector<TString>> catFeatures) {
+
+        // a bad request must not fail the other requests of its batch
+        try {
+            ValidateRequest(floatFeatures, catFeatures);
+        } catch (...) {
+            return NThreading::MakeErrorFuture<TVector<double>>(std::current_exception());
+        }
+        if (floatFeatures.empty()) {
+            return NThreading::MakeFuture(TVector<double>());
+        }
+        const size_t objectCount = floatFeatures.size();
+        auto result = NThreading::NewPromise<TVector<double>>();
+        with_lock (Mutex) {
+            CB_ENSURE(!Stopped, "Batching calcer is stopped");
+            Queue.push_back(TRequest{std::move(floatFeatures), std::move(catFeatures), result, TInstant::Now()});
+            ++Counters.QueuedRequestCount;
+            Counters.QueuedObjectCount += objectCount;
+        }
+        QueueChanged.Signal();
+        return result.GetFuture();
+    }
+
+    void TBatchingModelCalcer::ValidateRequest(
+        const TVector<TVector<float>>& floatFeatures,
+        const TVector<TVector<TString>>& catFeatures) const {
+
+        CB_ENSURE(
+            catFeatures.empty() || catFeatures.size() == floatFeatures.size(),
+            "Float and categorical features should be given for the same objects");
+        const size_t floatFeatureCount = Model.GetMinimalSufficientFloatFeaturesVectorSize();
+        for (auto objectIdx : xrange(floatFeatures.size())) {
+            CB_ENSURE(
+                floatFeatures[objectIdx].size() >= floatFeatureCount,
+                "Object " << objectIdx << " has " << floatFeatures[objectIdx].size()
+                << " float features, model needs at least " << floatFeatureCount);
+        }
+        if (Model.GetUsedCatFeaturesCount() == 0) {
+            return;
+        }
+        CB_ENSURE(floatFeatures.empty() || !catFeatures.empty(), "Model needs categorical features");
+        const size_t catFeatureCount = Model.GetMinimalSufficientCatFeaturesVectorSize();
+        for (auto objectIdx : xrange(catFeatures.size())) {
+            CB_ENSURE(
+                catFeatures[objectIdx].size() >= catFeatureCount,
+                "Object " << objectIdx << " has " << catFeatures[objectIdx].size()
+                << " categorical features, model needs at least " << catFeatureCount);
+        }
+    }
+
+    TBatchingCalcerCounters TBatchingModelCalcer::GetCounters() const {
+        with_lock (Mutex) {
+            return Counters;
+        }
+    }
+
+    void TBatchingModelCalcer::DispatchLoop() {
+        while (true) {
+            TVector<TRequest> batch;
+            with_lock (Mutex) {
+                QueueChanged.Wait(Mutex, [this] () { return Stopped || !Queue.empty(); });
+                if (Queue.empty()) {
+                    return;
+                }
+                const TInstant deadline = Queue.front().SubmitTime + Options.MaxDelay;
+                QueueChanged.WaitD(
+                    Mutex,
+                    deadline,
+                    [this] () { return Stopped || Counters.QueuedObjectCount >= Options.MaxBatchSize; });
+
+                // the first request is taken even if it is larger than the batch
+                size_t batchObjectCount = 0;
+                while (!Queue.empty()
+                    && (batch.empty() || batchObjectCount + Queue.front().FloatFeatures.size() <= Options.MaxBatchSize))
+                {
+                    batchObjectCount += Queue.front().FloatFeatures.size();
+                    batch.push_back(std::move(Queue.front()));
+                    Queue.pop_front();
+                }
+                Counters.QueuedRequestCount -= batch.size();
+                Counters.QueuedObjectCount -= batchObjectCount;
+                ++Counters.BatchCount;
+            }
+            EvaluationPool->SafeAddFunc(
+                [this, batch = std::move(batch)] () mutable {
+                    CalcBatch(std::move(batch));
+                });
+        }
+    }
+
+    void TBatchingModelCalcer::CalcBatch(TVector<TRequest>&& batch) {
+        TVector<TConstArrayRef<float>> floatFeatures;
+        TVector<TVector<TStringBuf>> catFeatures;
+        for (const auto& request : batch) {
+            for (auto objectIdx : xrange(request.FloatFeatures.size())) {
+                floatFeatures.push_back(request.FloatFeatures[objectIdx]);
+                auto& objectCatFeatures = catFeatures.emplace_back();
+                if (!request.CatFeatures.empty()) {
+                    const auto& values = request.CatFeatures[objectIdx];
+                    objectCatFeatures.assign(values.begin(), values.end());
+                }
+            }
+        }
+
+        const size_t approxDimension = Model.GetDimensionsCount();
+        TVector<double> approx(floatFeatures.size() * approxDimension);
+        try {
+            Model.Calc(floatFeatures, catFeatures, approx);
+        } catch (...) {
+            if (batch.size() == 1) {
+                batch[0].Result.SetException(std::current_exception());
+                return;
+            }
+            // requests are validated on submission, but still only the failing ones should get the error
+            for (auto& request : batch) {
+                TVector<TRequest> singleRequestBatch;
+                singleRequestBatch.push_back(std::move(request));
+                CalcBatch(std::move(singleRequestBatch));
+            }
+            return;
+        }
+
+        // counters are updated before the results are set, so they include all requests the callers got results of
+        const TInstant now = TInstant::Now();
+        with_lock (Mutex) {
+            for (const auto& request : batch) {
+                const TDuration latency = now - request.SubmitTime;
+                Counters.TotalLatency += latency;
+                Counters.MaxLatency = Max(Counters.MaxLatency, latency);
+            }
+            Counters.RequestCount += batch.size();
+            Counters.ObjectCount += floatFeatures.size();
+        }
+        size_t offset = 0;
+        for (auto& request : batch) {
+            const size_t size = request.FloatFeatures.size() * approxDimension;
+            request.Result.SetValue(TVector<double>(approx.begin() + offset, approx.begin() + offset + size));
+            offset += size;
+        }
+    }
+
+}
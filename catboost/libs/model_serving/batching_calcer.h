@@ -0,0 +1,105 @@
+#pragma once
+
+#include <catboost/libs/model/model.h>
+
+#include <library/cpp/threading/future/future.h>
+
+#include <util/datetime/base.h>
+#include <util/generic/deque.h>
+#include <util/generic/ptr.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/system/condvar.h>
+#include <util/system/mutex.h>
+#include <util/system/thread.h>
+#include <util/thread/pool.h>
+
+
+namespace NCB {
+
+    struct TBatchingCalcerOptions {
+        // requests are joined into a batch until it has this many objects
+        size_t MaxBatchSize = 1024;
+        // or until the first request in the batch has waited for this long
+        TDuration MaxDelay = TDuration::MicroSeconds(500);
+        // threads evaluating batches
+        size_t ThreadCount = 1;
+    };
+
+    struct TBatchingCalcerCounters {
+        ui64 RequestCount = 0;
+        ui64 ObjectCount = 0;
+        ui64 BatchCount = 0;
+        // requests and objects waiting to be put into a batch
+        size_t QueuedRequestCount = 0;
+        size_t QueuedObjectCount = 0;
+        // from the request submission to the result
+        TDuration TotalLatency;
+        TDuration MaxLatency;
+
+    public:
+        double GetMeanBatchSize() const {
+            return BatchCount ? double(ObjectCount) / BatchCount : 0.0;
+        }
+
+        TDuration GetMeanLatency() const {
+            return RequestCount ? TotalLatency / RequestCount : TDuration::Zero();
+        }
+    };
+
+    /* Joins small concurrent requests into batches so that the model is applied by its block based evaluator
+     * to many objects at once.
+     * Requests are collected by a dispatcher thread for at most MaxDelay (or until MaxBatchSize objects are queued)
+     * and evaluated by a pool of ThreadCount threads, results are returned through futures.
+     */
+    class TBatchingModelCalcer {
+    public:
+        TBatchingModelCalcer(TFullModel model, const TBatchingCalcerOptions& options);
+        // evaluates all already submitted requests
+        ~TBatchingModelCalcer();
+
+        /* floatFeatures and catFeatures are [objectIdx][featureIdx], catFeatures can be empty for models without
+         * categorical features.
+         * Result contains raw predictions [objectIdx * approxDimension + dim].
+         * Requests with too few features for the model get an exception in the result.
+         */
+        NThreading::TFuture<TVector<double>> Calc(
+            TVector<TVector<float>> floatFeatures,
+            TVector<TVector<TString>> catFeatures = {});
+
+        TBatchingCalcerCounters GetCounters() const;
+
+        const TFullModel& GetModel() const {
+            return Model;
+        }
+
+    private:
+        struct TRequest {
+            TVector<TVector<float>> FloatFeatures;
+            TVector<TVector<TString>> CatFeatures;
+            NThreading::TPromise<TVector<double>> Result;
+            TInstant SubmitTime;
+        };
+
+    private:
+        void ValidateRequest(
+            const TVector<TVector<float>>& floatFeatures,
+            const TVector<TVector<TString>>& catFeatures) const;
+        void DispatchLoop();
+        void CalcBatch(TVector<TRequest>&& batch);
+
+    private:
+        const TFullModel Model;
+        const TBatchingCalcerOptions Options;
+
+        mutable TMutex Mutex;
+        TCondVar QueueChanged;
+        TDeque<TRequest> Queue;
+        bool Stopped = false;
+        TBatchingCalcerCounters Counters;
+
+        THolder<IThreadPool> EvaluationPool;
+        THolder<TThread> Dispatcher;
+    };
+
+}
@@ -0,0 +1,193 @@
+#include <catboost/libs/model_serving/batching_calcer.h>
+
+#include <catboost/libs/model/ut/lib/model_test_helpers.h>
+
+#include <library/cpp/testing/unittest/registar.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/system/event.h>
+#include <util/system/thread.h>
+
+using namespace NCB;
+
+
+static TVector<TVector<float>> GenerateObjects(size_t objectCount, TFastRng64* rng) {
+    TVector<TVector<float>> objects(objectCount);
+    for (auto& object : objects) {
+        object = {float(rng->GenRandReal1()), float(rng->GenRandReal1()), float(rng->GenRandReal1())};
+    }
+    return objects;
+}
+
+static TVector<double> CalcDirectly(const TFullModel& model, const TVector<TVector<float>>& objects) {
+    TVector<TConstArrayRef<float>> features(objects.begin(), objects.end());
+    TVector<double> result(objects.size() * model.GetDimensionsCount());
+    model.CalcFlat(features, result);
+    return result;
+}
+
+Y_UNIT_TEST_SUITE(TBatchingModelCalcer) {
+    Y_UNIT_TEST(TestSyntheticLoad) {
+        const TFullModel model = TrainFloatCatboostModel(/*iterations*/ 20);
+        TBatchingCalcerOptions options;
+        options.MaxBatchSize = 64;
+        options.MaxDelay = TDuration::MicroSeconds(200);
+        options.ThreadCount = 2;
+        TBatchingModelCalcer calcer(model, options);
+
+        const size_t clientCount = 8;
+        const size_t requestsPerClient = 200;
+        TVector<size_t> mismatchCounts(clientCount, 0);
+        TVector<size_t> objectCounts(clientCount, 0);
+        TVector<THolder<TThread>> clients;
+        for (auto clientIdx : xrange(clientCount)) {
+            clients.push_back(MakeHolder<TThread>([&, clientIdx] () {
+                TFastRng64 rng(clientIdx);
+                for (auto requestIdx : xrange(requestsPerClient)) {
+                    Y_UNUSED(requestIdx);
+                    auto objects = GenerateObjects(1 + rng.Uniform(5), &rng);
+                    const auto expected = CalcDirectly(model, objects);
+                    objectCounts[clientIdx] += objects.size();
+                    const auto result = calcer.Calc(std::move(objects)).ExtractValueSync();
+                    if (result != expected) {
+                        ++mismatchCounts[clientIdx];
+                    }
+                }
+            }));
+            clients.back()->Start();
+        }
+        for (auto& client : clients) {
+            client->Join();
+        }
+
+        for (auto mismatchCount : mismatchCounts) {
+            UNIT_ASSERT_VALUES_EQUAL(mismatchCount, 0);
+        }
+        const auto counters = calcer.GetCounters();
+        UNIT_ASSERT_VALUES_EQUAL(counters.RequestCount, clientCount * requestsPerClient);
+        UNIT_ASSERT_VALUES_EQUAL(counters.ObjectCount, Accumulate(objectCounts, size_t(0)));
+        UNIT_ASSERT(counters.BatchCount > 0);
+        UNIT_ASSERT(counters.BatchCount <= counters.RequestCount);
+        UNIT_ASSERT_VALUES_EQUAL(counters.QueuedRequestCount, 0);
+        UNIT_ASSERT_VALUES_EQUAL(counters.QueuedObjectCount, 0);
+        UNIT_ASSERT(counters.MaxLatency >= counters.GetMeanLatency());
+    }
+
+    Y_UNIT_TEST(TestRequestsAreJoined) {
+        const TFullModel model = TrainFloatCatboostModel();
+        TBatchingCalcerOptions options;
+        options.MaxBatchSize = 10;
+        options.MaxDelay = TDuration::Seconds(60);
+        TBatchingModelCalcer calcer(model, options);
+
+        TFastRng64 rng(0);
+        TVector<TVector<TVector<float>>> requests;
+        TVector<NThreading::TFuture<TVector<double>>> results;
+        for (auto requestIdx : xrange(10)) {
+            Y_UNUSED(requestIdx);
+            requests.push_back(GenerateObjects(1, &rng));
+            results.push_back(calcer.Calc(requests.back()));
+        }
+        for (auto requestIdx : xrange(requests.size())) {
+            UNIT_ASSERT_VALUES_EQUAL(results[requestIdx].ExtractValueSync(), CalcDirectly(model, requests[requestIdx]));
+        }
+        const auto counters = calcer.GetCounters();
+        UNIT_ASSERT_VALUES_EQUAL(counters.BatchCount, 1);
+        UNIT_ASSERT_DOUBLES_EQUAL(counters.GetMeanBatchSize(), 10.0, 1e-9);
+    }
+
+    Y_UNIT_TEST(TestSingleThreadDoesNotBlockDispatcher) {
+        const TFullModel model = TrainFloatCatboostModel();
+        TBatchingCalcerOptions options;
+        options.MaxBatchSize = 2;
+        options.MaxDelay = TDuration::Seconds(60);
+        options.ThreadCount = 1;
+        TBatchingModelCalcer calcer(model, options);
+
+        TFastRng64 rng(0);
+        // the first batch is dispatched only with the second request, so the callback is set before its evaluation
+        TManualEvent evaluationRelease;
+        auto blockedResult = calcer.Calc(GenerateObjects(1, &rng)).Subscribe(
+            [&] (const auto&) {
+                evaluationRelease.Wait();
+            });
+        calcer.Calc(GenerateObjects(1, &rng));
+
+        const auto objects = GenerateObjects(2, &rng);
+        auto result = calcer.Calc(objects);
+        const TInstant deadline = TDuration::Seconds(10).ToDeadLine();
+        while (calcer.GetCounters().BatchCount < 2 && Now() < deadline) {
+            Sleep(TDuration::MilliSeconds(1));
+        }
+        const bool isSecondBatchDispatched = calcer.GetCounters().BatchCount == 2;
+        evaluationRelease.Signal();
+
+        UNIT_ASSERT(isSecondBatchDispatched);
+        UNIT_ASSERT_VALUES_EQUAL(result.ExtractValueSync(), CalcDirectly(model, objects));
+        blockedResult.Wait();
+    }
+
+    Y_UNIT_TEST(TestQueueIsDrainedOnDestruction) {
+        const TFullModel model = TrainFloatCatboostModel();
+        TBatchingCalcerOptions options;
+        options.MaxBatchSize = 1000;
+        options.MaxDelay = TDuration::Seconds(60);
+
+        TFastRng64 rng(0);
+        const auto objects = GenerateObjects(3, &rng);
+        NThreading::TFuture<TVector<double>> result;
+        {
+            TBatchingModelCalcer calcer(model, options);
+            result = calcer.Calc(objects);
+        }
+        UNIT_ASSERT(result.HasValue());
+        UNIT_ASSERT_VALUES_EQUAL(result.GetValue(), CalcDirectly(model, objects));
+    }
+
+    Y_UNIT_TEST(TestBadRequestDoesNotFailOthers) {
+        const TFullModel model = TrainFloatCatboostModel();
+        TBatchingCalcerOptions options;
+        options.MaxBatchSize = 3;
+        options.MaxDelay = TDuration::Seconds(60);
+        TBatchingModelCalcer calcer(model, options);
+
+        TFastRng64 rng(0);
+        const auto goodObjects = GenerateObjects(3, &rng);
+        const TVector<TVector<float>> badObjects = {goodObjects[0], {0.5f}};
+        TVector<NThreading::TFuture<TVector<double>>> goodResults;
+        goodResults.push_back(calcer.Calc({goodObjects[0]}));
+        const auto badResult = calcer.Calc(badObjects);
+        goodResults.push_back(calcer.Calc({goodObjects[1]}));
+        goodResults.push_back(calcer.Calc({goodObjects[2]}));
+
+        UNIT_ASSERT_EXCEPTION_CONTAINS(badResult.GetValueSync(), TCatBoostException, "Object 1 has 1 float features");
+        for (auto objectIdx : xrange(goodObjects.size())) {
+            UNIT_ASSERT_VALUES_EQUAL(
+                goodResults[objectIdx].ExtractValueSync(),
+                CalcDirectly(model, {goodObjects[objectIdx]}));
+        }
+        const auto counters = calcer.GetCounters();
+        UNIT_ASSERT_VALUES_EQUAL(counters.RequestCount, 3);
+        UNIT_ASSERT_VALUES_EQUAL(counters.BatchCount, 1);
+    }
+
+    Y_UNIT_TEST(TestMissingCatFeatures) {
+        const TFullModel model = TrainCatOnlyModel();
+        TBatchingModelCalcer calcer(model, TBatchingCalcerOptions());
+
+        const TVector<TVector<float>> floatFeatures(2);
+        UNIT_ASSERT_EXCEPTION(calcer.Calc(floatFeatures).GetValueSync(), TCatBoostException);
+        UNIT_ASSERT_EXCEPTION(calcer.Calc(floatFeatures, {{"a", "d", "e"}, {"a"}}).GetValueSync(), TCatBoostException);
+
+        TVector<double> expected(2 * model.GetDimensionsCount());
+        model.Calc(
+            TVector<TConstArrayRef<float>>(2),
+            TVector<TVector<TStringBuf>>{{"a", "d", "e"}, {"b", "c", "f"}},
+            expected);
+        UNIT_ASSERT_VALUES_EQUAL(
+            calcer.Calc(floatFeatures, {{"a", "d", "e"}, {"b", "c", "f"}}).ExtractValueSync(),
+            expected);
+    }
+}
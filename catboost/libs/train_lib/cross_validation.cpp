@@ -890,7 +890,7 @@ void CrossValidate(
 
     TRestorableFastRng64 rand(cvParams.PartitionRandSeed);
 
-    NPar::TLocalExecutor localExecutor;
+    NPar::TLocalExecutor localExecutor(GetLocalExecutorOptions(catBoostOptions.SystemOptions.Get()));
     localExecutor.RunAdditionalThreads(catBoostOptions.SystemOptions->NumThreads.Get() - 1);
 
     const ui64 cpuUsedRamLimit =
@@ -4,6 +4,9 @@
 #include <catboost/libs/helpers/vector_helpers.h>
 #include <catboost/private/libs/options/enum_helpers.h>
 #include <catboost/private/libs/options/defaults_helper.h>
+#include <catboost/private/libs/options/json_helper.h>
+
+#include <library/cpp/json/json_value.h>
 
 #include <util/generic/algorithm.h>
 #include <util/generic/maybe.h>
@@ -429,3 +432,25 @@ void SetDataDependentDefaults(
     UpdateSampleRateOption(learnPoolSize, catBoostOptions);
     AdjustPosteriorSamplingDeafultValues(trainDataMetaInfo, continueFromModel || continueFromProgress, catBoostOptions);
 }
+
+NPar::TLocalExecutor::TOptions GetLocalExecutorOptions(const NCatboostOptions::TSystemOptions& systemOptions) {
+    // CPU only options, so they keep default values for GPU
+    NPar::TLocalExecutor::TOptions options;
+    options.WorkStealing = systemOptions.WorkStealing.GetUnchecked();
+    options.PinThreads = systemOptions.PinThreads.GetUnchecked();
+    return options;
+}
+
+NPar::TLocalExecutor::TOptions GetLocalExecutorOptions(const NJson::TJsonValue& catBoostJsonOptions) {
+    NCatboostOptions::TOption<bool> workStealing("work_stealing", false);
+    NCatboostOptions::TOption<bool> pinThreads("pin_threads", false);
+    if (catBoostJsonOptions.Has("system_options")) {
+        const auto& systemOptions = catBoostJsonOptions["system_options"];
+        NCatboostOptions::TJsonFieldHelper<decltype(workStealing)>::Read(systemOptions, &workStealing);
+        NCatboostOptions::TJsonFieldHelper<decltype(pinThreads)>::Read(systemOptions, &pinThreads);
+    }
+    NPar::TLocalExecutor::TOptions options;
+    options.WorkStealing = workStealing.Get();
+    options.PinThreads = pinThreads.Get();
+    return options;
+}
@@ -3,6 +3,12 @@
 #include <catboost/libs/data/meta_info.h>
 #include <catboost/private/libs/options/catboost_options.h>
 
+#include <library/cpp/threading/local_executor/local_executor.h>
+
+namespace NJson {
+    class TJsonValue;
+}
+
 void UpdateYetiRankEvalMetric(
     const TMaybe<NCB::TTargetStats>& learnTargetStats,
     const TMaybe<NCB::TTargetStats>& testTargetStats,
@@ -17,3 +23,8 @@ void SetDataDependentDefaults(
     NCatboostOptions::TOutputFilesOptions* outputFilesOptions,
     NCatboostOptions::TCatBoostOptions* catBoostOptions
 );
+
+NPar::TLocalExecutor::TOptions GetLocalExecutorOptions(const NCatboostOptions::TSystemOptions& systemOptions);
+
+// for options in json form, as NCatboostOptions::GetThreadCount
+NPar::TLocalExecutor::TOptions GetLocalExecutorOptions(const NJson::TJsonValue& catBoostJsonOptions);
@@ -3,6 +3,7 @@
 #include "cross_validation.h"
 #include "dir_helper.h"
 
+#include <catboost/private/libs/algo/approx_cache.h>
 #include <catboost/private/libs/algo/approx_dimension.h>
 #include <catboost/private/libs/algo/data.h>
 #include <catboost/private/libs/algo/full_model_saver.h>
@@ -27,6 +28,7 @@
 #include <catboost/libs/loggers/catboost_logger_helpers.h>
 #include <catboost/libs/loggers/logger.h>
 #include <catboost/libs/logging/profile_info.h>
+#include <catboost/libs/logging/trace.h>
 #include <catboost/libs/metrics/metric.h>
 #include <catboost/libs/metrics/optimal_const_for_loss.h>
 #include <catboost/libs/model/ctr_data.h>
@@ -41,6 +43,7 @@
 #include <library/cpp/grid_creator/binarization.h>
 #include <library/cpp/json/json_prettifier.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/cast.h>
 #include <util/generic/mapfindptr.h>
 #include <util/generic/scope.h>
@@ -330,6 +333,7 @@ static void CalcErrors(
     int iter,
     TLearnContext* ctx) {
 
+    CB_TRACE_SCOPE("Calc errors");
     CalcErrors(data, metricsData.Metrics, ShouldCalcAllMetrics(iter, metricsData, *ctx), ShouldCalcErrorTrackerMetric(iter, metricsData, *ctx), ctx);
 }
 
@@ -518,6 +522,51 @@ static THolder<TNonSymmetricTreeNode> BuildTree(
 }
 
 
+static void SaveApproxCacheIfNeeded(
+    const TTrainingDataProviders& trainingData,
+    const TLearnContext& ctx,
+    const TFullModel& resultModel
+) {
+    if (!ctx.OutputOptions.AllowWriteFiles()) {
+        return;
+    }
+    const TString approxCacheFile = ctx.OutputOptions.CreateApproxCacheFullPath();
+    if (approxCacheFile.empty()) {
+        return;
+    }
+
+    const TLearnProgress& progress = *ctx.LearnProgress;
+    const bool approxesContainBaseline = (progress.SeparateInitModelTreesSize == 0) &&
+        (trainingData.Learn->TargetData->GetBaseline() ||
+         AnyOf(
+             trainingData.Test,
+             [] (const auto& testData) { return bool(testData->TargetData->GetBaseline()); }));
+
+    // training approxes use online ctrs and estimated features computed on the learn permutation,
+    // while the model applies its final ctr tables and estimators
+    const bool modelUsesOnlineFeatures = !resultModel.ModelTrees->GetCtrFeatures().empty()
+        || !resultModel.ModelTrees->GetEstimatedFeatures().empty();
+
+    // approxes are stored on workers in distributed training and are not reverted by the model shrinking
+    if (!ctx.Params.SystemOptions->IsSingleHost()
+        || !progress.IsFoldsAndApproxDataValid
+        || approxesContainBaseline
+        || modelUsesOnlineFeatures)
+    {
+        CATBOOST_WARNING_LOG << "Approxes are not saved to " << approxCacheFile
+            << " as they do not correspond to the resulting model" << Endl;
+        return;
+    }
+
+    TApproxCache::Save(
+        CalcApproxCacheModelCheckSum(resultModel),
+        progress.LearnAndTestQuantizedFeaturesCheckSum,
+        progress.AvrgApprox,
+        progress.TestApprox,
+        approxCacheFile);
+}
+
+
 static void SaveModel(
     const TTrainingDataProviders& trainingDataForCpu,
     const TLearnContext& ctx,
@@ -662,6 +711,11 @@ static void SaveModel(
             trainingDataForCpu.FeatureEstimators
         );
 
+        if (!addResultModelToInitModel) {
+            // the conversion to the full model does not change the core model that approxes depend on
+            SaveApproxCacheIfNeeded(trainingDataForCpu, ctx, *modelPtr);
+        }
+
         const TVector<TTargetClassifier>* targetClassifiers = &ctx.CtrsHelper.GetTargetClassifiers();
         if (dstModel || addResultModelToInitModel) {
             coreModelToFullModelConverter.Do(true, modelPtr, ctx.LocalExecutor, targetClassifiers);
@@ -669,6 +723,7 @@ static void SaveModel(
                 TVector<const TFullModel*> models = {*initModel, modelPtr};
                 TVector<double> weights = {1.0, 1.0};
                 (dstModel ? *dstModel : *modelPtr) = SumModels(models, weights);
+                SaveApproxCacheIfNeeded(trainingDataForCpu, ctx, dstModel ? *dstModel : *modelPtr);
 
                 if (!dstModel) {
                     const bool allLearnObjectsDataIsAvailable
@@ -978,6 +1033,8 @@ static void TrainModel(
     if (outputOptions.AllowWriteFiles()) {
         NCB::NPrivate::CreateTrainDirWithTmpDirIfNotExist(outputOptions.GetTrainDir(), &tmpDir);
     }
+    NCB::TChromeTraceSink chromeTraceSink(
+        outputOptions.AllowWriteFiles() ? outputOptions.CreateChromeTraceFullPath() : TString());
 
     const bool haveLearnFeaturesInMemory = HaveLearnFeaturesInMemory(poolLoadOptions, catBoostOptions);
     CB_ENSURE_INTERNAL(
@@ -1118,7 +1175,7 @@ void TrainModel(
     }
 
 
-    NPar::TLocalExecutor executor;
+    NPar::TLocalExecutor executor(GetLocalExecutorOptions(catBoostOptions.SystemOptions.Get()));
     executor.RunAdditionalThreads(catBoostOptions.SystemOptions.Get().NumThreads.Get() - 1);
 
     TVector<NJson::TJsonValue> classLabels = catBoostOptions.DataProcessingOptions->ClassLabels;
@@ -1414,7 +1471,7 @@ void ModelBasedEval(
         "Multiple eval sets not supported for GPU"
     );
 
-    NPar::TLocalExecutor executor;
+    NPar::TLocalExecutor executor(GetLocalExecutorOptions(catBoostOptions.SystemOptions.Get()));
     executor.RunAdditionalThreads(catBoostOptions.SystemOptions.Get().NumThreads.Get() - 1);
 
     TVector<NJson::TJsonValue> classLabels = catBoostOptions.DataProcessingOptions->ClassLabels;
@@ -1496,7 +1553,7 @@ void TrainModel(
     NCatboostOptions::TOutputFilesOptions outputOptions;
     outputOptions.Load(outputFilesOptionsJson);
 
-    NPar::TLocalExecutor executor;
+    NPar::TLocalExecutor executor(GetLocalExecutorOptions(trainOptionsJson));
     executor.RunAdditionalThreads(
         NCatboostOptions::GetThreadCount(trainOptionsJson) - 1);
 
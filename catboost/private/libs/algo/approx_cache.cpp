@@ -0,0 +1,158 @@
+#include "approx_cache.h"
+
+#include "learn_context.h"
+
+#include <catboost/libs/helpers/checksum.h>
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/logging/logging.h>
+#include <catboost/libs/model/model.h>
+
+#include <util/generic/cast.h>
+#include <util/generic/xrange.h>
+#include <util/stream/file.h>
+#include <util/system/fs.h>
+
+#include <cstring>
+
+
+namespace {
+    struct TApproxCacheHeader {
+        ui64 Magic = 0;
+        ui32 Version = 0;
+        ui32 ModelCheckSum = 0;
+        ui32 FeaturesCheckSum = 0;
+        ui32 ApproxDimension = 0;
+        ui32 DatasetCount = 0;
+        ui32 Reserved = 0; // keeps object counts and approxes 8-byte aligned
+    };
+
+    static_assert(sizeof(TApproxCacheHeader) == 32, "");
+}
+
+static const ui64 ApproxCacheMagic = 0x584f525050414243ull; // "CBAPPROX" in little endian
+static const ui32 ApproxCacheVersion = 1;
+
+
+namespace NCB {
+
+    ui32 CalcApproxCacheModelCheckSum(const TFullModel& model) {
+        const auto& scaleAndBias = model.GetScaleAndBias();
+        return UpdateCheckSum(CalcCoreModelCheckSum(model), scaleAndBias.Scale, scaleAndBias.GetBiasRef());
+    }
+
+    void TApproxCache::Save(
+        ui32 modelCheckSum,
+        ui32 featuresCheckSum,
+        const TVector<TVector<double>>& learnApprox,
+        TConstArrayRef<TVector<TVector<double>>> testApprox,
+        const TString& path) {
+
+        TVector<const TVector<TVector<double>>*> datasetApproxes = {&learnApprox};
+        for (const auto& approx : testApprox) {
+            datasetApproxes.push_back(&approx);
+        }
+
+        TApproxCacheHeader header;
+        header.Magic = ApproxCacheMagic;
+        header.Version = ApproxCacheVersion;
+        header.ModelCheckSum = modelCheckSum;
+        header.FeaturesCheckSum = featuresCheckSum;
+        header.ApproxDimension = SafeIntegerCast<ui32>(learnApprox.size());
+        header.DatasetCount = SafeIntegerCast<ui32>(datasetApproxes.size());
+
+        TVector<ui64> objectCounts;
+        for (const auto* approx : datasetApproxes) {
+            CB_ENSURE_INTERNAL(
+                approx->size() == header.ApproxDimension,
+                "All datasets should have approxes of the same dimension");
+            objectCounts.push_back(approx->empty() ? 0 : approx->front().size());
+        }
+
+        // write to a temporary file first so that an interrupted save does not leave a broken cache
+        const TString tmpPath = path + ".tmp";
+        {
+            TFileOutput output(tmpPath);
+            output.Write(&header, sizeof(header));
+            output.Write(objectCounts.data(), objectCounts.size() * sizeof(ui64));
+            for (auto datasetIdx : xrange(datasetApproxes.size())) {
+                for (const auto& dimensionApprox : *datasetApproxes[datasetIdx]) {
+                    CB_ENSURE_INTERNAL(
+                        dimensionApprox.size() == objectCounts[datasetIdx],
+                        "All approx dimensions should have the same size");
+                    output.Write(dimensionApprox.data(), dimensionApprox.size() * sizeof(double));
+                }
+            }
+            output.Finish();
+        }
+        CB_ENSURE(NFs::Rename(tmpPath, path), "Failed to save approx cache to " << path);
+    }
+
+    TMaybe<TApproxCache> TApproxCache::TryLoad(
+        const TString& path,
+        ui32 modelCheckSum,
+        ui32 featuresCheckSum,
+        ui32 approxDimension,
+        TConstArrayRef<ui64> objectCounts) {
+
+        if (!NFs::Exists(path)) {
+            CATBOOST_INFO_LOG << "Approx cache " << path << " does not exist, init model will be applied" << Endl;
+            return Nothing();
+        }
+
+        TApproxCache cache;
+        cache.Data = TBlob::FromFile(path);
+
+        const size_t countsOffset = sizeof(TApproxCacheHeader);
+        TApproxCacheHeader header;
+        if (cache.Data.Size() >= countsOffset) {
+            std::memcpy(&header, cache.Data.Data(), sizeof(header));
+        }
+        if ((cache.Data.Size() < countsOffset)
+            || (header.Magic != ApproxCacheMagic)
+            || (header.Version != ApproxCacheVersion))
+        {
+            CATBOOST_WARNING_LOG << "Approx cache " << path << " has unknown format, it is ignored" << Endl;
+            return Nothing();
+        }
+        if ((header.ModelCheckSum != modelCheckSum)
+            || (header.FeaturesCheckSum != featuresCheckSum)
+            || (header.ApproxDimension != approxDimension)
+            || (header.DatasetCount != objectCounts.size())
+            || (cache.Data.Size() < countsOffset + objectCounts.size() * sizeof(ui64))
+            || (std::memcmp(
+                    cache.Data.AsCharPtr() + countsOffset,
+                    objectCounts.data(),
+                    objectCounts.size() * sizeof(ui64)) != 0))
+        {
+            CATBOOST_INFO_LOG << "Approx cache " << path << " has been saved for another model or datasets,"
+                " init model will be applied" << Endl;
+            return Nothing();
+        }
+
+        size_t offset = (countsOffset + objectCounts.size() * sizeof(ui64)) / sizeof(double);
+        for (auto objectCount : objectCounts) {
+            cache.DatasetOffsets.push_back(offset);
+            offset += objectCount * approxDimension;
+        }
+        if (cache.Data.Size() != offset * sizeof(double)) {
+            CATBOOST_WARNING_LOG << "Approx cache " << path << " has unexpected size, it is ignored" << Endl;
+            return Nothing();
+        }
+        cache.ApproxDimension = approxDimension;
+        cache.ObjectCounts.assign(objectCounts.begin(), objectCounts.end());
+
+        CATBOOST_INFO_LOG << "Init model approxes are loaded from " << path << Endl;
+        return cache;
+    }
+
+    TVector<TVector<double>> TApproxCache::GetApprox(size_t datasetIdx) const {
+        const size_t objectCount = ObjectCounts[datasetIdx];
+        const double* approx = reinterpret_cast<const double*>(Data.Data()) + DatasetOffsets[datasetIdx];
+        TVector<TVector<double>> result(ApproxDimension);
+        for (auto dim : xrange(ApproxDimension)) {
+            result[dim].assign(approx + dim * objectCount, approx + (dim + 1) * objectCount);
+        }
+        return result;
+    }
+
+}
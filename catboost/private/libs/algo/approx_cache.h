@@ -0,0 +1,53 @@
+#pragma once
+
+#include <util/generic/array_ref.h>
+#include <util/generic/maybe.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/memory/blob.h>
+#include <util/system/types.h>
+
+class TFullModel;
+
+
+namespace NCB {
+
+    // core model checksum extended with scale and bias as they are a part of raw approxes
+    ui32 CalcApproxCacheModelCheckSum(const TFullModel& model);
+
+    /* Raw approxes of a model on the learn and test datasets, saved after training so that the training
+     * continuation from this model on the same datasets does not have to apply the model again.
+     * The cache is valid only for the model and quantized features checksums it has been saved with.
+     *
+     * Datasets are enumerated as learn, then tests in their order, approxes are stored as [dim][objectIdx].
+     */
+    class TApproxCache {
+    public:
+        static void Save(
+            ui32 modelCheckSum,
+            ui32 featuresCheckSum,
+            const TVector<TVector<double>>& learnApprox,
+            TConstArrayRef<TVector<TVector<double>>> testApprox,
+            const TString& path);
+
+        // Nothing if there is no file or it has been saved for other model, features or datasets sizes
+        static TMaybe<TApproxCache> TryLoad(
+            const TString& path,
+            ui32 modelCheckSum,
+            ui32 featuresCheckSum,
+            ui32 approxDimension,
+            TConstArrayRef<ui64> objectCounts);
+
+        TVector<TVector<double>> GetApprox(size_t datasetIdx) const;
+
+    private:
+        TApproxCache() = default;
+
+    private:
+        TBlob Data; // memory-mapped file
+        ui32 ApproxDimension = 0;
+        TVector<ui64> ObjectCounts;
+        TVector<size_t> DatasetOffsets; // in doubles from the beginning of Data
+    };
+
+}
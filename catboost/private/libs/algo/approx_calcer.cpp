@@ -17,6 +17,7 @@
 #include <catboost/libs/helpers/quantile.h>
 #include <catboost/libs/logging/logging.h>
 #include <catboost/libs/logging/profile_info.h>
+#include <catboost/libs/logging/trace.h>
 #include <catboost/libs/metrics/metric.h>
 #include <catboost/libs/metrics/optimal_const_for_loss.h>
 #include <catboost/private/libs/algo/approx_calcer/approx_calcer_multi.h>
@@ -967,6 +968,7 @@ void CalcLeafValues(
     TVector<TVector<double>>* leafDeltas,
     TVector<TIndexType>* indices) {
 
+    CB_TRACE_SCOPE_WITH_COUNTERS("CalcLeafValues", fold.GetLearnSampleCount(), /*bytes*/ -1);
     *indices = BuildIndices(fold, tree, data, EBuildIndicesDataParts::All, ctx->LocalExecutor);
     const int approxDimension = ctx->LearnProgress->AveragingFold.GetApproxDimension();
     Y_VERIFY(fold.GetLearnSampleCount() == data.Learn->GetObjectCount());
@@ -994,6 +996,7 @@ void CalcApproxForLeafStruct(
     TLearnContext* ctx,
     TVector<TVector<TVector<double>>>* approxesDelta // [bodyTailId][approxDim][docIdxInPermuted]
 ) {
+    CB_TRACE_SCOPE_WITH_COUNTERS("CalcApproxForLeafStruct", fold.GetLearnSampleCount(), /*bytes*/ -1);
     const TVector<TIndexType> indices = BuildIndices(
         fold,
         tree,
@@ -21,15 +21,18 @@
 #include <catboost/libs/helpers/query_info_helper.h>
 #include <catboost/libs/helpers/parallel_tasks.h>
 #include <catboost/libs/logging/profile_info.h>
+#include <catboost/libs/logging/trace.h>
 #include <catboost/private/libs/algo_helpers/langevin_utils.h>
 #include <catboost/private/libs/distributed/master.h>
 
 #include <library/cpp/fast_log/fast_log.h>
 
 #include <util/generic/cast.h>
+#include <util/generic/maybe.h>
 #include <util/generic/queue.h>
 #include <util/generic/scope.h>
 #include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
 #include <util/string/builder.h>
 #include <util/system/mem_info.h>
 
@@ -620,7 +623,7 @@ static void SelectCtrsToDropAfterCalc(
 }
 
 
-static void CalcBestScore(
+static EScoringParallelism CalcBestScore(
     const TTrainingDataProviders& data,
     const TSplitTree& currentTree,
     ui64 randSeed,
@@ -638,16 +641,48 @@ static void CalcBestScore(
     );
 
     TVector<std::pair<size_t, size_t>> tasks; // vector of (contextIdx, candId)
+    int candidateCount = 0;
+    i64 bucketCountSum = 0;
 
     for (auto contextIdx : xrange(candidatesContexts->size())) {
         TCandidatesContext& candidatesContext = (*candidatesContexts)[contextIdx];
+        const auto& learnData = *candidatesContext.LearnData;
         for (auto candId : xrange(candidatesContext.CandidateList.size())) {
             tasks.emplace_back(contextIdx, candId);
+            for (const auto& candidateInfo : candidatesContext.CandidateList[candId].Candidates) {
+                bucketCountSum += GetBucketCount(
+                    candidateInfo.SplitEnsemble,
+                    *learnData.GetQuantizedFeaturesInfo(),
+                    learnData.GetPackedBinaryFeaturesSize(),
+                    learnData.GetExclusiveFeatureBundlesMetaData(),
+                    learnData.GetFeaturesGroupsMetaData());
+                ++candidateCount;
+            }
         }
     }
 
-    ctx->LocalExecutor->ExecRange(
+    const EScoringParallelism parallelism = ChooseScoringParallelism(
+        candidateCount,
+        ctx->SampledDocs.GetDocCount(),
+        ctx->SampledDocs.GetCalcStatsIndexRanges().RangesCount(),
+        1 << currentTree.GetDepth(),
+        candidateCount ? SafeIntegerCast<int>(CeilDiv<i64>(bucketCountSum, candidateCount)) : 0,
+        ctx->LocalExecutor->GetThreadCount() + 1);
+    NPar::ILocalExecutor* documentsExecutor =
+        parallelism == EScoringParallelism::Candidates ? nullptr : ctx->LocalExecutor;
+    const auto forEachCandidate = [&] (const auto& body, int count) {
+        if (parallelism == EScoringParallelism::Documents) {
+            for (int idx : xrange(count)) {
+                body(idx);
+            }
+        } else {
+            ctx->LocalExecutor->ExecRange(body, 0, count, NPar::TLocalExecutor::WAIT_COMPLETE);
+        }
+    };
+
+    forEachCandidate(
         [&] (int taskIdx) {
+            CB_TRACE_SCOPE("Score candidate");
             TCandidatesContext& candidatesContext = (*candidatesContexts)[tasks[taskIdx].first];
             TCandidateList& candList = candidatesContext.CandidateList;
 
@@ -663,7 +698,7 @@ static void CalcBestScore(
                 }
             }
             TVector<TVector<double>> allScores(candidate.Candidates.size());
-            ctx->LocalExecutor->ExecRange(
+            forEachCandidate(
                 [&](int oneCandidate) {
                     THolder<IScoreCalcer> scoreCalcer;
                     if (IsPairwiseScoring(ctx->Params.LossFunctionDescription->GetLossFunction())) {
@@ -687,16 +722,14 @@ static void CalcBestScore(
                         ctx->UseTreeLevelCaching(),
                         currTreeMonotonicConstraints,
                         monotonicConstraints,
-                        ctx->LocalExecutor,
+                        documentsExecutor,
                         &ctx->PrevTreeLevelStats,
                         /*stats3d*/nullptr,
                         /*pairwiseStats*/nullptr,
                         scoreCalcer.Get());
                     scoreCalcer->GetScores().swap(allScores[oneCandidate]);
                 },
-                0,
-                candidate.Candidates.ysize(),
-                NPar::TLocalExecutor::WAIT_COMPLETE);
+                candidate.Candidates.ysize());
 
             if (splitEnsemble.IsSplitOfType(ESplitType::OnlineCtr) && candidate.ShouldDropCtrAfterCalc) {
                 fold->ClearCtrDataForProjectionIfOwned(splitEnsemble.SplitCandidate.Ctr.Projection);
@@ -718,9 +751,9 @@ static void CalcBestScore(
                 &candidate.Candidates
             );
         },
-        0,
-        tasks.ysize(),
-        NPar::TLocalExecutor::WAIT_COMPLETE);
+        tasks.ysize());
+
+    return parallelism;
 }
 
 static void DoBootstrap(
@@ -729,6 +762,7 @@ static void DoBootstrap(
     TLearnContext* ctx,
     ui32 leavesCount = 0) {
 
+    CB_TRACE_SCOPE("Bootstrap");
     if (!ctx->Params.SystemOptions->IsSingleHost()) {
         MapBootstrap(ctx);
     } else {
@@ -777,6 +811,7 @@ static void CalcBestScoreLeafwise(
 
     ctx->LocalExecutor->ExecRange(
         [&] (int taskIdx) {
+            CB_TRACE_SCOPE("Score candidate");
             TCandidatesContext& candidatesContext = (*candidatesContexts)[tasks[taskIdx].first];
             TCandidateList& candList = candidatesContext.CandidateList;
 
@@ -840,7 +875,8 @@ static double CalcScoreStDev(
         * CalcDerivativesStDevFromZeroMultiplier(learnSampleCount, modelLength);
 }
 
-static void CalcScores(
+// returns the scoring strategy if it was chosen by the cost model
+static TMaybe<EScoringParallelism> CalcScores(
     const TTrainingDataProviders& data,
     const TSplitTree& currentSplitTree,
     const double scoreStDev,
@@ -848,6 +884,7 @@ static void CalcScores(
     TFold* fold,
     TLearnContext* ctx) {
 
+    CB_TRACE_SCOPE("Calc scores");
     if (!ctx->Params.SystemOptions->IsSingleHost()) {
         if (IsPairwiseScoring(ctx->Params.LossFunctionDescription->GetLossFunction())) {
             MapRemotePairwiseCalcScore(scoreStDev, candidatesContexts, ctx);
@@ -866,7 +903,7 @@ static void CalcScores(
                 fold,
                 ctx);
         } else {
-            CalcBestScore(
+            return CalcBestScore(
                 data,
                 currentSplitTree,
                 randSeed,
@@ -876,6 +913,7 @@ static void CalcScores(
                 ctx);
         }
     }
+    return Nothing();
 }
 
 static void SelectBestCandidate(
@@ -886,6 +924,7 @@ static void SelectBestCandidate(
     double* bestScore,
     const TCandidateInfo** bestSplitCandidate) {
 
+    CB_TRACE_SCOPE("Select best candidate");
     for (const auto& candidatesContext : candidatesContexts) {
         for (const auto& subList : candidatesContext.CandidateList) {
             for (const auto& candidate : subList.Candidates) {
@@ -1144,12 +1183,17 @@ static TSplitTree GreedyTensorSearchOblivious(
         }
         profile.AddOperation(TStringBuilder() << "Bootstrap, depth " << curDepth);
 
-        CalcScores(data, currentSplitTree, scoreStDev, &candidatesContexts, fold, ctx);
+        const auto scoringParallelism
+            = CalcScores(data, currentSplitTree, scoreStDev, &candidatesContexts, fold, ctx);
 
         const size_t maxFeatureValueCount = CalcMaxFeatureValueCount(*fold, candidatesContexts);
 
         CheckInterrupted(); // check after long-lasting operation
         profile.AddOperation(TStringBuilder() << "Calc scores " << curDepth);
+        if (scoringParallelism) {
+            // takes no time, shows the strategy chosen for the depth in the profile
+            profile.AddOperation(TStringBuilder() << "Scoring parallelism " << *scoringParallelism << ", depth " << curDepth);
+        }
 
         double bestScore = MINIMAL_SCORE;
         const TCandidateInfo* bestSplitCandidate = nullptr;
@@ -1475,6 +1519,7 @@ void GreedyTensorSearch(
     TLearnContext* ctx,
     TVariant<TSplitTree, TNonSymmetricTreeStructure>* resTreeStructure) {
 
+    CB_TRACE_SCOPE("GreedyTensorSearch");
     TrimOnlineCTRcache({fold});
 
     ui32 learnSampleCount = data.Learn->ObjectsData->GetObjectCount();
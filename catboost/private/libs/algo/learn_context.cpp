@@ -1,6 +1,7 @@
 #include "learn_context.h"
 
 #include "apply.h"
+#include "approx_cache.h"
 #include "approx_dimension.h"
 #include "approx_updater_helpers.h"
 #include "calc_score_cache.h"
@@ -203,7 +204,7 @@ static inline ui32 UpdateCheckSumImpl(ui32 init, const TCtrFeature& ctrFeature)
 }
 
 
-static ui32 CalcCoreModelCheckSum(const TFullModel& model) {
+ui32 CalcCoreModelCheckSum(const TFullModel& model) {
     const auto& trees = *model.ModelTrees;
 
     return UpdateCheckSum(
@@ -345,6 +346,7 @@ TLearnContext::TLearnContext(
             params.ObliviousTreeOptions.Get(),
             initModel,
             initModelApplyCompatiblePools,
+            OutputOptions.CreateApproxCacheFullPath(),
             LocalExecutor
         );
     }
@@ -446,6 +448,7 @@ TLearnProgress::TLearnProgress(
     const NCatboostOptions::TObliviousTreeLearnerOptions& trainOptions,
     TMaybe<TFullModel*> initModel,
     NCB::TDataProviders initModelApplyCompatiblePools,
+    const TString& approxCacheFile,
     NPar::ILocalExecutor* localExecutor)
     : StartingApprox(foldsCreationParams.StartingApprox)
     , FoldCreationParamsCheckSum(foldCreationParamsCheckSum)
@@ -606,6 +609,7 @@ TLearnProgress::TLearnProgress(
             initModelApplyCompatiblePools,
             foldsCreationParams.IsOrderedBoosting,
             foldsCreationParams.StoreExpApproxes,
+            approxCacheFile,
             localExecutor
         );
     }
@@ -634,6 +638,7 @@ void TLearnProgress::SetSeparateInitModel(
     const TDataProviders& initModelApplyCompatiblePools,
     bool isOrderedBoosting,
     bool storeExpApproxes,
+    const TString& approxCacheFile,
     NPar::ILocalExecutor* localExecutor) {
 
     CATBOOST_DEBUG_LOG << "TLearnProgress::SetSeparateInitModel\n";
@@ -643,7 +648,28 @@ void TLearnProgress::SetSeparateInitModel(
 
     // Calc approxes
 
-    auto calcApproxFunction = [&] (const TObjectsDataProvider& objectsData) -> TVector<TVector<double>> {
+    TMaybe<TApproxCache> approxCache;
+    if (!approxCacheFile.empty()) {
+        TVector<ui64> objectCounts = {initModelApplyCompatiblePools.Learn->GetObjectCount()};
+        for (const auto& testPool : initModelApplyCompatiblePools.Test) {
+            objectCounts.push_back(testPool->GetObjectCount());
+        }
+        approxCache = TApproxCache::TryLoad(
+            approxCacheFile,
+            CalcApproxCacheModelCheckSum(initModel),
+            LearnAndTestQuantizedFeaturesCheckSum,
+            SafeIntegerCast<ui32>(ApproxDimension),
+            objectCounts);
+    }
+
+    // datasetIdx is 0 for learn and testIdx + 1 for tests
+    auto calcApproxFunction = [&] (
+        size_t datasetIdx,
+        const TObjectsDataProvider& objectsData) -> TVector<TVector<double>> {
+
+        if (approxCache) {
+            return approxCache->GetApprox(datasetIdx);
+        }
         return ApplyModelMulti(
             initModel,
             objectsData,
@@ -660,7 +686,7 @@ void TLearnProgress::SetSeparateInitModel(
         [&] () {
             const ui32 learnObjectCount = initModelApplyCompatiblePools.Learn->GetObjectCount();
 
-            AvrgApprox = calcApproxFunction(*initModelApplyCompatiblePools.Learn->ObjectsData);
+            AvrgApprox = calcApproxFunction(/*datasetIdx*/ 0, *initModelApplyCompatiblePools.Learn->ObjectsData);
 
             TVector<TConstArrayRef<double>> approxRef(AvrgApprox.begin(), AvrgApprox.end());
 
@@ -698,6 +724,7 @@ void TLearnProgress::SetSeparateInitModel(
         tasks.push_back(
             [&, testIdx] () {
                 TestApprox[testIdx] = calcApproxFunction(
+                    testIdx + 1,
                     *initModelApplyCompatiblePools.Test[testIdx]->ObjectsData);
             }
         );
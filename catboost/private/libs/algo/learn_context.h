@@ -136,6 +136,7 @@ public:
         const NCatboostOptions::TObliviousTreeLearnerOptions& trainOptions,
         TMaybe<TFullModel*> initModel,
         NCB::TDataProviders initModelApplyCompatiblePools,
+        const TString& approxCacheFile, // empty if init model approxes should not be loaded from a cache
         NPar::ILocalExecutor* localExecutor);
 
     // call after fold initizalization
@@ -144,6 +145,7 @@ public:
         const NCB::TDataProviders& initModelApplyCompatiblePools,
         bool isOrderedBoosting,
         bool storeExpApproxes,
+        const TString& approxCacheFile,
         NPar::ILocalExecutor* localExecutor);
 
     void PrepareForContinuation();
@@ -234,3 +236,6 @@ bool NeedToUseTreeLevelCaching(
     const NCatboostOptions::TCatBoostOptions& params,
     ui32 maxBodyTailCount,
     ui32 approxDimension);
+
+// splits, leaf values and features of the model, used to check that approxes correspond to the model
+ui32 CalcCoreModelCheckSum(const TFullModel& model);
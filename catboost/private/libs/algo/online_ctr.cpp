@@ -10,6 +10,7 @@
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/helpers/mem_usage.h>
 #include <catboost/libs/helpers/resource_constrained_executor.h>
+#include <catboost/libs/logging/trace.h>
 #include <catboost/libs/model/ctr_value_table.h>
 #include <catboost/libs/model/model.h>
 
@@ -612,6 +613,10 @@ void ComputeOnlineCTRs(
     size_t learnSampleCount = data.Learn->GetObjectCount();
     const TVector<size_t>& testOffsets = data.CalcTestOffsets();
     size_t totalSampleCount = learnSampleCount + data.GetTestSampleCount();
+    CB_TRACE_SCOPE_WITH_COUNTERS(
+        "ComputeOnlineCTRs",
+        totalSampleCount,
+        totalSampleCount * (sizeof(ui64) + ctrInfo.size() * sizeof(ui8)));
 
     const auto& quantizedFeaturesInfo = *data.Learn->ObjectsData->GetQuantizedFeaturesInfo();
 
@@ -12,6 +12,7 @@
 #include <catboost/libs/data/objects.h>
 #include <catboost/libs/helpers/map_merge.h>
 #include <catboost/libs/helpers/dispatch_generic_lambda.h>
+#include <catboost/libs/logging/trace.h>
 #include <catboost/private/libs/algo_helpers/online_predictor.h>
 #include <catboost/private/libs/algo_helpers/scoring_helpers.h>
 #include <catboost/private/libs/data_types/pair.h>
@@ -23,6 +24,8 @@
 #include <library/cpp/dot_product/dot_product.h>
 
 #include <util/generic/array_ref.h>
+#include <util/generic/utility.h>
+#include <util/generic/ymath.h>
 
 #include <type_traits>
 
@@ -770,6 +773,45 @@ static void CalculateNonPairwiseScore(
 }
 
 
+EScoringParallelism ChooseScoringParallelism(
+    int candidateCount,
+    int docCount,
+    int docBlockCount,
+    int leafCount,
+    int bucketCount,
+    int threadCount
+) {
+    if (threadCount <= 1 || candidateCount == 0) {
+        return EScoringParallelism::Candidates;
+    }
+    // all costs are in bucket statistics updates
+    const double syncCost = 1e4;
+    // document blocks of different candidates compete for the threads
+    const double hybridOverhead = 1.1;
+
+    const int blockCount = Max(docBlockCount, 1);
+    const double blockStatsCost = double(leafCount) * bucketCount;
+    const double candidateCost = double(docCount) + blockCount * blockStatsCost;
+
+    const double candidatesTime = CeilDiv(candidateCount, threadCount) * candidateCost;
+    const double documentsTime = double(candidateCount) * (
+        CeilDiv(blockCount, threadCount) * (double(docCount) / blockCount)
+        + blockCount * blockStatsCost
+        + syncCost
+    );
+    // all blocks share the threads, but a thread can't take less than a block
+    const double hybridTime = hybridOverhead * Max(
+        double(candidateCount) * (candidateCost + syncCost) / threadCount,
+        CeilDiv<i64>(i64(candidateCount) * blockCount, threadCount) * (double(docCount) / blockCount)
+    );
+
+    if (candidatesTime <= documentsTime && candidatesTime <= hybridTime) {
+        return EScoringParallelism::Candidates;
+    }
+    return documentsTime <= hybridTime ? EScoringParallelism::Documents : EScoringParallelism::Hybrid;
+}
+
+
 void CalcStatsAndScores(
     const TQuantizedForCPUObjectsDataProvider& objectsDataProvider,
     const std::tuple<const TOnlineCtrBase&, const TOnlineCtrBase&>& allCtrs,
@@ -794,6 +836,7 @@ void CalcStatsAndScores(
         "stats3d, pairwiseStats, and scoreCalcer are empty - nothing to calculate"
     );
     CB_ENSURE(!scoreCalcer || initialFold, "initialFold must be non-nullptr for scores calculation");
+    CB_TRACE_SCOPE_WITH_COUNTERS("CalcStatsAndScores", fold.GetDocCount(), /*bytes*/ -1);
 
     const auto& splitEnsemble = candidateInfo.SplitEnsemble;
     const bool isPairwiseScoring = IsPairwiseScoring(fitParams.LossFunctionDescription->GetLossFunction());
@@ -30,10 +30,32 @@ namespace NPar {
 }
 
 
+// How the threads are shared by CalcStatsAndScores calls for the candidates of one tree level
+enum class EScoringParallelism {
+    Candidates, // candidates are scored in parallel, documents of each one by a single thread
+    Documents,  // candidates are scored one after another, each one by all threads over document blocks
+    Hybrid      // candidates and their document blocks are scored in parallel
+};
+
+// Cost model of the strategies: each candidate adds every document to its histogram
+// and merges leafCount * bucketCount statistics per document block, Documents and Hybrid
+// also pay for a fork-join per candidate.
+// bucketCount is the mean bucket count of the candidates.
+EScoringParallelism ChooseScoringParallelism(
+    int candidateCount,
+    int docCount,
+    int docBlockCount,
+    int leafCount,
+    int bucketCount,
+    int threadCount);
+
+
 // Function that calculates score statistics for each split of a split candidate
 // (candidate is a feature == all splits of this feature).
 // This function does all the work - it calculates sums in buckets, gets real sums for splits and
 // (optionally - if scoreCalcer is non-null) calculates scores.
+// Document blocks are processed in parallel by localExecutor or sequentially if it is nullptr,
+// the result is the same.
 void CalcStatsAndScores(
     const NCB::TQuantizedForCPUObjectsDataProvider& objectsDataProvider,
     const std::tuple<const TOnlineCtrBase&, const TOnlineCtrBase&>& allCtrs,
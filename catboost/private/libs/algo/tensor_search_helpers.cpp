@@ -6,6 +6,7 @@
 
 #include <catboost/libs/data/objects.h>
 #include <catboost/libs/helpers/restorable_rng.h>
+#include <catboost/private/libs/algo_helpers/approx_calcer_multi_helpers.h>
 #include <catboost/private/libs/options/catboost_options.h>
 
 #include <library/cpp/threading/local_executor/local_executor.h>
@@ -572,7 +573,35 @@ void CalcWeightedDerivatives(
         blockParams.SetBlockSize(1000);
 
         Y_ASSERT(error.GetErrorType() == EErrorType::PerObjectError);
-        if (const auto multiError = dynamic_cast<const TMultiDerCalcer*>(&error)) {
+        if (approxDimension > 1 && error.HasCalcDersMultiBatch()) {
+            const TVector<TConstArrayRef<float>> multiTarget(
+                takenFold->LearnTarget.begin(),
+                takenFold->LearnTarget.end());
+            localExecutor->ExecRangeWithThrow(
+                [&](int blockId) {
+                    const int blockOffset = blockId * blockParams.GetBlockSize();
+                    const int blockEnd = Min<int>(blockOffset + blockParams.GetBlockSize(), tailFinish);
+                    TVector<double> ders;
+                    CalcDersMultiBatch(
+                        multiTarget,
+                        weight,
+                        approx,
+                        /*approxDeltas*/ {},
+                        error,
+                        blockOffset,
+                        blockEnd,
+                        &ders,
+                        /*der2*/ nullptr);
+                    for (int dim = 0; dim < approxDimension; ++dim) {
+                        for (int docId : xrange(blockOffset, blockEnd)) {
+                            (*weightedDerivatives)[dim][docId] = ders[(docId - blockOffset) * approxDimension + dim];
+                        }
+                    }
+                },
+                0,
+                blockParams.GetBlockCount(),
+                NPar::TLocalExecutor::WAIT_COMPLETE);
+        } else if (const auto multiError = dynamic_cast<const TMultiDerCalcer*>(&error)) {
             const auto& multiTarget = takenFold->LearnTarget;
             localExecutor->ExecRangeWithThrow(
                 [&](int blockId) {
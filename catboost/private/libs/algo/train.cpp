@@ -16,6 +16,7 @@
 #include <catboost/libs/helpers/interrupt.h>
 #include <catboost/libs/helpers/query_info_helper.h>
 #include <catboost/libs/logging/profile_info.h>
+#include <catboost/libs/logging/trace.h>
 #include <catboost/private/libs/algo/approx_calcer/leafwise_approx_calcer.h>
 #include <catboost/private/libs/algo_helpers/approx_calcer_helpers.h>
 #include <catboost/private/libs/algo_helpers/error_functions.h>
@@ -170,6 +171,7 @@ void CalcApproxesLeafwise(
 }
 
 void TrainOneIteration(const NCB::TTrainingDataProviders& data, TLearnContext* ctx) {
+    CB_TRACE_SCOPE("TrainOneIteration");
     const auto error = BuildError(ctx->Params, ctx->ObjectiveDescriptor);
     ctx->LearnProgress->HessianType = error->GetHessianType();
     TProfileInfo& profile = ctx->Profile;
@@ -215,6 +217,7 @@ void TrainOneIteration(const NCB::TTrainingDataProviders& data, TLearnContext* c
         if (ctx->Params.SystemOptions->IsSingleHost()) {
             ctx->LocalExecutor->ExecRangeWithThrow(
                 [&](int bodyTailId) {
+                    CB_TRACE_SCOPE("Calc derivatives");
                     CalcWeightedDerivatives(
                         *error,
                         bodyTailId,
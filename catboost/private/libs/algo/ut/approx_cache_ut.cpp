@@ -0,0 +1,230 @@
+#include <library/cpp/testing/unittest/registar.h>
+
+#include <catboost/libs/data/data_provider_builders.h>
+#include <catboost/libs/train_lib/train_model.h>
+#include <catboost/private/libs/algo/approx_cache.h>
+#include <catboost/private/libs/algo/apply.h>
+
+#include <library/cpp/json/json_value.h>
+
+#include <util/folder/path.h>
+#include <util/folder/tempdir.h>
+#include <util/generic/xrange.h>
+#include <util/memory/blob.h>
+#include <util/random/fast.h>
+#include <util/string/cast.h>
+#include <util/system/fs.h>
+#include <util/system/mktemp.h>
+#include <util/system/tempfile.h>
+
+using namespace NCB;
+
+
+// float features 0 and 1, feature 2 is categorical if withCatFeature
+static TDataProviderPtr MakeApproxCacheTestPool(ui32 docCount, ui32 seed, bool withCatFeature) {
+    const ui32 floatFeatureCount = 2;
+
+    TReallyFastRng32 rng(seed);
+    TVector<TVector<float>> floatFeatures(floatFeatureCount, TVector<float>(docCount)); // [featureIdx][objectIdx]
+    TVector<TString> catFeature(docCount);
+    TVector<float> target(docCount);
+    for (auto docIdx : xrange(docCount)) {
+        for (auto featureIdx : xrange(floatFeatureCount)) {
+            floatFeatures[featureIdx][docIdx] = rng.GenRandReal2();
+        }
+        const ui32 category = rng.Uniform(10);
+        catFeature[docIdx] = ToString(category);
+        target[docIdx] = floatFeatures[0][docIdx] - floatFeatures[1][docIdx]
+            + (withCatFeature ? 0.1f * category : 0.0f);
+    }
+
+    return CreateDataProvider(
+        [&] (IRawFeaturesOrderDataVisitor* visitor) {
+            TDataMetaInfo metaInfo;
+            metaInfo.TargetType = ERawTargetType::Float;
+            metaInfo.TargetCount = 1;
+            metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                floatFeatureCount + (withCatFeature ? 1 : 0),
+                withCatFeature ? TVector<ui32>{floatFeatureCount} : TVector<ui32>{},
+                TVector<ui32>{},
+                TVector<ui32>{},
+                TVector<TString>{});
+
+            visitor->Start(metaInfo, docCount, EObjectsOrder::Undefined, {});
+            for (auto featureIdx : xrange(floatFeatureCount)) {
+                visitor->AddFloatFeature(
+                    featureIdx,
+                    MakeIntrusive<TTypeCastArrayHolder<float, float>>(std::move(floatFeatures[featureIdx])));
+            }
+            if (withCatFeature) {
+                visitor->AddCatFeature(floatFeatureCount, TConstArrayRef<TString>(catFeature));
+            }
+            visitor->AddTarget(MakeIntrusive<TTypeCastArrayHolder<float, float>>(std::move(target)));
+            visitor->Finish();
+        }
+    );
+}
+
+// approxCacheFile is relative to trainDir and is not used if empty
+static TFullModel TrainWithApproxCache(
+    const TDataProviders& dataProviders,
+    const TString& trainDir,
+    const TString& approxCacheFile,
+    TMaybe<TFullModel*> initModel,
+    TEvalResult* evalResult) {
+
+    NJson::TJsonValue params;
+    params.InsertValue("iterations", 10);
+    params.InsertValue("random_seed", 1);
+    params.InsertValue("thread_count", 2);
+    params.InsertValue("one_hot_max_size", 1);
+    params.InsertValue("boost_from_average", false); // not supported with init model
+    params.InsertValue("train_dir", trainDir);
+    if (!approxCacheFile.empty()) {
+        params.InsertValue("approx_cache_file", approxCacheFile);
+    }
+
+    TFullModel model;
+    TrainModel(
+        params,
+        nullptr,
+        Nothing(),
+        Nothing(),
+        dataProviders,
+        initModel,
+        /*initLearnProgress*/ nullptr,
+        "",
+        &model,
+        {evalResult});
+    return model;
+}
+
+// checksums are stored after ui64 magic and ui32 version, see TApproxCacheHeader
+static ui32 ReadApproxCacheFeaturesCheckSum(const TString& path, ui32 expectedModelCheckSum) {
+    const TBlob data = TBlob::FromFileContent(path);
+    UNIT_ASSERT(data.Size() >= 20);
+    ui32 checkSums[2];
+    memcpy(checkSums, data.AsCharPtr() + 12, sizeof(checkSums));
+    UNIT_ASSERT_VALUES_EQUAL(checkSums[0], expectedModelCheckSum);
+    return checkSums[1];
+}
+
+Y_UNIT_TEST_SUITE(TApproxCache) {
+    Y_UNIT_TEST(TestSaveLoad) {
+        const TTempFile cacheFile(MakeTempName());
+        const TVector<TVector<double>> learnApprox = {{0.5, -1.0, 2.0}, {1.5, 0.0, -3.25}};
+        const TVector<TVector<TVector<double>>> testApprox = {{{4.0}, {-4.0}}, {{}, {}}};
+        TApproxCache::Save(/*modelCheckSum*/ 17, /*featuresCheckSum*/ 42, learnApprox, testApprox, cacheFile.Name());
+        UNIT_ASSERT(!NFs::Exists(cacheFile.Name() + ".tmp"));
+
+        const TVector<ui64> objectCounts = {3, 1, 0};
+        const auto cache = TApproxCache::TryLoad(cacheFile.Name(), 17, 42, 2, objectCounts);
+        UNIT_ASSERT(cache);
+        UNIT_ASSERT_VALUES_EQUAL(cache->GetApprox(0), learnApprox);
+        UNIT_ASSERT_VALUES_EQUAL(cache->GetApprox(1), testApprox[0]);
+        UNIT_ASSERT_VALUES_EQUAL(cache->GetApprox(2), testApprox[1]);
+    }
+
+    Y_UNIT_TEST(TestMismatchIsIgnored) {
+        const TTempFile cacheFile(MakeTempName());
+        const TVector<TVector<double>> learnApprox = {{0.5, -1.0, 2.0}};
+        const TVector<TVector<TVector<double>>> testApprox = {{{4.0, 5.0}}};
+        TApproxCache::Save(/*modelCheckSum*/ 17, /*featuresCheckSum*/ 42, learnApprox, testApprox, cacheFile.Name());
+
+        const TVector<ui64> objectCounts = {3, 2};
+        UNIT_ASSERT(TApproxCache::TryLoad(cacheFile.Name(), 17, 42, 1, objectCounts));
+        UNIT_ASSERT(!TApproxCache::TryLoad(cacheFile.Name(), 18, 42, 1, objectCounts));
+        UNIT_ASSERT(!TApproxCache::TryLoad(cacheFile.Name(), 17, 43, 1, objectCounts));
+        UNIT_ASSERT(!TApproxCache::TryLoad(cacheFile.Name(), 17, 42, 2, objectCounts));
+        UNIT_ASSERT(!TApproxCache::TryLoad(cacheFile.Name(), 17, 42, 1, TVector<ui64>{3, 3}));
+        UNIT_ASSERT(!TApproxCache::TryLoad(cacheFile.Name(), 17, 42, 1, TVector<ui64>{3}));
+        UNIT_ASSERT(!TApproxCache::TryLoad(cacheFile.Name() + ".absent", 17, 42, 1, objectCounts));
+    }
+
+    Y_UNIT_TEST(TestTrainingContinuation) {
+        TTempDir trainDir;
+        TDataProviders dataProviders;
+        dataProviders.Learn = MakeApproxCacheTestPool(2000, /*seed*/ 1, /*withCatFeature*/ false);
+        dataProviders.Test.push_back(MakeApproxCacheTestPool(500, /*seed*/ 2, /*withCatFeature*/ false));
+
+        TEvalResult initEvalResult;
+        TFullModel initModel = TrainWithApproxCache(
+            dataProviders, trainDir.Name(), "approx_cache", Nothing(), &initEvalResult);
+        const TString cachePath = TFsPath(trainDir.Name()) / "approx_cache";
+        UNIT_ASSERT(NFs::Exists(cachePath));
+        const ui32 initModelCheckSum = CalcApproxCacheModelCheckSum(initModel);
+        const ui32 featuresCheckSum = ReadApproxCacheFeaturesCheckSum(cachePath, initModelCheckSum);
+
+        TEvalResult cachedEvalResult;
+        const TFullModel cachedModel = TrainWithApproxCache(
+            dataProviders, trainDir.Name(), "approx_cache", &initModel, &cachedEvalResult);
+        TEvalResult appliedEvalResult;
+        const TFullModel appliedModel = TrainWithApproxCache(
+            dataProviders, trainDir.Name(), "", &initModel, &appliedEvalResult);
+
+        // approxes accumulated during training and approxes of the applied model are summed in different order
+        const auto& cachedTrees = *cachedModel.ModelTrees;
+        const auto& appliedTrees = *appliedModel.ModelTrees;
+        UNIT_ASSERT_VALUES_EQUAL(cachedTrees.GetTreeCount(), 20);
+        UNIT_ASSERT_EQUAL(
+            cachedTrees.GetModelTreeData()->GetTreeSplits(),
+            appliedTrees.GetModelTreeData()->GetTreeSplits());
+        const auto cachedLeafValues = cachedTrees.GetModelTreeData()->GetLeafValues();
+        const auto appliedLeafValues = appliedTrees.GetModelTreeData()->GetLeafValues();
+        UNIT_ASSERT_VALUES_EQUAL(cachedLeafValues.size(), appliedLeafValues.size());
+        for (auto leafIdx : xrange(cachedLeafValues.size())) {
+            UNIT_ASSERT_DOUBLES_EQUAL(cachedLeafValues[leafIdx], appliedLeafValues[leafIdx], 1e-9);
+        }
+
+        const auto& cachedTestApprox = cachedEvalResult.GetRawValuesConstRef()[0][0];
+        const auto& appliedTestApprox = appliedEvalResult.GetRawValuesConstRef()[0][0];
+        UNIT_ASSERT_VALUES_EQUAL(cachedTestApprox.size(), 500);
+        UNIT_ASSERT_VALUES_EQUAL(cachedTestApprox.size(), appliedTestApprox.size());
+        for (auto docIdx : xrange(cachedTestApprox.size())) {
+            UNIT_ASSERT_DOUBLES_EQUAL(cachedTestApprox[docIdx], appliedTestApprox[docIdx], 1e-9);
+        }
+
+        // the same results above could come from applying the init model again, so check that
+        // continuation starts from the cached approxes by replacing them with sentinel values
+        const double sentinelApprox = 100.0;
+        TApproxCache::Save(
+            initModelCheckSum,
+            featuresCheckSum,
+            {TVector<double>(2000, sentinelApprox)},
+            {{TVector<double>(500, sentinelApprox)}},
+            cachePath);
+        TEvalResult sentinelEvalResult;
+        const TFullModel sentinelModel = TrainWithApproxCache(
+            dataProviders, trainDir.Name(), "approx_cache", &initModel, &sentinelEvalResult);
+        UNIT_ASSERT_VALUES_EQUAL(sentinelModel.ModelTrees->GetTreeCount(), 20);
+
+        // new trees compensate the learn sentinel, test approxes are accumulated over the test sentinel
+        const auto newTreesTestApprox = ApplyModelMulti(
+            sentinelModel,
+            *dataProviders.Test[0]->ObjectsData,
+            EPredictionType::RawFormulaVal,
+            /*begin*/ 10,
+            /*end*/ 20)[0];
+        const auto& sentinelTestApprox = sentinelEvalResult.GetRawValuesConstRef()[0][0];
+        UNIT_ASSERT_VALUES_EQUAL(sentinelTestApprox.size(), 500);
+        for (auto docIdx : xrange(sentinelTestApprox.size())) {
+            UNIT_ASSERT_LT(newTreesTestApprox[docIdx], -0.1 * sentinelApprox);
+            UNIT_ASSERT_DOUBLES_EQUAL(
+                sentinelTestApprox[docIdx],
+                sentinelApprox + newTreesTestApprox[docIdx],
+                1e-6);
+        }
+    }
+
+    Y_UNIT_TEST(TestNotSavedForModelWithCtrs) {
+        TTempDir trainDir;
+        TDataProviders dataProviders;
+        dataProviders.Learn = MakeApproxCacheTestPool(2000, /*seed*/ 1, /*withCatFeature*/ true);
+
+        TEvalResult evalResult;
+        const TFullModel model = TrainWithApproxCache(
+            dataProviders, trainDir.Name(), "approx_cache", Nothing(), &evalResult);
+        UNIT_ASSERT(!model.ModelTrees->GetCtrFeatures().empty());
+        UNIT_ASSERT(!NFs::Exists(TFsPath(trainDir.Name()) / "approx_cache"));
+    }
+}
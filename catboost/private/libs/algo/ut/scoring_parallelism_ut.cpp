@@ -0,0 +1,166 @@
+#include <library/cpp/testing/unittest/registar.h>
+
+#include <catboost/libs/data/data_provider_builders.h>
+#include <catboost/libs/train_lib/train_model.h>
+#include <catboost/private/libs/algo/scoring.h>
+
+#include <library/cpp/json/json_value.h>
+
+#include <util/folder/path.h>
+#include <util/folder/tempdir.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/stream/file.h>
+
+
+using namespace NCB;
+
+
+static TDataProviders MakeScoringTestData(bool withPairs) {
+    const ui32 docCount = 20000;
+    const ui32 featureCount = 2;
+    const ui32 groupSize = 20;
+
+    TReallyFastRng32 rng(42);
+    TVector<TVector<float>> features(featureCount, TVector<float>(docCount)); // [featureIdx][objectIdx]
+    TVector<float> target(docCount);
+    for (auto docIdx : xrange(docCount)) {
+        for (auto featureIdx : xrange(featureCount)) {
+            features[featureIdx][docIdx] = rng.GenRandReal2();
+        }
+        target[docIdx] = features[0][docIdx] + 0.5f * features[1][docIdx] + 0.1f * rng.GenRandReal2();
+    }
+
+    TDataProviders dataProviders;
+    dataProviders.Learn = CreateDataProvider(
+        [&] (IRawFeaturesOrderDataVisitor* visitor) {
+            TDataMetaInfo metaInfo;
+            metaInfo.TargetType = ERawTargetType::Float;
+            metaInfo.TargetCount = 1;
+            metaInfo.HasGroupId = withPairs;
+            metaInfo.HasPairs = withPairs;
+            metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                featureCount,
+                TVector<ui32>{},
+                TVector<ui32>{},
+                TVector<ui32>{},
+                TVector<TString>{});
+
+            visitor->Start(metaInfo, docCount, EObjectsOrder::Undefined, {});
+            for (auto featureIdx : xrange(featureCount)) {
+                visitor->AddFloatFeature(
+                    featureIdx,
+                    MakeIntrusive<TTypeCastArrayHolder<float, float>>(TVector<float>(features[featureIdx])));
+            }
+            if (withPairs) {
+                TVector<TPair> pairs;
+                for (auto docIdx : xrange(docCount)) {
+                    visitor->AddGroupId(docIdx, docIdx / groupSize);
+                    if (docIdx % groupSize) {
+                        const bool isPrevBetter = target[docIdx - 1] > target[docIdx];
+                        pairs.emplace_back(
+                            isPrevBetter ? docIdx - 1 : docIdx,
+                            isPrevBetter ? docIdx : docIdx - 1,
+                            1.0f);
+                    }
+                }
+                visitor->SetPairs(TRawPairsData(std::move(pairs)));
+            }
+            visitor->AddTarget(MakeIntrusive<TTypeCastArrayHolder<float, float>>(std::move(target)));
+            visitor->Finish();
+        }
+    );
+    return dataProviders;
+}
+
+// writes the detailed profile to trainDir if it is not empty
+static TFullModel TrainScoringTestModel(
+    const TDataProviders& dataProviders,
+    const TString& lossFunction,
+    int threadCount,
+    const TString& trainDir = TString()) {
+
+    NJson::TJsonValue plainFitParams;
+    plainFitParams.InsertValue("loss_function", lossFunction);
+    plainFitParams.InsertValue("random_seed", 5);
+    plainFitParams.InsertValue("iterations", 5);
+    plainFitParams.InsertValue("depth", 4);
+    if (trainDir.empty()) {
+        plainFitParams.InsertValue("allow_writing_files", false);
+    } else {
+        plainFitParams.InsertValue("train_dir", trainDir);
+        plainFitParams.InsertValue("detailed_profile", true);
+    }
+    plainFitParams.InsertValue("thread_count", threadCount);
+    // many document blocks, so that the cost model does not choose Candidates with several threads
+    plainFitParams.InsertValue("dev_score_calc_obj_block_size", 1000);
+
+    TEvalResult evalResult;
+    TFullModel model;
+    TrainModel(
+        plainFitParams,
+        nullptr,
+        Nothing(),
+        Nothing(),
+        dataProviders,
+        /*initModel*/ Nothing(),
+        /*initLearnProgress*/ nullptr,
+        "",
+        &model,
+        {&evalResult});
+    return model;
+}
+
+
+Y_UNIT_TEST_SUITE(ScoringParallelism) {
+    Y_UNIT_TEST(WideAndShort) {
+        // 20k features, 100k documents in one block
+        UNIT_ASSERT_EQUAL(
+            ChooseScoringParallelism(20000, 100000, 1, 64, 255, 32),
+            EScoringParallelism::Candidates);
+    }
+
+    Y_UNIT_TEST(TallAndNarrow) {
+        // a few features, documents in many blocks
+        UNIT_ASSERT_EQUAL(
+            ChooseScoringParallelism(2, 100000000, 20, 64, 255, 32),
+            EScoringParallelism::Documents);
+        UNIT_ASSERT_EQUAL(
+            ChooseScoringParallelism(50, 500000000, 100, 64, 255, 32),
+            EScoringParallelism::Hybrid);
+    }
+
+    Y_UNIT_TEST(SingleThread) {
+        UNIT_ASSERT_EQUAL(
+            ChooseScoringParallelism(2, 100000000, 20, 64, 255, 1),
+            EScoringParallelism::Candidates);
+    }
+
+    // a single thread scores documents without an executor, several threads score them in parallel blocks
+    Y_UNIT_TEST(SameModelWithAndWithoutExecutor) {
+        UNIT_ASSERT_EQUAL(ChooseScoringParallelism(2, 20000, 20, 1, 256, 4), EScoringParallelism::Hybrid);
+        UNIT_ASSERT_EQUAL(ChooseScoringParallelism(2, 20000, 20, 8, 256, 4), EScoringParallelism::Hybrid);
+
+        const auto pointwiseData = MakeScoringTestData(/*withPairs*/ false);
+        UNIT_ASSERT_EQUAL(
+            TrainScoringTestModel(pointwiseData, "RMSE", 1),
+            TrainScoringTestModel(pointwiseData, "RMSE", 4));
+
+        const auto pairwiseData = MakeScoringTestData(/*withPairs*/ true);
+        UNIT_ASSERT_EQUAL(
+            TrainScoringTestModel(pairwiseData, "PairLogitPairwise", 1),
+            TrainScoringTestModel(pairwiseData, "PairLogitPairwise", 4));
+    }
+
+    Y_UNIT_TEST(ProfileShowsChosenStrategy) {
+        const auto data = MakeScoringTestData(/*withPairs*/ false);
+        for (auto [threadCount, strategy] : {std::make_pair(1, "Candidates"), std::make_pair(4, "Hybrid")}) {
+            TTempDir trainDir;
+            TrainScoringTestModel(data, "RMSE", threadCount, trainDir.Name());
+            const TString profile = TFileInput(TFsPath(trainDir.Name()) / "catboost_profile.log").ReadAll();
+            UNIT_ASSERT_STRING_CONTAINS(profile, TString("Scoring parallelism ") + strategy + ", depth 0");
+            UNIT_ASSERT_STRING_CONTAINS(profile, "Calc scores 0");
+        }
+    }
+}
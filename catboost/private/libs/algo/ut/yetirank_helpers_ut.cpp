@@ -0,0 +1,105 @@
+#include <catboost/private/libs/algo/yetirank_helpers.h>
+#include <catboost/private/libs/options/loss_description.h>
+
+#include <library/cpp/testing/unittest/registar.h>
+#include <library/cpp/threading/local_executor/local_executor.h>
+
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+static TVector<TQueryInfo> GenerateYetiRankPairs(
+    TStringBuf lossDescription,
+    TConstArrayRef<ui32> querySizes,
+    TConstArrayRef<double> expApproxes,
+    TConstArrayRef<float> relevances,
+    int threadCount
+) {
+    TVector<TQueryInfo> queriesInfo;
+    ui32 queryBegin = 0;
+    for (ui32 querySize : querySizes) {
+        queriesInfo.emplace_back(queryBegin, queryBegin + querySize);
+        queryBegin += querySize;
+    }
+    NPar::TLocalExecutor executor;
+    executor.RunAdditionalThreads(threadCount - 1);
+    UpdatePairsForYetiRank(
+        expApproxes,
+        relevances,
+        NCatboostOptions::ParseLossDescription(lossDescription),
+        /*randomSeed*/ 42,
+        /*queryBegin*/ 0,
+        queriesInfo.ysize(),
+        &queriesInfo,
+        &executor);
+    return queriesInfo;
+}
+
+static void GenerateQueries(
+    TConstArrayRef<ui32> querySizes,
+    TVector<double>* expApproxes,
+    TVector<float>* relevances
+) {
+    TFastRng64 rand(0);
+    for (ui32 querySize : querySizes) {
+        for (ui32 docIdx : xrange(querySize)) {
+            Y_UNUSED(docIdx);
+            expApproxes->push_back(0.5 + rand.GenRandReal1());
+            relevances->push_back(rand.Uniform(5));
+        }
+    }
+}
+
+Y_UNIT_TEST_SUITE(YetiRankPairs) {
+    Y_UNIT_TEST(WinnersAreMoreRelevant) {
+        const TVector<ui32> querySizes = {1, 2, 17, 300, 5};
+        TVector<double> expApproxes;
+        TVector<float> relevances;
+        GenerateQueries(querySizes, &expApproxes, &relevances);
+
+        const auto queriesInfo = GenerateYetiRankPairs("YetiRank", querySizes, expApproxes, relevances, 2);
+        for (const auto& queryInfo : queriesInfo) {
+            const ui32 querySize = queryInfo.End - queryInfo.Begin;
+            UNIT_ASSERT_VALUES_EQUAL(queryInfo.Competitors.size(), querySize);
+            for (ui32 winnerIdx : xrange(querySize)) {
+                const auto& competitors = queryInfo.Competitors[winnerIdx];
+                for (auto competitorIdx : xrange(competitors.size())) {
+                    const auto& competitor = competitors[competitorIdx];
+                    UNIT_ASSERT(competitor.Id < querySize);
+                    UNIT_ASSERT(competitorIdx == 0 || competitors[competitorIdx - 1].Id < competitor.Id);
+                    UNIT_ASSERT(relevances[queryInfo.Begin + winnerIdx] > relevances[queryInfo.Begin + competitor.Id]);
+                    UNIT_ASSERT(competitor.Weight > 0);
+                }
+            }
+        }
+    }
+
+    Y_UNIT_TEST(TopLimitsPairCount) {
+        const TVector<ui32> querySizes = {5000, 3, 2000};
+        TVector<double> expApproxes;
+        TVector<float> relevances;
+        GenerateQueries(querySizes, &expApproxes, &relevances);
+
+        const auto queriesInfo = GenerateYetiRankPairs("YetiRank:permutations=4;top=10", querySizes, expApproxes, relevances, 1);
+        for (const auto& queryInfo : queriesInfo) {
+            size_t pairCount = 0;
+            for (const auto& competitors : queryInfo.Competitors) {
+                pairCount += competitors.size();
+            }
+            UNIT_ASSERT(pairCount <= 4 * (10 - 1));
+        }
+    }
+
+    Y_UNIT_TEST(DoesNotDependOnThreadCount) {
+        const TVector<ui32> querySizes = {40, 1000, 7, 7, 250};
+        TVector<double> expApproxes;
+        TVector<float> relevances;
+        GenerateQueries(querySizes, &expApproxes, &relevances);
+
+        for (TStringBuf lossDescription : {"YetiRank", "YetiRank:top=20"}) {
+            const auto oneThread = GenerateYetiRankPairs(lossDescription, querySizes, expApproxes, relevances, 1);
+            const auto fourThreads = GenerateYetiRankPairs(lossDescription, querySizes, expApproxes, relevances, 4);
+            UNIT_ASSERT_EQUAL(oneThread, fourThreads);
+        }
+    }
+}
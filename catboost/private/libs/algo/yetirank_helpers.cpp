@@ -8,8 +8,26 @@
 
 #include <library/cpp/threading/local_executor/local_executor.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/vector.h>
 
+#include <tuple>
+
+
+namespace {
+    struct TYetiRankPair {
+        ui32 Winner;
+        ui32 Loser;
+        float Weight;
+    };
+
+    // reused between queries processed by the same thread
+    struct TYetiRankPairsBuffers {
+        TVector<int> Indices;
+        TVector<double> BootstrappedApprox;
+        TVector<TYetiRankPair> Pairs;
+    };
+}
 
 static void GenerateYetiRankPairsForQuery(
     const float* relevs,
@@ -18,7 +36,9 @@ static void GenerateYetiRankPairsForQuery(
     ui32 querySize,
     int permutationCount,
     double decaySpeed,
+    int topSize,
     ui64 randomSeed,
+    TYetiRankPairsBuffers* buffers,
     TVector<TVector<TCompetitor>>* competitors
 ) {
     TFastRng64 rand(randomSeed);
@@ -26,26 +46,34 @@ static void GenerateYetiRankPairsForQuery(
     competitorsRef.clear();
     competitorsRef.resize(querySize);
 
-    TVector<int> indices(querySize);
-    TVector<TVector<float>> competitorsWeights(querySize, TVector<float>(querySize));
+    // Only neighbours in the sampled permutations are paired, so pairs are accumulated sparsely:
+    // at most permutationCount * (rankedSize - 1) of them instead of querySize x querySize weights.
+    const ui32 rankedSize = topSize == -1 ? querySize : Min<ui32>(topSize, querySize);
+    TVector<int>& indices = buffers->Indices;
+    TVector<double>& bootstrappedApprox = buffers->BootstrappedApprox;
+    TVector<TYetiRankPair>& pairs = buffers->Pairs;
+    indices.yresize(querySize);
+    bootstrappedApprox.yresize(querySize);
+    pairs.clear();
     for (int permutationIndex = 0; permutationIndex < permutationCount; ++permutationIndex) {
         std::iota(indices.begin(), indices.end(), 0);
-        TVector<double> bootstrappedApprox(expApproxes, expApproxes + querySize);
         for (ui32 docId = 0; docId < querySize; ++docId) {
             const float uniformValue = rand.GenRandReal1();
             // TODO(nikitxskv): try to experiment with different bootstraps.
-            bootstrappedApprox[docId] *= uniformValue / (1.000001f - uniformValue);
+            bootstrappedApprox[docId] = expApproxes[docId] * (uniformValue / (1.000001f - uniformValue));
         }
 
-        Sort(
-            indices,
-            [&](int i, int j) {
-                return bootstrappedApprox[i] > bootstrappedApprox[j];
-            }
-        );
+        const auto isBetter = [&](int i, int j) {
+            return bootstrappedApprox[i] > bootstrappedApprox[j];
+        };
+        if (rankedSize == querySize) {
+            Sort(indices, isBetter);
+        } else {
+            PartialSort(indices.begin(), indices.begin() + rankedSize, indices.end(), isBetter);
+        }
 
         double decayCoefficient = 1;
-        for (ui32 docId = 1; docId < querySize; ++docId) {
+        for (ui32 docId = 1; docId < rankedSize; ++docId) {
             const int firstCandidate = indices[docId - 1];
             const int secondCandidate = indices[docId];
             const double magicConst = 0.15; // Like in GPU
@@ -53,22 +81,31 @@ static void GenerateYetiRankPairsForQuery(
             const float pairWeight = magicConst * decayCoefficient
                 * Abs(relevs[firstCandidate] - relevs[secondCandidate]);
             if (relevs[firstCandidate] > relevs[secondCandidate]) {
-                competitorsWeights[firstCandidate][secondCandidate] += pairWeight;
+                pairs.push_back({static_cast<ui32>(firstCandidate), static_cast<ui32>(secondCandidate), pairWeight});
             } else if (relevs[firstCandidate] < relevs[secondCandidate]) {
-                competitorsWeights[secondCandidate][firstCandidate] += pairWeight;
+                pairs.push_back({static_cast<ui32>(secondCandidate), static_cast<ui32>(firstCandidate), pairWeight});
             }
             decayCoefficient *= decaySpeed;
         }
     }
 
-    // TODO(nikitxskv): Can be optimized
-    for (ui32 winnerIndex = 0; winnerIndex < querySize; ++winnerIndex) {
-        for (ui32 loserIndex = 0; loserIndex < querySize; ++loserIndex) {
-            const float competitorsWeight
-                = queryWeight * competitorsWeights[winnerIndex][loserIndex] / permutationCount;
-            if (competitorsWeight != 0) {
-                competitorsRef[winnerIndex].push_back({loserIndex, competitorsWeight});
-            }
+    // stable to sum weights of the same pair in the order of permutations
+    StableSort(
+        pairs,
+        [](const TYetiRankPair& lhs, const TYetiRankPair& rhs) {
+            return std::tie(lhs.Winner, lhs.Loser) < std::tie(rhs.Winner, rhs.Loser);
+        }
+    );
+    for (size_t pairIdx = 0; pairIdx < pairs.size();) {
+        const ui32 winnerIndex = pairs[pairIdx].Winner;
+        const ui32 loserIndex = pairs[pairIdx].Loser;
+        float pairWeightSum = 0;
+        for (; pairIdx < pairs.size() && pairs[pairIdx].Winner == winnerIndex && pairs[pairIdx].Loser == loserIndex; ++pairIdx) {
+            pairWeightSum += pairs[pairIdx].Weight;
+        }
+        const float competitorsWeight = queryWeight * pairWeightSum / permutationCount;
+        if (competitorsWeight != 0) {
+            competitorsRef[winnerIndex].push_back({loserIndex, competitorsWeight});
         }
     }
 }
@@ -85,6 +122,7 @@ void UpdatePairsForYetiRank(
 ) {
     const int permutationCount = NCatboostOptions::GetYetiRankPermutations(lossDescription);
     const double decaySpeed = NCatboostOptions::GetYetiRankDecay(lossDescription);
+    const int topSize = NCatboostOptions::GetYetiRankTopSize(lossDescription);
 
     NPar::ILocalExecutor::TExecRangeParams blockParams(queryBegin, queryEnd);
     blockParams.SetBlockCount(CB_THREAD_LIMIT);
@@ -97,6 +135,7 @@ void UpdatePairsForYetiRank(
         blockCount,
         [&](int blockId) {
             TFastRng64 rand(randomSeeds[blockId]);
+            TYetiRankPairsBuffers buffers;
             const int from = queryBegin + blockId * blockSize;
             const int to = Min<int>(queryBegin + (blockId + 1) * blockSize, queryEnd);
             for (int queryIndex = from; queryIndex < to; ++queryIndex) {
@@ -108,7 +147,9 @@ void UpdatePairsForYetiRank(
                     queryInfoRef.End - queryInfoRef.Begin,
                     permutationCount,
                     decaySpeed,
+                    topSize,
                     rand.GenRand(),
+                    &buffers,
                     &queryInfoRef.Competitors
                 );
             }
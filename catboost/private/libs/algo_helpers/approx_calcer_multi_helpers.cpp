@@ -2,6 +2,91 @@
 
 #include <catboost/libs/helpers/dispatch_generic_lambda.h>
 
+#include <util/generic/xrange.h>
+
+void CalcDersMultiBatch(
+    TConstArrayRef<TConstArrayRef<float>> target, // [targetIdx][rowIdx]
+    TConstArrayRef<float> weight,
+    TConstArrayRef<TVector<double>> approx, // [dimensionIdx][rowIdx]
+    TConstArrayRef<TVector<double>> approxDeltas, // [dimensionIdx][rowIdx]
+    const IDerCalcer& error,
+    int rowBegin,
+    int rowEnd,
+    TVector<double>* ders, // [rowIdx - rowBegin][dimensionIdx]
+    TVector<double>* der2 // [rowIdx - rowBegin][hessianIdx]
+) {
+    const int rowCount = rowEnd - rowBegin;
+    const int approxDimension = approx.size();
+    const int targetDimension = target.size();
+
+    TVector<double> curApprox;
+    curApprox.yresize(rowCount * approxDimension);
+    for (int dim : xrange(approxDimension)) {
+        const double* approxData = approx[dim].data();
+        const double* approxDeltaData = approxDeltas.empty() ? nullptr : approxDeltas[dim].data();
+        for (int rowIdx : xrange(rowBegin, rowEnd)) {
+            curApprox[(rowIdx - rowBegin) * approxDimension + dim] = approxDeltaData
+                ? approxData[rowIdx] + approxDeltaData[rowIdx]
+                : approxData[rowIdx];
+        }
+    }
+    TVector<float> curTarget;
+    curTarget.yresize(rowCount * targetDimension);
+    for (int targetIdx : xrange(targetDimension)) {
+        for (int rowIdx : xrange(rowBegin, rowEnd)) {
+            curTarget[(rowIdx - rowBegin) * targetDimension + targetIdx] = target[targetIdx][rowIdx];
+        }
+    }
+
+    ders->yresize(rowCount * approxDimension);
+    if (der2) {
+        der2->yresize(rowCount * CalcInternalDer2DataSize(error.GetHessianType(), approxDimension));
+    }
+    error.CalcDersMultiBatch(
+        rowCount,
+        approxDimension,
+        targetDimension,
+        curApprox.data(),
+        curTarget.data(),
+        weight.empty() ? nullptr : weight.data() + rowBegin,
+        ders->data(),
+        der2 ? der2->data() : nullptr);
+}
+
+static void AddDersRangeMultiBatch(
+    TConstArrayRef<TIndexType> leafIndices,
+    TConstArrayRef<TConstArrayRef<float>> target,
+    TConstArrayRef<float> weight,
+    TConstArrayRef<TVector<double>> approx, // [dimensionIdx][docIdx]
+    TConstArrayRef<TVector<double>> approxDeltas, // [dimensionIdx][docIdx]
+    const IDerCalcer& error,
+    int rowBegin,
+    int rowEnd,
+    bool isUpdateWeight,
+    TArrayRef<TSumMulti> leafDers // [dimensionIdx]
+) {
+    const int approxDimension = approx.size();
+    const bool useHessian = !leafDers[0].SumDer2.Data.empty();
+    TVector<double> ders;
+    TVector<double> der2;
+    CalcDersMultiBatch(target, weight, approx, approxDeltas, error, rowBegin, rowEnd, &ders, useHessian ? &der2 : nullptr);
+
+    THessianInfo curDer2(useHessian * approxDimension, error.GetHessianType());
+    const int der2Size = curDer2.Data.ysize();
+    TVector<double> curDer(approxDimension);
+    for (int rowIdx : xrange(rowBegin, rowEnd)) {
+        const int localIdx = rowIdx - rowBegin;
+        Copy(ders.begin() + localIdx * approxDimension, ders.begin() + (localIdx + 1) * approxDimension, curDer.begin());
+        TSumMulti& curLeafDers = leafIndices.empty() ? leafDers[0] : leafDers[leafIndices[rowIdx]];
+        if (useHessian) {
+            Copy(der2.begin() + localIdx * der2Size, der2.begin() + (localIdx + 1) * der2Size, curDer2.Data.begin());
+            curLeafDers.AddDerDer2(curDer, curDer2);
+        } else {
+            curLeafDers.AddDerWeight(curDer, weight.empty() ? 1 : weight[rowIdx], isUpdateWeight);
+        }
+    }
+}
+
 inline void AddDersRangeMulti(
     TConstArrayRef<TIndexType> leafIndices,
     TConstArrayRef<TConstArrayRef<float>> target,
@@ -14,6 +99,11 @@ inline void AddDersRangeMulti(
     bool isUpdateWeight,
     TArrayRef<TSumMulti> leafDers // [dimensionIdx]
 ) {
+    if (error.HasCalcDersMultiBatch()) {
+        AddDersRangeMultiBatch(leafIndices, target, weight, approx, approxDeltas, error, rowBegin, rowEnd, isUpdateWeight, leafDers);
+        return;
+    }
+
     const auto* multiError = dynamic_cast<const TMultiDerCalcer*>(&error);
     const bool isMultiRegression = multiError != nullptr;
 
@@ -35,6 +35,20 @@ inline void AddDersRangeMulti(
     TArrayRef<TSumMulti> leafDers // [dimensionIdx]
 );
 
+// Evaluates derivatives of rows [rowBegin, rowEnd) with a single IDerCalcer::CalcDersMultiBatch call,
+// der2 is not calculated if nullptr
+void CalcDersMultiBatch(
+    TConstArrayRef<TConstArrayRef<float>> target, // [targetIdx][rowIdx]
+    TConstArrayRef<float> weight,
+    TConstArrayRef<TVector<double>> approx, // [dimensionIdx][rowIdx]
+    TConstArrayRef<TVector<double>> approxDeltas, // [dimensionIdx][rowIdx], can be empty
+    const IDerCalcer& error,
+    int rowBegin,
+    int rowEnd,
+    TVector<double>* ders, // [rowIdx - rowBegin][dimensionIdx]
+    TVector<double>* der2 // [rowIdx - rowBegin][hessianIdx]
+);
+
 void CalcLeafDersMulti(
     const TVector<TIndexType>& indices,
     TConstArrayRef<TConstArrayRef<float>> target,
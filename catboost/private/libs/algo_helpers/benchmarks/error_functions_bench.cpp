@@ -0,0 +1,152 @@
+#include <catboost/private/libs/algo_helpers/error_functions.h>
+
+#include <library/cpp/testing/benchmark/bench.h>
+
+#include <util/generic/singleton.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+#include <cmath>
+
+namespace {
+    struct TBenchData {
+        TVector<double> Approxes;
+        TVector<double> ApproxDeltas;
+        TVector<float> Targets;
+        TVector<float> Weights;
+        TVector<TDers> Ders;
+
+        TBenchData() {
+            const int docCount = 100000;
+            TFastRng64 rng(0);
+            Approxes.yresize(docCount);
+            ApproxDeltas.yresize(docCount);
+            Targets.yresize(docCount);
+            Weights.yresize(docCount);
+            Ders.yresize(docCount);
+            for (auto i : xrange(docCount)) {
+                Approxes[i] = rng.GenRandReal1() - 0.5;
+                ApproxDeltas[i] = 0.1 * (rng.GenRandReal1() - 0.5);
+                Targets[i] = 3 * rng.GenRandReal1();
+                Weights[i] = rng.GenRandReal1();
+            }
+        }
+    };
+
+    // IDerCalcer generic path with virtual CalcDer* calls per object, as before range kernels
+
+    class TScalarRMSEError final : public IDerCalcer {
+    public:
+        TScalarRMSEError()
+            : IDerCalcer(/*isExpApprox*/ false)
+        {
+        }
+
+    private:
+        double CalcDer(double approx, float target) const override {
+            return target - approx;
+        }
+
+        double CalcDer2(double /*approx*/, float /*target*/) const override {
+            return -1.0;
+        }
+
+        double CalcDer3(double /*approx*/, float /*target*/) const override {
+            return 0.0;
+        }
+    };
+
+    class TScalarExpectileError final : public IDerCalcer {
+    public:
+        explicit TScalarExpectileError(double alpha)
+            : IDerCalcer(/*isExpApprox*/ false)
+            , Alpha(alpha)
+        {
+        }
+
+    private:
+        double CalcDer(double approx, float target) const override {
+            const double e = target - approx;
+            return (e > 0) ? 2.0 * Alpha * e : 2.0 * (1 - Alpha) * e;
+        }
+
+        double CalcDer2(double approx, float target) const override {
+            const double e = target - approx;
+            return (e > 0) ? -2.0 * Alpha : -2.0 * (1 - Alpha);
+        }
+
+        double CalcDer3(double /*approx*/, float /*target*/) const override {
+            return 0.0;
+        }
+
+    private:
+        const double Alpha;
+    };
+
+    class TScalarTweedieError final : public IDerCalcer {
+    public:
+        explicit TScalarTweedieError(double variancePower)
+            : IDerCalcer(/*isExpApprox*/ false)
+            , VariancePower(variancePower)
+        {
+        }
+
+    private:
+        double CalcDer(double approx, float target) const override {
+            return target * std::exp((1 - VariancePower) * approx) - std::exp((2 - VariancePower) * approx);
+        }
+
+        double CalcDer2(double approx, float target) const override {
+            return target * std::exp((1 - VariancePower) * approx) * (1 - VariancePower)
+                - std::exp((2 - VariancePower) * approx) * (2 - VariancePower);
+        }
+
+        double CalcDer3(double approx, float target) const override {
+            return target * std::exp((1 - VariancePower) * approx) * Sqr(1 - VariancePower)
+                - std::exp((2 - VariancePower) * approx) * Sqr(2 - VariancePower);
+        }
+
+    private:
+        const double VariancePower;
+    };
+}
+
+static void CalcDers(const IDerCalcer& error, size_t iterations) {
+    auto& data = *Singleton<TBenchData>();
+    for (size_t i = 0; i < iterations; ++i) {
+        error.CalcDersRange(
+            /*start*/ 0,
+            data.Ders.ysize(),
+            /*calcThirdDer*/ false,
+            data.Approxes.data(),
+            data.ApproxDeltas.data(),
+            data.Targets.data(),
+            data.Weights.data(),
+            data.Ders.data());
+        Y_DO_NOT_OPTIMIZE_AWAY(data.Ders.data());
+    }
+}
+
+Y_CPU_BENCHMARK(RMSEScalar, iface) {
+    CalcDers(TScalarRMSEError(), iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(RMSERangeKernel, iface) {
+    CalcDers(TRMSEError(/*isExpApprox*/ false), iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(ExpectileScalar, iface) {
+    CalcDers(TScalarExpectileError(/*alpha*/ 0.3), iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(ExpectileRangeKernel, iface) {
+    CalcDers(TExpectileError(/*alpha*/ 0.3, /*isExpApprox*/ false), iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(TweedieScalar, iface) {
+    CalcDers(TScalarTweedieError(/*variancePower*/ 1.5), iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(TweedieRangeKernel, iface) {
+    CalcDers(TTweedieError(/*variancePower*/ 1.5, /*isExpApprox*/ false), iface.Iterations());
+}
@@ -34,9 +34,25 @@ struct TCustomObjectiveDescriptor {
         THessianInfo* der2,
         void* customData);
 
+    /* Optional batched variant of CalcDersMultiClass/CalcDersMultiRegression, all buffers are object-major:
+     * approxes[count][approxDimension], targets[count][targetDimension], weights[count] (nullptr if unweighted),
+     * ders[count][approxDimension], der2[count][THessianInfo::Data size] (nullptr if not required).
+     */
+    using TCalcDersMultiBatchPtr = void (*)(
+        int count,
+        int approxDimension,
+        int targetDimension,
+        const double* approxes,
+        const float* targets,
+        const float* weights,
+        double* ders,
+        double* der2,
+        void* customData);
+
 public:
     void* CustomData = nullptr;
     TCalcDersRangePtr CalcDersRange = nullptr;
     TCalcDersMultiClassPtr CalcDersMultiClass = nullptr;
     TCalcDersMultiRegressionPtr CalcDersMultiRegression = nullptr;
+    TCalcDersMultiBatchPtr CalcDersMultiBatch = nullptr;
 };
@@ -109,6 +109,219 @@ void IDerCalcer::CalcDersRange(
     useTDers, IsExpApprox, hasDelta);
 }
 
+template <class TError>
+template <int MaxDerivativeOrder, bool UseTDers, bool UseExpApprox, bool HasDelta, bool HasWeights>
+void TPointwiseDerCalcer<TError>::CalcDersRangeImpl(
+    int start,
+    int count,
+    const double* approxes,
+    const double* approxDeltas,
+    const float* targets,
+    const float* weights,
+    TDers* ders,
+    double* firstDers
+) const {
+    Y_ASSERT(UseExpApprox == GetIsExpApprox());
+    Y_ASSERT(HasDelta == (approxDeltas != nullptr));
+    Y_ASSERT(HasWeights == (weights != nullptr));
+    Y_ASSERT(UseTDers == (ders != nullptr) && (ders != nullptr) == (firstDers == nullptr));
+    Y_ASSERT(MaxDerivativeOrder <= static_cast<int>(GetMaxSupportedDerivativeOrder()));
+    Y_ASSERT((MaxDerivativeOrder > 1) <= (ders != nullptr));
+    const TError& error = static_cast<const TError&>(*this);
+#if defined(NDEBUG) && !defined(address_sanitizer_enabled)
+#pragma clang loop vectorize(enable) interleave_count(2)
+#endif
+    for (int i = start; i < start + count; ++i) {
+        double updatedApprox = approxes[i];
+        if (HasDelta) {
+            updatedApprox = UpdateApprox<UseExpApprox>(updatedApprox, approxDeltas[i]);
+        }
+        const float target = targets[i];
+        const double weight = HasWeights ? weights[i] : 1.0;
+        if (UseTDers) {
+            ders[i].Der1 = error.Der1(updatedApprox, target) * weight;
+        } else {
+            firstDers[i] = error.Der1(updatedApprox, target) * weight;
+        }
+        if (MaxDerivativeOrder >= 2) {
+            ders[i].Der2 = error.Der2(updatedApprox, target) * weight;
+        }
+        if (MaxDerivativeOrder >= 3) {
+            ders[i].Der3 = error.Der3(updatedApprox, target) * weight;
+        }
+    }
+}
+
+template <class TError>
+void TPointwiseDerCalcer<TError>::CalcDersRange(
+    int start,
+    int count,
+    int maxDerivativeOrder,
+    const double* approxes,
+    const double* approxDeltas,
+    const float* targets,
+    const float* weights,
+    TDers* ders,
+    double* firstDers
+) const {
+    DispatchGenericLambda(
+        [=] (auto useTDers, auto isExpApprox, auto hasDelta, auto hasWeights) {
+            switch (maxDerivativeOrder) {
+                case 1:
+                    return CalcDersRangeImpl<1, useTDers, isExpApprox, hasDelta, hasWeights>(
+                        start, count, approxes, approxDeltas, targets, weights, ders, firstDers);
+                case 2:
+                    return CalcDersRangeImpl<2, useTDers, isExpApprox, hasDelta, hasWeights>(
+                        start, count, approxes, approxDeltas, targets, weights, ders, firstDers);
+                case 3:
+                    return CalcDersRangeImpl<3, useTDers, isExpApprox, hasDelta, hasWeights>(
+                        start, count, approxes, approxDeltas, targets, weights, ders, firstDers);
+                default:
+                    CB_ENSURE(false, "Only 1st, 2nd, and 3rd derivatives are supported");
+            }
+        },
+        ders != nullptr, GetIsExpApprox(), approxDeltas != nullptr, weights != nullptr);
+}
+
+template <class TError>
+void TPointwiseDerCalcer<TError>::CalcFirstDerRange(
+    int start,
+    int count,
+    const double* approxes,
+    const double* approxDeltas,
+    const float* targets,
+    const float* weights,
+    double* firstDers
+) const {
+    CalcDersRange(
+        start,
+        count,
+        /*maxDerivativeOrder*/ 1,
+        approxes,
+        approxDeltas,
+        targets,
+        weights,
+        /*ders*/ nullptr,
+        firstDers);
+}
+
+template <class TError>
+void TPointwiseDerCalcer<TError>::CalcDersRange(
+    int start,
+    int count,
+    bool calcThirdDer,
+    const double* approxes,
+    const double* approxDeltas,
+    const float* targets,
+    const float* weights,
+    TDers* ders
+) const {
+    const int maxDerivativeOrder = calcThirdDer ? 3 : Min(GetMaxSupportedDerivativeOrder(), 2u);
+    CalcDersRange(
+        start,
+        count,
+        maxDerivativeOrder,
+        approxes,
+        approxDeltas,
+        targets,
+        weights,
+        ders,
+        /*firstDers*/ nullptr);
+}
+
+template class TPointwiseDerCalcer<TRMSEError>;
+template class TPointwiseDerCalcer<TQuantileError>;
+template class TPointwiseDerCalcer<TExpectileError>;
+template class TPointwiseDerCalcer<TLqError>;
+template class TPointwiseDerCalcer<TLogLinQuantileError>;
+template class TPointwiseDerCalcer<TMAPError>;
+template class TPointwiseDerCalcer<TPoissonError>;
+template class TPointwiseDerCalcer<THuberError>;
+template class TPointwiseDerCalcer<TTweedieError>;
+
+template <int MaxDerivativeOrder, bool UseTDers, bool HasDelta, bool HasWeights>
+static void CalcTweedieDersRangeImpl(
+    double variancePower,
+    int start,
+    int count,
+    const double* approxes,
+    const double* approxDeltas,
+    const float* targets,
+    const float* weights,
+    TDers* ders,
+    double* firstDers
+) {
+    constexpr int BlockSize = 64;
+    std::array<double, BlockSize> expTargetPower; // exp((1 - variancePower) * approx)
+    std::array<double, BlockSize> expPredictionPower; // exp((2 - variancePower) * approx)
+    for (int blockStart = start; blockStart < start + count; blockStart += BlockSize) {
+        const int blockSize = Min(BlockSize, start + count - blockStart);
+        for (int idx : xrange(blockSize)) {
+            double updatedApprox = approxes[blockStart + idx];
+            if (HasDelta) {
+                updatedApprox = UpdateApprox</*StoreExpApprox*/ false>(updatedApprox, approxDeltas[blockStart + idx]);
+            }
+            expTargetPower[idx] = (1 - variancePower) * updatedApprox;
+            expPredictionPower[idx] = (2 - variancePower) * updatedApprox;
+        }
+        FastExpInplace(expTargetPower.data(), blockSize);
+        FastExpInplace(expPredictionPower.data(), blockSize);
+        for (int idx : xrange(blockSize)) {
+            const int i = blockStart + idx;
+            const double weight = HasWeights ? weights[i] : 1.0;
+            const double targetTerm = targets[i] * expTargetPower[idx];
+            const double der1 = (targetTerm - expPredictionPower[idx]) * weight;
+            if (UseTDers) {
+                ders[i].Der1 = der1;
+            } else {
+                firstDers[i] = der1;
+            }
+            if (MaxDerivativeOrder >= 2) {
+                ders[i].Der2 = (targetTerm * (1 - variancePower) - expPredictionPower[idx] * (2 - variancePower)) * weight;
+            }
+            if (MaxDerivativeOrder >= 3) {
+                ders[i].Der3
+                    = (targetTerm * Sqr(1 - variancePower) - expPredictionPower[idx] * Sqr(2 - variancePower)) * weight;
+            }
+        }
+    }
+}
+
+void TTweedieError::CalcFirstDerRange(
+    int start,
+    int count,
+    const double* approxes,
+    const double* approxDeltas,
+    const float* targets,
+    const float* weights,
+    double* firstDers
+) const {
+    DispatchGenericLambda(
+        [=] (auto hasDelta, auto hasWeights) {
+            CalcTweedieDersRangeImpl<1, false, hasDelta, hasWeights>(
+                VariancePower, start, count, approxes, approxDeltas, targets, weights, nullptr, firstDers);
+        },
+        approxDeltas != nullptr, weights != nullptr);
+}
+
+void TTweedieError::CalcDersRange(
+    int start,
+    int count,
+    bool calcThirdDer,
+    const double* approxes,
+    const double* approxDeltas,
+    const float* targets,
+    const float* weights,
+    TDers* ders
+) const {
+    DispatchGenericLambda(
+        [=] (auto calcThirdDer, auto hasDelta, auto hasWeights) {
+            CalcTweedieDersRangeImpl<calcThirdDer ? 3 : 2, true, hasDelta, hasWeights>(
+                VariancePower, start, count, approxes, approxDeltas, targets, weights, ders, nullptr);
+        },
+        calcThirdDer, approxDeltas != nullptr, weights != nullptr);
+}
+
 namespace {
     template <int Capacity>
     class TExpForwardView {
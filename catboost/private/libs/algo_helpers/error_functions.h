@@ -111,6 +111,25 @@ public:
         CB_ENSURE(false, "Not implemented");
     }
 
+    // Objects are evaluated by one CalcDersMultiBatch call instead of per object CalcDersMulti/CalcDers
+    virtual bool HasCalcDersMultiBatch() const {
+        return false;
+    }
+
+    // See TCustomObjectiveDescriptor::TCalcDersMultiBatchPtr for buffers layout
+    virtual void CalcDersMultiBatch(
+        int /*count*/,
+        int /*approxDimension*/,
+        int /*targetDimension*/,
+        const double* /*approxes*/,
+        const float* /*targets*/,
+        const float* /*weights*/,
+        double* /*ders*/,
+        double* /*der2*/
+    ) const {
+        CB_ENSURE(false, "Not implemented");
+    }
+
     virtual void CalcDersForQueries(
         int /*queryStartIndex*/,
         int /*queryEndIndex*/,
@@ -169,6 +188,76 @@ private:
     const EHessianType HessianType;
 };
 
+/*
+ * Base for per-object losses with closed form derivatives.
+ * TError defines non-virtual inline Der1/Der2/Der3(approx, target), so range calculation is
+ * a single loop over contiguous approx/target/weight arrays without virtual calls per object
+ * that compiler is able to vectorize.
+ */
+template <class TError>
+class TPointwiseDerCalcer : public IDerCalcer {
+public:
+    using IDerCalcer::IDerCalcer;
+
+    void CalcFirstDerRange(
+        int start,
+        int count,
+        const double* approxes,
+        const double* approxDeltas,
+        const float* targets,
+        const float* weights,
+        double* firstDers
+    ) const override;
+
+    void CalcDersRange(
+        int start,
+        int count,
+        bool calcThirdDer,
+        const double* approxes,
+        const double* approxDeltas,
+        const float* targets,
+        const float* weights,
+        TDers* ders
+    ) const override;
+
+private:
+    double CalcDer(double approx, float target) const override {
+        return static_cast<const TError*>(this)->Der1(approx, target);
+    }
+
+    double CalcDer2(double approx, float target) const override {
+        return static_cast<const TError*>(this)->Der2(approx, target);
+    }
+
+    double CalcDer3(double approx, float target) const override {
+        return static_cast<const TError*>(this)->Der3(approx, target);
+    }
+
+    template <int MaxDerivativeOrder, bool UseTDers, bool UseExpApprox, bool HasDelta, bool HasWeights>
+    void CalcDersRangeImpl(
+        int start,
+        int count,
+        const double* approxes,
+        const double* approxDeltas,
+        const float* targets,
+        const float* weights,
+        TDers* ders,
+        double* firstDers
+    ) const;
+
+    void CalcDersRange(
+        int start,
+        int count,
+        int maxDerivativeOrder,
+        const double* approxes,
+        const double* approxDeltas,
+        const float* targets,
+        const float* weights,
+        TDers* ders,
+        double* firstDers
+    ) const;
+};
+
 class TMultiDerCalcer : public IDerCalcer {
 public:
     static constexpr int MaxDerivativeOrder = 2;
@@ -277,33 +366,32 @@ public:
     ) const override;
 };
 
-class TRMSEError final : public IDerCalcer {
+class TRMSEError final : public TPointwiseDerCalcer<TRMSEError> {
 public:
     static constexpr double RMSE_DER2 = -1.0;
     static constexpr double RMSE_DER3 = 0.0;
 
 public:
     explicit TRMSEError(bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPointwiseDerCalcer(isExpApprox)
     {
         CB_ENSURE(isExpApprox == false, "Approx format does not match");
     }
 
-private:
-    double CalcDer(double approx, float target) const override {
+    double Der1(double approx, float target) const {
         return target - approx;
     }
 
-    double CalcDer2(double /*approx*/, float /*target*/) const override {
+    double Der2(double /*approx*/, float /*target*/) const {
         return RMSE_DER2;
     }
 
-    double CalcDer3(double /*approx*/, float /*target*/) const override {
+    double Der3(double /*approx*/, float /*target*/) const {
         return RMSE_DER3;
     }
 };
 
-class TQuantileError final : public IDerCalcer {
+class TQuantileError final : public TPointwiseDerCalcer<TQuantileError> {
 public:
     static constexpr double QUANTILE_DER2_AND_DER3 = 0.0;
 
@@ -313,7 +401,7 @@ public:
 
 public:
     explicit TQuantileError(bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPointwiseDerCalcer(isExpApprox)
         , Alpha(0.5)
         , Delta(1e-6)
     {
@@ -321,7 +409,7 @@ public:
     }
 
     TQuantileError(double alpha, double delta, bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPointwiseDerCalcer(isExpApprox)
         , Alpha(alpha)
         , Delta(delta)
     {
@@ -330,23 +418,22 @@ public:
         CB_ENSURE(isExpApprox == false, "Approx format does not match");
     }
 
-private:
-    double CalcDer(double approx, float target) const override {
+    double Der1(double approx, float target) const {
         const double val = target - approx;
         if (abs(val) < Delta) return 0;
         return (target - approx > 0) ? Alpha : -(1 - Alpha);
     }
 
-    double CalcDer2(double /*approx*/, float /*target*/) const override {
+    double Der2(double /*approx*/, float /*target*/) const {
         return QUANTILE_DER2_AND_DER3;
     }
 
-    double CalcDer3(double /*approx*/, float /*target*/) const override {
+    double Der3(double /*approx*/, float /*target*/) const {
         return QUANTILE_DER2_AND_DER3;
     }
 };
 
-class TExpectileError final : public IDerCalcer {
+class TExpectileError final : public TPointwiseDerCalcer<TExpectileError> {
 public:
     static constexpr double EXPECTILE_DER3 = 0.0;
 
@@ -355,68 +442,66 @@ public:
 
 public:
     explicit TExpectileError(bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPointwiseDerCalcer(isExpApprox)
         , Alpha(0.5)
     {
         CB_ENSURE(isExpApprox == false, "Approx format does not match");
     }
 
     TExpectileError(double alpha, bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPointwiseDerCalcer(isExpApprox)
         , Alpha(alpha)
     {
         Y_ASSERT(Alpha > -1e-6 && Alpha < 1.0 + 1e-6);
         CB_ENSURE(isExpApprox == false, "Approx format does not match");
     }
 
-private:
-    double CalcDer(double approx, float target) const override {
+    double Der1(double approx, float target) const {
         double e = target - approx;
         return (e > 0) ? 2.0 * Alpha * e : 2.0 * (1 - Alpha) * e;
     }
 
-    double CalcDer2(double approx, float target) const override {
+    double Der2(double approx, float target) const {
         double e = target - approx;
         return (e > 0) ? -2.0 * Alpha : -2.0 * (1 - Alpha);
     }
 
-    double CalcDer3(double /*approx*/, float /*target*/) const override {
+    double Der3(double /*approx*/, float /*target*/) const {
         return EXPECTILE_DER3;
     }
 };
 
-class TLqError final : public IDerCalcer {
+class TLqError final : public TPointwiseDerCalcer<TLqError> {
 public:
     const double Q;
 
 public:
     TLqError(double q, bool isExpApprox)
-        : IDerCalcer(isExpApprox, /*maxDerivativeOrder*/ q >= 2 ?  3 : 1)
+        : TPointwiseDerCalcer(isExpApprox, /*maxDerivativeOrder*/ q >= 2 ?  3 : 1)
         , Q(q)
     {
         Y_ASSERT(Q >= 1);
         CB_ENSURE(isExpApprox == false, "Approx format does not match");
     }
 
-private:
-    double CalcDer(double approx, float target) const override {
+    double Der1(double approx, float target) const {
         const double absLoss = abs(approx - target);
         const double absLossQ = std::pow(absLoss, Q - 1);
         return Q * (target - approx > 0 ? 1 : -1)  * absLossQ;
     }
 
-    double CalcDer2(double approx, float target) const override {
+    double Der2(double approx, float target) const {
         const double absLoss = abs(target - approx);
         return -Q * (Q - 1) * std::pow(absLoss, Q - 2);
     }
 
-    double CalcDer3(double approx, float target) const override {
+    double Der3(double approx, float target) const {
         const double absLoss = abs(target - approx);
         return Q * (Q - 1) *  (Q - 2) * std::pow(absLoss, Q - 3) * (target - approx > 0 ? 1 : -1);
     }
 };
 
-class TLogLinQuantileError final : public IDerCalcer {
+class TLogLinQuantileError final : public TPointwiseDerCalcer<TLogLinQuantileError> {
 public:
     static constexpr double QUANTILE_DER2_AND_DER3 = 0.0;
 
@@ -425,77 +510,74 @@ public:
 
 public:
     explicit TLogLinQuantileError(bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPointwiseDerCalcer(isExpApprox)
         , Alpha(0.5)
     {
         CB_ENSURE(isExpApprox == true, "Approx format does not match");
     }
 
     TLogLinQuantileError(double alpha, bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPointwiseDerCalcer(isExpApprox)
         , Alpha(alpha)
     {
         Y_ASSERT(Alpha > -1e-6 && Alpha < 1.0 + 1e-6);
         CB_ENSURE(isExpApprox == true, "Approx format does not match");
     }
 
-private:
-    double CalcDer(double approxExp, float target) const override {
+    double Der1(double approxExp, float target) const {
         return (target - approxExp > 0) ? Alpha * approxExp : -(1 - Alpha) * approxExp;
     }
 
-    double CalcDer2(double /*approx*/, float /*target*/) const override {
+    double Der2(double /*approx*/, float /*target*/) const {
         return QUANTILE_DER2_AND_DER3;
     }
 
-    double CalcDer3(double /*approx*/, float /*target*/) const override {
+    double Der3(double /*approx*/, float /*target*/) const {
         return QUANTILE_DER2_AND_DER3;
     }
 };
 
-class TMAPError final : public IDerCalcer {
+class TMAPError final : public TPointwiseDerCalcer<TMAPError> {
 public:
     static constexpr double MAPE_DER2_AND_DER3 = 0.0;
 
 public:
     explicit TMAPError(bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPointwiseDerCalcer(isExpApprox)
     {
         CB_ENSURE(isExpApprox == false, "Approx format does not match");
     }
 
-private:
-    double CalcDer(double approx, float target) const override {
+    double Der1(double approx, float target) const {
         return (target - approx > 0) ? 1 / Max(1.f, Abs(target)) : -1 / Max(1.f, Abs(target));
     }
 
-    double CalcDer2(double /*approx*/, float /*target*/) const override {
+    double Der2(double /*approx*/, float /*target*/) const {
         return MAPE_DER2_AND_DER3;
     }
 
-    double CalcDer3(double /*approx*/, float /*target*/) const override {
+    double Der3(double /*approx*/, float /*target*/) const {
         return MAPE_DER2_AND_DER3;
     }
 };
 
-class TPoissonError final : public IDerCalcer {
+class TPoissonError final : public TPointwiseDerCalcer<TPoissonError> {
 public:
     explicit TPoissonError(bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPointwiseDerCalcer(isExpApprox)
     {
         CB_ENSURE(isExpApprox == true, "Approx format does not match");
     }
 
-private:
-    double CalcDer(double approxExp, float target) const override {
+    double Der1(double approxExp, float target) const {
         return target - approxExp;
     }
 
-    double CalcDer2(double approxExp, float) const override {
+    double Der2(double approxExp, float) const {
         return -approxExp;
     }
 
-    double CalcDer3(double approxExp, float /*target*/) const override {
+    double Der3(double approxExp, float /*target*/) const {
         return -approxExp;
     }
 };
@@ -784,6 +866,32 @@ public:
         Descriptor.CalcDersMultiClass(approx, target, weight, der, der2, Descriptor.CustomData);
     }
 
+    bool HasCalcDersMultiBatch() const override {
+        return Descriptor.CalcDersMultiBatch != nullptr;
+    }
+
+    void CalcDersMultiBatch(
+        int count,
+        int approxDimension,
+        int targetDimension,
+        const double* approxes,
+        const float* targets,
+        const float* weights,
+        double* ders,
+        double* der2
+    ) const override {
+        Descriptor.CalcDersMultiBatch(
+            count,
+            approxDimension,
+            targetDimension,
+            approxes,
+            targets,
+            weights,
+            ders,
+            der2,
+            Descriptor.CustomData);
+    }
+
     void CalcDersRange(
         int start,
         int count,
@@ -868,6 +976,32 @@ public:
         Descriptor.CalcDersMultiRegression(approx, target, weight, der, der2, Descriptor.CustomData);
     }
 
+    bool HasCalcDersMultiBatch() const override {
+        return Descriptor.CalcDersMultiBatch != nullptr;
+    }
+
+    void CalcDersMultiBatch(
+        int count,
+        int approxDimension,
+        int targetDimension,
+        const double* approxes,
+        const float* targets,
+        const float* weights,
+        double* ders,
+        double* der2
+    ) const override {
+        Descriptor.CalcDersMultiBatch(
+            count,
+            approxDimension,
+            targetDimension,
+            approxes,
+            targets,
+            weights,
+            ders,
+            der2,
+            Descriptor.CustomData);
+    }
+
 private:
     TCustomObjectiveDescriptor Descriptor;
 };
@@ -1147,7 +1281,7 @@ private:
     }
 };
 
-class THuberError final : public IDerCalcer {
+class THuberError final : public TPointwiseDerCalcer<THuberError> {
     static constexpr double HUBER_DER2 = -1.0;
     static constexpr double HUBER_DER3 = 0.0;
 
@@ -1155,14 +1289,13 @@ class THuberError final : public IDerCalcer {
 public:
 
     explicit THuberError(double delta, bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPointwiseDerCalcer(isExpApprox)
         , Delta(delta)
     {
         CB_ENSURE(isExpApprox == false, "Approx format does not match");
     }
 
-private:
-    double CalcDer(double approx, float target) const override {
+    double Der1(double approx, float target) const {
         double diff = target - approx;
         if (fabs(diff) < Delta) {
             return diff;
@@ -1171,7 +1304,7 @@ private:
         }
     }
 
-    double CalcDer2(double approx, float target) const override {
+    double Der2(double approx, float target) const {
         double diff = target - approx;
         if (fabs(diff) < Delta) {
             return HUBER_DER2;
@@ -1180,38 +1313,59 @@ private:
         }
     }
 
-    double CalcDer3(double /*approx*/, float /*target*/) const override {
+    double Der3(double /*approx*/, float /*target*/) const {
         return HUBER_DER3;
     }
 };
 
-class TTweedieError final : public IDerCalcer {
+class TTweedieError final : public TPointwiseDerCalcer<TTweedieError> {
 public:
     const double VariancePower;
 
 public:
     TTweedieError(double variance_power, bool isExpApprox)
-        : IDerCalcer(isExpApprox, /*maxDerivativeOrder*/ 3)
+        : TPointwiseDerCalcer(isExpApprox, /*maxDerivativeOrder*/ 3)
         , VariancePower(variance_power)
     {
         Y_ASSERT(VariancePower > 1 && VariancePower < 2);
         CB_ENSURE(isExpApprox == false, "Approx format does not match");
     }
 
-private:
-    double CalcDer(double approx, float target) const override {
+    // exponents shared by all derivatives are calculated blockwise with FastExpInplace
+    void CalcFirstDerRange(
+        int start,
+        int count,
+        const double* approxes,
+        const double* approxDeltas,
+        const float* targets,
+        const float* weights,
+        double* firstDers
+    ) const override;
+
+    void CalcDersRange(
+        int start,
+        int count,
+        bool calcThirdDer,
+        const double* approxes,
+        const double* approxDeltas,
+        const float* targets,
+        const float* weights,
+        TDers* ders
+    ) const override;
+
+    double Der1(double approx, float target) const {
         double der = target * std::exp((1 - VariancePower) * approx);
         der -= std::exp((2 - VariancePower) * approx);
         return der;
     }
 
-    double CalcDer2(double approx, float target) const override {
+    double Der2(double approx, float target) const {
         double der2 = target * std::exp((1 - VariancePower) * approx) * (1 - VariancePower);
         der2 -= std::exp((2 - VariancePower) * approx) * (2 - VariancePower);
         return der2;
     }
 
-    double CalcDer3(double approx, float target) const override {
+    double Der3(double approx, float target) const {
         double der3 = target * std::exp((1 - VariancePower) * approx) * Sqr(1 - VariancePower);
         der3 -= std::exp((2 - VariancePower) * approx) * Sqr(2 - VariancePower);
         return der3;
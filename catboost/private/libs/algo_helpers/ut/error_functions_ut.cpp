@@ -0,0 +1,106 @@
+#include <catboost/private/libs/algo_helpers/error_functions.h>
+
+#include <library/cpp/testing/unittest/registar.h>
+
+#include <util/generic/xrange.h>
+
+#include <cmath>
+
+namespace {
+    struct TDersTestData {
+        TVector<double> Approxes = {-1.5, -0.2, 0.0, 0.3, 0.7, 1.1, 2.0, -0.9, 0.05};
+        TVector<double> ApproxDeltas = {0.1, -0.05, 0.2, 0.0, -0.3, 0.15, -0.1, 0.05, 0.0};
+        TVector<float> Targets = {0.0f, 1.0f, 0.5f, 0.3f, 2.5f, 0.0f, 3.0f, 1.5f, 0.05f};
+        TVector<float> Weights = {1.0f, 0.5f, 2.0f, 0.0f, 1.5f, 0.3f, 1.0f, 0.7f, 1.2f};
+    };
+}
+
+template <class TDersFunc>
+static void CheckDers(const IDerCalcer& error, TDersFunc&& expectedDers, double eps) {
+    const TDersTestData data;
+    const int docCount = data.Approxes.ysize();
+    for (bool hasDelta : {false, true}) {
+        for (bool hasWeights : {false, true}) {
+            TVector<TDers> ders(docCount);
+            TVector<double> firstDers(docCount);
+            error.CalcDersRange(
+                /*start*/ 0,
+                docCount,
+                /*calcThirdDer*/ true,
+                data.Approxes.data(),
+                hasDelta ? data.ApproxDeltas.data() : nullptr,
+                data.Targets.data(),
+                hasWeights ? data.Weights.data() : nullptr,
+                ders.data());
+            error.CalcFirstDerRange(
+                /*start*/ 0,
+                docCount,
+                data.Approxes.data(),
+                hasDelta ? data.ApproxDeltas.data() : nullptr,
+                data.Targets.data(),
+                hasWeights ? data.Weights.data() : nullptr,
+                firstDers.data());
+            for (auto i : xrange(docCount)) {
+                const double approx = data.Approxes[i] + (hasDelta ? data.ApproxDeltas[i] : 0.0);
+                const double weight = hasWeights ? data.Weights[i] : 1.0;
+                const TDers expected = expectedDers(approx, data.Targets[i]);
+                UNIT_ASSERT_DOUBLES_EQUAL(ders[i].Der1, weight * expected.Der1, eps);
+                UNIT_ASSERT_DOUBLES_EQUAL(ders[i].Der2, weight * expected.Der2, eps);
+                UNIT_ASSERT_DOUBLES_EQUAL(ders[i].Der3, weight * expected.Der3, eps);
+                UNIT_ASSERT_DOUBLES_EQUAL(firstDers[i], weight * expected.Der1, eps);
+            }
+        }
+    }
+}
+
+Y_UNIT_TEST_SUITE(PointwiseDerCalcerTest) {
+    Y_UNIT_TEST(RMSE) {
+        CheckDers(
+            TRMSEError(/*isExpApprox*/ false),
+            [] (double approx, float target) {
+                return TDers{target - approx, -1.0, 0.0};
+            },
+            1e-12);
+    }
+
+    Y_UNIT_TEST(Expectile) {
+        const double alpha = 0.3;
+        CheckDers(
+            TExpectileError(alpha, /*isExpApprox*/ false),
+            [=] (double approx, float target) {
+                const double e = target - approx;
+                const double scale = e > 0 ? 2.0 * alpha : 2.0 * (1 - alpha);
+                return TDers{scale * e, -scale, 0.0};
+            },
+            1e-12);
+    }
+
+    Y_UNIT_TEST(Huber) {
+        const double delta = 0.5;
+        CheckDers(
+            THuberError(delta, /*isExpApprox*/ false),
+            [=] (double approx, float target) {
+                const double diff = target - approx;
+                if (std::abs(diff) < delta) {
+                    return TDers{diff, -1.0, 0.0};
+                }
+                return TDers{diff > 0 ? delta : -delta, 0.0, 0.0};
+            },
+            1e-12);
+    }
+
+    Y_UNIT_TEST(Tweedie) {
+        const double p = 1.5;
+        CheckDers(
+            TTweedieError(p, /*isExpApprox*/ false),
+            [=] (double approx, float target) {
+                const double expTarget = target * std::exp((1 - p) * approx);
+                const double expPrediction = std::exp((2 - p) * approx);
+                return TDers{
+                    expTarget - expPrediction,
+                    expTarget * (1 - p) - expPrediction * (2 - p),
+                    expTarget * Sqr(1 - p) - expPrediction * Sqr(2 - p)};
+            },
+            1e-6);
+    }
+}
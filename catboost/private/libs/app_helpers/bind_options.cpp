@@ -328,6 +328,20 @@ static void BindOutputParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonValue* p
             (*plainJsonPtr)["profile_log"] = name;
         });
 
+    parser.AddLongOption("chrome-trace", "file to write per-thread training spans in Chrome trace format")
+        .RequiredArgument("file")
+        .Handler1T<TString>([plainJsonPtr](const TString& name) {
+            (*plainJsonPtr)["chrome_trace_file"] = name;
+        });
+
+    parser.AddLongOption(
+        "approx-cache-file",
+        "file to save learn and test approxes of the final model to and to load approxes of the init model from")
+        .RequiredArgument("file")
+        .Handler1T<TString>([plainJsonPtr](const TString& name) {
+            (*plainJsonPtr)["approx_cache_file"] = name;
+        });
+
     parser.AddLongOption("trace-log", "path for trace log")
         .RequiredArgument("file")
         .Handler1T<TString>([](const TString& name) {
@@ -1281,6 +1295,18 @@ static void BindSystemParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonValue* p
             (*plainJsonPtr).InsertValue("thread_count", count);
         });
 
+    parser.AddLongOption("work-stealing", "Use per-thread task queues with work stealing in the thread pool. CPU only.")
+        .NoArgument()
+        .Handler0([plainJsonPtr]() {
+            (*plainJsonPtr)["work_stealing"] = true;
+        });
+
+    parser.AddLongOption("pin-threads", "Bind worker threads to CPUs, keeps their buffers on the local NUMA node. CPU only.")
+        .NoArgument()
+        .Handler0([plainJsonPtr]() {
+            (*plainJsonPtr)["pin_threads"] = true;
+        });
+
     parser.AddLongOption("used-ram-limit", "Try to limit used memory. CPU only. WARNING: This option affects CTR memory usage only.\nAllowed suffixes: GB, MB, KB in different cases")
             .RequiredArgument("TARGET_RSS")
             .Handler1T<TString>([plainJsonPtr](const TString& param) {
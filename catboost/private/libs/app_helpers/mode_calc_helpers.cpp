@@ -181,12 +181,19 @@ void NCB::CalcModelSingleHost(
     size_t virtualEnsemblesCount,
     TFullModel&& model) {
 
-    CB_ENSURE(params.OutputPath.Scheme == "dsv" || params.OutputPath.Scheme == "stream", "Local model evaluation supports only \"dsv\"  and \"stream\" output file schemas.");
+    const bool isBinaryOutput = IsBinaryEvalResultScheme(params.OutputPath.Scheme);
+    CB_ENSURE(
+        params.OutputPath.Scheme == "dsv" || params.OutputPath.Scheme == "stream" || isBinaryOutput,
+        "Local model evaluation supports only \"dsv\", \"stream\", \"npy\", \"raw-f32\", \"raw-f64\""
+        " and \"arrow\" output file schemas.");
     params.DatasetReadingParams.ValidatePoolParams();
 
-    TSetLogging logging(params.OutputPath.Scheme == "dsv" ? ELoggingLevel::Info : ELoggingLevel::Silent);
+    TSetLogging logging(params.OutputPath.Scheme == "stream" ? ELoggingLevel::Silent : ELoggingLevel::Info);
     THolder<IOutputStream> outputStream;
-    if (params.OutputPath.Scheme == "dsv") {
+    THolder<TBinaryEvalResultWriter> binaryWriter;
+    if (isBinaryOutput) {
+        binaryWriter = MakeHolder<TBinaryEvalResultWriter>(params.OutputPath);
+    } else if (params.OutputPath.Scheme == "dsv") {
          outputStream = MakeHolder<TOFStream>(params.OutputPath.Path);
     } else {
         CB_ENSURE(params.OutputPath.Path == "stdout" || params.OutputPath.Path == "stderr", "Local model evaluation supports only stderr and stdout paths.");
@@ -223,22 +230,40 @@ void NCB::CalcModelSingleHost(
             poolColumnsPrinter->UpdateColumnTypeInfo(datasetPart->MetaInfo.ColumnsInfo);
 
             TSetLoggingSilent inThisScope;
-            OutputEvalResultToFile(
-                approx,
-                &executor,
-                params.OutputColumnsIds,
-                model.GetLossFunctionName(),
-                visibleLabelsHelper,
-                *datasetPart,
-                outputStream.Get(),
-                // TODO: src file columns output is incompatible with block processing
-                poolColumnsPrinter,
-                /*testFileWhichOf*/ {0, 0},
-                IsFirstBlock,
-                docIdOffset,
-                std::make_pair(evalPeriod, iterationsLimit));
+            if (binaryWriter) {
+                OutputEvalResultToBinaryWriter(
+                    approx,
+                    &executor,
+                    params.OutputColumnsIds,
+                    model.GetLossFunctionName(),
+                    visibleLabelsHelper,
+                    *datasetPart,
+                    binaryWriter.Get(),
+                    poolColumnsPrinter,
+                    /*testFileWhichOf*/ {0, 0},
+                    docIdOffset,
+                    std::make_pair(evalPeriod, iterationsLimit));
+            } else {
+                OutputEvalResultToFile(
+                    approx,
+                    &executor,
+                    params.OutputColumnsIds,
+                    model.GetLossFunctionName(),
+                    visibleLabelsHelper,
+                    *datasetPart,
+                    outputStream.Get(),
+                    // TODO: src file columns output is incompatible with block processing
+                    poolColumnsPrinter,
+                    /*testFileWhichOf*/ {0, 0},
+                    IsFirstBlock,
+                    docIdOffset,
+                    std::make_pair(evalPeriod, iterationsLimit));
+            }
             docIdOffset += datasetPart->ObjectsGrouping->GetObjectCount();
             IsFirstBlock = false;
         },
         &executor);
+    if (binaryWriter) {
+        binaryWriter->Finish();
+    }
 }
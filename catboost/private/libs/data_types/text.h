@@ -1,6 +1,7 @@
 #pragma once
 
 #include <util/generic/algorithm.h>
+#include <util/generic/array_ref.h>
 #include <util/generic/map.h>
 #include <util/generic/vector.h>
 #include <util/stream/output.h>
@@ -152,7 +153,13 @@ namespace NCB {
         }
 
         TText(TVector<ui32>&& tokenIds) {
+            Assign(tokenIds);
+        }
+
+        // tokenIds are sorted inplace, allocated storage is reused
+        void Assign(TArrayRef<ui32> tokenIds) {
             Sort(tokenIds);
+            TokenToCount.clear();
             for (const auto& tokenId : tokenIds) {
                 if (TokenToCount.empty() || TokenToCount.back().Token() != tokenId) {
                     TokenToCount.push_back(TTokenToCountPair{TTokenId(tokenId), 1});
@@ -0,0 +1,383 @@
+#include "compressed_line_data_reader.h"
+#include "exists_checker.h"
+
+#include <contrib/libs/lz4/lz4frame.h>
+#include <contrib/libs/zstd/zstd.h>
+
+#include <library/cpp/threading/local_executor/local_executor.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/cast.h>
+#include <util/generic/maybe.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/stream/file.h>
+#include <util/stream/zlib.h>
+#include <util/system/byteorder.h>
+#include <util/system/file.h>
+#include <util/system/fstat.h>
+#include <util/system/fs.h>
+#include <util/system/unaligned_mem.h>
+
+
+namespace NCB {
+
+    static constexpr size_t DECOMPRESSION_BUFFER_SIZE = 1 << 20;
+
+    namespace {
+
+        class TZstdDecompressInput final : public IInputStream {
+        public:
+            explicit TZstdDecompressInput(IInputStream* slave)
+                : Slave(slave)
+                , Stream(ZSTD_createDStream())
+            {
+                CB_ENSURE(Stream, "Failed to create zstd decompression stream");
+                ZSTD_initDStream(Stream);
+                InBuffer.yresize(ZSTD_DStreamInSize());
+            }
+
+            ~TZstdDecompressInput() override {
+                ZSTD_freeDStream(Stream);
+            }
+
+        private:
+            size_t DoRead(void* buf, size_t len) override {
+                ZSTD_outBuffer output{buf, len, 0};
+                while (output.pos == 0) {
+                    if (Input.pos == Input.size) {
+                        if (!SlaveFinished) {
+                            const size_t readSize = Slave->Read(InBuffer.data(), InBuffer.size());
+                            SlaveFinished = (readSize == 0);
+                            Input = ZSTD_inBuffer{InBuffer.data(), readSize, 0};
+                        }
+                        // 0 is returned only when the frame is completely decoded and flushed
+                        if (SlaveFinished && (LastResult == 0)) {
+                            return 0;
+                        }
+                    }
+                    // frames following the finished one (incl. skippable ones) are processed transparently,
+                    // after the end of input the decoder still flushes the data it has buffered
+                    LastResult = ZSTD_decompressStream(Stream, &output, &Input);
+                    CB_ENSURE(!ZSTD_isError(LastResult), "zstd decompression error: " << ZSTD_getErrorName(LastResult));
+                    CB_ENSURE(!SlaveFinished || output.pos, "Truncated zstd stream");
+                }
+                return output.pos;
+            }
+
+        private:
+            IInputStream* Slave;
+            ZSTD_DStream* Stream;
+            TVector<char> InBuffer;
+            ZSTD_inBuffer Input = {nullptr, 0, 0};
+            bool SlaveFinished = false;
+            size_t LastResult = 0;
+        };
+
+
+        class TLz4FrameDecompressInput final : public IInputStream {
+        public:
+            explicit TLz4FrameDecompressInput(IInputStream* slave)
+                : Slave(slave)
+            {
+                const auto errorCode = LZ4F_createDecompressionContext(&Context, LZ4F_VERSION);
+                CB_ENSURE(!LZ4F_isError(errorCode), "Failed to create lz4 decompression context: " << LZ4F_getErrorName(errorCode));
+                InBuffer.yresize(DECOMPRESSION_BUFFER_SIZE);
+            }
+
+            ~TLz4FrameDecompressInput() override {
+                LZ4F_freeDecompressionContext(Context);
+            }
+
+        private:
+            size_t DoRead(void* buf, size_t len) override {
+                while (true) {
+                    if (InPos == InSize) {
+                        if (!SlaveFinished) {
+                            InSize = Slave->Read(InBuffer.data(), InBuffer.size());
+                            InPos = 0;
+                            SlaveFinished = (InSize == 0);
+                        }
+                        // 0 is returned only when the frame is completely decoded and flushed
+                        if (SlaveFinished && (LastHint == 0)) {
+                            return 0;
+                        }
+                    }
+                    // after the end of input the decoder still flushes the data it has buffered
+                    size_t dstSize = len;
+                    size_t srcSize = InSize - InPos;
+                    LastHint = LZ4F_decompress(Context, buf, &dstSize, InBuffer.data() + InPos, &srcSize, nullptr);
+                    CB_ENSURE(!LZ4F_isError(LastHint), "lz4 decompression error: " << LZ4F_getErrorName(LastHint));
+                    InPos += srcSize;
+                    if (dstSize) {
+                        return dstSize;
+                    }
+                    CB_ENSURE(!SlaveFinished, "Truncated lz4 stream");
+                }
+            }
+
+        private:
+            IInputStream* Slave;
+            LZ4F_dctx* Context = nullptr;
+            TVector<char> InBuffer;
+            size_t InPos = 0;
+            size_t InSize = 0;
+            bool SlaveFinished = false;
+            size_t LastHint = 0;
+        };
+
+
+        // owns the file and the decoder that reads from it
+        class TDecompressedFileInput final : public IInputStream {
+        public:
+            TDecompressedFileInput(const TString& path, TStringBuf codec)
+                : FileInput(path, DECOMPRESSION_BUFFER_SIZE)
+            {
+                if (codec == "gzip") {
+                    Decoder = MakeHolder<TZLibDecompress>(&FileInput, ZLib::Auto);
+                } else if (codec == "zstd") {
+                    Decoder = MakeHolder<TZstdDecompressInput>(&FileInput);
+                } else if (codec == "lz4") {
+                    Decoder = MakeHolder<TLz4FrameDecompressInput>(&FileInput);
+                } else {
+                    CB_ENSURE(false, "Unsupported compression codec \"" << codec << "\"");
+                }
+            }
+
+        private:
+            size_t DoRead(void* buf, size_t len) override {
+                return Decoder->Read(buf, len);
+            }
+
+        private:
+            TFileInput FileInput;
+            THolder<IInputStream> Decoder;
+        };
+
+
+        // see contrib/seekable_format/zstd_seekable_compression_format.md in zstd sources
+        constexpr ui32 ZSTD_SEEKABLE_MAGIC_NUMBER = 0x8F92EAB1;
+        constexpr ui32 ZSTD_SEEK_TABLE_SKIPPABLE_MAGIC_NUMBER = ZSTD_MAGIC_SKIPPABLE_START | 0xE;
+        constexpr size_t ZSTD_SEEK_TABLE_FOOTER_SIZE = 9;
+        constexpr size_t ZSTD_SKIPPABLE_HEADER_SIZE = 8;
+
+        struct TZstdSeekableFrame {
+            ui64 CompressedOffset = 0;
+            ui32 CompressedSize = 0;
+            ui32 DecompressedSize = 0;
+        };
+
+        ui32 ReadLittleEndianUi32(const char* ptr) {
+            return LittleToHost(ReadUnaligned<ui32>(ptr));
+        }
+
+        // returns Nothing() if the file is not in the seekable format
+        TMaybe<TVector<TZstdSeekableFrame>> ReadZstdSeekTable(const TFile& file) {
+            const ui64 fileSize = file.GetLength();
+            if (fileSize < ZSTD_SKIPPABLE_HEADER_SIZE + ZSTD_SEEK_TABLE_FOOTER_SIZE) {
+                return Nothing();
+            }
+            char footer[ZSTD_SEEK_TABLE_FOOTER_SIZE];
+            file.Pread(footer, ZSTD_SEEK_TABLE_FOOTER_SIZE, fileSize - ZSTD_SEEK_TABLE_FOOTER_SIZE);
+            if (ReadLittleEndianUi32(footer + 5) != ZSTD_SEEKABLE_MAGIC_NUMBER) {
+                return Nothing();
+            }
+            const ui64 frameCount = ReadLittleEndianUi32(footer);
+            const ui8 descriptor = footer[4];
+            const bool hasChecksums = descriptor & 0x80;
+            CB_ENSURE((descriptor & 0x7C) == 0, "Invalid zstd seek table descriptor");
+
+            const ui64 entrySize = hasChecksums ? 12 : 8;
+            const ui64 seekTableSize = ZSTD_SKIPPABLE_HEADER_SIZE + frameCount * entrySize + ZSTD_SEEK_TABLE_FOOTER_SIZE;
+            CB_ENSURE(seekTableSize <= fileSize, "Invalid zstd seek table: larger than the file");
+
+            TVector<char> seekTable;
+            seekTable.yresize(seekTableSize);
+            file.Pread(seekTable.data(), seekTableSize, fileSize - seekTableSize);
+            CB_ENSURE(
+                ReadLittleEndianUi32(seekTable.data()) == ZSTD_SEEK_TABLE_SKIPPABLE_MAGIC_NUMBER
+                && ReadLittleEndianUi32(seekTable.data() + 4) == seekTableSize - ZSTD_SKIPPABLE_HEADER_SIZE,
+                "Invalid zstd seek table header"
+            );
+
+            TVector<TZstdSeekableFrame> frames(frameCount);
+            ui64 offset = 0;
+            for (auto frameIdx : xrange(frameCount)) {
+                const char* entry = seekTable.data() + ZSTD_SKIPPABLE_HEADER_SIZE + frameIdx * entrySize;
+                frames[frameIdx].CompressedOffset = offset;
+                frames[frameIdx].CompressedSize = ReadLittleEndianUi32(entry);
+                frames[frameIdx].DecompressedSize = ReadLittleEndianUi32(entry + 4);
+                offset += frames[frameIdx].CompressedSize;
+            }
+            CB_ENSURE(offset + seekTableSize == fileSize, "Invalid zstd seek table: frame sizes do not match the file size");
+            return frames;
+        }
+
+
+        // decompresses independent frames by batches in parallel, returns data in the original order
+        class TZstdSeekableParallelInput final : public IInputStream {
+        public:
+            TZstdSeekableParallelInput(
+                const TFile& file,
+                TVector<TZstdSeekableFrame>&& frames,
+                NPar::ILocalExecutor* localExecutor
+            )
+                : File(file)
+                , Frames(std::move(frames))
+                , LocalExecutor(localExecutor)
+                , FramesPerBatch(2 * (localExecutor->GetThreadCount() + 1))
+            {}
+
+        private:
+            size_t DoRead(void* buf, size_t len) override {
+                while (BatchFrameIdx == Batch.size() || BatchPos == Batch[BatchFrameIdx].size()) {
+                    if (BatchFrameIdx < Batch.size()) {
+                        ++BatchFrameIdx;
+                        BatchPos = 0;
+                    }
+                    if (BatchFrameIdx == Batch.size()) {
+                        if (NextFrameIdx == Frames.size()) {
+                            return 0;
+                        }
+                        DecompressNextBatch();
+                    }
+                }
+                const auto& frameData = Batch[BatchFrameIdx];
+                const size_t readSize = Min(len, frameData.size() - BatchPos);
+                MemCopy((char*)buf, frameData.data() + BatchPos, readSize);
+                BatchPos += readSize;
+                return readSize;
+            }
+
+            void DecompressNextBatch() {
+                const size_t batchSize = Min(FramesPerBatch, Frames.size() - NextFrameIdx);
+                Batch.resize(batchSize);
+                LocalExecutor->ExecRangeWithThrow(
+                    [&] (int idxInBatch) {
+                        const auto& frame = Frames[NextFrameIdx + idxInBatch];
+                        TVector<char> compressed;
+                        compressed.yresize(frame.CompressedSize);
+                        File.Pread(compressed.data(), frame.CompressedSize, frame.CompressedOffset);
+
+                        auto& decompressed = Batch[idxInBatch];
+                        decompressed.yresize(frame.DecompressedSize);
+                        const size_t result = ZSTD_decompress(
+                            decompressed.data(),
+                            decompressed.size(),
+                            compressed.data(),
+                            compressed.size()
+                        );
+                        CB_ENSURE(!ZSTD_isError(result), "zstd decompression error: " << ZSTD_getErrorName(result));
+                        CB_ENSURE(result == frame.DecompressedSize, "zstd frame size does not match the seek table");
+                    },
+                    0,
+                    SafeIntegerCast<int>(batchSize),
+                    NPar::TLocalExecutor::WAIT_COMPLETE
+                );
+                NextFrameIdx += batchSize;
+                BatchFrameIdx = 0;
+                BatchPos = 0;
+            }
+
+        private:
+            TFile File;
+            TVector<TZstdSeekableFrame> Frames;
+            NPar::ILocalExecutor* LocalExecutor;
+            size_t FramesPerBatch;
+
+            size_t NextFrameIdx = 0;
+            TVector<TVector<char>> Batch;
+            size_t BatchFrameIdx = 0;
+            size_t BatchPos = 0;
+        };
+
+    }
+
+
+    THolder<IInputStream> OpenDecompressedInput(
+        const TString& path,
+        TStringBuf codec,
+        NPar::ILocalExecutor* localExecutor
+    ) {
+        CB_ENSURE(NFs::Exists(path), "file '" << path << "' is not found");
+        // decoders treat the absence of input as the end of stream
+        CB_ENSURE(GetFileLength(path) > 0, "compressed file '" << path << "' is empty");
+        if ((codec == "zstd") && localExecutor) {
+            TFile file(path, OpenExisting | RdOnly);
+            auto frames = ReadZstdSeekTable(file);
+            if (frames) {
+                return MakeHolder<TZstdSeekableParallelInput>(file, std::move(*frames), localExecutor);
+            }
+        }
+        return MakeHolder<TDecompressedFileInput>(path, codec);
+    }
+
+
+    TCompressedFileLineDataReader::TCompressedFileLineDataReader(const TLineDataReaderArgs& args)
+        : Args(args)
+        , DecompressedInput(
+            OpenDecompressedInput(args.PathWithScheme.Path, args.PathWithScheme.GetCompressionCodec(), args.LocalExecutor)
+        )
+        , Input(DecompressedInput.Get(), DECOMPRESSION_BUFFER_SIZE)
+        , HeaderProcessed(!Args.Format.HasHeader)
+    {}
+
+    ui64 TCompressedFileLineDataReader::GetDataLineCount() {
+        auto input = OpenDecompressedInput(
+            Args.PathWithScheme.Path,
+            Args.PathWithScheme.GetCompressionCodec(),
+            Args.LocalExecutor
+        );
+        TVector<char> buffer;
+        buffer.yresize(DECOMPRESSION_BUFFER_SIZE);
+        ui64 nLines = 0;
+        ui64 decompressedSize = 0;
+        char lastChar = '\n';
+        while (const size_t readSize = input->Read(buffer.data(), buffer.size())) {
+            nLines += Count(buffer.begin(), buffer.begin() + readSize, '\n');
+            decompressedSize += readSize;
+            lastChar = buffer[readSize - 1];
+        }
+        CB_ENSURE(decompressedSize > 0, "compressed file '" << Args.PathWithScheme.Path << "' contains no data");
+        if (lastChar != '\n') { // last line without line end
+            ++nLines;
+        }
+        if (Args.Format.HasHeader) {
+            --nLines;
+        }
+        return nLines;
+    }
+
+    TMaybe<TString> TCompressedFileLineDataReader::GetHeader() {
+        if (Args.Format.HasHeader) {
+            CB_ENSURE(!HeaderProcessed, "TCompressedFileLineDataReader: multiple calls to GetHeader");
+            TString header;
+            CB_ENSURE(Input.ReadLine(header), "TCompressedFileLineDataReader: no header in file");
+            HeaderProcessed = true;
+            return header;
+        }
+
+        return {};
+    }
+
+    bool TCompressedFileLineDataReader::ReadLine(TString* line) {
+        // skip header if it hasn't been read
+        if (!HeaderProcessed) {
+            GetHeader();
+        }
+        return Input.ReadLine(*line) != 0;
+    }
+
+
+    namespace {
+
+    TLineDataReaderFactory::TRegistrator<TCompressedFileLineDataReader> DsvGzipLineDataReaderReg("dsv+gzip");
+    TLineDataReaderFactory::TRegistrator<TCompressedFileLineDataReader> DsvZstdLineDataReaderReg("dsv+zstd");
+    TLineDataReaderFactory::TRegistrator<TCompressedFileLineDataReader> DsvLz4LineDataReaderReg("dsv+lz4");
+
+    TExistsCheckerFactory::TRegistrator<TFSExistsChecker> DsvGzipExistsCheckerReg("dsv+gzip");
+    TExistsCheckerFactory::TRegistrator<TFSExistsChecker> DsvZstdExistsCheckerReg("dsv+zstd");
+    TExistsCheckerFactory::TRegistrator<TFSExistsChecker> DsvLz4ExistsCheckerReg("dsv+lz4");
+
+    }
+}
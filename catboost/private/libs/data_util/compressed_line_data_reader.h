@@ -0,0 +1,47 @@
+#pragma once
+
+#include "line_data_reader.h"
+
+#include <util/generic/ptr.h>
+#include <util/generic/strbuf.h>
+#include <util/stream/buffered.h>
+#include <util/stream/input.h>
+
+
+namespace NPar {
+    class ILocalExecutor;
+}
+
+namespace NCB {
+
+    /* Decompressing input for files with "<format>+<codec>" schemes, codec is one of "gzip", "zstd", "lz4".
+       Concatenated streams (pigz, pzstd, ...) are supported.
+       zstd files in the seekable format (independent frames followed by a seek table) are decompressed
+       by batches of frames in parallel if localExecutor is provided.
+    */
+    THolder<IInputStream> OpenDecompressedInput(
+        const TString& path,
+        TStringBuf codec,
+        NPar::ILocalExecutor* localExecutor = nullptr
+    );
+
+
+    class TCompressedFileLineDataReader : public ILineDataReader {
+    public:
+        explicit TCompressedFileLineDataReader(const TLineDataReaderArgs& args);
+
+        // decompresses the whole file once more
+        ui64 GetDataLineCount() override;
+
+        TMaybe<TString> GetHeader() override;
+
+        bool ReadLine(TString* line) override;
+
+    private:
+        TLineDataReaderArgs Args;
+        THolder<IInputStream> DecompressedInput;
+        TBufferedInput Input;
+        bool HeaderProcessed;
+    };
+
+}
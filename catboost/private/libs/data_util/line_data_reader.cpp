@@ -1,15 +1,22 @@
 #include "line_data_reader.h"
 
+#include <library/cpp/threading/local_executor/local_executor.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/cast.h>
 #include <util/system/fs.h>
 
+#include <cstring>
+
 
 namespace NCB {
 
     THolder<ILineDataReader> GetLineDataReader(const TPathWithScheme& pathWithScheme,
-                                               const TDsvFormatOptions& format)
+                                               const TDsvFormatOptions& format,
+                                               NPar::ILocalExecutor* localExecutor)
     {
         return GetProcessor<ILineDataReader, TLineDataReaderArgs>(
-            pathWithScheme, TLineDataReaderArgs{pathWithScheme, format}
+            pathWithScheme, TLineDataReaderArgs{pathWithScheme, format, localExecutor}
         );
     }
 
@@ -24,6 +31,103 @@ namespace NCB {
         return count;
     }
 
+    static constexpr size_t LINE_RANGES_READ_BUFFER_SIZE = 1 << 20;
+
+    // returns position right after the first '\n' at or after offset (or fileSize if there's none)
+    static ui64 FindNextLineStart(const TFile& file, ui64 offset, ui64 fileSize) {
+        TVector<char> buffer;
+        buffer.yresize(Min<ui64>(LINE_RANGES_READ_BUFFER_SIZE, fileSize - Min(offset, fileSize)));
+        while (offset < fileSize) {
+            const size_t readSize = file.Pread(buffer.data(), Min<ui64>(buffer.size(), fileSize - offset), offset);
+            CB_ENSURE(readSize > 0, "Unexpected end of file " << file.GetName());
+            const char* lineEnd = (const char*)memchr(buffer.data(), '\n', readSize);
+            if (lineEnd) {
+                return offset + (lineEnd - buffer.data()) + 1;
+            }
+            offset += readSize;
+        }
+        return fileSize;
+    }
+
+    static ui64 CountLineEnds(const TFile& file, ui64 begin, ui64 end) {
+        TVector<char> buffer;
+        buffer.yresize(Min<ui64>(LINE_RANGES_READ_BUFFER_SIZE, end - begin));
+        ui64 count = 0;
+        for (ui64 offset = begin; offset < end;) {
+            const size_t readSize = file.Pread(buffer.data(), Min<ui64>(buffer.size(), end - offset), offset);
+            CB_ENSURE(readSize > 0, "Unexpected end of file " << file.GetName());
+            count += Count(buffer.begin(), buffer.begin() + readSize, '\n');
+            offset += readSize;
+        }
+        return count;
+    }
+
+    TVector<TFileLineRange> SplitFileIntoLineRanges(
+        const TString& path,
+        bool hasHeader,
+        ui64 rangeSize,
+        NPar::ILocalExecutor* localExecutor
+    ) {
+        CB_ENSURE(NFs::Exists(path), "pool file '" << path << "' is not found");
+        CB_ENSURE_INTERNAL(rangeSize > 0, "SplitFileIntoLineRanges: rangeSize == 0");
+
+        TFile file(path, OpenExisting | RdOnly);
+        const ui64 fileSize = file.GetLength();
+        const ui64 dataBegin = hasHeader ? FindNextLineStart(file, 0, fileSize) : 0;
+        const ui64 nominalRangeCount = Max<ui64>(1, (fileSize - dataBegin + rangeSize - 1) / rangeSize);
+        CB_ENSURE(nominalRangeCount <= (ui64)Max<int>(), "Too many line ranges, increase range size");
+
+        TVector<ui64> rangeStarts(nominalRangeCount + 1);
+        rangeStarts[0] = dataBegin;
+        rangeStarts.back() = fileSize;
+        localExecutor->ExecRangeWithThrow(
+            [&] (int rangeIdx) {
+                // the range starts right after the end of the line that contains byte before its nominal start
+                rangeStarts[rangeIdx] = FindNextLineStart(file, dataBegin + rangeIdx * rangeSize - 1, fileSize);
+            },
+            1,
+            SafeIntegerCast<int>(nominalRangeCount),
+            NPar::TLocalExecutor::WAIT_COMPLETE
+        );
+        // lines longer than rangeSize make consecutive starts coincide
+        rangeStarts.erase(Unique(rangeStarts.begin(), rangeStarts.end()), rangeStarts.end());
+
+        TVector<TFileLineRange> ranges(rangeStarts.size() - 1);
+        localExecutor->ExecRangeWithThrow(
+            [&] (int rangeIdx) {
+                auto& range = ranges[rangeIdx];
+                range.Begin = rangeStarts[rangeIdx];
+                range.End = rangeStarts[rangeIdx + 1];
+                range.LineCount = CountLineEnds(file, range.Begin, range.End);
+            },
+            0,
+            SafeIntegerCast<int>(ranges.size()),
+            NPar::TLocalExecutor::WAIT_COMPLETE
+        );
+        EraseIf(ranges, [] (const TFileLineRange& range) { return range.Begin == range.End; });
+
+        if (!ranges.empty()) {
+            char lastChar;
+            CB_ENSURE(file.Pread(&lastChar, 1, fileSize - 1) == 1, "Unexpected end of file " << path);
+            if (lastChar != '\n') { // last line without line end
+                ++ranges.back().LineCount;
+            }
+        }
+        return ranges;
+    }
+
+    static TFile OpenAtOffset(const TString& path, ui64 offset) {
+        TFile file(path, OpenExisting | RdOnly | Seq);
+        file.Seek(offset, sSet);
+        return file;
+    }
+
+    TFileLineRangeReader::TFileLineRangeReader(const TString& path, const TFileLineRange& range)
+        : File(OpenAtOffset(path, range.Begin))
+        , FileInput(File)
+        , LimitedInput(&FileInput, range.End - range.Begin)
+    {}
+
     TLineDataReaderFactory::TRegistrator<TFileLineDataReader> DefLineDataReaderReg("");
     TLineDataReaderFactory::TRegistrator<TFileLineDataReader> FileLineDataReaderReg("file");
     TLineDataReaderFactory::TRegistrator<TFileLineDataReader> DsvLineDataReaderReg("dsv");
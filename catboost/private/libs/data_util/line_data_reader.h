@@ -8,9 +8,17 @@
 
 #include <util/generic/maybe.h>
 #include <util/generic/string.h>
+#include <util/generic/vector.h>
 
 #include <util/stream/file.h>
+#include <util/stream/length.h>
 #include <util/string/escape.h>
+#include <util/system/file.h>
+
+
+namespace NPar {
+    class ILocalExecutor;
+}
 
 
 namespace NCB {
@@ -45,6 +53,7 @@ namespace NCB {
     struct TLineDataReaderArgs {
         TPathWithScheme PathWithScheme;
         TDsvFormatOptions Format;
+        NPar::ILocalExecutor* LocalExecutor = nullptr; // optional, used by readers that can decode data in parallel
     };
 
 
@@ -71,7 +80,8 @@ namespace NCB {
         NObjectFactory::TParametrizedObjectFactory<ILineDataReader, TString, TLineDataReaderArgs>;
 
     THolder<ILineDataReader> GetLineDataReader(const TPathWithScheme& pathWithScheme,
-                                               const TDsvFormatOptions& format = TDsvFormatOptions());
+                                               const TDsvFormatOptions& format = TDsvFormatOptions(),
+                                               NPar::ILocalExecutor* localExecutor = nullptr);
 
 
     int CountLines(const TString& poolFile);
@@ -112,10 +122,49 @@ namespace NCB {
             return IFStream.ReadLine(*line) != 0;
         }
 
+        const TLineDataReaderArgs& GetArgs() const {
+            return Args;
+        }
+
     private:
         TLineDataReaderArgs Args;
         TIFStream IFStream;
         bool HeaderProcessed;
     };
 
+
+    // byte range [Begin, End) of a file that starts at a line start and contains LineCount whole lines
+    struct TFileLineRange {
+        ui64 Begin = 0;
+        ui64 End = 0;
+        ui64 LineCount = 0;
+    };
+
+    /* Splits data lines of the file (w/o header, if present) into ranges of approximately rangeSize bytes
+       aligned to line starts and counts lines in them in parallel.
+       Sum of LineCount over the result is the number of data lines, so no separate CountLines pass is needed.
+       Lines are counted the same way as ReadLine does: the last line may have no trailing '\n'.
+    */
+    TVector<TFileLineRange> SplitFileIntoLineRanges(
+        const TString& path,
+        bool hasHeader,
+        ui64 rangeSize,
+        NPar::ILocalExecutor* localExecutor
+    );
+
+    // reads lines of one TFileLineRange, independent readers of the same file can be used concurrently
+    class TFileLineRangeReader {
+    public:
+        TFileLineRangeReader(const TString& path, const TFileLineRange& range);
+
+        bool ReadLine(TString* line) {
+            return LimitedInput.ReadLine(*line) != 0;
+        }
+
+    private:
+        TFile File;
+        TFileInput FileInput;
+        TLengthLimitedInput LimitedInput;
+    };
+
 }
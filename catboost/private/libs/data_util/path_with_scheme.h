@@ -40,6 +40,18 @@ namespace NCB {
         bool Inited() const {
             return !Path.empty();
         }
+
+        // "dsv+zstd" scheme has "dsv" format and "zstd" compression codec
+        TStringBuf GetFormat() const {
+            return TStringBuf(Scheme).Before('+');
+        }
+
+        // empty for uncompressed data
+        TStringBuf GetCompressionCodec() const {
+            TStringBuf format, codec;
+            TStringBuf(Scheme).TrySplit('+', format, codec);
+            return codec;
+        }
     };
 
 
@@ -0,0 +1,152 @@
+#include <library/cpp/testing/unittest/registar.h>
+
+#include <catboost/private/libs/data_util/compressed_line_data_reader.h>
+
+#include <contrib/libs/lz4/lz4frame.h>
+#include <contrib/libs/zstd/zstd.h>
+
+#include <library/cpp/threading/local_executor/local_executor.h>
+
+#include <util/generic/xrange.h>
+#include <util/stream/file.h>
+#include <util/stream/zlib.h>
+#include <util/system/mktemp.h>
+#include <util/system/tempfile.h>
+#include <util/system/unaligned_mem.h>
+
+
+using namespace NCB;
+
+
+static TString ZstdCompress(TStringBuf data) {
+    TString result;
+    result.resize(ZSTD_compressBound(data.size()));
+    const size_t size = ZSTD_compress(result.begin(), result.size(), data.data(), data.size(), 1);
+    UNIT_ASSERT(!ZSTD_isError(size));
+    result.resize(size);
+    return result;
+}
+
+static void AppendUi32(ui32 value, TString* result) {
+    char buf[4];
+    WriteUnaligned<ui32>(buf, value);
+    result->append(buf, 4);
+}
+
+// independent frames of frameSize bytes followed by a seek table
+static TString ZstdSeekableCompress(TStringBuf data, size_t frameSize) {
+    TString result;
+    TString seekTableEntries;
+    ui32 frameCount = 0;
+    for (size_t offset = 0; offset < data.size(); offset += frameSize, ++frameCount) {
+        const TStringBuf frameData = data.SubStr(offset, frameSize);
+        const TString frame = ZstdCompress(frameData);
+        result += frame;
+        AppendUi32(frame.size(), &seekTableEntries);
+        AppendUi32(frameData.size(), &seekTableEntries);
+    }
+    AppendUi32(ZSTD_MAGIC_SKIPPABLE_START | 0xE, &result);
+    AppendUi32(seekTableEntries.size() + 9, &result);
+    result += seekTableEntries;
+    AppendUi32(frameCount, &result);
+    result.push_back('\0');
+    AppendUi32(0x8F92EAB1, &result);
+    return result;
+}
+
+static TString Lz4Compress(TStringBuf data) {
+    TString result;
+    result.resize(LZ4F_compressFrameBound(data.size(), nullptr));
+    const size_t size = LZ4F_compressFrame(result.begin(), result.size(), data.data(), data.size(), nullptr);
+    UNIT_ASSERT(!LZ4F_isError(size));
+    result.resize(size);
+    return result;
+}
+
+static TString GzipCompress(TStringBuf data) {
+    TStringStream result;
+    {
+        TZLibCompress compress(&result, ZLib::GZip);
+        compress.Write(data);
+        compress.Finish();
+    }
+    return result.Str();
+}
+
+static TVector<TString> ReadAllLines(const TString& fileContent, TStringBuf scheme, NPar::ILocalExecutor* localExecutor) {
+    TTempFile file(MakeTempName());
+    {
+        TOFStream out(file.Name());
+        out << fileContent;
+    }
+    auto reader = GetLineDataReader(TPathWithScheme(file.Name(), scheme), TDsvFormatOptions(true), localExecutor);
+    const ui64 lineCount = reader->GetDataLineCount();
+    UNIT_ASSERT(reader->GetHeader());
+
+    TVector<TString> lines;
+    TString line;
+    while (reader->ReadLine(&line)) {
+        lines.push_back(line);
+    }
+    UNIT_ASSERT_VALUES_EQUAL(lines.size(), lineCount);
+    return lines;
+}
+
+Y_UNIT_TEST_SUITE(TCompressedFileLineDataReader) {
+    Y_UNIT_TEST(SameLinesAsUncompressed) {
+        TString data = "header\n";
+        for (auto i : xrange(10000)) {
+            data += ToString(i) + "\t" + ToString(i * i) + (i % 3 ? "\n" : "\r\n");
+        }
+        data += "last line without line end";
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        const auto expected = ReadAllLines(data, "dsv", nullptr);
+        UNIT_ASSERT_VALUES_EQUAL(ReadAllLines(GzipCompress(data), "dsv+gzip", nullptr), expected);
+        UNIT_ASSERT_VALUES_EQUAL(ReadAllLines(Lz4Compress(data), "dsv+lz4", nullptr), expected);
+        UNIT_ASSERT_VALUES_EQUAL(ReadAllLines(ZstdCompress(data), "dsv+zstd", &localExecutor), expected);
+        // concatenated frames
+        const TString twoFrames = ZstdCompress(TStringBuf(data).Head(1000)) + ZstdCompress(TStringBuf(data).Tail(1000));
+        UNIT_ASSERT_VALUES_EQUAL(ReadAllLines(twoFrames, "dsv+zstd", nullptr), expected);
+        for (size_t frameSize : {1, 777, 1 << 20}) {
+            const TString seekable = ZstdSeekableCompress(data, frameSize);
+            UNIT_ASSERT_VALUES_EQUAL(ReadAllLines(seekable, "dsv+zstd", &localExecutor), expected);
+            UNIT_ASSERT_VALUES_EQUAL(ReadAllLines(seekable, "dsv+zstd", nullptr), expected);
+        }
+    }
+
+    // decoders keep decompressed data after the end of the compressed input when the output buffer is full
+    Y_UNIT_TEST(LargeDecompressedSize) {
+        TString data = "header\n";
+        for (auto i : xrange(500000)) {
+            data += ToString(i % 1000) + "\tvalue\n";
+        }
+        UNIT_ASSERT(data.size() > (4 << 20));
+
+        const auto expected = ReadAllLines(data, "dsv", nullptr);
+        UNIT_ASSERT_VALUES_EQUAL(ReadAllLines(Lz4Compress(data), "dsv+lz4", nullptr), expected);
+        UNIT_ASSERT_VALUES_EQUAL(ReadAllLines(ZstdCompress(data), "dsv+zstd", nullptr), expected);
+    }
+
+    Y_UNIT_TEST(TruncatedStream) {
+        TString data = "header\n";
+        for (auto i : xrange(10000)) {
+            data += ToString(i) + "\n";
+        }
+        const TString lz4 = Lz4Compress(data);
+        const TString zstd = ZstdCompress(data);
+        UNIT_ASSERT_EXCEPTION(ReadAllLines(lz4.substr(0, lz4.size() - 4), "dsv+lz4", nullptr), TCatBoostException);
+        UNIT_ASSERT_EXCEPTION(ReadAllLines(zstd.substr(0, zstd.size() - 4), "dsv+zstd", nullptr), TCatBoostException);
+    }
+
+    Y_UNIT_TEST(EmptyFile) {
+        for (TStringBuf scheme : {"dsv+gzip", "dsv+lz4", "dsv+zstd"}) {
+            UNIT_ASSERT_EXCEPTION_CONTAINS(ReadAllLines("", scheme, nullptr), TCatBoostException, "is empty");
+        }
+        UNIT_ASSERT_EXCEPTION_CONTAINS(ReadAllLines(GzipCompress(""), "dsv+gzip", nullptr), TCatBoostException, "contains no data");
+        UNIT_ASSERT_EXCEPTION_CONTAINS(ReadAllLines(Lz4Compress(""), "dsv+lz4", nullptr), TCatBoostException, "contains no data");
+        UNIT_ASSERT_EXCEPTION_CONTAINS(ReadAllLines(ZstdCompress(""), "dsv+zstd", nullptr), TCatBoostException, "contains no data");
+    }
+}
@@ -0,0 +1,68 @@
+#include <library/cpp/testing/unittest/registar.h>
+
+#include <catboost/private/libs/data_util/line_data_reader.h>
+
+#include <library/cpp/threading/local_executor/local_executor.h>
+
+#include <util/generic/xrange.h>
+#include <util/stream/file.h>
+#include <util/system/mktemp.h>
+#include <util/system/tempfile.h>
+
+
+using namespace NCB;
+
+
+static TVector<TString> ReadAllLines(const TString& path, bool hasHeader) {
+    TFileLineDataReader reader(TLineDataReaderArgs{TPathWithScheme(path, "dsv"), TDsvFormatOptions(hasHeader)});
+    TVector<TString> lines;
+    TString line;
+    while (reader.ReadLine(&line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+static TVector<TString> ReadAllLinesInRanges(const TString& path, bool hasHeader, ui64 rangeSize) {
+    NPar::TLocalExecutor localExecutor;
+    localExecutor.RunAdditionalThreads(3);
+
+    const auto ranges = SplitFileIntoLineRanges(path, hasHeader, rangeSize, &localExecutor);
+    TVector<TString> lines;
+    for (const auto& range : ranges) {
+        UNIT_ASSERT(range.Begin < range.End);
+        TFileLineRangeReader reader(path, range);
+        TString line;
+        ui64 rangeLineCount = 0;
+        while (reader.ReadLine(&line)) {
+            lines.push_back(line);
+            ++rangeLineCount;
+        }
+        UNIT_ASSERT_VALUES_EQUAL(rangeLineCount, range.LineCount);
+    }
+    return lines;
+}
+
+Y_UNIT_TEST_SUITE(TFileLineRanges) {
+    Y_UNIT_TEST(SameLinesAsSequentialReader) {
+        const TVector<TString> contents = {
+            "a\tb\n",
+            "header\n0\t1\n2\t3\n",
+            "header\n0\t1\r\n2\t3\r\n4\t5",
+            "h\nshort\na much longer line that spans several ranges\n\nx\n",
+        };
+        for (const auto& content : contents) {
+            TTempFile file(MakeTempName());
+            {
+                TOFStream out(file.Name());
+                out << content;
+            }
+            for (bool hasHeader : {false, true}) {
+                const auto expected = ReadAllLines(file.Name(), hasHeader);
+                for (ui64 rangeSize : {1, 2, 3, 7, 1000}) {
+                    UNIT_ASSERT_VALUES_EQUAL(ReadAllLinesInRanges(file.Name(), hasHeader, rangeSize), expected);
+                }
+            }
+        }
+    }
+}
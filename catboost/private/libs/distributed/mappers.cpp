@@ -19,6 +19,7 @@
 #include <catboost/libs/helpers/parallel_tasks.h>
 #include <catboost/libs/helpers/query_info_helper.h>
 #include <catboost/libs/helpers/vector_helpers.h>
+#include <catboost/libs/logging/trace.h>
 #include <catboost/private/libs/index_range/index_range.h>
 
 #include <util/generic/ymath.h>
@@ -98,6 +99,7 @@ namespace NCatboostDistributed {
         TInput* params,
         TOutput* /*unused*/
     ) const {
+        CB_TRACE_SCOPE("TDatasetLoader::DoMap");
         auto& localData = TLocalTensorSearchData::GetRef();
         if (localData.Rand == nullptr) {
             localData.Rand = MakeHolder<TRestorableFastRng64>(params->RandomSeed + hostId);
@@ -157,6 +159,7 @@ namespace NCatboostDistributed {
         TInput* params,
         TOutput* /*unused*/
     ) const {
+        CB_TRACE_SCOPE("TPlainFoldBuilder::DoMap");
         NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
         auto& localData = TLocalTensorSearchData::GetRef();
         if (localData.Rand == nullptr) { // may be set by TDatasetLoader
@@ -196,6 +199,7 @@ namespace NCatboostDistributed {
             trainParams.ObliviousTreeOptions.Get(),
             /*initModel*/ Nothing(),
             /*initModelApplyCompatiblePools*/ NCB::TDataProviders(),
+            /*approxCacheFile*/ "",
             &NPar::LocalExecutor());
         Y_ASSERT(localData.Progress->AveragingFold.BodyTailArr.ysize() == 1);
 
@@ -246,6 +250,7 @@ namespace NCatboostDistributed {
         TInput* valuedForest,
         TOutput* /*unused*/
     ) const {
+        CB_TRACE_SCOPE("TApproxReconstructor::DoMap");
         NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
 
         auto& localData = TLocalTensorSearchData::GetRef();
@@ -288,6 +293,7 @@ namespace NCatboostDistributed {
         TInput* /*unused*/,
         TOutput* /*unused*/
     ) const {
+        CB_TRACE_SCOPE("TTensorSearchStarter::DoMap");
         auto& localData = TLocalTensorSearchData::GetRef();
         localData.Depth = 0;
         Fill(localData.Indices.begin(), localData.Indices.end(), 0);
@@ -302,6 +308,7 @@ namespace NCatboostDistributed {
         TInput* /*unused*/,
         TOutput* /*unused*/
     ) const {
+        CB_TRACE_SCOPE("TBootstrapMaker::DoMap");
         auto& localData = TLocalTensorSearchData::GetRef();
         Bootstrap(
             localData.Params,
@@ -321,6 +328,7 @@ namespace NCatboostDistributed {
         TInput* /*unused*/,
         TOutput* outSum2
     ) const {
+        CB_TRACE_SCOPE("TDerivativesStDevFromZeroCalcer::DoMap");
         auto& localData = TLocalTensorSearchData::GetRef();
 
         const auto& bodyTailArr = localData.Progress->AveragingFold.BodyTailArr;
@@ -427,6 +435,7 @@ namespace NCatboostDistributed {
         TInput* candidateList,
         TOutput* bucketStats
     ) const {
+        CB_TRACE_SCOPE("TScoreCalcer::DoMap");
         NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
         auto calcStats3D = [&](const TCandidateInfo& candidate, TStats3D* stats3D) {
             CalcStats3D(trainData, candidate, stats3D);
@@ -440,6 +449,7 @@ namespace NCatboostDistributed {
         TInput* candidateList,
         TOutput* bucketStats
     ) const {
+        CB_TRACE_SCOPE("TPairwiseScoreCalcer::DoMap");
         NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
         auto& localData = TLocalTensorSearchData::GetRef();
         auto calcPairwiseStats = [&](const TCandidateInfo& candidate, TPairwiseStats* pairwiseStats) {
@@ -455,6 +465,7 @@ namespace NCatboostDistributed {
         TInput* candidate,
         TOutput* bucketStats
     ) const {
+        CB_TRACE_SCOPE("TRemotePairwiseBinCalcer::DoMap");
         NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
         auto& localData = TLocalTensorSearchData::GetRef();
         auto calcPairwiseStats = [&](const TCandidateInfo& candidate, TPairwiseStats* pairwiseStats) {
@@ -465,6 +476,7 @@ namespace NCatboostDistributed {
 
     // workerPairwiseStats -> pairwiseStats
     void TRemotePairwiseBinCalcer::DoReduce(TVector<TOutput>* statsFromAllWorkers, TOutput* stats) const {
+        CB_TRACE_SCOPE("TRemotePairwiseBinCalcer::DoReduce");
         const int workerCount = statsFromAllWorkers->ysize();
         const int bucketCount = (*statsFromAllWorkers)[0].ysize();
         stats->yresize(bucketCount);
@@ -486,6 +498,7 @@ namespace NCatboostDistributed {
         TInput* bucketStats,
         TOutput* scores
     ) const {
+        CB_TRACE_SCOPE("TRemotePairwiseScoreCalcer::DoMap");
         const auto& localData = TLocalTensorSearchData::GetRef();
         const int bucketCount = (*bucketStats)[0].DerSums[0].ysize();
         const auto getScores =
@@ -510,6 +523,7 @@ namespace NCatboostDistributed {
         TInput* candidatesInfoList,
         TOutput* bucketStats
     ) const {
+        CB_TRACE_SCOPE("TRemoteBinCalcer::DoMap");
         NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
         auto calcStats3D = [&](const TCandidateInfo& candidate, TStats3D* stats3D) {
             CalcStats3D(trainData, candidate, stats3D);
@@ -519,6 +533,7 @@ namespace NCatboostDistributed {
 
     // vector<TStats4D> -> TStats4D
     void TRemoteBinCalcer::DoReduce(TVector<TOutput>* statsFromAllWorkers, TOutput* stats) const {
+        CB_TRACE_SCOPE("TRemoteBinCalcer::DoReduce");
         const int workerCount = statsFromAllWorkers->ysize();
         const int bucketCount = (*statsFromAllWorkers)[0].ysize();
         stats->yresize(bucketCount);
@@ -540,6 +555,7 @@ namespace NCatboostDistributed {
         TInput* bucketStats,
         TOutput* scores
     ) const {
+        CB_TRACE_SCOPE("TRemoteScoreCalcer::DoMap");
         const auto& localData = TLocalTensorSearchData::GetRef();
         const auto getScores =
             [&] (const TStats3D& candidateStats3D, TVector<double>* candidateScores) {
@@ -558,6 +574,7 @@ namespace NCatboostDistributed {
         TInput* bestSplit,
         TOutput* /*unused*/
     ) const {
+        CB_TRACE_SCOPE("TLeafIndexSetter::DoMap");
         Y_ASSERT(bestSplit->Type != ESplitType::OnlineCtr);
         auto& localData = TLocalTensorSearchData::GetRef();
         NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
@@ -585,6 +602,7 @@ namespace NCatboostDistributed {
         TInput* /*unused*/,
         TOutput* isLeafEmpty
     ) const {
+        CB_TRACE_SCOPE("TEmptyLeafFinder::DoMap");
         auto& localData = TLocalTensorSearchData::GetRef();
         *isLeafEmpty = GetIsLeafEmpty(localData.Depth + 1, localData.Indices, &NPar::LocalExecutor());
         ++localData.Depth; // tree level completed
@@ -596,6 +614,7 @@ namespace NCatboostDistributed {
         TInput* /*unused*/,
         TOutput* sums
     ) const {
+        CB_TRACE_SCOPE("TBucketSimpleUpdater::DoMap");
         auto& localData = TLocalTensorSearchData::GetRef();
         const int approxDimension = localData.Progress->ApproxDimension;
         Y_ASSERT(approxDimension == 1);
@@ -635,6 +654,7 @@ namespace NCatboostDistributed {
         TInput* splitTree,
         TOutput* /*unused*/
     ) const {
+        CB_TRACE_SCOPE("TCalcApproxStarter::DoMap");
         auto& localData = TLocalTensorSearchData::GetRef();
         const auto& error = BuildError(localData.Params, /*custom objective*/Nothing());
         NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
@@ -672,6 +692,7 @@ namespace NCatboostDistributed {
         TInput* leafValues,
         TOutput* /*unused*/
     ) const {
+        CB_TRACE_SCOPE("TDeltaSimpleUpdater::DoMap");
         auto& localData = TLocalTensorSearchData::GetRef();
         UpdateApproxDeltas(
             localData.StoreExpApprox,
@@ -689,6 +710,7 @@ namespace NCatboostDistributed {
         TInput* averageLeafValues,
         TOutput* /*unused*/
     ) const {
+        CB_TRACE_SCOPE("TApproxUpdater::DoMap");
         auto& localData = TLocalTensorSearchData::GetRef();
         if (localData.StoreExpApprox) {
             UpdateBodyTailApprox</*StoreExpApprox*/true>(
@@ -722,6 +744,7 @@ namespace NCatboostDistributed {
         TInput* /*unused*/,
         TOutput* /*unused*/
     ) const {
+        CB_TRACE_SCOPE("TDerivativeSetter::DoMap");
         auto& localData = TLocalTensorSearchData::GetRef();
         Y_ASSERT(localData.Progress->AveragingFold.BodyTailArr.ysize() == 1);
         const auto error = BuildError(localData.Params, /*custom objective*/Nothing());
@@ -740,6 +763,7 @@ namespace NCatboostDistributed {
         TInput* /*unused*/,
         TOutput* sums
     ) const {
+        CB_TRACE_SCOPE("TBucketMultiUpdater::DoMap");
         auto& localData = TLocalTensorSearchData::GetRef();
         const auto error = BuildError(localData.Params, /*custom objective*/Nothing());
         const auto estimationMethod = localData.Params.ObliviousTreeOptions->LeavesEstimationMethod;
@@ -765,6 +789,7 @@ namespace NCatboostDistributed {
         TInput* leafValues,
         TOutput* /*unused*/
     ) const {
+        CB_TRACE_SCOPE("TDeltaMultiUpdater::DoMap");
         auto& localData = TLocalTensorSearchData::GetRef();
         UpdateApproxDeltasMulti(
             localData.Indices,
@@ -781,6 +806,7 @@ namespace NCatboostDistributed {
         TInput* useAveragingFold,
         TOutput* additiveStats
     ) const {
+        CB_TRACE_SCOPE("TErrorCalcer::DoMap");
         const auto& localData = TLocalTensorSearchData::GetRef();
         NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
         const NCB::TTrainingDataProvider& learnData = *(GetTrainData(trainData).Learn);
@@ -821,6 +847,7 @@ namespace NCatboostDistributed {
         TInput* /*unused*/,
         TOutput* leafWeights
     ) const {
+        CB_TRACE_SCOPE("TLeafWeightsGetter::DoMap");
         auto& localData = TLocalTensorSearchData::GetRef();
         NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
         const size_t leafCount = localData.Buckets.size();
@@ -833,6 +860,7 @@ namespace NCatboostDistributed {
     }
 
     void TLeafWeightsGetter::DoReduce(TVector<TOutput>* inLeafWeightsFromWorkers, TOutput* outTotalLeafWeights) const {
+        CB_TRACE_SCOPE("TLeafWeightsGetter::DoReduce");
         const auto& leafWeightsFromWorkers = *inLeafWeightsFromWorkers;
         TOutput totalLeafWeights = leafWeightsFromWorkers[0];
         for (auto i : xrange(1, SafeIntegerCast<int>(leafWeightsFromWorkers.size()))) {
@@ -851,6 +879,7 @@ namespace NCatboostDistributed {
         TInput* /*input*/,
         TOutput* outMinMaxDiffs
     ) const {
+        CB_TRACE_SCOPE("TQuantileExactApproxStarter::DoMap");
         auto& localData = TLocalTensorSearchData::GetRef();
         const int leafCount = localData.Buckets.size();
         const int approxDimension = localData.Progress->AvrgApprox.size();
@@ -901,6 +930,7 @@ namespace NCatboostDistributed {
 
     void TQuantileExactApproxStarter::DoReduce(TVector<TOutput>* inMinMaxDiffsFromWorkers,
                                                TOutput* reducedMinMaxDiffs) const {
+        CB_TRACE_SCOPE("TQuantileExactApproxStarter::DoReduce");
         const auto& minMaxDiffsFromWorkers = *inMinMaxDiffsFromWorkers;
         TOutput result = minMaxDiffsFromWorkers[0];
         for (auto worker : xrange(1, SafeIntegerCast<int>(minMaxDiffsFromWorkers.size()))) {
@@ -925,6 +955,7 @@ namespace NCatboostDistributed {
         TInput* pivots,
         TOutput* outLeftRightWeights
     ) const {
+        CB_TRACE_SCOPE("TQuantileArraySplitter::DoMap");
         auto& localData = TLocalTensorSearchData::GetRef();
         const auto leafCount = localData.Buckets.size();
         const auto& pivotsRef = *pivots;
@@ -971,6 +1002,7 @@ namespace NCatboostDistributed {
         TVector<TOutput>* inLeftWeightsFromWorkers,
         TOutput* outTotalLeftWeights
     ) const {
+        CB_TRACE_SCOPE("TQuantileArraySplitter::DoReduce");
         const auto& leftWeightsFromWorkers = *inLeftWeightsFromWorkers;
         TOutput totalLeftWeights = leftWeightsFromWorkers[0];
         for (auto worker : xrange(1, SafeIntegerCast<int>(leftWeightsFromWorkers.size()))) {
@@ -991,6 +1023,7 @@ namespace NCatboostDistributed {
         TInput* inPivots,
         TOutput* outEqualSumWeights
     ) const {
+        CB_TRACE_SCOPE("TQuantileEqualWeightsCalcer::DoMap");
         auto& localData = TLocalTensorSearchData::GetRef();
         const auto& pivots = *inPivots;
         const auto approxDimension = pivots.size();
@@ -1013,6 +1046,7 @@ namespace NCatboostDistributed {
     }
 
     void TQuantileEqualWeightsCalcer::DoReduce(TVector<TOutput>* inEqualSumWeightsFromWorkers, TOutput* outTotalEqualSumWeights) const {
+        CB_TRACE_SCOPE("TQuantileEqualWeightsCalcer::DoReduce");
         const auto& equalSumWeightsFromWorkers = *inEqualSumWeightsFromWorkers;
         TOutput totalEqualSumWeights = equalSumWeightsFromWorkers[0];
         for (auto worker : xrange(1, SafeIntegerCast<int>(equalSumWeightsFromWorkers.size()))) {
@@ -1024,6 +1058,7 @@ namespace NCatboostDistributed {
     }
 
     void TArmijoStartPointBackupper::DoMap(NPar::IUserContext* /*ctx*/, int /*hostId*/, TInput* isRestore, TOutput* /*unused*/) const {
+        CB_TRACE_SCOPE("TArmijoStartPointBackupper::DoMap");
         auto& localData = TLocalTensorSearchData::GetRef();
         if (*isRestore) {
             CB_ENSURE_INTERNAL(!localData.BacktrackingStart.empty(), "Need saved backtracking start point to restore from");
@@ -10,15 +10,16 @@
 #include <catboost/libs/logging/logging.h>
 #include <catboost/private/libs/target/data_providers.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/cast.h>
 #include <util/generic/maybe.h>
 #include <util/generic/ptr.h>
+#include <util/generic/xrange.h>
 #include <util/generic/ymath.h>
 #include <util/string/cast.h>
 #include <util/string/split.h>
 
-#include <functional>
-#include <numeric>
+#include <utility>
 
 
 using namespace NCB;
@@ -42,73 +43,123 @@ static TUpdateMethod ParseUpdateMethod(const TString& updateMethod) {
     return TUpdateMethod(updateType, topSize);
 }
 
-static TDStrResult GetFinalDocumentImportances(
-    const TVector<TVector<double>>& rawImportances,
-    EDocumentStrengthType docImpMethod,
-    int topSize,
-    EImportanceValuesSign importanceValuesSign
-) {
-    const ui32 trainDocCount = rawImportances.size();
-    Y_ASSERT(rawImportances.size() != 0);
-    const ui32 testDocCount = rawImportances[0].size();
-    TVector<TVector<double>> preprocessedImportances;
-    if (docImpMethod == EDocumentStrengthType::Average) {
-        preprocessedImportances = TVector<TVector<double>>(1, TVector<double>(trainDocCount));
-        for (ui32 trainDocId = 0; trainDocId < trainDocCount; ++trainDocId) {
-            for (ui32 testDocId = 0; testDocId < testDocCount; ++testDocId) {
-                preprocessedImportances[0][trainDocId] += rawImportances[trainDocId][testDocId];
+static bool HasRequiredSign(double importance, EImportanceValuesSign importanceValuesSign) {
+    switch (importanceValuesSign) {
+        case EImportanceValuesSign::Positive:
+            return importance > 0;
+        case EImportanceValuesSign::Negative:
+            return importance < 0;
+        case EImportanceValuesSign::All:
+            return true;
+    }
+    Y_UNREACHABLE();
+}
+
+namespace {
+    // Reduces importances of train documents, which come in blocks, to the final top of them,
+    // so the dense [trainDocCount][testDocCount] matrix is never stored.
+    class TDocumentImportancesAggregator {
+    public:
+        using TScoredDoc = std::pair<double, ui32>; // (importance, trainDocId)
+
+    public:
+        TDocumentImportancesAggregator(
+            EDocumentStrengthType docImpMethod,
+            int topSize,
+            EImportanceValuesSign importanceValuesSign,
+            ui32 trainDocCount,
+            ui32 testDocCount,
+            NPar::ILocalExecutor* localExecutor
+        )
+            : DocImpMethod(docImpMethod)
+            , TopSize(topSize)
+            , ImportanceValuesSign(importanceValuesSign)
+            , TestDocCount(testDocCount)
+            , LocalExecutor(localExecutor)
+        {
+            if (DocImpMethod == EDocumentStrengthType::Average) {
+                AverageImportances.resize(trainDocCount);
+            } else {
+                Y_ASSERT(DocImpMethod == EDocumentStrengthType::PerObject || DocImpMethod == EDocumentStrengthType::Raw);
+                TopDocs.resize(testDocCount);
             }
         }
-        for (ui32 trainDocId = 0; trainDocId < trainDocCount; ++trainDocId) {
-            preprocessedImportances[0][trainDocId] /= testDocCount;
-        }
 
-    } else {
-        Y_ASSERT(docImpMethod == EDocumentStrengthType::PerObject || docImpMethod == EDocumentStrengthType::Raw);
-        preprocessedImportances = TVector<TVector<double>>(testDocCount, TVector<double>(trainDocCount));
-        for (ui32 trainDocId = 0; trainDocId < trainDocCount; ++trainDocId) {
-            for (ui32 testDocId = 0; testDocId < testDocCount; ++testDocId) {
-                preprocessedImportances[testDocId][trainDocId] = rawImportances[trainDocId][testDocId];
+        void AddBlock(ui32 trainDocBegin, TConstArrayRef<TVector<double>> importances /*[blockTrainDocId][testDocId]*/) {
+            const int blockSize = importances.size();
+            if (DocImpMethod == EDocumentStrengthType::Average) {
+                LocalExecutor->ExecRange([&] (int blockDocId) {
+                    double& averageImportance = AverageImportances[trainDocBegin + blockDocId];
+                    for (double importance : importances[blockDocId]) {
+                        averageImportance += importance;
+                    }
+                    averageImportance /= TestDocCount;
+                }, NPar::ILocalExecutor::TExecRangeParams(0, blockSize), NPar::TLocalExecutor::WAIT_COMPLETE);
+                return;
             }
+            NPar::ILocalExecutor::TExecRangeParams testDocParams(0, TestDocCount);
+            testDocParams.SetBlockSize(1000);
+            LocalExecutor->ExecRange([&] (int testDocId) {
+                for (int blockDocId : xrange(blockSize)) {
+                    AddCandidate(importances[blockDocId][testDocId], trainDocBegin + blockDocId, &TopDocs[testDocId]);
+                }
+            }, testDocParams, NPar::TLocalExecutor::WAIT_COMPLETE);
         }
-    }
 
-    TDStrResult result(preprocessedImportances.size());
-    for (ui32 testDocId = 0; testDocId < preprocessedImportances.size(); ++testDocId) {
-        TVector<double>& preprocessedImportancesRef = preprocessedImportances[testDocId];
-
-        const ui32 docCount = preprocessedImportancesRef.size();
-        TVector<ui32> indices(docCount);
-        std::iota(indices.begin(), indices.end(), 0);
-        if (docImpMethod != EDocumentStrengthType::Raw) {
-            Sort(indices.begin(), indices.end(), [&](ui32 first, ui32 second) {
-                return Abs(preprocessedImportancesRef[first]) > Abs(preprocessedImportancesRef[second]);
-            });
+        TDStrResult GetResult() {
+            if (DocImpMethod == EDocumentStrengthType::Average) {
+                TopDocs.assign(1, {});
+                for (ui32 trainDocId : xrange(AverageImportances.size())) {
+                    AddCandidate(AverageImportances[trainDocId], trainDocId, &TopDocs[0]);
+                }
+            }
+            TDStrResult result(TopDocs.size());
+            for (auto docId : xrange(TopDocs.size())) {
+                auto& topDocs = TopDocs[docId];
+                if (DocImpMethod != EDocumentStrengthType::Raw) {
+                    Sort(topDocs, IsMoreImportant);
+                }
+                for (const auto& [importance, trainDocId] : topDocs) {
+                    result.Scores[docId].push_back(importance);
+                    result.Indices[docId].push_back(trainDocId);
+                }
+                TVector<TScoredDoc>().swap(topDocs);
+            }
+            return result;
         }
 
-        std::function<bool(double)> predicate;
-        if (importanceValuesSign == EImportanceValuesSign::Positive) {
-            predicate = [](double v){return v > 0;};
-        } else if (importanceValuesSign == EImportanceValuesSign::Negative) {
-            predicate = [](double v){return v < 0;};
-        } else {
-            Y_ASSERT(importanceValuesSign == EImportanceValuesSign::All);
-            predicate = [](double){return true;};
+    private:
+        static bool IsMoreImportant(const TScoredDoc& lhs, const TScoredDoc& rhs) {
+            return Abs(lhs.first) > Abs(rhs.first) || (Abs(lhs.first) == Abs(rhs.first) && lhs.second < rhs.second);
         }
 
-        int currentSize = 0;
-        for (ui32 i = 0; i < docCount; ++i) {
-            if (currentSize == topSize) {
-                break;
+        // Raw keeps the first TopSize train docs in their order, other methods keep a heap of the most important ones.
+        void AddCandidate(double importance, ui32 trainDocId, TVector<TScoredDoc>* topDocs) const {
+            if (!HasRequiredSign(importance, ImportanceValuesSign) || TopSize == 0) {
+                return;
             }
-            if (predicate(preprocessedImportancesRef[indices[i]])) {
-                result.Scores[testDocId].push_back(preprocessedImportancesRef[indices[i]]);
-                result.Indices[testDocId].push_back(indices[i]);
-                ++currentSize;
+            const bool isRaw = DocImpMethod == EDocumentStrengthType::Raw;
+            if (topDocs->ysize() < TopSize) {
+                topDocs->emplace_back(importance, trainDocId);
+                if (!isRaw) {
+                    PushHeap(topDocs->begin(), topDocs->end(), IsMoreImportant);
+                }
+            } else if (!isRaw && IsMoreImportant({importance, trainDocId}, topDocs->front())) {
+                PopHeap(topDocs->begin(), topDocs->end(), IsMoreImportant);
+                topDocs->back() = {importance, trainDocId};
+                PushHeap(topDocs->begin(), topDocs->end(), IsMoreImportant);
             }
         }
-    }
-    return result;
+
+    private:
+        EDocumentStrengthType DocImpMethod;
+        int TopSize;
+        EImportanceValuesSign ImportanceValuesSign;
+        ui32 TestDocCount;
+        NPar::ILocalExecutor* LocalExecutor;
+        TVector<double> AverageImportances; // [trainDocCount]
+        TVector<TVector<TScoredDoc>> TopDocs; // [testDocCount][<= topSize], heaps for PerObject
+    };
 }
 
 TDStrResult GetDocumentImportances(
@@ -166,7 +217,18 @@ TDStrResult GetDocumentImportances(
     ExecuteTasksInParallel(&tasks, localExecutor.Get());
 
     TDocumentImportancesEvaluator leafInfluenceEvaluator(model, *trainProcessedData, updateMethod, localExecutor, logPeriod);
-    const TVector<TVector<double>> documentImportances
-        = leafInfluenceEvaluator.GetDocumentImportances(*testProcessedData, logPeriod);
-    return GetFinalDocumentImportances(documentImportances, dstrType, topSize, importanceValuesSign);
+    TDocumentImportancesAggregator aggregator(
+        dstrType,
+        topSize,
+        importanceValuesSign,
+        trainProcessedData->GetObjectCount(),
+        testProcessedData->GetObjectCount(),
+        localExecutor.Get());
+    leafInfluenceEvaluator.ProcessDocumentImportances(
+        *testProcessedData,
+        [&] (ui32 trainDocBegin, TConstArrayRef<TVector<double>> importances) {
+            aggregator.AddBlock(trainDocBegin, importances);
+        },
+        logPeriod);
+    return aggregator.GetResult();
 }
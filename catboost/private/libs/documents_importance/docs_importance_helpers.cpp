@@ -10,6 +10,7 @@
 #include <util/generic/algorithm.h>
 #include <util/generic/cast.h>
 #include <util/generic/utility.h>
+#include <util/generic/xrange.h>
 #include <util/generic/ymath.h>
 
 #include <numeric>
@@ -20,6 +21,23 @@ using namespace NCB;
 
 TVector<TVector<double>> TDocumentImportancesEvaluator::GetDocumentImportances(
     const TProcessedDataProvider& processedData, int logPeriod
+) {
+    TVector<TVector<double>> documentImportances(DocCount);
+    ProcessDocumentImportances(
+        processedData,
+        [&] (ui32 trainDocBegin, TConstArrayRef<TVector<double>> importances) {
+            for (auto blockDocId : xrange(importances.size())) {
+                documentImportances[trainDocBegin + blockDocId] = importances[blockDocId];
+            }
+        },
+        logPeriod);
+    return documentImportances;
+}
+
+void TDocumentImportancesEvaluator::ProcessDocumentImportances(
+    const TProcessedDataProvider& processedData,
+    const TImportancesBlockConsumer& consumer,
+    int logPeriod
 ) {
     TVector<TVector<ui32>> leafIndices(TreeCount);
     auto binarizedFeatures = MakeQuantizedFeaturesForEvaluator(Model, *processedData.ObjectsData.Get());
@@ -28,8 +46,12 @@ TVector<TVector<double>> TDocumentImportancesEvaluator::GetDocumentImportances(
     }, NPar::ILocalExecutor::TExecRangeParams(0, TreeCount), NPar::TLocalExecutor::WAIT_COMPLETE);
 
     UpdateFinalFirstDerivatives(leafIndices, *processedData.TargetData->GetOneDimensionalTarget());
-    TVector<TVector<double>> documentImportances(DocCount, TVector<double>(processedData.GetObjectCount()));
-    const size_t docBlockSize = 1000;
+    const size_t docCount = processedData.GetObjectCount();
+    // keep the block of importances within ~256Mb, but give every thread some train docs
+    const size_t docBlockSize = Max<size_t>(
+        Min<size_t>(1000, (size_t(32) << 20) / Max<size_t>(docCount, 1)),
+        LocalExecutor->GetThreadCount() + 1);
+    TVector<TVector<double>> blockImportances;
     TImportanceLogger documentsLogger(DocCount, "documents processed", "Processing documents...", logPeriod);
     TProfileInfo processDocumentsProfile(DocCount);
 
@@ -37,18 +59,21 @@ TVector<TVector<double>> TDocumentImportancesEvaluator::GetDocumentImportances(
         const size_t end = Min<size_t>(start + docBlockSize, DocCount);
         processDocumentsProfile.StartIterationBlock();
 
+        blockImportances.resize(end - start);
         LocalExecutor->ExecRange([&] (int docId) {
             // The derivative of leaf values with respect to train doc weight.
             TVector<TVector<TVector<double>>> leafDerivatives(TreeCount, TVector<TVector<double>>(LeavesEstimationIterations)); // [treeCount][LeavesEstimationIterationsCount][leafCount]
             UpdateLeavesDerivatives(docId, &leafDerivatives);
-            GetDocumentImportancesForOneTrainDoc(leafDerivatives, leafIndices, &documentImportances[docId]);
+            TVector<double>& documentImportance = blockImportances[docId - start];
+            documentImportance.resize(docCount);
+            GetDocumentImportancesForOneTrainDoc(leafDerivatives, leafIndices, &documentImportance);
         }, NPar::ILocalExecutor::TExecRangeParams(start, end), NPar::TLocalExecutor::WAIT_COMPLETE);
+        consumer(start, blockImportances);
 
         processDocumentsProfile.FinishIterationBlock(end - start);
         auto profileResults = processDocumentsProfile.GetProfileResults();
         documentsLogger.Log(profileResults);
-        }
-    return documentImportances;
+    }
 }
 
 void TDocumentImportancesEvaluator::UpdateFinalFirstDerivatives(const TVector<TVector<ui32>>& leafIndices, TConstArrayRef<float> target) {
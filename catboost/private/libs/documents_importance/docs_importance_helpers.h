@@ -17,6 +17,8 @@
 #include <util/system/types.h>
 #include <util/system/yassert.h>
 
+#include <functional>
+
 
 /*
  * This is the implementation of the LeafInfluence algorithm from the following paper:
@@ -71,10 +73,10 @@ public:
         THolder<ITreeStatisticsEvaluator> treeStatisticsEvaluator;
         const ELeavesEstimation leavesEstimationMethod = FromString<ELeavesEstimation>(paramsJson["tree_learner_options"]["leaf_estimation_method"].GetString());
         if (leavesEstimationMethod == ELeavesEstimation::Gradient) {
-            treeStatisticsEvaluator = MakeHolder<TGradientTreeStatisticsEvaluator>(DocCount);
+            treeStatisticsEvaluator = MakeHolder<TGradientTreeStatisticsEvaluator>(DocCount, LocalExecutor.Get());
         } else {
         Y_ASSERT(leavesEstimationMethod == ELeavesEstimation::Newton);
-            treeStatisticsEvaluator = MakeHolder<TNewtonTreeStatisticsEvaluator>(DocCount);
+            treeStatisticsEvaluator = MakeHolder<TNewtonTreeStatisticsEvaluator>(DocCount, LocalExecutor.Get());
         }
         TreesStatistics = treeStatisticsEvaluator->EvaluateTreeStatistics(model, processedData, startingApprox, logPeriod);
     }
@@ -82,6 +84,17 @@ public:
     // Getting the importance of all train objects for all objects from pool.
     TVector<TVector<double>> GetDocumentImportances(const NCB::TProcessedDataProvider& processedData, int logPeriod = 0);
 
+    // (trainDocBegin, importances[blockTrainDocId][docId]) for consecutive blocks of train objects.
+    using TImportancesBlockConsumer = std::function<void(ui32, TConstArrayRef<TVector<double>>)>;
+
+    // The same as GetDocumentImportances, but the importances are passed to consumer block by block,
+    // so they could be aggregated without materializing the whole [trainDocCount][docCount] matrix.
+    void ProcessDocumentImportances(
+        const NCB::TProcessedDataProvider& processedData,
+        const TImportancesBlockConsumer& consumer,
+        int logPeriod = 0
+    );
+
 private:
     // Evaluate first derivatives at the final approxes
     void UpdateFinalFirstDerivatives(const TVector<TVector<ui32>>& leafIndices, TConstArrayRef<float> target);
@@ -34,6 +34,12 @@ TVector<TTreeStatistics> ITreeStatisticsEvaluator::EvaluateTreeStatistics(
     treeStatistics.reserve(treeCount);
     TVector<double> approxes(DocCount, startingApprox ? *startingApprox : 0);
 
+    // trees depend on each other only through approxes, so leaf indices are calculated for all of them at once
+    TVector<TVector<ui32>> leafIndices(treeCount);
+    LocalExecutor->ExecRange([&] (int treeId) {
+        leafIndices[treeId] = BuildIndicesForBinTree(model, binarizedFeatures.Get(), treeId);
+    }, NPar::ILocalExecutor::TExecRangeParams(0, treeCount), NPar::TLocalExecutor::WAIT_COMPLETE);
+
     TImportanceLogger treesLogger(treeCount, "Trees processed", "Processing trees...", logPeriod);
     TProfileInfo processTreesProfile(treeCount);
 
@@ -41,11 +47,12 @@ TVector<TTreeStatistics> ITreeStatisticsEvaluator::EvaluateTreeStatistics(
         processTreesProfile.StartIterationBlock();
 
         LeafCount = 1 << model.ModelTrees->GetModelTreeData()->GetTreeSizes()[treeId];
-        LeafIndices = BuildIndicesForBinTree(model, binarizedFeatures.Get(), treeId);
+        // the precomputed indices of the tree are released here, they live on in the tree statistics
+        LeafIndices = std::move(leafIndices[treeId]);
 
-        TVector<TVector<ui32>> leavesDocId(LeafCount);
+        LeavesDocId.assign(LeafCount, {});
         for (ui32 docId = 0; docId < DocCount; ++docId) {
-            leavesDocId[LeafIndices[docId]].push_back(docId);
+            LeavesDocId[LeafIndices[docId]].push_back(docId);
         }
 
 
@@ -78,9 +85,9 @@ TVector<TTreeStatistics> ITreeStatisticsEvaluator::EvaluateTreeStatistics(
             formulaNumeratorMultiplier[it] = ComputeFormulaNumeratorMultiplier(weights);
             formulaDenominators[it].swap(leafDenominators);
 
-            for (ui32 docId = 0; docId < DocCount; ++docId) {
+            ParallelForDocs([&] (int docId) {
                 localApproxes[docId] += LeafValues[LeafIndices[docId]];
-            }
+            });
             leafValues[it].swap(LeafValues);
         }
 
@@ -88,19 +95,19 @@ TVector<TTreeStatistics> ITreeStatisticsEvaluator::EvaluateTreeStatistics(
             for (auto& leafValue : leafValuesOneIteration) {
                 leafValue *= learningRate;
             }
-            for (ui32 docId = 0; docId < DocCount; ++docId) {
+            ParallelForDocs([&] (int docId) {
                 approxes[docId] += leafValuesOneIteration[LeafIndices[docId]];
-            }
+            });
         }
 
         treeStatistics.push_back({
             LeafCount,
-            LeafIndices,
-            leavesDocId,
-            leafValues,
-            formulaDenominators,
-            formulaNumeratorAdding,
-            formulaNumeratorMultiplier
+            std::move(LeafIndices),
+            std::move(LeavesDocId),
+            std::move(leafValues),
+            std::move(formulaDenominators),
+            std::move(formulaNumeratorAdding),
+            std::move(formulaNumeratorMultiplier)
         });
 
         processTreesProfile.FinishIteration();
@@ -114,29 +121,31 @@ TVector<TTreeStatistics> ITreeStatisticsEvaluator::EvaluateTreeStatistics(
 
 TVector<double> TGradientTreeStatisticsEvaluator::ComputeLeafNumerators(TConstArrayRef<float> weights) {
     TVector<double> leafNumerators(LeafCount);
-    if (weights.empty()) {
-        for (ui32 docId = 0; docId < DocCount; ++docId) {
-            leafNumerators[LeafIndices[docId]] += FirstDerivatives[docId];
-        }
-    } else {
-        for (ui32 docId = 0; docId < DocCount; ++docId) {
-            leafNumerators[LeafIndices[docId]] += weights[docId] * FirstDerivatives[docId];
+    ParallelForLeaves([&] (int leafId) {
+        if (weights.empty()) {
+            for (ui32 docId : LeavesDocId[leafId]) {
+                leafNumerators[leafId] += FirstDerivatives[docId];
+            }
+        } else {
+            for (ui32 docId : LeavesDocId[leafId]) {
+                leafNumerators[leafId] += weights[docId] * FirstDerivatives[docId];
+            }
         }
-    }
+    });
     return leafNumerators;
 }
 
 TVector<double> TGradientTreeStatisticsEvaluator::ComputeLeafDenominators(TConstArrayRef<float> weights, float l2LeafReg) {
     TVector<double> leafDenominators(LeafCount);
-    if (weights.empty()) {
-        for (ui32 docId = 0; docId < DocCount; ++docId) {
-            leafDenominators[LeafIndices[docId]] += 1;
-        }
-    } else {
-        for (ui32 docId = 0; docId < DocCount; ++docId) {
-            leafDenominators[LeafIndices[docId]] += weights[docId];
+    ParallelForLeaves([&] (int leafId) {
+        if (weights.empty()) {
+            leafDenominators[leafId] = LeavesDocId[leafId].size();
+        } else {
+            for (ui32 docId : LeavesDocId[leafId]) {
+                leafDenominators[leafId] += weights[docId];
+            }
         }
-    }
+    });
     for (ui32 leafId = 0; leafId < LeafCount; ++leafId) {
         leafDenominators[leafId] += l2LeafReg;
     }
@@ -144,10 +153,11 @@ TVector<double> TGradientTreeStatisticsEvaluator::ComputeLeafDenominators(TConst
 }
 
 TVector<double> TGradientTreeStatisticsEvaluator::ComputeFormulaNumeratorAdding() {
-    TVector<double> formulaNumeratorAdding(DocCount);
-    for (ui32 docId = 0; docId < DocCount; ++docId) {
+    TVector<double> formulaNumeratorAdding;
+    formulaNumeratorAdding.yresize(DocCount);
+    ParallelForDocs([&] (int docId) {
         formulaNumeratorAdding[docId] = LeafValues[LeafIndices[docId]] + FirstDerivatives[docId];
-    }
+    });
     return formulaNumeratorAdding;
 }
 
@@ -167,29 +177,33 @@ TVector<double> TGradientTreeStatisticsEvaluator::ComputeFormulaNumeratorMultipl
 
 TVector<double> TNewtonTreeStatisticsEvaluator::ComputeLeafNumerators(TConstArrayRef<float> weights) {
     TVector<double> leafNumerators(LeafCount);
-    if (weights.empty()) {
-        for (ui32 docId = 0; docId < DocCount; ++docId) {
-            leafNumerators[LeafIndices[docId]] += FirstDerivatives[docId];
-        }
-    } else {
-        for (ui32 docId = 0; docId < DocCount; ++docId) {
-            leafNumerators[LeafIndices[docId]] += weights[docId] * FirstDerivatives[docId];
+    ParallelForLeaves([&] (int leafId) {
+        if (weights.empty()) {
+            for (ui32 docId : LeavesDocId[leafId]) {
+                leafNumerators[leafId] += FirstDerivatives[docId];
+            }
+        } else {
+            for (ui32 docId : LeavesDocId[leafId]) {
+                leafNumerators[leafId] += weights[docId] * FirstDerivatives[docId];
+            }
         }
-    }
+    });
     return leafNumerators;
 }
 
 TVector<double> TNewtonTreeStatisticsEvaluator::ComputeLeafDenominators(TConstArrayRef<float> weights, float l2LeafReg) {
     TVector<double> leafDenominators(LeafCount);
-    if (weights.empty()) {
-        for (ui32 docId = 0; docId < DocCount; ++docId) {
-            leafDenominators[LeafIndices[docId]] += SecondDerivatives[docId];
-        }
-    } else {
-        for (ui32 docId = 0; docId < DocCount; ++docId) {
-            leafDenominators[LeafIndices[docId]] += weights[docId] * SecondDerivatives[docId];
+    ParallelForLeaves([&] (int leafId) {
+        if (weights.empty()) {
+            for (ui32 docId : LeavesDocId[leafId]) {
+                leafDenominators[leafId] += SecondDerivatives[docId];
+            }
+        } else {
+            for (ui32 docId : LeavesDocId[leafId]) {
+                leafDenominators[leafId] += weights[docId] * SecondDerivatives[docId];
+            }
         }
-    }
+    });
     for (ui32 leafId = 0; leafId < LeafCount; ++leafId) {
         leafDenominators[leafId] += l2LeafReg;
     }
@@ -197,23 +211,24 @@ TVector<double> TNewtonTreeStatisticsEvaluator::ComputeLeafDenominators(TConstAr
 }
 
 TVector<double> TNewtonTreeStatisticsEvaluator::ComputeFormulaNumeratorAdding() {
-    TVector<double> formulaNumeratorAdding(DocCount);
-    for (ui32 docId = 0; docId < DocCount; ++docId) {
+    TVector<double> formulaNumeratorAdding;
+    formulaNumeratorAdding.yresize(DocCount);
+    ParallelForDocs([&] (int docId) {
         formulaNumeratorAdding[docId] = LeafValues[LeafIndices[docId]] * SecondDerivatives[docId] + FirstDerivatives[docId];
-    }
+    });
     return formulaNumeratorAdding;
 }
 
 TVector<double> TNewtonTreeStatisticsEvaluator::ComputeFormulaNumeratorMultiplier(TConstArrayRef<float> weights) {
     TVector<double> formulaNumeratorMultiplier(DocCount);
     if (weights.empty()) {
-        for (ui32 docId = 0; docId < DocCount; ++docId) {
+        ParallelForDocs([&] (int docId) {
             formulaNumeratorMultiplier[docId] = LeafValues[LeafIndices[docId]] * ThirdDerivatives[docId] + SecondDerivatives[docId];
-        }
+        });
     } else {
-        for (ui32 docId = 0; docId < DocCount; ++docId) {
+        ParallelForDocs([&] (int docId) {
             formulaNumeratorMultiplier[docId] = weights[docId] * (LeafValues[LeafIndices[docId]] * ThirdDerivatives[docId] + SecondDerivatives[docId]);
-        }
+        });
     }
     return formulaNumeratorMultiplier;
 }
@@ -3,6 +3,8 @@
 #include <catboost/libs/data/data_provider.h>
 #include <catboost/libs/model/model.h>
 
+#include <library/cpp/threading/local_executor/local_executor.h>
+
 #include <util/generic/fwd.h>
 #include <util/generic/vector.h>
 #include <util/system/types.h>
@@ -23,8 +25,9 @@ struct TTreeStatistics {
 // A class that stores all the necessary statistics per each tree.
 class ITreeStatisticsEvaluator {
 public:
-    ITreeStatisticsEvaluator(ui32 docCount)
+    ITreeStatisticsEvaluator(ui32 docCount, NPar::ILocalExecutor* localExecutor)
         : DocCount(docCount)
+        , LocalExecutor(localExecutor)
         , FirstDerivatives(docCount)
         , SecondDerivatives(docCount)
         , ThirdDerivatives(docCount)
@@ -49,21 +52,39 @@ private:
     // Compute formula (6) numerator multiplier.
     virtual TVector<double> ComputeFormulaNumeratorMultiplier(TConstArrayRef<float> weights) = 0;
 
+protected:
+    // Runs func(docId) for all train docs in parallel blocks.
+    template <class TFunc>
+    void ParallelForDocs(const TFunc& func) {
+        NPar::ILocalExecutor::TExecRangeParams blockParams(0, DocCount);
+        blockParams.SetBlockSize(10000);
+        LocalExecutor->ExecRange(func, blockParams, NPar::TLocalExecutor::WAIT_COMPLETE);
+    }
+
+    // Runs func(leafId) for all leaves of the current tree in parallel, every leaf is processed by one thread,
+    // so per leaf sums could be accumulated over LeavesDocId in the same order as in a serial loop over docs.
+    template <class TFunc>
+    void ParallelForLeaves(const TFunc& func) {
+        LocalExecutor->ExecRange(func, NPar::ILocalExecutor::TExecRangeParams(0, LeafCount), NPar::TLocalExecutor::WAIT_COMPLETE);
+    }
+
 protected:
     ui32 DocCount;
+    NPar::ILocalExecutor* LocalExecutor;
     TVector<double> FirstDerivatives; // [docCount]
     TVector<double> SecondDerivatives; // [docCount]
     TVector<double> ThirdDerivatives; // [docCount]
 
     ui32 LeafCount;
     TVector<ui32> LeafIndices; // [docCount]
+    TVector<TVector<ui32>> LeavesDocId; // [leafCount]
     TVector<double> LeafValues; // [leafCount]
 };
 
 class TGradientTreeStatisticsEvaluator : public ITreeStatisticsEvaluator {
 public:
-    TGradientTreeStatisticsEvaluator(ui32 docCount)
-        : ITreeStatisticsEvaluator(docCount)
+    TGradientTreeStatisticsEvaluator(ui32 docCount, NPar::ILocalExecutor* localExecutor)
+        : ITreeStatisticsEvaluator(docCount, localExecutor)
     {
     }
     TVector<double> ComputeLeafNumerators(TConstArrayRef<float> weights) override;
@@ -74,8 +95,8 @@ public:
 
 class TNewtonTreeStatisticsEvaluator : public ITreeStatisticsEvaluator {
 public:
-    TNewtonTreeStatisticsEvaluator(ui32 docCount)
-        : ITreeStatisticsEvaluator(docCount)
+    TNewtonTreeStatisticsEvaluator(ui32 docCount, NPar::ILocalExecutor* localExecutor)
+        : ITreeStatisticsEvaluator(docCount, localExecutor)
     {
     }
     TVector<double> ComputeLeafNumerators(TConstArrayRef<float> weights) override;
@@ -0,0 +1,118 @@
+#include <catboost/private/libs/documents_importance/docs_importance.h>
+
+#include <catboost/libs/data/data_provider_builders.h>
+#include <catboost/libs/train_lib/train_model.h>
+
+#include <library/cpp/json/json_value.h>
+#include <library/cpp/testing/unittest/registar.h>
+
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+using namespace NCB;
+
+
+static TDataProviderPtr CreateRandomDataProvider(ui32 docCount, ui32 seed) {
+    TFastRng64 rng(seed);
+    const ui32 factorCount = 4;
+    return CreateDataProvider(
+        [&] (IRawFeaturesOrderDataVisitor* visitor) {
+            TDataMetaInfo metaInfo;
+            metaInfo.TargetType = ERawTargetType::Float;
+            metaInfo.TargetCount = 1;
+            metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                factorCount,
+                TVector<ui32>{},
+                TVector<ui32>{},
+                TVector<ui32>{},
+                TVector<TString>{});
+
+            visitor->Start(metaInfo, docCount, EObjectsOrder::Undefined, {});
+
+            TVector<float> target(docCount, 0.0f);
+            for (auto factorId : xrange(factorCount)) {
+                TVector<float> values(docCount);
+                for (auto docId : xrange(docCount)) {
+                    values[docId] = rng.GenRandReal1();
+                    target[docId] += (factorId + 1) * values[docId];
+                }
+                visitor->AddFloatFeature(
+                    factorId,
+                    MakeIntrusive<TTypeCastArrayHolder<float, float>>(std::move(values)));
+            }
+            for (auto& value : target) {
+                value += 0.1 * rng.GenRandReal1();
+            }
+            visitor->AddTarget(MakeIntrusive<TTypeCastArrayHolder<float, float>>(std::move(target)));
+
+            visitor->Finish();
+        }
+    );
+}
+
+static TFullModel TrainRegressionModel(TDataProviderPtr trainData, const TString& leafEstimationMethod) {
+    TDataProviders dataProviders;
+    dataProviders.Learn = trainData;
+
+    NJson::TJsonValue params;
+    params.InsertValue("iterations", 20);
+    params.InsertValue("depth", 4);
+    params.InsertValue("random_seed", 0);
+    params.InsertValue("leaf_estimation_method", leafEstimationMethod);
+    TFullModel model;
+    TEvalResult evalResult;
+    TrainModel(
+        params,
+        nullptr,
+        Nothing(),
+        Nothing(),
+        std::move(dataProviders),
+        /*initModel*/ Nothing(),
+        /*initLearnProgress*/ nullptr,
+        "",
+        &model,
+        {&evalResult});
+    return model;
+}
+
+// parallel tree statistics and streaming aggregation should give the same result as the sequential computation
+static void CheckParallelIsSequential(const TString& leafEstimationMethod, const TString& dstrType, int topSize) {
+    const auto trainData = CreateRandomDataProvider(/*docCount*/ 3000, /*seed*/ 0);
+    const auto testData = CreateRandomDataProvider(/*docCount*/ 200, /*seed*/ 1);
+    const TFullModel model = TrainRegressionModel(trainData, leafEstimationMethod);
+
+    const auto calcImportances = [&] (int threadCount) {
+        return GetDocumentImportances(
+            model,
+            *trainData,
+            *testData,
+            dstrType,
+            topSize,
+            "SinglePoint",
+            "All",
+            threadCount);
+    };
+    const TDStrResult sequential = calcImportances(/*threadCount*/ 1);
+    const TDStrResult parallel = calcImportances(/*threadCount*/ 4);
+    UNIT_ASSERT(!sequential.Indices.empty());
+    UNIT_ASSERT_VALUES_EQUAL(sequential.Indices, parallel.Indices);
+    UNIT_ASSERT_VALUES_EQUAL(sequential.Scores, parallel.Scores);
+}
+
+Y_UNIT_TEST_SUITE(TDocumentImportances) {
+    Y_UNIT_TEST(TestPerObjectGradient) {
+        CheckParallelIsSequential("Gradient", "PerObject", /*topSize*/ 10);
+    }
+
+    Y_UNIT_TEST(TestPerObjectNewton) {
+        CheckParallelIsSequential("Newton", "PerObject", /*topSize*/ -1);
+    }
+
+    Y_UNIT_TEST(TestAverage) {
+        CheckParallelIsSequential("Newton", "Average", /*topSize*/ 100);
+    }
+
+    Y_UNIT_TEST(TestRaw) {
+        CheckParallelIsSequential("Gradient", "Raw", /*topSize*/ 50);
+    }
+}
@@ -1,6 +1,19 @@
 #include "embedding_feature_calcer.h"
 
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+
 namespace NCB {
+    TVector<float> GatherEmbeddings(TConstArrayRef<TEmbeddingsArray> vectors, ui32 dimension) {
+        TVector<float> result;
+        result.yresize(vectors.size() * dimension);
+        for (auto idx : xrange(vectors.size())) {
+            Y_ASSERT(vectors[idx].GetSize() == dimension);
+            Copy(vectors[idx].begin(), vectors[idx].end(), result.begin() + idx * dimension);
+        }
+        return result;
+    }
+
     void TEmbeddingFeatureCalcer::TrimFeatures(TConstArrayRef<ui32> featureIndices) {
         const ui32 featureCount = FeatureCount();
         CB_ENSURE(
@@ -10,6 +23,16 @@ namespace NCB {
         ActiveFeatureIndices = TVector<ui32>(featureIndices.begin(), featureIndices.end());
     }
 
+    void TEmbeddingFeatureCalcer::ComputeBatch(
+        TConstArrayRef<TEmbeddingsArray> vectors,
+        TConstArrayRef<TOutputFloatIterator> outputFeaturesIterators) const {
+
+        Y_ASSERT(vectors.size() == outputFeaturesIterators.size());
+        for (auto idx : xrange(vectors.size())) {
+            Compute(vectors[idx], outputFeaturesIterators[idx]);
+        }
+    }
+
     TConstArrayRef<ui32> TEmbeddingFeatureCalcer::GetActiveFeatureIndices() const {
         return MakeConstArrayRef(ActiveFeatureIndices);
     }
@@ -86,6 +109,19 @@ namespace NCB {
         );
     }
 
+    void IEmbeddingCalcerVisitor::ComputeAndUpdate(
+        TConstArrayRef<ui32> classIds,
+        TConstArrayRef<TEmbeddingsArray> vectors,
+        TConstArrayRef<TOutputFloatIterator> outputFeaturesIterators,
+        TEmbeddingFeatureCalcer* featureCalcer) {
+
+        Y_ASSERT(vectors.size() == classIds.size() && vectors.size() == outputFeaturesIterators.size());
+        for (auto idx : xrange(vectors.size())) {
+            featureCalcer->Compute(vectors[idx], outputFeaturesIterators[idx]);
+            Update(classIds[idx], vectors[idx], featureCalcer);
+        }
+    }
+
     void TEmbeddingCalcerSerializer::Save(IOutputStream* stream, const TEmbeddingFeatureCalcer& calcer) {
         WriteMagic(CalcerMagic.data(), MagicSize, Alignment, stream);
 
@@ -8,6 +8,9 @@
 
 namespace NCB {
 
+    // row-major [vectorIdx * dimension + coordinate] copy of the block, for matrix products over the whole block
+    TVector<float> GatherEmbeddings(TConstArrayRef<TEmbeddingsArray> vectors, ui32 dimension);
+
     class TEmbeddingFeatureCalcer : public IFeatureCalcer {
     public:
         TEmbeddingFeatureCalcer(ui32 baseFeatureCount, const TGuid& calcerId)
@@ -19,6 +22,14 @@ namespace NCB {
 
         virtual void Compute(const TEmbeddingsArray& vector, TOutputFloatIterator outputFeaturesIterator) const = 0;
 
+        /* Computes features of a block of vectors, features of vectors[i] are written to outputFeaturesIterators[i].
+         * Calcers that can process many vectors at once (e.g. with matrix products) override it,
+         * default implementation calls Compute for every vector.
+         */
+        virtual void ComputeBatch(
+            TConstArrayRef<TEmbeddingsArray> vectors,
+            TConstArrayRef<TOutputFloatIterator> outputFeaturesIterators) const;
+
         void Save(IOutputStream* stream) const final;
         void Load(IInputStream* stream) final;
 
@@ -87,6 +98,16 @@ namespace NCB {
     class IEmbeddingCalcerVisitor : public TThrRefBase {
     public:
         virtual void Update(ui32 classId, const TEmbeddingsArray& vector, TEmbeddingFeatureCalcer* featureCalcer) = 0;
+
+        /* Online pass over a block of vectors: features of vectors[i] are computed by the calcer updated with
+         * all the previous vectors of the block, then the calcer is updated with vectors[i].
+         * Default implementation is the sequential loop of Compute and Update.
+         */
+        virtual void ComputeAndUpdate(
+            TConstArrayRef<ui32> classIds,
+            TConstArrayRef<TEmbeddingsArray> vectors,
+            TConstArrayRef<TOutputFloatIterator> outputFeaturesIterators,
+            TEmbeddingFeatureCalcer* featureCalcer);
     };
 
     using TEmbeddingFeatureCalcerPtr = TIntrusivePtr<TEmbeddingFeatureCalcer>;
@@ -185,12 +185,12 @@ namespace NCB {
                 result.data() + calcerOffset,
                 result.data() + calcerOffset + calculatedFeaturesSize
             );
+            TVector<TOutputFloatIterator> outputFeaturesIterators;
+            outputFeaturesIterators.reserve(docCount);
             for (ui32 docId: xrange(docCount)) {
-                calcer->Compute(
-                    embeddingFeature[docId],
-                    TOutputFloatIterator(result.data() + docId, docCount, result.size())
-                );
+                outputFeaturesIterators.emplace_back(currentResult.data() + docId, docCount, currentResult.size());
             }
+            calcer->ComputeBatch(embeddingFeature, outputFeaturesIterators);
         }
     }
 
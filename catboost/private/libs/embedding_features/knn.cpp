@@ -2,10 +2,21 @@
 
 #include <catboost/private/libs/embedding_features/flatbuffers/embedding_feature_calcers.fbs.h>
 
+#include <catboost/libs/helpers/exception.h>
+
+#include <contrib/libs/clapack/clapack.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
 #include <util/stream/length.h>
 
+#include <algorithm>
+
 namespace NCB {
 
+    // points block is small enough for the products with a block of queries to stay in cache
+    static constexpr ui32 BruteForcePointBlockSize = 256;
+
     TVector<ui32> TKNNUpdatableCloud::GetNearestNeighbors(const float* embed, ui32 knum) const  {
         TVector<ui32> result;
         auto neighbors = Cloud.GetNearestNeighbors(embed, knum);
@@ -26,12 +37,99 @@ namespace NCB {
         return result;
     }
 
-    void TKNNCalcer::Compute(const TEmbeddingsArray& embed,
-                             TOutputFloatIterator iterator) const {
+    TKNNBruteForceCloud::TKNNBruteForceCloud(ui32 dimension, TVector<float>&& points)
+        : Dimension(dimension)
+        , Points(std::move(points))
+    {
+        CB_ENSURE(Dimension > 0, "Embedding dimension should be positive");
+        CB_ENSURE(Points.size() % Dimension == 0, "Points data size is not a multiple of embedding dimension");
+        SquaredNorms.reserve(Points.size() / Dimension);
+        for (size_t offset = 0; offset < Points.size(); offset += Dimension) {
+            const float* point = Points.data() + offset;
+            SquaredNorms.push_back(cblas_sdot(Dimension, point, 1, point, 1));
+        }
+    }
+
+    void TKNNBruteForceCloud::AddItem(const float* embed) {
+        Points.insert(Points.end(), embed, embed + Dimension);
+        SquaredNorms.push_back(cblas_sdot(Dimension, embed, 1, embed, 1));
+    }
+
+    TVector<ui32> TKNNBruteForceCloud::GetNearestNeighbors(const float* embed, ui32 knum) const {
+        return std::move(GetNearestNeighborsBatch(MakeArrayRef(embed, Dimension), knum)[0]);
+    }
+
+    TVector<TVector<ui32>> TKNNBruteForceCloud::GetNearestNeighborsBatch(
+        TConstArrayRef<float> queries,
+        ui32 knum,
+        TConstArrayRef<ui32> visiblePointCounts) const {
+
+        Y_ASSERT(queries.size() % Dimension == 0);
+        const ui32 queryCount = queries.size() / Dimension;
+        Y_ASSERT(visiblePointCounts.empty() || visiblePointCounts.size() == queryCount);
+
+        TVector<ui32> visibleCounts(queryCount, GetSize());
+        TVector<float> queryNorms(queryCount);
+        for (auto queryIdx : xrange(queryCount)) {
+            if (!visiblePointCounts.empty()) {
+                visibleCounts[queryIdx] = Min(visiblePointCounts[queryIdx], GetSize());
+            }
+            const float* query = queries.data() + queryIdx * Dimension;
+            queryNorms[queryIdx] = cblas_sdot(Dimension, query, 1, query, 1);
+        }
+        const ui32 maxVisibleCount = queryCount ? *MaxElement(visibleCounts.begin(), visibleCounts.end()) : 0;
+
+        // max-heaps of (distance, id) of the nearest points found so far
+        using TNeighbor = std::pair<float, ui32>;
+        TVector<TVector<TNeighbor>> nearest(queryCount);
+        TVector<float> products;
+        for (ui32 blockStart = 0; knum > 0 && blockStart < maxVisibleCount; blockStart += BruteForcePointBlockSize) {
+            const ui32 blockSize = Min(BruteForcePointBlockSize, maxVisibleCount - blockStart);
+            products.yresize(queryCount * blockSize);
+            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans,
+                        queryCount, blockSize, Dimension,
+                        1.0f, queries.data(), Dimension,
+                        Points.data() + blockStart * Dimension, Dimension,
+                        0.0f, products.data(), blockSize);
+
+            for (auto queryIdx : xrange(queryCount)) {
+                auto& heap = nearest[queryIdx];
+                const float* queryProducts = products.data() + queryIdx * blockSize;
+                const ui32 blockEnd = Min(blockStart + blockSize, visibleCounts[queryIdx]);
+                for (ui32 pointIdx = blockStart; pointIdx < blockEnd; ++pointIdx) {
+                    const TNeighbor candidate{
+                        queryNorms[queryIdx] + SquaredNorms[pointIdx] - 2 * queryProducts[pointIdx - blockStart],
+                        pointIdx
+                    };
+                    if (heap.size() < knum) {
+                        heap.push_back(candidate);
+                        std::push_heap(heap.begin(), heap.end());
+                    } else if (candidate < heap.front()) {
+                        std::pop_heap(heap.begin(), heap.end());
+                        heap.back() = candidate;
+                        std::push_heap(heap.begin(), heap.end());
+                    }
+                }
+            }
+        }
+
+        TVector<TVector<ui32>> result(queryCount);
+        for (auto queryIdx : xrange(queryCount)) {
+            auto& heap = nearest[queryIdx];
+            std::sort_heap(heap.begin(), heap.end());
+            result[queryIdx].reserve(heap.size());
+            for (const auto& [distance, pointIdx] : heap) {
+                Y_UNUSED(distance);
+                result[queryIdx].push_back(pointIdx);
+            }
+        }
+        return result;
+    }
+
+    void TKNNCalcer::WriteFeatures(TConstArrayRef<ui32> neighbors, TOutputFloatIterator iterator) const {
         TVector<float> result(NumClasses, 0);
-        auto neighbors = Cloud->GetNearestNeighbors(embed.data(), CloseNum);
-        for (size_t pos = 0; pos < neighbors.size(); ++pos) {
-            ++result[Targets.at(neighbors[pos])];
+        for (auto neighbor : neighbors) {
+            ++result[Targets.at(neighbor)];
         }
         ForEachActiveFeature(
             [&result, &iterator](ui32 featureId){
@@ -41,18 +139,78 @@ namespace NCB {
         );
     }
 
+    void TKNNCalcer::Compute(const TEmbeddingsArray& embed,
+                             TOutputFloatIterator iterator) const {
+        WriteFeatures(Cloud->GetNearestNeighbors(embed.data(), CloseNum), iterator);
+    }
+
+    void TKNNCalcer::ComputeBatch(
+        TConstArrayRef<TEmbeddingsArray> embeds,
+        TConstArrayRef<TOutputFloatIterator> outputFeaturesIterators) const {
+
+        if (!BruteForce) {
+            TEmbeddingFeatureCalcer::ComputeBatch(embeds, outputFeaturesIterators);
+            return;
+        }
+        const auto* cloud = static_cast<const TKNNBruteForceCloud*>(Cloud.Get());
+        const auto neighbors = cloud->GetNearestNeighborsBatch(GatherEmbeddings(embeds, TotalDimension), CloseNum);
+        for (auto idx : xrange(embeds.size())) {
+            WriteFeatures(neighbors[idx], outputFeaturesIterators[idx]);
+        }
+    }
+
     void TKNNCalcerVisitor::Update(ui32 classId,
                 const TEmbeddingsArray& embed,
                 TEmbeddingFeatureCalcer* featureCalcer) {
         auto knn = dynamic_cast<TKNNCalcer*>(featureCalcer);
         Y_ASSERT(knn);
-        auto cloudPtr = dynamic_cast<TKNNUpdatableCloud*>(knn->Cloud.Get());
-        Y_ASSERT(cloudPtr);
-        cloudPtr->AddItem(embed.data());
+        if (knn->BruteForce) {
+            auto cloudPtr = dynamic_cast<TKNNBruteForceCloud*>(knn->Cloud.Get());
+            Y_ASSERT(cloudPtr);
+            cloudPtr->AddItem(embed.data());
+        } else {
+            auto cloudPtr = dynamic_cast<TKNNUpdatableCloud*>(knn->Cloud.Get());
+            Y_ASSERT(cloudPtr);
+            cloudPtr->AddItem(embed.data());
+        }
         knn->Targets.push_back(classId);
         ++knn->Size;
     }
 
+    void TKNNCalcerVisitor::ComputeAndUpdate(
+        TConstArrayRef<ui32> classIds,
+        TConstArrayRef<TEmbeddingsArray> embeds,
+        TConstArrayRef<TOutputFloatIterator> outputFeaturesIterators,
+        TEmbeddingFeatureCalcer* featureCalcer) {
+
+        auto knn = dynamic_cast<TKNNCalcer*>(featureCalcer);
+        Y_ASSERT(knn);
+        if (!knn->BruteForce) {
+            IEmbeddingCalcerVisitor::ComputeAndUpdate(classIds, embeds, outputFeaturesIterators, featureCalcer);
+            return;
+        }
+        auto cloudPtr = dynamic_cast<TKNNBruteForceCloud*>(knn->Cloud.Get());
+        Y_ASSERT(cloudPtr);
+
+        // the whole block is added at once, i-th vector sees only the points added before it
+        const ui32 initialSize = cloudPtr->GetSize();
+        TVector<ui32> visiblePointCounts(embeds.size());
+        for (auto idx : xrange(embeds.size())) {
+            visiblePointCounts[idx] = initialSize + idx;
+            cloudPtr->AddItem(embeds[idx].data());
+            knn->Targets.push_back(classIds[idx]);
+        }
+        knn->Size += embeds.size();
+
+        const auto neighbors = cloudPtr->GetNearestNeighborsBatch(
+            GatherEmbeddings(embeds, knn->TotalDimension),
+            knn->CloseNum,
+            visiblePointCounts);
+        for (auto idx : xrange(embeds.size())) {
+            knn->WriteFeatures(neighbors[idx], outputFeaturesIterators[idx]);
+        }
+    }
+
     TEmbeddingFeatureCalcer::TEmbeddingCalcerFbs TKNNCalcer::SaveParametersToFB(flatbuffers::FlatBufferBuilder& builder) const {
         using namespace NCatBoostFbs::NEmbeddings;
 
@@ -61,7 +219,8 @@ namespace NCB {
             TotalDimension,
             NumClasses,
             CloseNum,
-            Size
+            Size,
+            BruteForce
         );
         return TEmbeddingCalcerFbs(TAnyEmbeddingCalcer_TKNN, fbLDA.Union());
     }
@@ -72,10 +231,15 @@ namespace NCB {
         NumClasses = fbKNN->NumClasses();
         CloseNum = fbKNN->KNum();
         Size = fbKNN->Size();
+        BruteForce = fbKNN->BruteForce();
     }
 
     void TKNNCalcer::SaveLargeParameters(IOutputStream* stream) const {
         ::Save(stream, Targets);
+        if (BruteForce) {
+            ::Save(stream, dynamic_cast<TKNNBruteForceCloud*>(Cloud.Get())->GetVector());
+            return;
+        }
         auto cl = dynamic_cast<TKNNUpdatableCloud*>(Cloud.Get());
         NOnlineHnsw::TOnlineHnswIndexData indexData = cl->GetCloud().ConstructIndexData();
         ::SaveSize(stream, NOnlineHnsw::ExpectedSize(indexData));
@@ -86,13 +250,19 @@ namespace NCB {
 
     void TKNNCalcer::LoadLargeParameters(IInputStream* stream) {
         ::Load(stream, Targets);
+        if (BruteForce) {
+            TVector<float> points;
+            ::Load(stream, points);
+            Cloud = MakeHolder<TKNNBruteForceCloud>(TotalDimension, std::move(points));
+            return;
+        }
         size_t indexSize = ::LoadSize(stream);
         TArrayHolder<ui8> indexArray = TArrayHolder<ui8>(new ui8[indexSize]);
         stream->Load(indexArray.Get(), indexSize);
         TVector<float> points(TotalDimension * Size);
         ::Load(stream, points);
-        auto cloudPtr = MakeHolder<TKNNCloud>(std::move(indexArray), indexSize,
-                                              std::move(points), TotalDimension, Size);
+        Cloud = MakeHolder<TKNNCloud>(std::move(indexArray), indexSize,
+                                      std::move(points), Size, TotalDimension);
     }
 
     TEmbeddingFeatureCalcerFactory::TRegistrator<TKNNCalcer> KNNRegistrator(EFeatureCalcerType::KNN);
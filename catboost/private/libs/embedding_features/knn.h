@@ -45,6 +45,41 @@ namespace NCB {
         TOnlineHnswCloud Cloud;
     };
 
+    /* Exact search over all points, distances of a block of queries to a block of points are computed
+     * by a single matrix product: |q - p|^2 = |q|^2 + |p|^2 - 2 q.p
+     * It is faster than HNSW for the clouds that fit into a few blocks of cache.
+     */
+    class TKNNBruteForceCloud : public IKNNCloud {
+    public:
+        explicit TKNNBruteForceCloud(ui32 dimension, TVector<float>&& points = {});
+
+        TVector<ui32> GetNearestNeighbors(const float* embed, ui32 knum) const override;
+
+        /* queries are [queryIdx * dimension + coordinate], result is [queryIdx][neighbor] sorted by distance
+         * (ties are broken by point id).
+         * If visiblePointCounts is not empty, i-th query is searched among the first visiblePointCounts[i] points.
+         */
+        TVector<TVector<ui32>> GetNearestNeighborsBatch(
+            TConstArrayRef<float> queries,
+            ui32 knum,
+            TConstArrayRef<ui32> visiblePointCounts = {}) const;
+
+        void AddItem(const float* embed);
+
+        ui32 GetSize() const {
+            return SquaredNorms.size();
+        }
+
+        const TVector<float>& GetVector() const {
+            return Points;
+        }
+
+    private:
+        ui32 Dimension;
+        TVector<float> Points;
+        TVector<float> SquaredNorms;
+    };
+
     template<typename D>
     struct TL2Distance {
     public:
@@ -86,6 +121,7 @@ namespace NCB {
             int totalDimension = 2,
             int numClasses = 2,
             ui32 closeNum = 5,
+            bool bruteForce = false,
             const TGuid& calcerId = CreateGuid()
         )
             : TEmbeddingFeatureCalcer(numClasses, calcerId)
@@ -93,11 +129,25 @@ namespace NCB {
             , NumClasses(numClasses)
             , CloseNum(closeNum)
             , Size(0)
-            , Cloud(MakeHolder<TKNNUpdatableCloud>(NOnlineHnsw::TOnlineHnswBuildOptions({CloseNum, 300}),
-                                                   totalDimension))
-        {}
+            , BruteForce(bruteForce)
+        {
+            if (BruteForce) {
+                Cloud = MakeHolder<TKNNBruteForceCloud>(totalDimension);
+            } else {
+                Cloud = MakeHolder<TKNNUpdatableCloud>(NOnlineHnsw::TOnlineHnswBuildOptions({CloseNum, 300}),
+                                                       totalDimension);
+            }
+        }
+
+        // exact search is faster than HNSW (and has no recall loss) for small clouds
+        static bool IsBruteForceFaster(ui64 cloudSize) {
+            return cloudSize < MaxBruteForceCloudSize;
+        }
 
         void Compute(const TEmbeddingsArray& embed, TOutputFloatIterator outputFeaturesIterator) const override;
+        void ComputeBatch(
+            TConstArrayRef<TEmbeddingsArray> embeds,
+            TConstArrayRef<TOutputFloatIterator> outputFeaturesIterators) const override;
 
         ui32 FeatureCount() const override {
             return NumClasses;
@@ -115,10 +165,16 @@ namespace NCB {
         void LoadLargeParameters(IInputStream*) override;
 
     private:
+        void WriteFeatures(TConstArrayRef<ui32> neighbors, TOutputFloatIterator iterator) const;
+
+    private:
+        static constexpr ui64 MaxBruteForceCloudSize = 100000;
+
         int TotalDimension;
         int NumClasses;
         ui32 CloseNum;
         ui32 Size;
+        bool BruteForce;
         TKNNCloudPtr Cloud;
         TVector<ui32> Targets;
 
@@ -129,6 +185,11 @@ namespace NCB {
     class TKNNCalcerVisitor final : public IEmbeddingCalcerVisitor{
     public:
         void Update(ui32 classId, const TEmbeddingsArray& embed, TEmbeddingFeatureCalcer* featureCalcer) override;
+        void ComputeAndUpdate(
+            TConstArrayRef<ui32> classIds,
+            TConstArrayRef<TEmbeddingsArray> embeds,
+            TConstArrayRef<TOutputFloatIterator> outputFeaturesIterators,
+            TEmbeddingFeatureCalcer* featureCalcer) override;
     };
 
 };
@@ -3,6 +3,8 @@
 
 #include <catboost/private/libs/embedding_features/flatbuffers/embedding_feature_calcers.fbs.h>
 
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
 #include <util/generic/ymath.h>
 
 
@@ -69,12 +71,13 @@ namespace NCB {
     }
 
     void IncrementalCloud::AddVector(const TEmbeddingsArray& embed) {
+        const bool needUpdate = IsUpdatedAfterAdding(1);
         ++AdditionalSize;
         for (int idx = 0; idx < Dimension; ++idx) {
             Buffer.push_back(embed[idx] - BaseCenter[idx]);
             NewShift[idx] += Buffer.back();
         }
-        if (BaseSize < 128 || AdditionalSize >= 32) {
+        if (needUpdate) {
             Update();
         }
     }
@@ -108,33 +111,96 @@ namespace NCB {
 
     void TLinearDACalcer::Compute(const TEmbeddingsArray& embed,
                                   TOutputFloatIterator iterator) const {
-        TVector<float> proj(ProjectionDimension, 0.0);
-        cblas_sgemv(CblasRowMajor, CblasNoTrans,
-                    ProjectionDimension, TotalDimension,
+        ComputeBatch(MakeArrayRef(&embed, 1), MakeArrayRef(&iterator, 1));
+    }
+
+    void TLinearDACalcer::ComputeBatch(
+        TConstArrayRef<TEmbeddingsArray> embeds,
+        TConstArrayRef<TOutputFloatIterator> outputFeaturesIterators) const {
+
+        Y_ASSERT(embeds.size() == outputFeaturesIterators.size());
+        if (embeds.empty()) {
+            return;
+        }
+        const int embedsCount = embeds.size();
+        const int featureCount = FeatureCount();
+        const TVector<float> vectors = GatherEmbeddings(embeds, TotalDimension);
+
+        // [embedIdx * featureCount + featureId], projections go first and probabilities after them
+        TVector<float> features;
+        features.yresize(embedsCount * featureCount);
+        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans,
+                    embedsCount, ProjectionDimension, TotalDimension,
                     1.0,
-                    &ProjectionMatrix[0], TotalDimension,
-                    &embed[0], 1,
+                    vectors.data(), TotalDimension,
+                    ProjectionMatrix.data(), TotalDimension,
                     0.0,
-                    &proj[0], 1);
+                    features.data(), featureCount);
         if (ComputeProbabilities) {
-            std::vector<float> likehoods(NumClasses);
+            CalculateClassProbabilities(vectors, embedsCount, features.data() + ProjectionDimension, featureCount);
+        }
+
+        for (auto embedIdx : xrange(embedsCount)) {
+            const float* embedFeatures = features.data() + embedIdx * featureCount;
+            TOutputFloatIterator iterator = outputFeaturesIterators[embedIdx];
+            ForEachActiveFeature(
+                [embedFeatures, &iterator](ui32 featureId){
+                    *iterator = embedFeatures[featureId];
+                    ++iterator;
+                }
+            );
+        }
+    }
+
+    void TLinearDACalcer::CalculateClassProbabilities(
+        TConstArrayRef<float> embeds,
+        int embedsCount,
+        float* result,
+        int resultStride) const {
+
+        const int dim = TotalDimension;
+        // (x - m)^T S (x - m) is computed for all embeddings of the block with one matrix product per class,
+        // S is the inverted scatter matrix; vectors are centered first as expanding the product loses precision
+        // for embeddings with large norms
+        TVector<float> centered;
+        centered.yresize(embedsCount * dim);
+        TVector<float> scatteredCentered;
+        scatteredCentered.yresize(embedsCount * dim);
+        for (auto classId : xrange(NumClasses)) {
+            const auto& mean = ClassesDist[classId].BaseCenter;
+            for (auto embedIdx : xrange(embedsCount)) {
+                const float* embed = embeds.data() + embedIdx * dim;
+                float* centeredEmbed = centered.data() + embedIdx * dim;
+                for (auto idx : xrange(dim)) {
+                    centeredEmbed[idx] = embed[idx] - mean[idx];
+                }
+            }
+            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans,
+                        embedsCount, dim, dim,
+                        1.0,
+                        centered.data(), dim,
+                        BetweenMatrix.data(), dim,
+                        0.0,
+                        scatteredCentered.data(), dim);
+            for (auto embedIdx : xrange(embedsCount)) {
+                const float deg = cblas_sdot(
+                    dim,
+                    centered.data() + embedIdx * dim, 1,
+                    scatteredCentered.data() + embedIdx * dim, 1);
+                result[embedIdx * resultStride + classId] = Exp2f(- M_LN2_INV * 0.5 * deg);
+            }
+        }
+
+        for (auto embedIdx : xrange(embedsCount)) {
+            float* likehoods = result + embedIdx * resultStride;
             float likehood = 0;
-            for (int classId = 0; classId < NumClasses; ++classId) {
-                likehoods[classId] = CalculateGaussianLikehood(embed,
-                                                               ClassesDist[classId].BaseCenter,
-                                                               BetweenMatrix);
+            for (auto classId : xrange(NumClasses)) {
                 likehood += likehoods[classId];
             }
-            for (auto like : likehoods) {
-                proj.push_back((likehood > 1e-6 ? like/likehood : 1.0/NumClasses));
+            for (auto classId : xrange(NumClasses)) {
+                likehoods[classId] = likehood > 1e-6 ? likehoods[classId] / likehood : 1.0 / NumClasses;
             }
         }
-        ForEachActiveFeature(
-            [&proj, &iterator](ui32 featureId){
-                *iterator = proj[featureId];
-                ++iterator;
-            }
-        );
     }
 
     void TLinearDACalcer::TotalScatterCalculation(TVector<float>* result) {
@@ -172,6 +238,46 @@ namespace NCB {
         }
     }
 
+    void TLinearDACalcerVisitor::ComputeAndUpdate(
+        TConstArrayRef<ui32> classIds,
+        TConstArrayRef<TEmbeddingsArray> embeds,
+        TConstArrayRef<TOutputFloatIterator> outputFeaturesIterators,
+        TEmbeddingFeatureCalcer* featureCalcer) {
+
+        auto lda = dynamic_cast<TLinearDACalcer*>(featureCalcer);
+        Y_ASSERT(lda);
+        /* Features depend on the projection (changed by flushes) and, with probabilities, on the class centers
+         * (changed by cloud updates). Runs of vectors that don't change them are computed as one batch
+         * before the calcer is updated with them, so the result is the same as of the sequential pass.
+         */
+        TVector<int> pendingClassCounts(lda->NumClasses, 0);
+        size_t segmentStart = 0;
+        const auto computeAndUpdateSegment = [&] (size_t segmentEnd) {
+            lda->ComputeBatch(
+                embeds.subspan(segmentStart, segmentEnd - segmentStart),
+                outputFeaturesIterators.subspan(segmentStart, segmentEnd - segmentStart));
+            for (auto idx : xrange(segmentStart, segmentEnd)) {
+                Update(classIds[idx], embeds[idx], featureCalcer);
+            }
+            Fill(pendingClassCounts.begin(), pendingClassCounts.end(), 0);
+            segmentStart = segmentEnd;
+        };
+        for (auto idx : xrange(embeds.size())) {
+            const ui32 classId = classIds[idx];
+            ++pendingClassCounts[classId];
+            const int pendingCount = idx + 1 - segmentStart;
+            const bool changesFeatures = 2 * LastFlush <= lda->Size + pendingCount
+                || (lda->ComputeProbabilities
+                    && lda->ClassesDist[classId].IsUpdatedAfterAdding(pendingClassCounts[classId]));
+            if (changesFeatures) {
+                computeAndUpdateSegment(idx + 1);
+            }
+        }
+        if (segmentStart < embeds.size()) {
+            computeAndUpdateSegment(embeds.size());
+        }
+    }
+
     void TLinearDACalcerVisitor::Flush(TEmbeddingFeatureCalcer* featureCalcer) {
         auto lda = dynamic_cast<TLinearDACalcer*>(featureCalcer);
         Y_ASSERT(lda);
@@ -21,10 +21,18 @@ namespace NCB {
         void AddVector(const TEmbeddingsArray& embed);
         void Update();
 
+        // whether adding count more vectors makes AddVector call Update and move the center
+        bool IsUpdatedAfterAdding(int count) const {
+            return BaseSize < MinBaseSize || AdditionalSize + count >= MaxAdditionalSize;
+        }
+
         float TotalSize() {
             return BaseSize + AdditionalSize;
         }
     public:
+        static constexpr int MinBaseSize = 128;
+        static constexpr int MaxAdditionalSize = 32;
+
         int Dimension;
         int BaseSize = 0;
         int AdditionalSize = 0;
@@ -58,6 +66,9 @@ namespace NCB {
         {}
 
         void Compute(const TEmbeddingsArray& embed, TOutputFloatIterator outputFeaturesIterator) const override;
+        void ComputeBatch(
+            TConstArrayRef<TEmbeddingsArray> embeds,
+            TConstArrayRef<TOutputFloatIterator> outputFeaturesIterators) const override;
 
         ui32 FeatureCount() const override {
             if (ComputeProbabilities) {
@@ -79,6 +90,11 @@ namespace NCB {
 
     private:
         void TotalScatterCalculation(TVector<float>* result);
+        void CalculateClassProbabilities(
+            TConstArrayRef<float> embeds,
+            int embedsCount,
+            float* result,
+            int resultStride) const;
 
     private:
         int TotalDimension;
@@ -100,6 +116,11 @@ namespace NCB {
     class TLinearDACalcerVisitor final : public IEmbeddingCalcerVisitor {
     public:
         void Update(ui32 classId, const TEmbeddingsArray& embed, TEmbeddingFeatureCalcer* featureCalcer) override;
+        void ComputeAndUpdate(
+            TConstArrayRef<ui32> classIds,
+            TConstArrayRef<TEmbeddingsArray> embeds,
+            TConstArrayRef<TOutputFloatIterator> outputFeaturesIterators,
+            TEmbeddingFeatureCalcer* featureCalcer) override;
         void Flush(TEmbeddingFeatureCalcer* featureCalcer);
     private:
         int LastFlush = 0;
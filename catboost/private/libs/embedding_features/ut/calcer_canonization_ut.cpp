@@ -4,6 +4,8 @@
 #include <util/random/fast.h>
 #include <util/random/normal.h>
 #include <util/random/random.h>
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
 #include <util/generic/ymath.h>
 
 using namespace NCB;
@@ -80,4 +82,96 @@ Y_UNIT_TEST_SUITE(TestCalcerCanonization) {
         UNIT_ASSERT_DOUBLES_EQUAL(proj[0] - proj[2] + proj[4], 0.0, eps * norm1);
         UNIT_ASSERT_DOUBLES_EQUAL(proj[1] - proj[3] + proj[5], 0.0, eps * norm2);
     }
+
+    Y_UNIT_TEST(TestLDABlockOnlinePass) {
+        const ui32 numSamples = 3000;
+        TVector<TVector<float>> means{{3, 5, 2}, {-8, -3, 5}, {5, -5, -2}};
+        TVector<ui32> target;
+        for (ui32 id = 0; id < numSamples; ++id) {
+            target.push_back(RandomNumber<ui32>(means.size()));
+        }
+        auto dataSet = DataSetGenerator(means, target);
+        const ui32 dim = means[0].size();
+        const ui32 featureCount = 2 + means.size();
+
+        TLinearDACalcer sequentialLDA(dim, means.size(), 2, 0.01, /*computeProb*/ true);
+        TLinearDACalcer blockLDA(dim, means.size(), 2, 0.01, /*computeProb*/ true);
+        TLinearDACalcerVisitor sequentialVisitor;
+        TLinearDACalcerVisitor blockVisitor;
+        TVector<float> sequentialFeatures(numSamples * featureCount);
+        TVector<float> blockFeatures(numSamples * featureCount);
+        for (ui32 idx = 0; idx < numSamples; ++idx) {
+            sequentialLDA.Compute(
+                dataSet[idx],
+                TOutputFloatIterator(sequentialFeatures.data() + idx * featureCount, featureCount));
+            sequentialVisitor.Update(target[idx], dataSet[idx], &sequentialLDA);
+        }
+        for (ui32 blockStart = 0; blockStart < numSamples; blockStart += 256) {
+            const ui32 blockSize = Min<ui32>(256, numSamples - blockStart);
+            TVector<TOutputFloatIterator> iterators;
+            for (ui32 idx = blockStart; idx < blockStart + blockSize; ++idx) {
+                iterators.emplace_back(blockFeatures.data() + idx * featureCount, featureCount);
+            }
+            blockVisitor.ComputeAndUpdate(
+                MakeArrayRef(target).subspan(blockStart, blockSize),
+                MakeArrayRef(dataSet).subspan(blockStart, blockSize),
+                iterators,
+                &blockLDA);
+        }
+        UNIT_ASSERT_VALUES_EQUAL(sequentialFeatures, blockFeatures);
+    }
+
+    // embeddings with large norms, class centers are close relative to them
+    Y_UNIT_TEST(TestLDAProbabilitiesWithLargeNorms) {
+        const ui32 numSamples = 3000;
+        const float offset = 1000;
+        TVector<TVector<float>> means{{offset + 1, offset, offset}, {offset, offset + 1, offset}, {offset, offset, offset + 1}};
+        TVector<ui32> target;
+        for (ui32 id = 0; id < numSamples; ++id) {
+            target.push_back(RandomNumber<ui32>(means.size()));
+        }
+        auto dataSet = DataSetGenerator(means, target);
+        const int dim = means[0].size();
+        const int numClasses = means.size();
+        const float regularization = 0.01;
+
+        TLinearDACalcer lda(dim, numClasses, 2, regularization, /*computeProb*/ true);
+        TLinearDACalcerVisitor visitor;
+        // the same class clouds as in the calcer, for the reference computation
+        TVector<IncrementalCloud> clouds(numClasses, IncrementalCloud(dim));
+        for (ui32 idx = 0; idx < numSamples; ++idx) {
+            visitor.Update(target[idx], dataSet[idx], &lda);
+            clouds[target[idx]].AddVector(dataSet[idx]);
+        }
+        visitor.Flush(&lda);
+
+        TVector<float> scatter(dim * dim, 0);
+        for (auto& cloud : clouds) {
+            const float weight = cloud.TotalSize() / numSamples;
+            for (auto idx : xrange(scatter.size())) {
+                scatter[idx] += weight * cloud.ScatterMatrix[idx];
+            }
+        }
+        for (int idx = 0; idx < dim; ++idx) {
+            scatter[idx * (dim + 1)] += regularization;
+        }
+        InverseMatrix(&scatter, dim);
+
+        const ui32 featureCount = lda.FeatureCount();
+        for (auto classId : xrange(numClasses)) {
+            const auto embed = NormalEmbedding(means[classId]);
+            TVector<float> features(featureCount);
+            lda.Compute(embed, TOutputFloatIterator(features.data(), featureCount));
+
+            TVector<float> expected;
+            for (const auto& cloud : clouds) {
+                expected.push_back(CalculateGaussianLikehood(embed, cloud.BaseCenter, scatter));
+            }
+            const float likehood = Accumulate(expected, 0.0f);
+            UNIT_ASSERT(likehood > 1e-6);
+            for (auto otherClassId : xrange(numClasses)) {
+                UNIT_ASSERT_DOUBLES_EQUAL(features[2 + otherClassId], expected[otherClassId] / likehood, 1e-4);
+            }
+        }
+    }
 }
@@ -0,0 +1,134 @@
+#include <catboost/private/libs/embedding_features/knn.h>
+
+#include <library/cpp/testing/unittest/registar.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/stream/str.h>
+
+using namespace NCB;
+
+Y_UNIT_TEST_SUITE(TestKNN) {
+
+    // small integer coordinates make float distances exact, so the results don't depend on the summation order
+    TVector<float> GeneratePoints(ui32 count, ui32 dimension, TFastRng<ui32>* rng) {
+        TVector<float> points(count * dimension);
+        for (auto& coordinate : points) {
+            coordinate = int(rng->Uniform(7)) - 3;
+        }
+        return points;
+    }
+
+    TVector<ui32> NaiveNearestNeighbors(
+        const TVector<float>& points,
+        const float* query,
+        ui32 visibleCount,
+        ui32 dimension,
+        ui32 knum) {
+
+        TVector<std::pair<double, ui32>> distances;
+        for (auto pointIdx : xrange(visibleCount)) {
+            double distance = 0;
+            for (auto coordinate : xrange(dimension)) {
+                const double diff = points[pointIdx * dimension + coordinate] - query[coordinate];
+                distance += diff * diff;
+            }
+            distances.emplace_back(distance, pointIdx);
+        }
+        Sort(distances);
+        TVector<ui32> result;
+        for (auto idx : xrange(Min<size_t>(knum, distances.size()))) {
+            result.push_back(distances[idx].second);
+        }
+        return result;
+    }
+
+    TVector<TEmbeddingsArray> MakeEmbeddings(const TVector<float>& points, ui32 dimension) {
+        TVector<TEmbeddingsArray> result;
+        for (size_t offset = 0; offset < points.size(); offset += dimension) {
+            result.push_back(TEmbeddingsArray::CreateOwning(
+                TVector<float>(points.begin() + offset, points.begin() + offset + dimension)));
+        }
+        return result;
+    }
+
+    Y_UNIT_TEST(TestBruteForceIsExact) {
+        const ui32 dimension = 5;
+        const ui32 knum = 7;
+        TFastRng<ui32> rng(42);
+        auto points = GeneratePoints(1000, dimension, &rng);
+        const auto queries = GeneratePoints(100, dimension, &rng);
+        TVector<ui32> visibleCounts;
+        for (auto queryIdx : xrange(100)) {
+            visibleCounts.push_back(queryIdx * 11);
+        }
+
+        TKNNBruteForceCloud cloud(dimension, TVector<float>(points));
+        const auto allNeighbors = cloud.GetNearestNeighborsBatch(queries, knum);
+        const auto prefixNeighbors = cloud.GetNearestNeighborsBatch(queries, knum, visibleCounts);
+        for (auto queryIdx : xrange(100)) {
+            const float* query = queries.data() + queryIdx * dimension;
+            UNIT_ASSERT_VALUES_EQUAL(
+                allNeighbors[queryIdx],
+                NaiveNearestNeighbors(points, query, 1000, dimension, knum));
+            UNIT_ASSERT_VALUES_EQUAL(
+                prefixNeighbors[queryIdx],
+                NaiveNearestNeighbors(points, query, visibleCounts[queryIdx], dimension, knum));
+            UNIT_ASSERT_VALUES_EQUAL(cloud.GetNearestNeighbors(query, knum), allNeighbors[queryIdx]);
+        }
+    }
+
+    Y_UNIT_TEST(TestBlockOnlinePassIsSequential) {
+        const ui32 dimension = 4;
+        const ui32 numClasses = 3;
+        const ui32 count = 600;
+        TFastRng<ui32> rng(0);
+        const auto embeddings = MakeEmbeddings(GeneratePoints(count, dimension, &rng), dimension);
+        TVector<ui32> classIds;
+        for (auto idx : xrange(count)) {
+            Y_UNUSED(idx);
+            classIds.push_back(rng.Uniform(numClasses));
+        }
+
+        TKNNCalcer sequentialCalcer(dimension, numClasses, /*closeNum*/ 5, /*bruteForce*/ true);
+        TKNNCalcer blockCalcer(dimension, numClasses, /*closeNum*/ 5, /*bruteForce*/ true);
+        TKNNCalcerVisitor visitor;
+        TVector<float> sequentialFeatures(count * numClasses);
+        TVector<float> blockFeatures(count * numClasses);
+        for (auto idx : xrange(count)) {
+            sequentialCalcer.Compute(
+                embeddings[idx],
+                TOutputFloatIterator(sequentialFeatures.data() + idx * numClasses, numClasses));
+            visitor.Update(classIds[idx], embeddings[idx], &sequentialCalcer);
+        }
+        for (ui32 blockStart = 0; blockStart < count; blockStart += 256) {
+            const ui32 blockSize = Min<ui32>(256, count - blockStart);
+            TVector<TOutputFloatIterator> iterators;
+            for (auto idx : xrange(blockStart, blockStart + blockSize)) {
+                iterators.emplace_back(blockFeatures.data() + idx * numClasses, numClasses);
+            }
+            visitor.ComputeAndUpdate(
+                MakeArrayRef(classIds).subspan(blockStart, blockSize),
+                MakeArrayRef(embeddings).subspan(blockStart, blockSize),
+                iterators,
+                &blockCalcer);
+        }
+        UNIT_ASSERT_VALUES_EQUAL(sequentialFeatures, blockFeatures);
+
+        TStringStream stream;
+        TEmbeddingCalcerSerializer::Save(&stream, blockCalcer);
+        auto loadedCalcer = TEmbeddingCalcerSerializer::Load(&stream);
+        TVector<float> expectedFeatures(count * numClasses);
+        TVector<float> loadedFeatures(count * numClasses);
+        TVector<TOutputFloatIterator> expectedIterators;
+        TVector<TOutputFloatIterator> loadedIterators;
+        for (auto idx : xrange(count)) {
+            expectedIterators.emplace_back(expectedFeatures.data() + idx * numClasses, numClasses);
+            loadedIterators.emplace_back(loadedFeatures.data() + idx * numClasses, numClasses);
+        }
+        blockCalcer.ComputeBatch(embeddings, expectedIterators);
+        loadedCalcer->ComputeBatch(embeddings, loadedIterators);
+        UNIT_ASSERT_VALUES_EQUAL(expectedFeatures, loadedFeatures);
+    }
+}
@@ -3,6 +3,11 @@
 #include "feature_estimator.h"
 #include <catboost/private/libs/embeddings/embedding_dataset.h>
 
+#include <util/generic/cast.h>
+#include <util/generic/utility.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+
 namespace NCB {
 
     template <class TFeatureCalcer, class TCalcerVisitor>
@@ -21,26 +26,32 @@ namespace NCB {
         void ComputeFeatures(
             TCalculatedFeatureVisitor learnVisitor,
             TConstArrayRef<TCalculatedFeatureVisitor> testVisitors,
-            NPar::ILocalExecutor*) const override {
+            NPar::ILocalExecutor* executor) const override {
 
             THolder<TFeatureCalcer> featureCalcer = EstimateFeatureCalcer();
 
             TVector<TEmbeddingDataSetPtr> learnDataset{GetLearnDatasetPtr()};
             TVector<TCalculatedFeatureVisitor> learnVisitors{std::move(learnVisitor)};
-            Calc(*featureCalcer, learnDataset, learnVisitors);
+            Calc(*featureCalcer, learnDataset, learnVisitors, executor);
 
             if (!testVisitors.empty()) {
                 CB_ENSURE(testVisitors.size() == NumberOfTestDatasets(),
                           "If specified, testVisitors should be the same number as test sets");
-                Calc(*featureCalcer, GetTestDatasets(), testVisitors);
+                Calc(*featureCalcer, GetTestDatasets(), testVisitors, executor);
             }
         }
 
+        /*
+         * The learn pass is sequential: KNN cloud and LDA statistics depend on the order of updates,
+         * so they can't be accumulated by parts and merged without changing the result.
+         * It goes by blocks of the permutation, so calcers can compute a block at once
+         * (see IEmbeddingCalcerVisitor::ComputeAndUpdate).
+         */
         void ComputeOnlineFeatures(
             TConstArrayRef<ui32> learnPermutation,
             TCalculatedFeatureVisitor learnVisitor,
             TConstArrayRef<TCalculatedFeatureVisitor> testVisitors,
-            NPar::ILocalExecutor*) const override {
+            NPar::ILocalExecutor* executor) const override {
 
             TFeatureCalcer featureCalcer = CreateFeatureCalcer();
             TCalcerVisitor calcerVisitor = CreateCalcerVisitor();
@@ -53,11 +64,23 @@ namespace NCB {
                 const ui64 samplesCount = learnDataset.SamplesCount();
                 TVector<float> learnFeatures(featuresCount * samplesCount);
 
-                for (ui64 line : learnPermutation) {
-                    const TEmbeddingsArray& vector = learnDataset.GetVector(line);
-
-                    Compute(featureCalcer, vector, line, samplesCount, learnFeatures);
-                    calcerVisitor.Update(target.Classes[line], vector, &featureCalcer);
+                TVector<ui32> classIds;
+                TVector<TEmbeddingsArray> vectors;
+                for (ui64 blockStart = 0; blockStart < learnPermutation.size(); blockStart += VectorsBlockSize) {
+                    const auto blockLines = learnPermutation.subspan(
+                        blockStart,
+                        Min<ui64>(VectorsBlockSize, learnPermutation.size() - blockStart));
+                    classIds.clear();
+                    vectors.clear();
+                    for (ui64 line : blockLines) {
+                        classIds.push_back(target.Classes[line]);
+                        vectors.push_back(learnDataset.GetVector(line));
+                    }
+                    calcerVisitor.ComputeAndUpdate(
+                        classIds,
+                        vectors,
+                        MakeOutputIterators(blockLines, samplesCount, learnFeatures),
+                        &featureCalcer);
                 }
                 for (ui32 f = 0; f < featuresCount; ++f) {
                     learnVisitor(
@@ -72,7 +95,7 @@ namespace NCB {
             if (!testVisitors.empty()) {
                 CB_ENSURE(testVisitors.size() == NumberOfTestDatasets(),
                           "If specified, testVisitors should be the same number as test sets");
-                Calc(featureCalcer, GetTestDatasets(), testVisitors);
+                Calc(featureCalcer, GetTestDatasets(), testVisitors, executor);
             }
         }
 
@@ -102,7 +125,8 @@ namespace NCB {
         void Calc(
             const TFeatureCalcer& featureCalcer,
             TConstArrayRef<TEmbeddingDataSetPtr> datasets,
-            TConstArrayRef<TCalculatedFeatureVisitor> visitors) const {
+            TConstArrayRef<TCalculatedFeatureVisitor> visitors,
+            NPar::ILocalExecutor* executor) const {
 
             const ui32 featuresCount = featureCalcer.FeatureCount();
             for (ui32 id = 0; id < datasets.size(); ++id) {
@@ -110,9 +134,19 @@ namespace NCB {
                 const ui64 samplesCount = currentDataset.SamplesCount();
                 TVector<float> features(featuresCount * samplesCount);
 
-                for (ui64 line = 0; line < samplesCount; ++line) {
-                    Compute(featureCalcer, currentDataset.GetVector(line), line, samplesCount, features);
-                }
+                const auto vectors = currentDataset.GetEmbedding();
+                const int blockCount = SafeIntegerCast<int>(CeilDiv<ui64>(samplesCount, VectorsBlockSize));
+                executor->ExecRangeWithThrow(
+                    [&] (int blockIdx) {
+                        const ui64 blockStart = blockIdx * VectorsBlockSize;
+                        const ui64 blockEnd = Min<ui64>(blockStart + VectorsBlockSize, samplesCount);
+                        featureCalcer.ComputeBatch(
+                            vectors.subspan(blockStart, blockEnd - blockStart),
+                            MakeOutputIterators(xrange(blockStart, blockEnd), samplesCount, features));
+                    },
+                    0,
+                    blockCount,
+                    NPar::TLocalExecutor::WAIT_COMPLETE);
 
                 for (ui32 f = 0; f < featuresCount; ++f) {
                     visitors[id](
@@ -145,20 +179,17 @@ namespace NCB {
             return featureCalcer;
         }
 
-        void Compute(
-            const TFeatureCalcer& featureCalcer,
-            const TEmbeddingsArray& vector,
-            ui64 docId,
+        template <class TDocIds>
+        static TVector<TOutputFloatIterator> MakeOutputIterators(
+            const TDocIds& docIds,
             ui64 docCount,
-            TArrayRef<float> features) const {
-
-            auto outputFeaturesIterator = TOutputFloatIterator(
-                features.data() + docId,
-                docCount,
-                features.size()
-            );
+            TArrayRef<float> features) {
 
-            featureCalcer.Compute(vector, outputFeaturesIterator);
+            TVector<TOutputFloatIterator> outputFeaturesIterators;
+            for (ui64 docId : docIds) {
+                outputFeaturesIterators.emplace_back(features.data() + docId, docCount, features.size());
+            }
+            return outputFeaturesIterators;
         }
 
         const TEmbeddingClassificationTarget& GetTarget() const {
@@ -190,6 +221,9 @@ namespace NCB {
 
 
     private:
+        // vectors are passed to calcers by blocks of this size
+        static constexpr ui64 VectorsBlockSize = 256;
+
         TEmbeddingClassificationTargetPtr Target;
         TEmbeddingDataSetPtr LearnArrays;
         TVector<TEmbeddingDataSetPtr> TestArrays;
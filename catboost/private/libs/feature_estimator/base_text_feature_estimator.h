@@ -3,6 +3,9 @@
 #include "feature_estimator.h"
 #include <catboost/private/libs/text_processing/text_dataset.h>
 
+#include <util/generic/cast.h>
+#include <util/generic/utility.h>
+
 namespace NCB {
     //TODO(noxoomo): we could fuse estimation in one pass for naive bayes and bm25
     template <class TFeatureCalcer, class TCalcerVisitor>
@@ -21,26 +24,32 @@ namespace NCB {
         void ComputeFeatures(
             TCalculatedFeatureVisitor learnVisitor,
             TConstArrayRef<TCalculatedFeatureVisitor> testVisitors,
-            NPar::ILocalExecutor*) const override {
+            NPar::ILocalExecutor* executor) const override {
 
             THolder<TFeatureCalcer> featureCalcer = EstimateFeatureCalcer();
 
             TVector<TTextDataSetPtr> learnDs{GetLearnDataSetPtr()};
             TVector<TCalculatedFeatureVisitor> learnVisitors{std::move(learnVisitor)};
-            Calc(*featureCalcer, learnDs, learnVisitors);
+            Calc(*featureCalcer, learnDs, learnVisitors, executor);
 
             if (!testVisitors.empty()) {
                 CB_ENSURE(testVisitors.size() == NumberOfTestDataSets(),
                           "If specified, testVisitors should be the same number as test sets");
-                Calc(*featureCalcer, GetTestDataSets(), testVisitors);
+                Calc(*featureCalcer, GetTestDataSets(), testVisitors, executor);
             }
         }
 
+        /*
+         * If calcer statistics are mergeable the permutation is split into blocks: statistics of each block
+         * are accumulated in parallel, prefix sums of them give calcer states at the block starts and
+         * then blocks are processed in parallel starting from these states.
+         * Calcer statistics are integer counts, so the result is the same as for the sequential pass.
+         */
         void ComputeOnlineFeatures(
             TConstArrayRef<ui32> learnPermutation,
             TCalculatedFeatureVisitor learnVisitor,
             TConstArrayRef<TCalculatedFeatureVisitor> testVisitors,
-            NPar::ILocalExecutor*) const override {
+            NPar::ILocalExecutor* executor) const override {
 
             TFeatureCalcer featureCalcer = CreateFeatureCalcer();
             TCalcerVisitor calcerVisitor = CreateCalcerVisitor();
@@ -53,11 +62,56 @@ namespace NCB {
                 const ui64 samplesCount = ds.SamplesCount();
                 TVector<float> learnFeatures(featuresCount * samplesCount);
 
-                for (ui64 line : learnPermutation) {
-                    const TText& text = ds.GetText(line);
-
-                    Compute(featureCalcer, text, line, samplesCount, learnFeatures);
-                    calcerVisitor.Update(target.Classes[line], text, &featureCalcer);
+                const ui32 blockCount = GetOnlineBlockCount(calcerVisitor, learnPermutation.size(), executor);
+                if (blockCount > 1) {
+                    NPar::ILocalExecutor::TExecRangeParams blockParams(0, learnPermutation.size());
+                    blockParams.SetBlockCount(blockCount);
+                    const int blockSize = blockParams.GetBlockSize();
+                    const auto getBlock = [&] (int blockIdx) {
+                        const size_t blockStart = static_cast<size_t>(blockIdx) * blockSize;
+                        return learnPermutation.Slice(
+                            blockStart,
+                            Min<size_t>(blockSize, learnPermutation.size() - blockStart));
+                    };
+
+                    // blockStates[i] is the calcer state after blocks [0, i)
+                    TVector<TFeatureCalcer> blockStates(blockParams.GetBlockCount(), featureCalcer);
+                    executor->ExecRangeWithThrow(
+                        [&] (int blockIdx) {
+                            TCalcerVisitor blockVisitor = CreateCalcerVisitor();
+                            for (ui32 line : getBlock(blockIdx)) {
+                                blockVisitor.Update(target.Classes[line], ds.GetText(line), &blockStates[blockIdx + 1]);
+                            }
+                        },
+                        0,
+                        blockParams.GetBlockCount() - 1,
+                        NPar::TLocalExecutor::WAIT_COMPLETE);
+                    for (int blockIdx = 1; blockIdx < blockParams.GetBlockCount(); ++blockIdx) {
+                        calcerVisitor.Merge(blockStates[blockIdx - 1], &blockStates[blockIdx]);
+                    }
+
+                    executor->ExecRangeWithThrow(
+                        [&] (int blockIdx) {
+                            TCalcerVisitor blockVisitor = CreateCalcerVisitor();
+                            TFeatureCalcer& blockCalcer = blockStates[blockIdx];
+                            for (ui32 line : getBlock(blockIdx)) {
+                                const TText& text = ds.GetText(line);
+
+                                Compute(blockCalcer, text, line, samplesCount, learnFeatures);
+                                blockVisitor.Update(target.Classes[line], text, &blockCalcer);
+                            }
+                        },
+                        0,
+                        blockParams.GetBlockCount(),
+                        NPar::TLocalExecutor::WAIT_COMPLETE);
+                    featureCalcer = std::move(blockStates.back());
+                } else {
+                    for (ui64 line : learnPermutation) {
+                        const TText& text = ds.GetText(line);
+
+                        Compute(featureCalcer, text, line, samplesCount, learnFeatures);
+                        calcerVisitor.Update(target.Classes[line], text, &featureCalcer);
+                    }
                 }
                 for (ui32 f = 0; f < featuresCount; ++f) {
                     learnVisitor(
@@ -72,7 +126,7 @@ namespace NCB {
             if (!testVisitors.empty()) {
                 CB_ENSURE(testVisitors.size() == NumberOfTestDataSets(),
                           "If specified, testVisitors should be the same number as test sets");
-                Calc(featureCalcer, GetTestDataSets(), testVisitors);
+                Calc(featureCalcer, GetTestDataSets(), testVisitors, executor);
             }
         }
 
@@ -100,7 +154,8 @@ namespace NCB {
         void Calc(
             const TFeatureCalcer& featureCalcer,
             TConstArrayRef<TTextDataSetPtr> dataSets,
-            TConstArrayRef<TCalculatedFeatureVisitor> visitors) const {
+            TConstArrayRef<TCalculatedFeatureVisitor> visitors,
+            NPar::ILocalExecutor* executor) const {
 
             const ui32 featuresCount = featureCalcer.FeatureCount();
             for (ui32 id = 0; id < dataSets.size(); ++id) {
@@ -108,9 +163,14 @@ namespace NCB {
                 const ui64 samplesCount = ds.SamplesCount();
                 TVector<float> features(featuresCount * samplesCount);
 
-                for (ui64 line = 0; line < samplesCount; ++line) {
-                    Compute(featureCalcer, ds.GetText(line), line, samplesCount, features);
-                }
+                executor->ExecRangeBlockedWithThrow(
+                    [&] (int line) {
+                        Compute(featureCalcer, ds.GetText(line), line, samplesCount, features);
+                    },
+                    0,
+                    SafeIntegerCast<int>(samplesCount),
+                    /*batchSizeOrZeroForAutoBatchSize*/ 0,
+                    NPar::TLocalExecutor::WAIT_COMPLETE);
 
                 for (ui32 f = 0; f < featuresCount; ++f) {
                     visitors[id](
@@ -124,6 +184,17 @@ namespace NCB {
             }
         }
 
+        static ui32 GetOnlineBlockCount(
+            const TCalcerVisitor& calcerVisitor,
+            size_t permutationSize,
+            NPar::ILocalExecutor* executor) {
+
+            if (!calcerVisitor.IsMergeable()) {
+                return 1;
+            }
+            return Min<size_t>(executor->GetThreadCount() + 1, permutationSize / MinOnlineBlockSize);
+        }
+
         virtual TFeatureCalcer CreateFeatureCalcer() const = 0;
         virtual TCalcerVisitor CreateCalcerVisitor() const = 0;
 
@@ -187,6 +258,9 @@ namespace NCB {
         }
 
     private:
+        // smaller blocks are not worth merging of calcer statistics
+        static constexpr size_t MinOnlineBlockSize = 2048;
+
         TTextClassificationTargetPtr Target;
         TTextDataSetPtr LearnTexts;
         TVector<TTextDataSetPtr> TestTexts;
@@ -97,7 +97,13 @@ namespace NCB {
         }
 
         TKNNCalcer CreateFeatureCalcer() const override {
-            return TKNNCalcer(GetLearnDataset().GetDimension(), GetTarget().NumClasses, kNum);
+            const auto& learnDataset = GetLearnDataset();
+            return TKNNCalcer(
+                learnDataset.GetDimension(),
+                GetTarget().NumClasses,
+                kNum,
+                TKNNCalcer::IsBruteForceFaster(learnDataset.SamplesCount())
+            );
         }
 
         TKNNCalcerVisitor CreateCalcerVisitor() const override {
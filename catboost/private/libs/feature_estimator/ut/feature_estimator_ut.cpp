@@ -8,6 +8,7 @@
 
 #include <library/cpp/testing/unittest/registar.h>
 #include <util/random/fast.h>
+#include <util/random/shuffle.h>
 
 
 using namespace NCB;
@@ -283,4 +284,113 @@ Y_UNIT_TEST_SUITE(TestFeatureEstimators) {
             }
         }
     }
+
+    Y_UNIT_TEST(TestParallelOnlineIdenticalOutput) {
+        const ui32 numSamples = 10000;
+        const ui32 numClasses = 3;
+        const ui32 dictionarySize = 50;
+
+        TFastRng<ui64> rng(17);
+
+        TVector<ui32> classes(numSamples);
+        for (ui32 i: xrange(numSamples)) {
+            classes[i] = rng.Uniform(numClasses);
+        }
+        TTextClassificationTargetPtr target = MakeIntrusive<TTextClassificationTarget>(
+            std::move(classes),
+            numClasses
+        );
+
+        TVector<TText> texts;
+        texts.yresize(numSamples);
+
+        TTextColumnDictionaryOptions columnDictionaryOptions;
+        columnDictionaryOptions.DictionaryBuilderOptions->OccurrenceLowerBound = 1;
+        NTextProcessing::NDictionary::TDictionaryBuilder dictionaryBuilder(
+            columnDictionaryOptions.DictionaryBuilderOptions,
+            columnDictionaryOptions.DictionaryOptions
+        );
+
+        for (ui32 sampleId: xrange(numSamples)) {
+            TVector<ui32> tokenIds;
+            for (ui32 tokenId: xrange(dictionarySize)) {
+                if (rng.GenRandReal1() > 0.8) {
+                    tokenIds.push_back(tokenId);
+                    dictionaryBuilder.Add(ToString(tokenId));
+                }
+            }
+            texts[sampleId] = TText{std::move(tokenIds)};
+        }
+
+        TDictionaryPtr dictionary = new TDictionaryProxy(dictionaryBuilder.FinishBuilding());
+
+        TTextColumn textColumn = TTextColumn::CreateOwning(std::move(texts));
+        TTextDataSetPtr learnTexts = MakeIntrusive<TTextDataSet>(textColumn, dictionary);
+        TVector<TTextDataSetPtr> testText{learnTexts};
+
+        TVector<ui32> learnPermutation(numSamples);
+        Iota(learnPermutation.begin(), learnPermutation.end(), 0);
+        Shuffle(learnPermutation.begin(), learnPermutation.end(), rng);
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        for (auto calcerType : {EFeatureCalcerType::BM25, EFeatureCalcerType::NaiveBayes}) {
+            TVector<TOnlineFeatureEstimatorPtr> estimators = CreateTextEstimators(
+                {NCatboostOptions::TFeatureCalcerDescription(calcerType)},
+                target,
+                learnTexts,
+                testText
+            );
+            UNIT_ASSERT(estimators.size() == 1);
+
+            TTextFeatureCalcerPtr calcer;
+            TTextCalcerVisitorPtr visitor;
+            if (calcerType == EFeatureCalcerType::BM25) {
+                calcer = MakeIntrusive<TBM25>(CreateGuid(), numClasses);
+                visitor = MakeIntrusive<TBM25Visitor>();
+            } else {
+                calcer = MakeIntrusive<TMultinomialNaiveBayes>(CreateGuid(), numClasses);
+                visitor = MakeIntrusive<TNaiveBayesVisitor>();
+            }
+            const ui32 featureCount = calcer->FeatureCount();
+
+            TVector<float> learn(numSamples * featureCount);
+            TCalculatedFeatureVisitor learnVisitor{
+                [&](ui32 featureId, TConstArrayRef<float> features) {
+                    Copy(features.begin(), features.end(), learn.begin() + featureId * numSamples);
+                }
+            };
+            TVector<float> test(numSamples * featureCount);
+            TVector<TCalculatedFeatureVisitor> testVisitors{
+                TCalculatedFeatureVisitor{
+                    [&](ui32 featureId, TConstArrayRef<float> features) {
+                        Copy(features.begin(), features.end(), test.begin() + featureId * numSamples);
+                    }
+                }
+            };
+
+            estimators[0]->ComputeOnlineFeatures(
+                learnPermutation,
+                learnVisitor,
+                testVisitors,
+                &localExecutor
+            );
+
+            for (ui32 line : learnPermutation) {
+                TVector<float> features = calcer->Compute(learnTexts->GetText(line));
+                visitor->Update(target->Classes[line], learnTexts->GetText(line), calcer.Get());
+
+                for (ui32 featureId: xrange(featureCount)) {
+                    UNIT_ASSERT_EQUAL(features[featureId], learn[featureId * numSamples + line]);
+                }
+            }
+            for (ui32 line : xrange(numSamples)) {
+                TVector<float> features = calcer->Compute(learnTexts->GetText(line));
+                for (ui32 featureId: xrange(featureCount)) {
+                    UNIT_ASSERT_EQUAL(features[featureId], test[featureId * numSamples + line]);
+                }
+            }
+        }
+    }
 }
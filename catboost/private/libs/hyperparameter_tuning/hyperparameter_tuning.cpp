@@ -14,13 +14,18 @@
 #include <catboost/libs/train_lib/dir_helper.h>
 #include <catboost/private/libs/options/plain_options_helper.h>
 
+#include <library/cpp/threading/local_executor/local_executor.h>
+
 #include <util/generic/algorithm.h>
 #include <util/generic/deque.h>
+#include <util/generic/map.h>
+#include <util/generic/ptr.h>
 #include <util/generic/set.h>
 #include <util/generic/xrange.h>
 #include <util/random/shuffle.h>
 
 #include <numeric>
+#include <tuple>
 
 namespace {
 
@@ -389,6 +394,53 @@ namespace {
         );
     }
 
+    void QuantizeData(
+        bool allowWriteFiles,
+        const TString& tmpDir,
+        NCB::TFeaturesLayoutPtr featuresLayout,
+        NCB::TDataProviderPtr data,
+        const TQuantizationParamsInfo& quantizedParamsInfo,
+        TLabelConverter* labelConverter,
+        NPar::ILocalExecutor* localExecutor,
+        TRestorableFastRng64* rand,
+        NCatboostOptions::TCatBoostOptions* catBoostOptions,
+        NCB::TQuantizedFeaturesInfoPtr* quantizedFeaturesInfo,
+        NCB::TTrainingDataProviderPtr* result) {
+
+        NCatboostOptions::TBinarizationOptions commonFloatFeaturesBinarization(
+            quantizedParamsInfo.BorderType,
+            quantizedParamsInfo.BinsCount,
+            quantizedParamsInfo.NanMode
+        );
+
+        TVector<ui32> ignoredFeatureNums; // TODO(ilikepugs): MLTOOLS-3838
+        TMaybe<float> targetBorder = catBoostOptions->DataProcessingOptions->TargetBorder;
+
+        *quantizedFeaturesInfo = MakeIntrusive<NCB::TQuantizedFeaturesInfo>(
+            *(featuresLayout.Get()),
+            MakeConstArrayRef(ignoredFeatureNums),
+            commonFloatFeaturesBinarization,
+            /*perFloatFeatureQuantization*/TMap<ui32, NCatboostOptions::TBinarizationOptions>(),
+            /*floatFeaturesAllowNansInTestOnly*/true
+        );
+        // Quantizing training data
+        *result = GetTrainingData(
+            data,
+            /*isLearnData*/ true,
+            /*datasetName*/ TStringBuf(),
+            /*bordersFile*/ Nothing(),  // Already at quantizedFeaturesInfo
+            /*unloadCatFeaturePerfectHashFromRam*/ allowWriteFiles,
+            /*ensureConsecutiveLearnFeaturesDataForCpu*/ true,
+            tmpDir,
+            *quantizedFeaturesInfo,
+            catBoostOptions,
+            labelConverter,
+            &targetBorder,
+            localExecutor,
+            rand
+        );
+    }
+
     bool QuantizeDataIfNeeded(
         bool allowWriteFiles,
         const TString& tmpDir,
@@ -407,37 +459,18 @@ namespace {
             oldQuantizedParamsInfo.BorderType != newQuantizedParamsInfo.BorderType ||
             oldQuantizedParamsInfo.NanMode != newQuantizedParamsInfo.NanMode)
         {
-            NCatboostOptions::TBinarizationOptions commonFloatFeaturesBinarization(
-                newQuantizedParamsInfo.BorderType,
-                newQuantizedParamsInfo.BinsCount,
-                newQuantizedParamsInfo.NanMode
-            );
-
-            TVector<ui32> ignoredFeatureNums; // TODO(ilikepugs): MLTOOLS-3838
-            TMaybe<float> targetBorder = catBoostOptions->DataProcessingOptions->TargetBorder;
-
-            quantizedFeaturesInfo = MakeIntrusive<NCB::TQuantizedFeaturesInfo>(
-                *(featuresLayout.Get()),
-                MakeConstArrayRef(ignoredFeatureNums),
-                commonFloatFeaturesBinarization,
-                /*perFloatFeatureQuantization*/TMap<ui32, NCatboostOptions::TBinarizationOptions>(),
-                /*floatFeaturesAllowNansInTestOnly*/true
-            );
-            // Quantizing training data
-            *result = GetTrainingData(
-                data,
-                /*isLearnData*/ true,
-                /*datasetName*/ TStringBuf(),
-                /*bordersFile*/ Nothing(),  // Already at quantizedFeaturesInfo
-                /*unloadCatFeaturePerfectHashFromRam*/ allowWriteFiles,
-                /*ensureConsecutiveLearnFeaturesDataForCpu*/ true,
+            QuantizeData(
+                allowWriteFiles,
                 tmpDir,
-                quantizedFeaturesInfo,
-                catBoostOptions,
+                featuresLayout,
+                data,
+                newQuantizedParamsInfo,
                 labelConverter,
-                &targetBorder,
                 localExecutor,
-                rand
+                rand,
+                catBoostOptions,
+                &quantizedFeaturesInfo,
+                result
             );
             return true;
         }
@@ -1128,6 +1161,208 @@ namespace {
         }
         return bestParamsSetMetricValue;
     }
+
+    // Quantized and split dataset together with the state produced by its quantization
+    struct TQuantizedTrainTestData {
+        NCB::TTrainingDataProviders TrainTestData;
+        NCB::TQuantizedFeaturesInfoPtr QuantizedFeaturesInfo;
+        TLabelConverter LabelConverter;
+    };
+
+    // Keeps one quantized dataset per quantization params set, so trials which share border_count,
+    // feature_border_type and nan_mode don't requantize the source data.
+    class TQuantizedDataCache {
+    public:
+        TQuantizedDataCache(
+            const TTrainTestSplitParams& trainTestSplitParams,
+            ui64 cpuUsedRamLimit,
+            NCB::TDataProviderPtr data)
+            : TrainTestSplitParams(trainTestSplitParams)
+            , CpuUsedRamLimit(cpuUsedRamLimit)
+            , Data(data)
+        {}
+
+        const TQuantizedTrainTestData& GetOrQuantize(
+            const TQuantizationParamsInfo& quantizationParamsSet,
+            NPar::ILocalExecutor* localExecutor,
+            TRestorableFastRng64* rand,
+            NCatboostOptions::TCatBoostOptions* catBoostOptions) {
+
+            const auto key = std::make_tuple(
+                quantizationParamsSet.BinsCount,
+                quantizationParamsSet.BorderType,
+                quantizationParamsSet.NanMode);
+            if (const auto* cached = Cache.FindPtr(key)) {
+                return *cached;
+            }
+
+            TQuantizedTrainTestData& quantizedData = Cache[key];
+            NCB::TTrainingDataProviderPtr quantizedLearnData;
+            // cat features perfect hash is kept in RAM as concurrent trials share it and its lazy loading
+            // from the file is not thread-safe
+            QuantizeData(
+                /*allowWriteFiles*/ false,
+                /*tmpDir*/ TString(),
+                Data->MetaInfo.FeaturesLayout,
+                Data,
+                quantizationParamsSet,
+                &quantizedData.LabelConverter,
+                localExecutor,
+                rand,
+                catBoostOptions,
+                &quantizedData.QuantizedFeaturesInfo,
+                &quantizedLearnData
+            );
+            quantizedData.TrainTestData = PrepareTrainTestSplit(
+                quantizedLearnData,
+                TrainTestSplitParams,
+                CpuUsedRamLimit,
+                localExecutor
+            );
+            return quantizedData;
+        }
+
+    private:
+        const TTrainTestSplitParams TrainTestSplitParams;
+        const ui64 CpuUsedRamLimit;
+        const NCB::TDataProviderPtr Data;
+        TMap<std::tuple<int, EBorderSelectionType, ENanMode>, TQuantizedTrainTestData> Cache;
+    };
+
+    struct THalvingTrial {
+        TQuantizationParamsInfo QuantizationParamsSet;
+        NJson::TJsonValue ModelParams;
+        NCatboostOptions::TCatBoostOptions CatBoostOptions{ETaskType::CPU};
+        NCatboostOptions::TOutputFilesOptions OutputFileOptions;
+        const TQuantizedTrainTestData* QuantizedData = nullptr;
+        TString LossDescription;
+        int MetricSign = 1;
+
+        // state kept between rounds to continue training instead of starting from scratch
+        THolder<TLearnProgress> LearnProgress;
+        TMetricsAndTimeLeftHistory LastRoundMetricsAndTimeHistory;
+        double MetricValue = 0; // best test loss value over all trained iterations
+        bool IsTrainingStopped = false; // overfitting detector or degenerate solution stopped training
+    };
+
+    class TTrainUpToIterationCallbacks : public ITrainingCallbacks {
+    public:
+        explicit TTrainUpToIterationCallbacks(ui32 iterationCount)
+            : IterationCount(iterationCount)
+        {}
+
+        bool IsContinueTraining(const TMetricsAndTimeLeftHistory& history) override {
+            // history is reset when training is continued from saved learn progress
+            return history.TimeHistory.size() < IterationCount;
+        }
+
+    private:
+        const ui32 IterationCount;
+    };
+
+    ui32 GetTrainedIterationCount(const THalvingTrial& trial) {
+        return trial.LearnProgress ? trial.LearnProgress->GetCompleteModelTreesSize() : 0;
+    }
+
+    void TrainTrialUpToIteration(
+        ui32 iterationCount,
+        const TMaybe<TCustomObjectiveDescriptor>& objectiveDescriptor,
+        const TMaybe<TCustomMetricDescriptor>& evalMetricDescriptor,
+        NPar::ILocalExecutor* localExecutor,
+        THalvingTrial* trial) {
+
+        const ui32 trainedIterationCount = GetTrainedIterationCount(*trial);
+        if (trial->IsTrainingStopped || trainedIterationCount >= iterationCount) {
+            return;
+        }
+
+        TTrainModelInternalOptions internalOptions;
+        internalOptions.CalcMetricsOnly = true;
+        internalOptions.ForceCalcEvalMetricOnEveryIteration = false;
+        internalOptions.OffsetMetricPeriodByInitModelSize = true;
+        const auto callbacks = MakeHolder<TTrainUpToIterationCallbacks>(iterationCount - trainedIterationCount);
+        THolder<IModelTrainer> modelTrainerHolder = THolder<IModelTrainer>(TTrainerFactory::Construct(ETaskType::CPU));
+
+        TEvalResult evalRes;
+        TMetricsAndTimeLeftHistory metricsAndTimeHistory;
+        THolder<TLearnProgress> dstLearnProgress;
+        modelTrainerHolder->TrainModel(
+            internalOptions,
+            trial->CatBoostOptions,
+            trial->OutputFileOptions,
+            objectiveDescriptor,
+            evalMetricDescriptor,
+            trial->QuantizedData->TrainTestData,
+            /*precomputedSingleOnlineCtrDataForSingleFold*/ Nothing(),
+            trial->QuantizedData->LabelConverter,
+            callbacks.Get(),
+            /*initModel*/ Nothing(),
+            std::move(trial->LearnProgress),
+            /*initModelApplyCompatiblePools*/ NCB::TDataProviders(),
+            localExecutor,
+            /*rand*/ Nothing(),
+            /*dstModel*/ nullptr,
+            /*evalResultPtrs*/ {&evalRes},
+            &metricsAndTimeHistory,
+            &dstLearnProgress
+        );
+        trial->LearnProgress = std::move(dstLearnProgress);
+        trial->IsTrainingStopped = GetTrainedIterationCount(*trial) < iterationCount;
+
+        const auto& testBestError = metricsAndTimeHistory.TestBestError;
+        if (!testBestError.empty() && testBestError[0].contains(trial->LossDescription)) {
+            const double roundMetricValue = testBestError[0].at(trial->LossDescription);
+            if (trainedIterationCount == 0
+                || trial->MetricSign * roundMetricValue < trial->MetricSign * trial->MetricValue)
+            {
+                trial->MetricValue = roundMetricValue;
+            }
+        }
+        trial->LastRoundMetricsAndTimeHistory = std::move(metricsAndTimeHistory);
+    }
+
+    // Trials are distributed between concurrentTrials workers, each worker trains its trials
+    // one by one with its own share of threadCount threads.
+    void TrainTrialsUpToIteration(
+        ui32 iterationCount,
+        ui32 concurrentTrials,
+        int threadCount,
+        const TMaybe<TCustomObjectiveDescriptor>& objectiveDescriptor,
+        const TMaybe<TCustomMetricDescriptor>& evalMetricDescriptor,
+        TConstArrayRef<THalvingTrial*> trials,
+        NPar::ILocalExecutor* localExecutor) {
+
+        const int workerCount = Min<int>(concurrentTrials, trials.size());
+        if (workerCount <= 1) {
+            for (auto* trial : trials) {
+                TrainTrialUpToIteration(iterationCount, objectiveDescriptor, evalMetricDescriptor, localExecutor, trial);
+            }
+            return;
+        }
+
+        const int workerThreadCount = Max(1, threadCount / workerCount);
+        NPar::TLocalExecutor workersExecutor;
+        workersExecutor.RunAdditionalThreads(workerCount - 1);
+        workersExecutor.ExecRangeWithThrow(
+            [&] (int workerIdx) {
+                NPar::TLocalExecutor trialExecutor;
+                trialExecutor.RunAdditionalThreads(workerThreadCount - 1);
+                for (size_t trialIdx = workerIdx; trialIdx < trials.size(); trialIdx += workerCount) {
+                    trials[trialIdx]->CatBoostOptions.SystemOptions->NumThreads.Set(workerThreadCount);
+                    TrainTrialUpToIteration(
+                        iterationCount,
+                        objectiveDescriptor,
+                        evalMetricDescriptor,
+                        &trialExecutor,
+                        trials[trialIdx]
+                    );
+                }
+            },
+            0,
+            workerCount,
+            NPar::TLocalExecutor::WAIT_COMPLETE
+        );
+    }
 } // anonymous namespace
 
 namespace NCB {
@@ -1429,4 +1664,233 @@ namespace NCB {
             }
         }
     }
+
+    void SuccessiveHalvingSearch(
+        const THalvingSearchParams& halvingSearchParams,
+        const THashMap<TString, TCustomRandomDistributionGenerator>& randDistGenerators,
+        const NJson::TJsonValue& gridJsonValues,
+        const NJson::TJsonValue& modelJsonParams,
+        const TTrainTestSplitParams& trainTestSplitParams,
+        const TCrossValidationParams& cvParams,
+        const TMaybe<TCustomObjectiveDescriptor>& objectiveDescriptor,
+        const TMaybe<TCustomMetricDescriptor>& evalMetricDescriptor,
+        TDataProviderPtr data,
+        TBestOptionValuesWithCvResult* bestOptionValuesWithCvResult,
+        TMetricsAndTimeLeftHistory* trainTestResult,
+        bool returnCvStat,
+        int verbose) {
+
+        CB_ENSURE(halvingSearchParams.MinIterations > 0, "Successive halving: min iterations should be positive");
+        CB_ENSURE(halvingSearchParams.ReductionFactor > 1, "Successive halving: reduction factor should be greater than 1");
+        CB_ENSURE(halvingSearchParams.ConcurrentTrials > 0, "Successive halving: concurrent trials count should be positive");
+
+        // CatBoost options
+        NJson::TJsonValue jsonParams;
+        NJson::TJsonValue outputJsonParams;
+        NCatboostOptions::PlainJsonToOptions(modelJsonParams, &jsonParams, &outputJsonParams);
+        ConvertParamsToCanonicalFormat(data.Get()->MetaInfo, &jsonParams);
+        NCatboostOptions::TCatBoostOptions catBoostOptions(NCatboostOptions::LoadOptions(jsonParams));
+        NCatboostOptions::TOutputFilesOptions outputFileOptions;
+        outputFileOptions.Load(outputJsonParams);
+        CB_ENSURE(!outputJsonParams["save_snapshot"].GetBoolean(), "Snapshots are not yet supported for successive halving search");
+        CB_ENSURE(catBoostOptions.GetTaskType() == ETaskType::CPU, "Successive halving search is supported only on CPU");
+
+        InitializeEvalMetricIfNotSet(catBoostOptions.MetricOptions->ObjectiveMetric, &catBoostOptions.MetricOptions->EvalMetric);
+        const int threadCount = catBoostOptions.SystemOptions->NumThreads.Get();
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(threadCount - 1);
+
+        NJson::TJsonValue paramGrid;
+        if (gridJsonValues.GetType() == NJson::EJsonValueType::JSON_MAP) {
+            paramGrid = gridJsonValues;
+        } else {
+            paramGrid = gridJsonValues.GetArray()[0];
+        }
+        // Preparing parameters for cartesian product
+        TVector<TDeque<NJson::TJsonValue>> paramPossibleValues; // {border_count, feature_border_type, nan_mode, ...}
+        TGeneralQuatizationParamsInfo generalQuantizeParamsInfo;
+        TVector<TString> paramNames;
+
+        NJson::TJsonValue modelParamsToBeTried(modelJsonParams);
+
+        ParseGridParams(
+            catBoostOptions,
+            &paramGrid,
+            &modelParamsToBeTried,
+            &paramNames,
+            &paramPossibleValues,
+            &generalQuantizeParamsInfo
+        );
+
+        THolder<TProductIteratorBase<TDeque<NJson::TJsonValue>, NJson::TJsonValue>> gridIterator;
+        if (halvingSearchParams.NumberOfTries > 0) {
+            gridIterator = MakeHolder<TRandomizedProductIterator<TDeque<NJson::TJsonValue>, NJson::TJsonValue>>(
+                paramPossibleValues,
+                halvingSearchParams.NumberOfTries,
+                randDistGenerators.size() > 0
+            );
+        } else {
+            gridIterator = MakeHolder<TCartesianProductIterator<TDeque<NJson::TJsonValue>, NJson::TJsonValue>>(
+                paramPossibleValues
+            );
+        }
+
+        const ui64 cpuUsedRamLimit
+            = ParseMemorySizeDescription(catBoostOptions.SystemOptions->CpuUsedRamLimit.Get());
+
+        TRestorableFastRng64 rand(trainTestSplitParams.PartitionRandSeed);
+        if (trainTestSplitParams.Shuffle) {
+            auto objectsGroupingSubset = NCB::Shuffle(data->ObjectsGrouping, 1, &rand);
+            data = data->GetSubset(objectsGroupingSubset, cpuUsedRamLimit, &localExecutor);
+        }
+
+        TQuantizedDataCache quantizedDataCache(trainTestSplitParams, cpuUsedRamLimit, data);
+
+        // Materialize all trials, quantizing data for every new quantization params set
+        TVector<THolder<THalvingTrial>> trials;
+        ui32 maxIterationCount = 0;
+        TConstArrayRef<NJson::TJsonValue> paramsSet;
+        while (gridIterator->Next(&paramsSet)) {
+            // paramsSet: {border_count, feature_border_type, nan_mode, [others]}
+            auto trial = MakeHolder<THalvingTrial>();
+            trial->QuantizationParamsSet.BinsCount = GetRandomValueIfNeeded(paramsSet[0], randDistGenerators).GetInteger();
+            trial->QuantizationParamsSet.BorderType = FromString<EBorderSelectionType>(paramsSet[1].GetString());
+            trial->QuantizationParamsSet.NanMode = FromString<ENanMode>(paramsSet[2].GetString());
+
+            trial->ModelParams = modelParamsToBeTried;
+            AssignOptionsToJson(
+                TConstArrayRef<TString>(paramNames),
+                TConstArrayRef<NJson::TJsonValue>(
+                    paramsSet.begin() + IndexOfFirstTrainingParameter,
+                    paramsSet.end()
+                ), // Ignoring quantization params
+                randDistGenerators,
+                &trial->ModelParams
+            );
+
+            bool areParamsValid = ParseJsonParams(
+                data.Get()->MetaInfo,
+                trial->ModelParams,
+                &trial->CatBoostOptions,
+                &trial->OutputFileOptions
+            );
+            if (!areParamsValid) {
+                continue;
+            }
+            InitializeEvalMetricIfNotSet(
+                trial->CatBoostOptions.MetricOptions->ObjectiveMetric,
+                &trial->CatBoostOptions.MetricOptions->EvalMetric);
+            UpdateSampleRateOption(data->GetObjectCount(), &trial->CatBoostOptions);
+            trial->OutputFileOptions.SetAllowWriteFiles(false);
+
+            {
+                TSetLogging inThisScope(trial->CatBoostOptions.LoggingLevel);
+                trial->QuantizedData = &quantizedDataCache.GetOrQuantize(
+                    trial->QuantizationParamsSet,
+                    &localExecutor,
+                    &rand,
+                    &trial->CatBoostOptions
+                );
+            }
+
+            ui32 approxDimension = NCB::GetApproxDimension(
+                trial->CatBoostOptions,
+                trial->QuantizedData->LabelConverter,
+                data->RawTargetData.GetTargetDimension());
+            const TVector<THolder<IMetric>> metrics = CreateMetrics(
+                trial->CatBoostOptions.MetricOptions,
+                evalMetricDescriptor,
+                approxDimension,
+                data->MetaInfo.HasWeights
+            );
+            trial->LossDescription = metrics[0]->GetDescription();
+            trial->MetricSign = GetSignForMetricMinimization(metrics[0]);
+            maxIterationCount = Max(maxIterationCount, trial->CatBoostOptions.BoostingOptions->IterationCount.Get());
+            trials.push_back(std::move(trial));
+        }
+        CB_ENSURE(!trials.empty(), "Successive halving: no valid parameter sets in the grid");
+
+        TVector<THalvingTrial*> roundTrials;
+        for (const auto& trial : trials) {
+            roundTrials.push_back(trial.Get());
+        }
+        ui64 roundIterationCount = halvingSearchParams.MinIterations;
+        for (ui32 roundIdx = 0; ; ++roundIdx) {
+            const ui32 iterationCount = Min<ui64>(roundIterationCount, maxIterationCount);
+            if (verbose) {
+                TSetLogging inThisScope(ELoggingLevel::Verbose);
+                CATBOOST_NOTICE_LOG << "Successive halving round #" << roundIdx << ": "
+                    << roundTrials.size() << " parameter sets, " << iterationCount << " iterations" << Endl;
+            }
+            {
+                // trials could be trained concurrently, so logging level is set once for all of them
+                TSetLoggingSilent silentMode;
+                TrainTrialsUpToIteration(
+                    iterationCount,
+                    halvingSearchParams.ConcurrentTrials,
+                    threadCount,
+                    objectiveDescriptor,
+                    evalMetricDescriptor,
+                    roundTrials,
+                    &localExecutor
+                );
+            }
+            StableSort(
+                roundTrials,
+                [] (const THalvingTrial* lhs, const THalvingTrial* rhs) {
+                    return lhs->MetricSign * lhs->MetricValue < rhs->MetricSign * rhs->MetricValue;
+                }
+            );
+            if (verbose) {
+                TSetLogging inThisScope(ELoggingLevel::Verbose);
+                CATBOOST_NOTICE_LOG << "Successive halving round #" << roundIdx << ": best "
+                    << roundTrials[0]->LossDescription << " = " << roundTrials[0]->MetricValue << Endl;
+            }
+
+            const bool areAllTrialsStopped = AllOf(
+                roundTrials,
+                [=] (const THalvingTrial* trial) {
+                    return trial->IsTrainingStopped || GetTrainedIterationCount(*trial) >= maxIterationCount;
+                }
+            );
+            if (roundTrials.size() == 1 || iterationCount >= maxIterationCount || areAllTrialsStopped) {
+                break;
+            }
+            roundTrials.resize(Max<size_t>(1, roundTrials.size() / halvingSearchParams.ReductionFactor));
+            roundIterationCount *= halvingSearchParams.ReductionFactor;
+            // learn progress of eliminated trials is not needed anymore
+            for (auto& trial : trials) {
+                if (!IsIn(roundTrials, trial.Get())) {
+                    trial->LearnProgress.Reset();
+                }
+            }
+        }
+
+        const THalvingTrial& bestTrial = *roundTrials[0];
+        TGridParamsInfo bestGridParams;
+        bestGridParams.QuantizationParamsSet = bestTrial.QuantizationParamsSet;
+        bestGridParams.QuantizationParamsSet.GeneralInfo = generalQuantizeParamsInfo;
+        bestGridParams.OthersParamsSet = bestTrial.ModelParams;
+        bestGridParams.QuantizedFeatureInfo = bestTrial.QuantizedData->QuantizedFeaturesInfo;
+        bestGridParams.GridParamNames = paramNames;
+        *trainTestResult = bestTrial.LastRoundMetricsAndTimeHistory;
+        trials.clear();
+
+        SetGridParamsToBestOptionValues(bestGridParams, bestOptionValuesWithCvResult);
+        if (returnCvStat) {
+            if (verbose) {
+                TSetLogging inThisScope(ELoggingLevel::Verbose);
+                CATBOOST_NOTICE_LOG << "Estimating final quality...\n";
+            }
+            CrossValidate(
+                bestGridParams.OthersParamsSet,
+                bestGridParams.QuantizedFeatureInfo,
+                objectiveDescriptor,
+                evalMetricDescriptor,
+                data,
+                cvParams,
+                &(bestOptionValuesWithCvResult->CvResult)
+            );
+        }
+    }
 }
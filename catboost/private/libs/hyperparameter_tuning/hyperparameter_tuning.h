@@ -44,6 +44,21 @@ namespace NCB {
             const TVector<TString>& optionsNames);
     };
 
+    struct THalvingSearchParams {
+        // Number of parameter sets sampled from the grid, 0 means all grid points
+        ui32 NumberOfTries = 0;
+
+        // Iterations trained by every parameter set in the first round
+        ui32 MinIterations = 100;
+
+        // Each round keeps the best 1/ReductionFactor parameter sets and trains them ReductionFactor times longer
+        // (up to the iterations option), continuing from the learn progress saved in the previous round
+        ui32 ReductionFactor = 3;
+
+        // Parameter sets trained concurrently within a round, thread_count is split evenly between them
+        ui32 ConcurrentTrials = 1;
+    };
+
     void GridSearch(
         const NJson::TJsonValue& gridJsonValues,
         const NJson::TJsonValue& modelJsonParams,
@@ -73,4 +88,24 @@ namespace NCB {
         bool isSearchUsingTrainTestSplit = true,
         bool returnCvStat = true,
         int verbose = 1);
+
+    /*
+     * Successive halving search over the grid (grid points or random tries) on a train-test split.
+     * Quantized datasets are cached per quantization params set for the whole search.
+     * trainTestResult contains metrics of the last round of the best parameter set.
+     */
+    void SuccessiveHalvingSearch(
+        const THalvingSearchParams& halvingSearchParams,
+        const THashMap<TString, TCustomRandomDistributionGenerator>& randDistGenerators,
+        const NJson::TJsonValue& gridJsonValues,
+        const NJson::TJsonValue& modelJsonParams,
+        const TTrainTestSplitParams& trainTestSplitParams,
+        const TCrossValidationParams& cvParams,
+        const TMaybe<TCustomObjectiveDescriptor>& objectiveDescriptor,
+        const TMaybe<TCustomMetricDescriptor>& evalMetricDescriptor,
+        TDataProviderPtr data,
+        TBestOptionValuesWithCvResult* bestOptionValuesWithCvResult,
+        TMetricsAndTimeLeftHistory* trainTestResult,
+        bool returnCvStat = true,
+        int verbose = 1);
 }
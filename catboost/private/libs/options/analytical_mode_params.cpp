@@ -23,7 +23,10 @@ TString NCB::BuildModelFormatHelpMessage() {
 void NCB::TAnalyticalModeCommonParams::BindParserOpts(NLastGetopt::TOpts& parser) {
     DatasetReadingParams.BindParserOpts(&parser);
     BindModelFileParams(&parser, &ModelFileName, &ModelFormat);
-    parser.AddLongOption('o', "output-path", "output result path")
+    parser.AddLongOption(
+        'o',
+        "output-path",
+        "output result path, calc also supports binary npy://, raw-f32://, raw-f64:// and arrow:// schemes")
         .DefaultValue("output.tsv")
         .Handler1T<TStringBuf>([&](const TStringBuf& pathWithScheme) {
             OutputPath = TPathWithScheme(pathWithScheme, "dsv");
@@ -591,6 +591,12 @@ void NCatboostOptions::TCatBoostOptions::Validate() const {
             CB_ENSURE(lossFunction == ELossFunction::YetiRankPairwise,
                       "sampling_unit option on GPU is supported only for loss function YetiRankPairwise");
         }
+
+        if (lossFunction == ELossFunction::YetiRank || lossFunction == ELossFunction::YetiRankPairwise) {
+            CB_ENSURE(
+                !LossFunctionDescription->GetLossParamsMap().contains("top"),
+                "top parameter of " << lossFunction << " is supported only on CPU");
+        }
     }
 
     CB_ENSURE(!(IsPlainOnlyModeLoss(lossFunction) && (BoostingOptions->BoostingType == EBoostingType::Ordered)),
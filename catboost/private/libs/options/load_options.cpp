@@ -74,7 +74,7 @@ void NCatboostOptions::ValidatePoolParams(
     const TColumnarPoolFormatParams& poolFormatParams
 ) {
     CB_ENSURE(
-        poolPath.Scheme == "dsv" || !poolFormatParams.DsvFormat.HasHeader,
+        poolPath.GetFormat() == "dsv" || !poolFormatParams.DsvFormat.HasHeader,
         "HasHeader parameter supported for \"dsv\" pools only."
     );
 }
@@ -180,6 +180,15 @@ double NCatboostOptions::GetYetiRankDecay(const TLossDescription& lossFunctionCo
     return GetParamOrDefault(lossFunctionConfig, "decay", 0.99);
 }
 
+int NCatboostOptions::GetYetiRankTopSize(const TLossDescription& lossFunctionConfig) {
+    Y_ASSERT(
+        lossFunctionConfig.GetLossFunction() == ELossFunction::YetiRank ||
+        lossFunctionConfig.GetLossFunction() == ELossFunction::YetiRankPairwise);
+    const int topSize = GetParamOrDefault(lossFunctionConfig, "top", -1);
+    CB_ENSURE(topSize == -1 || topSize > 1, "YetiRank top should be -1 (all positions) or greater than 1");
+    return topSize;
+}
+
 double NCatboostOptions::GetLqParam(const TLossDescription& lossFunctionConfig) {
     Y_ASSERT(lossFunctionConfig.GetLossFunction() == ELossFunction::Lq);
     const auto& lossParams = lossFunctionConfig.GetLossParamsMap();
@@ -122,6 +122,9 @@ namespace NCatboostOptions {
 
     double GetYetiRankDecay(const TLossDescription& lossFunctionConfig);
 
+    // number of leading positions of each sampled permutation which generate pairs, -1 means all
+    int GetYetiRankTopSize(const TLossDescription& lossFunctionConfig);
+
     double GetLqParam(const TLossDescription& lossFunctionConfig);
 
     double GetHuberParam(const TLossDescription& lossFunctionConfig);
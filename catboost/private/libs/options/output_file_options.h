@@ -95,6 +95,12 @@ namespace NCatboostOptions {
 
         TString GetRocOutputPath() const;
 
+        // empty if chrome trace of training is not requested
+        TString CreateChromeTraceFullPath() const;
+
+        // empty if learn and test approxes of the final model should not be cached
+        TString CreateApproxCacheFullPath() const;
+
         void SetAllowWriteFiles(bool flag) {
             AllowWriteFilesFlag.Set(flag);
         }
@@ -155,5 +161,7 @@ namespace NCatboostOptions {
         TOption<TVector<EPredictionType>> PredictionTypes;
         TOption<TVector<TString>> OutputColumns;
         TOption<TString> RocOutputPath;
+        TOption<TString> ChromeTracePath;
+        TOption<TString> ApproxCachePath;
     };
 }
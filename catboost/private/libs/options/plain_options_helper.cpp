@@ -308,6 +308,8 @@ void NCatboostOptions::PlainJsonToOptions(
     CopyOption(plainOptions, "model_format",  &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "output_borders",  &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "roc_file",  &outputFilesJson, &seenKeys);
+    CopyOption(plainOptions, "chrome_trace_file",  &outputFilesJson, &seenKeys);
+    CopyOption(plainOptions, "approx_cache_file",  &outputFilesJson, &seenKeys);
 
 
     //boosting options
@@ -455,6 +457,8 @@ void NCatboostOptions::PlainJsonToOptions(
     systemOptions.SetType(NJson::JSON_MAP);
 
     CopyOption(plainOptions, "thread_count", &systemOptions, &seenKeys);
+    CopyOption(plainOptions, "work_stealing", &systemOptions, &seenKeys);
+    CopyOption(plainOptions, "pin_threads", &systemOptions, &seenKeys);
     CopyOptionWithNewKey(plainOptions, "device_config", "devices", &systemOptions, &seenKeys);
     CopyOption(plainOptions, "devices", &systemOptions, &seenKeys);
     CopyOption(plainOptions, "used_ram_limit", &systemOptions, &seenKeys);
@@ -559,6 +563,8 @@ void NCatboostOptions::ConvertOptionsToPlainJson(
     DeleteSeenOption(&outputoptionsCopy, "model_format");
     DeleteSeenOption(&outputoptionsCopy, "output_borders");
     DeleteSeenOption(&outputoptionsCopy, "roc_file");
+    DeleteSeenOption(&outputoptionsCopy, "chrome_trace_file");
+    DeleteSeenOption(&outputoptionsCopy, "approx_cache_file");
     CB_ENSURE(outputoptionsCopy.GetMapSafe().empty(), "output_options: key " + outputoptionsCopy.GetMapSafe().begin()->first + " wasn't added to plain options.");
 
     // boosting options
@@ -905,6 +911,12 @@ void NCatboostOptions::ConvertOptionsToPlainJson(
         CopyOption(systemOptions, "thread_count", &plainOptionsJson, &seenKeys);
         DeleteSeenOption(&optionsCopySystemOptions, "thread_count");
 
+        CopyOption(systemOptions, "work_stealing", &plainOptionsJson, &seenKeys);
+        DeleteSeenOption(&optionsCopySystemOptions, "work_stealing");
+
+        CopyOption(systemOptions, "pin_threads", &plainOptionsJson, &seenKeys);
+        DeleteSeenOption(&optionsCopySystemOptions, "pin_threads");
+
         CopyOption(systemOptions, "devices", &plainOptionsJson, &seenKeys);
         DeleteSeenOption(&optionsCopySystemOptions, "devices");
 
@@ -971,6 +983,8 @@ void NCatboostOptions::CleanPlainJson(
     // options with no influence on the final model
     DeleteSeenOption(plainOptionsJsonEfficient, "objective_metric");
     DeleteSeenOption(plainOptionsJsonEfficient, "thread_count");
+    DeleteSeenOption(plainOptionsJsonEfficient, "work_stealing");
+    DeleteSeenOption(plainOptionsJsonEfficient, "pin_threads");
     DeleteSeenOption(plainOptionsJsonEfficient, "allow_const_label");
     DeleteSeenOption(plainOptionsJsonEfficient, "detailed_profile");
     DeleteSeenOption(plainOptionsJsonEfficient, "logging_level");
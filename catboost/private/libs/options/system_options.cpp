@@ -10,6 +10,8 @@ using namespace NCatboostOptions;
 
 TSystemOptions::TSystemOptions(ETaskType taskType)
     : NumThreads("thread_count", NSystemInfo::CachedNumberOfCpus())
+    , WorkStealing("work_stealing", false, taskType)
+    , PinThreads("pin_threads", false, taskType)
     , CpuUsedRamLimit("used_ram_limit", {})
     , Devices("devices", "-1", taskType)
     , GpuRamPart("gpu_ram_part", 0.95, taskType)
@@ -24,17 +26,17 @@ TSystemOptions::TSystemOptions(ETaskType taskType)
 }
 
 void TSystemOptions::Load(const NJson::TJsonValue& options) {
-    CheckedLoad(options, &NumThreads, &CpuUsedRamLimit, &Devices, &GpuRamPart, &PinnedMemorySize, &NodeType, &FileWithHosts, &NodePort);
+    CheckedLoad(options, &NumThreads, &WorkStealing, &PinThreads, &CpuUsedRamLimit, &Devices, &GpuRamPart, &PinnedMemorySize, &NodeType, &FileWithHosts, &NodePort);
 }
 
 void TSystemOptions::Save(NJson::TJsonValue* options) const {
-    SaveFields(options, NumThreads, CpuUsedRamLimit, Devices, GpuRamPart, PinnedMemorySize, NodeType, FileWithHosts, NodePort);
+    SaveFields(options, NumThreads, WorkStealing, PinThreads, CpuUsedRamLimit, Devices, GpuRamPart, PinnedMemorySize, NodeType, FileWithHosts, NodePort);
 }
 
 bool TSystemOptions::operator==(const TSystemOptions& rhs) const {
-    return std::tie(NumThreads, CpuUsedRamLimit, Devices,
+    return std::tie(NumThreads, WorkStealing, PinThreads, CpuUsedRamLimit, Devices,
                     GpuRamPart, PinnedMemorySize, NodeType, FileWithHosts, NodePort) ==
-           std::tie(rhs.NumThreads, rhs.CpuUsedRamLimit, rhs.Devices,
+           std::tie(rhs.NumThreads, rhs.WorkStealing, rhs.PinThreads, rhs.CpuUsedRamLimit, rhs.Devices,
                     rhs.GpuRamPart, rhs.PinnedMemorySize, rhs.NodeType, rhs.FileWithHosts, rhs.NodePort);
 }
 
@@ -21,6 +21,8 @@ namespace NCatboostOptions {
         void Validate() const;
 
         TOption<ui32> NumThreads;
+        TCpuOnlyOption<bool> WorkStealing;
+        TCpuOnlyOption<bool> PinThreads;
         TOption<TString> CpuUsedRamLimit;
         TGpuOnlyOption<TString> Devices;
         TGpuOnlyOption<double> GpuRamPart;
@@ -5,6 +5,7 @@
 #include <catboost/private/libs/options/enums.h>
 #include <catboost/private/libs/options/system_options.h>
 #include <catboost/private/libs/options/catboost_options.h>
+#include <catboost/private/libs/options/plain_options_helper.h>
 
 Y_UNIT_TEST_SUITE(TOptionsTest) {
     using namespace NCatboostOptions;
@@ -129,4 +130,20 @@ Y_UNIT_TEST_SUITE(TOptionsTest) {
         options.SetNotSpecifiedOptionsToDefaults();
         TestSaveLoad(options, ETaskType::GPU);
     }
+
+    Y_UNIT_TEST(TestYetiRankTopIsCpuOnly) {
+        for (auto taskType : {ETaskType::CPU, ETaskType::GPU}) {
+            NJson::TJsonValue plainOptions;
+            plainOptions["loss_function"] = "YetiRank:top=10";
+            plainOptions["task_type"] = ToString(taskType);
+            NJson::TJsonValue catBoostOptions;
+            NJson::TJsonValue outputOptions;
+            PlainJsonToOptions(plainOptions, &catBoostOptions, &outputOptions);
+            if (taskType == ETaskType::CPU) {
+                UNIT_ASSERT_NO_EXCEPTION(LoadOptions(catBoostOptions));
+            } else {
+                UNIT_ASSERT_EXCEPTION_CONTAINS(LoadOptions(catBoostOptions), TCatBoostException, "supported only on CPU");
+            }
+        }
+    }
 }
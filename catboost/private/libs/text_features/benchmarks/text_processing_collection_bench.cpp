@@ -0,0 +1,97 @@
+#include <catboost/private/libs/text_features/text_processing_collection.h>
+#include <catboost/private/libs/text_features/ut/lib/text_features_data.h>
+
+#include <library/cpp/testing/benchmark/bench.h>
+
+#include <util/generic/singleton.h>
+#include <util/generic/xrange.h>
+
+using namespace NCB;
+using namespace NCBTest;
+
+namespace {
+    struct TBenchData {
+        TIntrusivePtr<TTextProcessingCollection> Collection;
+        TVector<TString> Texts;
+        TVector<ui32> TextFeatureIds;
+
+        TBenchData() {
+            TVector<TTextFeature> features;
+            TVector<TTokenizedTextFeature> tokenizedFeatures;
+            TVector<TDigitizer> digitizers;
+            TVector<TTextFeatureCalcerPtr> calcers;
+            TVector<TVector<ui32>> perFeatureDigitizers;
+            TVector<TVector<ui32>> perTokenizedFeatureCalcers;
+            CreateTextDataForTest(
+                &features,
+                &tokenizedFeatures,
+                &digitizers,
+                &calcers,
+                &perFeatureDigitizers,
+                &perTokenizedFeatureCalcers
+            );
+            Collection = MakeIntrusive<TTextProcessingCollection>(
+                digitizers,
+                calcers,
+                perFeatureDigitizers,
+                perTokenizedFeatureCalcers
+            );
+
+            const ui32 docCount = 10000;
+            const auto& sourceTexts = features[0];
+            Texts.reserve(docCount);
+            for (ui32 docId : xrange(docCount)) {
+                Texts.push_back(sourceTexts[docId % sourceTexts.size()]);
+            }
+            TextFeatureIds = {0};
+        }
+    };
+}
+
+static const TBenchData& GetBenchData() {
+    return *Singleton<TBenchData>();
+}
+
+template <class TCalcBlock>
+static void ProcessInBlocks(const TBenchData& data, ui32 blockSize, TCalcBlock&& calcBlock) {
+    const ui32 docCount = data.Texts.size();
+    TVector<float> result(data.Collection->TotalNumberOfOutputFeatures() * blockSize);
+    for (ui32 blockStart = 0; blockStart < docCount; blockStart += blockSize) {
+        const ui32 blockDocCount = Min(blockSize, docCount - blockStart);
+        calcBlock(
+            [&data, blockStart](ui32 /*textFeatureId*/, ui32 docId) {
+                return TStringBuf(data.Texts[blockStart + docId]);
+            },
+            blockDocCount,
+            MakeArrayRef(result)
+        );
+        Y_DO_NOT_OPTIMIZE_AWAY(result.data());
+    }
+}
+
+Y_CPU_BENCHMARK(TextFeaturesPerDocument, iface) {
+    const auto& data = GetBenchData();
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        ProcessInBlocks(
+            data,
+            /*blockSize*/ 1,
+            [&data](auto accessor, ui32 docCount, TArrayRef<float> result) {
+                data.Collection->CalcFeatures(accessor, data.TextFeatureIds, docCount, result);
+            }
+        );
+    }
+}
+
+Y_CPU_BENCHMARK(TextFeaturesInBlocks, iface) {
+    const auto& data = GetBenchData();
+    TTextProcessingBlockBuffers buffers;
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        ProcessInBlocks(
+            data,
+            /*blockSize*/ 128,
+            [&data, &buffers](auto accessor, ui32 docCount, TArrayRef<float> result) {
+                data.Collection->CalcFeatures(accessor, data.TextFeatureIds, docCount, result, &buffers);
+            }
+        );
+    }
+}
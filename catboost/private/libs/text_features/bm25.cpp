@@ -2,6 +2,9 @@
 
 #include <catboost/private/libs/text_features/flatbuffers/feature_calcers.fbs.h>
 
+#include <library/cpp/sse/sse.h>
+
+#include <util/generic/xrange.h>
 #include <util/generic/ymath.h>
 
 using namespace NCB;
@@ -17,39 +20,90 @@ static inline ui32 NonZeros(TConstArrayRef<T> arr) {
     return result;
 }
 
-static inline double CalcTruncatedInvClassFreq(TConstArrayRef<ui32> inClassFreq, double eps) {
-    double classesWithTerm = NonZeros(inClassFreq);
-    const auto numClasses = inClassFreq.size();
+static inline double CalcTruncatedInvClassFreq(ui32 classesWithTerm, ui32 numClasses, double eps) {
     return Max<double>(log(numClasses - classesWithTerm + 0.5) - log(classesWithTerm + 0.5), eps);
 }
 
-static inline void ExtractTermFreq(TConstArrayRef<TDenseHash<TTokenId, ui32>> freq,
-                                   TTokenId term,
-                                   TArrayRef<ui32> termFreq) {
-    for (ui32 clazz = 0; clazz < freq.size(); ++clazz) {
-        const auto& classFreqTable = freq[clazz];
-        auto termFreqIt = classFreqTable.find(term);
-        termFreq[clazz] = termFreqIt != classFreqTable.end() ? termFreqIt->second : 0;
+static inline double Score(double termFreq, double k, double classLengthNorm) {
+    return termFreq * (k + 1) / (termFreq + classLengthNorm);
+}
+
+static inline void AddTermScores(
+    TConstArrayRef<ui32> termFreqInClass,
+    TConstArrayRef<double> classLengthNorms,
+    double inverseClassFreq,
+    double k,
+    TArrayRef<double> scores
+) {
+    const ui32 numClasses = scores.size();
+    ui32 clazz = 0;
+#ifdef _sse2_
+    const __m128d kPlusOne = _mm_set1_pd(k + 1);
+    const __m128d invClassFreq = _mm_set1_pd(inverseClassFreq);
+    for (; clazz + 2 <= numClasses; clazz += 2) {
+        const __m128d termFreq = _mm_cvtepi32_pd(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(termFreqInClass.data() + clazz))
+        );
+        const __m128d score = _mm_div_pd(
+            _mm_mul_pd(termFreq, kPlusOne),
+            _mm_add_pd(termFreq, _mm_loadu_pd(classLengthNorms.data() + clazz))
+        );
+        const __m128d prevScores = _mm_loadu_pd(scores.data() + clazz);
+        _mm_storeu_pd(scores.data() + clazz, _mm_add_pd(prevScores, _mm_mul_pd(invClassFreq, score)));
+    }
+#endif
+    for (; clazz < numClasses; ++clazz) {
+        scores[clazz] += inverseClassFreq * Score(termFreqInClass[clazz], k, classLengthNorms[clazz]);
     }
 }
 
-static inline double Score(double termFreq, double k, double b, double meanLength, double classLength) {
-    return termFreq * (k + 1) / (termFreq + k * (1.0 - b + b * meanLength / classLength));
+TVector<double> TBM25::CalcClassLengthNorms() const {
+    const double meanClassLength = TotalTokens * 1.0 / NumClasses;
+    TVector<double> classLengthNorms;
+    classLengthNorms.yresize(NumClasses);
+    for (ui32 clazz = 0; clazz < NumClasses; ++clazz) {
+        classLengthNorms[clazz] = K * (1.0 - B + B * meanClassLength / ClassTotalTokens[clazz]);
+    }
+    return classLengthNorms;
 }
 
-void TBM25::Compute(const TText& text, TOutputFloatIterator iterator) const {
-    TVector<ui32> termFreqInClass(NumClasses);
-    TVector<double> scores(NumClasses);
+TVector<double> TBM25::CalcUnseenTermScores(TConstArrayRef<double> classLengthNorms) const {
+    const double inverseClassFreq = CalcTruncatedInvClassFreq(/*classesWithTerm*/ 0, NumClasses, TruncateBorder);
+    TVector<double> unseenTermScores;
+    unseenTermScores.yresize(NumClasses);
+    for (ui32 clazz = 0; clazz < NumClasses; ++clazz) {
+        unseenTermScores[clazz] = inverseClassFreq * Score(/*termFreq*/ 0, K, classLengthNorms[clazz]);
+    }
+    return unseenTermScores;
+}
 
-    for (const auto& tokenToCount : text) {
-        ExtractTermFreq(Frequencies, tokenToCount.Token(), termFreqInClass);
-        double inverseClassFreq = CalcTruncatedInvClassFreq(termFreqInClass, TruncateBorder);
-        double meanClassLength = TotalTokens * 1.0 / NumClasses;
+void TBM25::CalcScores(
+    const TText& text,
+    TConstArrayRef<double> classLengthNorms,
+    TConstArrayRef<double> unseenTermScores,
+    TArrayRef<double> scores
+) const {
+    Fill(scores.begin(), scores.end(), 0.0);
 
-        for (ui32 clazz = 0; clazz < NumClasses; ++clazz) {
-            scores[clazz] += inverseClassFreq * Score(termFreqInClass[clazz], K, B, meanClassLength,  ClassTotalTokens[clazz]);
+    for (const auto& tokenToCount : text) {
+        const auto termFreqInClass = Frequencies.GetClassCounts(tokenToCount.Token());
+        if (termFreqInClass.empty()) {
+            for (ui32 clazz = 0; clazz < NumClasses; ++clazz) {
+                scores[clazz] += unseenTermScores[clazz];
+            }
+            continue;
         }
+        const double inverseClassFreq = CalcTruncatedInvClassFreq(NonZeros(termFreqInClass), NumClasses, TruncateBorder);
+        AddTermScores(termFreqInClass, classLengthNorms, inverseClassFreq, K, scores);
     }
+}
+
+void TBM25::Compute(const TText& text, TOutputFloatIterator iterator) const {
+    const TVector<double> classLengthNorms = CalcClassLengthNorms();
+    const TVector<double> unseenTermScores = CalcUnseenTermScores(classLengthNorms);
+
+    TVector<double> scores(NumClasses);
+    CalcScores(text, classLengthNorms, unseenTermScores, scores);
 
     ForEachActiveFeature(
         [&scores, &iterator](ui32 featureId){
@@ -59,6 +113,27 @@ void TBM25::Compute(const TText& text, TOutputFloatIterator iterator) const {
     );
 }
 
+void TBM25::ComputeBlock(TConstArrayRef<TText> texts, TArrayRef<float> result) const {
+    const ui64 docCount = texts.size();
+    Y_ASSERT(result.size() >= docCount * FeatureCount());
+
+    const TVector<double> classLengthNorms = CalcClassLengthNorms();
+    const TVector<double> unseenTermScores = CalcUnseenTermScores(classLengthNorms);
+
+    TVector<double> scores(NumClasses);
+    for (ui64 docId = 0; docId < docCount; ++docId) {
+        CalcScores(texts[docId], classLengthNorms, unseenTermScores, scores);
+
+        float* docResult = result.data() + docId;
+        ForEachActiveFeature(
+            [&scores, &docResult, docCount](ui32 featureId){
+                *docResult = scores[featureId];
+                docResult += docCount;
+            }
+        );
+    }
+}
+
 TTextFeatureCalcer::TFeatureCalcerFbs TBM25::SaveParametersToFB(flatbuffers::FlatBufferBuilder& builder) const {
     using namespace NCatBoostFbs;
 
@@ -97,23 +172,38 @@ void TBM25::LoadParametersFromFB(const NCatBoostFbs::TFeatureCalcer* calcer) {
 }
 
 void TBM25::SaveLargeParameters(IOutputStream* stream) const {
-    ::Save(stream, Frequencies);
+    Frequencies.Save(stream);
 }
 
 void TBM25::LoadLargeParameters(IInputStream* stream) {
-    ::Load(stream, Frequencies);
+    Frequencies.Load(stream);
+    CB_ENSURE(
+        Frequencies.GetClassCount() == NumClasses,
+        "Failed to deserialize: BM25 token frequencies don't match number of classes"
+    );
 }
 
 void TBM25Visitor::Update(ui32 classId, const TText& text, TTextFeatureCalcer* calcer) {
     auto bm25 = dynamic_cast<TBM25*>(calcer);
     Y_ASSERT(bm25);
 
-    auto& classCounts = bm25->Frequencies[classId];
-
     for (const auto& tokenToCount : text) {
         const ui32 count = tokenToCount.Count();
-        classCounts[tokenToCount.Token()] += count;
+        bm25->Frequencies.Add(classId, tokenToCount.Token(), count);
         bm25->ClassTotalTokens[classId] += count;
         bm25->TotalTokens += count;
     }
 }
+
+void TBM25Visitor::Merge(const TTextFeatureCalcer& srcCalcer, TTextFeatureCalcer* dstCalcer) const {
+    auto srcBm25 = dynamic_cast<const TBM25*>(&srcCalcer);
+    auto dstBm25 = dynamic_cast<TBM25*>(dstCalcer);
+    Y_ASSERT(srcBm25 && dstBm25);
+
+    // TotalTokens of the initial state is 1, so add only tokens counted by Update
+    for (auto classId : xrange(dstBm25->NumClasses)) {
+        dstBm25->ClassTotalTokens[classId] += srcBm25->ClassTotalTokens[classId];
+        dstBm25->TotalTokens += srcBm25->ClassTotalTokens[classId];
+    }
+    dstBm25->Frequencies.Add(srcBm25->Frequencies);
+}
@@ -1,8 +1,7 @@
 #pragma once
 
 #include "feature_calcer.h"
-
-#include <library/cpp/containers/dense_hash/dense_hash.h>
+#include "term_class_frequencies.h"
 #include <util/system/types.h>
 #include <util/generic/fwd.h>
 
@@ -43,11 +42,22 @@ namespace NCB {
         }
 
         void Compute(const TText& text, TOutputFloatIterator iterator) const override;
+        void ComputeBlock(TConstArrayRef<TText> texts, TArrayRef<float> result) const override;
 
         static ui32 BaseFeatureCount(ui32 numClasses) {
             return numClasses;
         }
 
+    private:
+        TVector<double> CalcClassLengthNorms() const;
+        TVector<double> CalcUnseenTermScores(TConstArrayRef<double> classLengthNorms) const;
+        void CalcScores(
+            const TText& text,
+            TConstArrayRef<double> classLengthNorms,
+            TConstArrayRef<double> unseenTermScores,
+            TArrayRef<double> scores
+        ) const;
+
     private:
         ui32 NumClasses;
         double K;
@@ -56,7 +66,7 @@ namespace NCB {
 
         ui64 TotalTokens;
         TVector<ui64> ClassTotalTokens;
-        TVector<TDenseHash<TTokenId, ui32>> Frequencies;
+        TTermClassFrequencies Frequencies;
 
     protected:
         TTextFeatureCalcer::TFeatureCalcerFbs SaveParametersToFB(flatbuffers::FlatBufferBuilder& builder) const override;
@@ -71,5 +81,11 @@ namespace NCB {
     class TBM25Visitor final : public ITextCalcerVisitor {
     public:
         void Update(ui32 classId, const TText& text, TTextFeatureCalcer* bm25) override;
+
+        bool IsMergeable() const override {
+            return true;
+        }
+
+        void Merge(const TTextFeatureCalcer& srcBm25, TTextFeatureCalcer* dstBm25) const override;
     };
 }
@@ -76,6 +76,13 @@ namespace NCB {
         LoadLargeParameters(stream);
     }
 
+    void TTextFeatureCalcer::ComputeBlock(TConstArrayRef<TText> texts, TArrayRef<float> result) const {
+        const ui64 docCount = texts.size();
+        for (ui64 docId = 0; docId < docCount; ++docId) {
+            Compute(texts[docId], TOutputFloatIterator(result.data() + docId, docCount, result.size()));
+        }
+    }
+
     TTextFeatureCalcer::TFeatureCalcerFbs TTextFeatureCalcer::SaveParametersToFB(flatbuffers::FlatBufferBuilder&) const {
         Y_FAIL("Serialization to flatbuffer is not implemented");
     }
@@ -85,6 +85,12 @@ namespace NCB {
             return result;
         }
 
+        /*
+         * Computes features for a block of texts, result is feature-major:
+         * feature featureIdx of document docId is stored in result[featureIdx * texts.size() + docId]
+         */
+        virtual void ComputeBlock(TConstArrayRef<TText> texts, TArrayRef<float> result) const;
+
         void Save(IOutputStream* stream) const final;
         void Load(IInputStream* stream) final;
 
@@ -158,6 +164,20 @@ namespace NCB {
     class ITextCalcerVisitor : public TThrRefBase {
     public:
         virtual void Update(ui32 classId, const TText& text, TTextFeatureCalcer* featureCalcer) = 0;
+
+        /*
+         * true if statistics accumulated by Update are additive, so a calcer updated with a sequence of texts
+         * is equal to the merge of calcers updated with parts of this sequence
+         */
+        virtual bool IsMergeable() const {
+            return false;
+        }
+
+        // adds statistics of srcCalcer (updated starting from the initial state) to dstCalcer
+        virtual void Merge(const TTextFeatureCalcer& srcCalcer, TTextFeatureCalcer* dstCalcer) const {
+            Y_UNUSED(srcCalcer, dstCalcer);
+            CB_ENSURE_INTERNAL(false, "Text calcer statistics are not mergeable");
+        }
     };
 
     using TTextCalcerVisitorPtr = TIntrusivePtr<ITextCalcerVisitor>;
@@ -4,6 +4,7 @@
 #include <catboost/private/libs/text_features/flatbuffers/feature_calcers.fbs.h>
 
 #include <util/generic/array_ref.h>
+#include <util/generic/xrange.h>
 #include <util/generic/ymath.h>
 
 using namespace NCB;
@@ -11,48 +12,64 @@ using namespace NCB;
 TTextFeatureCalcerFactory::TRegistrator<TMultinomialNaiveBayes>
     NaiveBayesRegistrator(EFeatureCalcerType::NaiveBayes);
 
-double TMultinomialNaiveBayes::LogProb(
-    const TDenseHash<TTokenId, ui32>& freqTable,
-    double classSamples,
-    double classTokensCount,
-    const TText& text) const {
+void TMultinomialNaiveBayes::CalcClassProbs(
+    const TText& text,
+    TArrayRef<double> classTokensCount,
+    TArrayRef<double> probs) const {
 
-    Y_UNUSED(text, freqTable);
-    double value = log(classSamples + ClassPrior);
+    const double seenTokensPrior = TokenPrior * (NumSeenTokens + SEEN_TOKENS_PRIOR);
+    for (ui32 clazz = 0; clazz < NumClasses; ++clazz) {
+        probs[clazz] = log(ClassDocs[clazz] + ClassPrior);
+        classTokensCount[clazz] = ClassTotalTokens[clazz] + seenTokensPrior;
+    }
 
-    classTokensCount += TokenPrior * (NumSeenTokens + SEEN_TOKENS_PRIOR);
+    const double logTokenPrior = log(TokenPrior);
     double textLen = 0;
 
     for (const auto& tokenToCount : text) {
-        textLen += tokenToCount.Count();
+        const double count = tokenToCount.Count();
+        textLen += count;
 
-        auto tokenCountPtr = freqTable.find(tokenToCount.Token());
-        double num = TokenPrior;
-
-        if (tokenCountPtr != freqTable.end()) {
-            num += tokenCountPtr->second;
-        } else {
+        const auto tokenCountInClass = Frequencies.GetClassCounts(tokenToCount.Token());
+        if (tokenCountInClass.empty()) {
             //unseen word, adjust prior
-            classTokensCount += TokenPrior;
+            const double unseenLogProb = count * logTokenPrior;
+            for (ui32 clazz = 0; clazz < NumClasses; ++clazz) {
+                probs[clazz] += unseenLogProb;
+                classTokensCount[clazz] += TokenPrior;
+            }
+            continue;
+        }
+
+        for (ui32 clazz = 0; clazz < NumClasses; ++clazz) {
+            const ui32 tokenCount = tokenCountInClass[clazz];
+            if (tokenCount != 0) {
+                probs[clazz] += count * log(TokenPrior + tokenCount);
+            } else {
+                //word is unseen in this class, adjust prior
+                probs[clazz] += count * logTokenPrior;
+                classTokensCount[clazz] += TokenPrior;
+            }
         }
-        value += tokenToCount.Count() * log(num);
     }
 
     //denum
-    value -= textLen * log(classTokensCount);
+    for (ui32 clazz = 0; clazz < NumClasses; ++clazz) {
+        probs[clazz] -= textLen * log(classTokensCount[clazz]);
+    }
 
-    return value;
+    Softmax(probs);
 }
 
 void TMultinomialNaiveBayes::Compute(
     const TText& text,
     TOutputFloatIterator outputFeaturesIterator) const {
 
-    TVector<double> logProbs(NumClasses);
-    for (ui32 clazz = 0; clazz < NumClasses; ++clazz) {
-        logProbs[clazz] = LogProb(Frequencies[clazz], ClassDocs[clazz], ClassTotalTokens[clazz], text);
-    }
-    Softmax(logProbs);
+    TVector<double> classTokensCount;
+    classTokensCount.yresize(NumClasses);
+    TVector<double> logProbs;
+    logProbs.yresize(NumClasses);
+    CalcClassProbs(text, classTokensCount, logProbs);
 
     ForEachActiveFeature(
         [&logProbs, &outputFeaturesIterator](ui32 featureId) {
@@ -62,6 +79,28 @@ void TMultinomialNaiveBayes::Compute(
     );
 }
 
+void TMultinomialNaiveBayes::ComputeBlock(TConstArrayRef<TText> texts, TArrayRef<float> result) const {
+    const ui64 docCount = texts.size();
+    Y_ASSERT(result.size() >= docCount * FeatureCount());
+
+    TVector<double> classTokensCount;
+    classTokensCount.yresize(NumClasses);
+    TVector<double> logProbs;
+    logProbs.yresize(NumClasses);
+
+    for (ui64 docId = 0; docId < docCount; ++docId) {
+        CalcClassProbs(texts[docId], classTokensCount, logProbs);
+
+        float* docResult = result.data() + docId;
+        ForEachActiveFeature(
+            [&logProbs, &docResult, docCount](ui32 featureId) {
+                *docResult = logProbs[featureId];
+                docResult += docCount;
+            }
+        );
+    }
+}
+
 TTextFeatureCalcer::TFeatureCalcerFbs TMultinomialNaiveBayes::SaveParametersToFB(flatbuffers::FlatBufferBuilder& builder) const {
     using namespace NCatBoostFbs;
 
@@ -109,24 +148,39 @@ void TMultinomialNaiveBayes::LoadParametersFromFB(const NCatBoostFbs::TFeatureCa
 }
 
 void TMultinomialNaiveBayes::SaveLargeParameters(IOutputStream* stream) const {
-    ::Save(stream, Frequencies);
+    Frequencies.Save(stream);
 }
 
 void TMultinomialNaiveBayes::LoadLargeParameters(IInputStream* stream) {
-    ::Load(stream, Frequencies);
+    Frequencies.Load(stream);
+    CB_ENSURE(
+        Frequencies.GetClassCount() == NumClasses,
+        "Failed to deserialize: Naive Bayes token frequencies don't match number of classes"
+    );
 }
 
 void TNaiveBayesVisitor::Update(ui32 classId, const TText& text, TTextFeatureCalcer* calcer) {
     auto naiveBayes = dynamic_cast<TMultinomialNaiveBayes*>(calcer);
     Y_ASSERT(naiveBayes);
 
-    auto& classCounts = naiveBayes->Frequencies[classId];
-
     for (const auto& tokenToCount : text) {
-        SeenTokens.Insert(tokenToCount.Token());
-        classCounts[tokenToCount.Token()] += tokenToCount.Count();
+        naiveBayes->Frequencies.Add(classId, tokenToCount.Token(), tokenToCount.Count());
         naiveBayes->ClassTotalTokens[classId] += tokenToCount.Count();
     }
     naiveBayes->ClassDocs[classId] += 1;
-    naiveBayes->NumSeenTokens = SeenTokens.Size();
+    // every seen token has a row in Frequencies
+    naiveBayes->NumSeenTokens = naiveBayes->Frequencies.GetTermCount();
+}
+
+void TNaiveBayesVisitor::Merge(const TTextFeatureCalcer& srcCalcer, TTextFeatureCalcer* dstCalcer) const {
+    auto srcNaiveBayes = dynamic_cast<const TMultinomialNaiveBayes*>(&srcCalcer);
+    auto dstNaiveBayes = dynamic_cast<TMultinomialNaiveBayes*>(dstCalcer);
+    Y_ASSERT(srcNaiveBayes && dstNaiveBayes);
+
+    for (auto classId : xrange(dstNaiveBayes->NumClasses)) {
+        dstNaiveBayes->ClassDocs[classId] += srcNaiveBayes->ClassDocs[classId];
+        dstNaiveBayes->ClassTotalTokens[classId] += srcNaiveBayes->ClassTotalTokens[classId];
+    }
+    dstNaiveBayes->Frequencies.Add(srcNaiveBayes->Frequencies);
+    dstNaiveBayes->NumSeenTokens = dstNaiveBayes->Frequencies.GetTermCount();
 }
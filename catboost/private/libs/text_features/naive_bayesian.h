@@ -1,8 +1,8 @@
 #pragma once
 
 #include "feature_calcer.h"
+#include "term_class_frequencies.h"
 
-#include <library/cpp/containers/dense_hash/dense_hash.h>
 #include <util/system/types.h>
 #include <util/generic/fwd.h>
 
@@ -34,6 +34,7 @@ namespace NCB {
         }
 
         void Compute(const TText& text, TOutputFloatIterator iterator) const override;
+        void ComputeBlock(TConstArrayRef<TText> texts, TArrayRef<float> result) const override;
 
         static ui32 BaseFeatureCount(ui32 numClasses) {
             return numClasses > 2 ? numClasses : 1;
@@ -48,11 +49,11 @@ namespace NCB {
         }
 
     private:
-        double LogProb(
-            const TDenseHash<TTokenId, ui32>& freqTable,
-            double classSamples,
-            double classTokensCount,
-            const TText& text
+        // classTokensCount is a scratch buffer of NumClasses size
+        void CalcClassProbs(
+            const TText& text,
+            TArrayRef<double> classTokensCount,
+            TArrayRef<double> probs
         ) const;
 
     protected:
@@ -70,7 +71,7 @@ namespace NCB {
         ui64 NumSeenTokens;
         TVector<ui32> ClassDocs;
         TVector<ui64> ClassTotalTokens;
-        TVector<TDenseHash<TTokenId, ui32>> Frequencies;
+        TTermClassFrequencies Frequencies;
 
         friend class TNaiveBayesVisitor;
     };
@@ -78,7 +79,11 @@ namespace NCB {
     class TNaiveBayesVisitor final : public ITextCalcerVisitor {
     public:
         void Update(ui32 classId, const TText& text, TTextFeatureCalcer* naiveBayes) override;
-    private:
-        TDenseHashSet<ui32> SeenTokens;
+
+        bool IsMergeable() const override {
+            return true;
+        }
+
+        void Merge(const TTextFeatureCalcer& srcNaiveBayes, TTextFeatureCalcer* dstNaiveBayes) const override;
     };
 }
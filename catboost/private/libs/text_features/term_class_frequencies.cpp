@@ -0,0 +1,53 @@
+#include "term_class_frequencies.h"
+
+#include <util/generic/xrange.h>
+#include <util/ysaveload.h>
+
+using namespace NCB;
+
+TArrayRef<ui32> TTermClassFrequencies::GetOrCreateRow(TTokenId token) {
+    const ui32 newRow = TermToRow.Size();
+    const auto [rowIt, isInserted] = TermToRow.insert({token, newRow});
+    if (isInserted) {
+        Counts.resize(Counts.size() + NumClasses, 0);
+    }
+    return MakeArrayRef(Counts.data() + static_cast<size_t>(rowIt->second) * NumClasses, NumClasses);
+}
+
+void TTermClassFrequencies::Add(const TTermClassFrequencies& other) {
+    Y_ASSERT(other.NumClasses == NumClasses);
+    for (const auto& [token, otherRow] : other.TermToRow) {
+        const ui32* otherClassCounts = other.Counts.data() + static_cast<size_t>(otherRow) * NumClasses;
+        TArrayRef<ui32> classCounts = GetOrCreateRow(token);
+        for (ui32 classId : xrange(NumClasses)) {
+            classCounts[classId] += otherClassCounts[classId];
+        }
+    }
+}
+
+void TTermClassFrequencies::Save(IOutputStream* stream) const {
+    TVector<TDenseHash<TTokenId, ui32>> classFrequencies(NumClasses);
+    for (const auto& [token, row] : TermToRow) {
+        const ui32* classCounts = Counts.data() + static_cast<size_t>(row) * NumClasses;
+        for (ui32 classId : xrange(NumClasses)) {
+            if (classCounts[classId] != 0) {
+                classFrequencies[classId][token] = classCounts[classId];
+            }
+        }
+    }
+    ::Save(stream, classFrequencies);
+}
+
+void TTermClassFrequencies::Load(IInputStream* stream) {
+    TVector<TDenseHash<TTokenId, ui32>> classFrequencies;
+    ::Load(stream, classFrequencies);
+
+    NumClasses = classFrequencies.size();
+    TermToRow.MakeEmpty();
+    Counts.clear();
+    for (ui32 classId : xrange(NumClasses)) {
+        for (const auto& [token, count] : classFrequencies[classId]) {
+            GetOrCreateRow(token)[classId] = count;
+        }
+    }
+}
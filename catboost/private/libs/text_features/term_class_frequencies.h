@@ -0,0 +1,64 @@
+#pragma once
+
+#include <catboost/private/libs/data_types/text.h>
+
+#include <library/cpp/containers/dense_hash/dense_hash.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+#include <util/stream/input.h>
+#include <util/stream/output.h>
+#include <util/system/types.h>
+
+namespace NCB {
+
+    /*
+     * Term-major token statistics: for every seen token stores a contiguous row of per-class counts,
+     * so calcers could process all classes of a token with one hash lookup and a vectorized loop.
+     *
+     * Serialized in the same layout as TVector<TDenseHash<TTokenId, ui32>> (one table per class)
+     * to stay compatible with previously saved calcers.
+     */
+    class TTermClassFrequencies {
+    public:
+        explicit TTermClassFrequencies(ui32 numClasses = 0)
+            : NumClasses(numClasses)
+        {}
+
+        ui32 GetClassCount() const {
+            return NumClasses;
+        }
+
+        ui32 GetTermCount() const {
+            return TermToRow.Size();
+        }
+
+        void Add(ui32 classId, TTokenId token, ui32 count) {
+            Y_ASSERT(classId < NumClasses);
+            GetOrCreateRow(token)[classId] += count;
+        }
+
+        // adds counts of other, it must have the same number of classes
+        void Add(const TTermClassFrequencies& other);
+
+        // returns empty array for tokens which were never seen in any class
+        TConstArrayRef<ui32> GetClassCounts(TTokenId token) const {
+            const auto rowIt = TermToRow.find(token);
+            if (rowIt == TermToRow.end()) {
+                return {};
+            }
+            return MakeArrayRef(Counts.data() + static_cast<size_t>(rowIt->second) * NumClasses, NumClasses);
+        }
+
+        void Save(IOutputStream* stream) const;
+        void Load(IInputStream* stream);
+
+    private:
+        TArrayRef<ui32> GetOrCreateRow(TTokenId token);
+
+    private:
+        ui32 NumClasses;
+        TDenseHash<TTokenId, ui32> TermToRow;
+        TVector<ui32> Counts;
+    };
+}
@@ -12,47 +12,31 @@
 #include <cstring>
 
 namespace NCB {
-    static void CalcFeatures(
-        const TVector<TTokensWithBuffer>& tokens,
-        const TDictionaryProxy& dictionary,
-        const TTextFeatureCalcer& calcer,
-        TArrayRef<float> result
-    ) {
-        const ui64 docCount = tokens.size();
-        for (ui32 docId: xrange(docCount)) {
-            TText text = dictionary.Apply(tokens[docId].View);
-
-            calcer.Compute(
-                text,
-                TOutputFloatIterator(result.data() + docId, docCount, result.size())
-            );
-        }
-    }
-
-    static void TokenizeTextFeature(
+    void TTextProcessingCollection::CalcFeatures(
         TConstArrayRef<TStringBuf> textFeature,
+        ui32 textFeatureIdx,
         size_t docCount,
-        TTokenizerPtr tokenizer,
-        TVector<TTokensWithBuffer>* tokens
-    ) {
-        for (ui32 docId: xrange(docCount)) {
-            tokenizer->Tokenize(textFeature[docId], &(*tokens)[docId]);
-        }
+        TArrayRef<float> result
+    ) const {
+        TTextProcessingBlockBuffers buffers;
+        CalcFeatures(textFeature, textFeatureIdx, docCount, result, &buffers);
     }
 
     void TTextProcessingCollection::CalcFeatures(
         TConstArrayRef<TStringBuf> textFeature,
         ui32 textFeatureIdx,
         size_t docCount,
-        TArrayRef<float> result
+        TArrayRef<float> result,
+        TTextProcessingBlockBuffers* buffers
     ) const {
         CB_ENSURE(
             result.size() >= NumberOfOutputFeatures(textFeatureIdx) * docCount,
             "Proposed result buffer has size less than text processing produce"
         );
 
-        TVector<TTokensWithBuffer> tokens;
-        tokens.yresize(docCount);
+        const auto texts = textFeature.first(docCount);
+        auto& tokens = buffers->Tokens;
+        auto& digitizedTexts = buffers->DigitizedTexts;
         TTokenizerPtr previousTokenizer;
 
         for (ui32 digitizerId: PerFeatureDigitizers[textFeatureIdx]) {
@@ -60,10 +44,12 @@ namespace NCB {
             const ui32 tokenizedFeatureIdx = GetTokenizedFeatureId(textFeatureIdx, digitizerId);
 
             if (!previousTokenizer || Digitizers[digitizerId].Tokenizer != previousTokenizer) {
-                TokenizeTextFeature(textFeature, docCount, Digitizers[digitizerId].Tokenizer, &tokens);
+                Digitizers[digitizerId].Tokenizer->TokenizeBlock(texts, &tokens);
                 previousTokenizer = Digitizers[digitizerId].Tokenizer;
             }
 
+            dictionary->Apply(tokens, &digitizedTexts);
+
             for (ui32 calcerId: PerTokenizedFeatureCalcers[tokenizedFeatureIdx]) {
                 const auto& calcer = FeatureCalcers[calcerId];
 
@@ -74,7 +60,7 @@ namespace NCB {
                     result.data() + calcerOffset,
                     result.data() + calcerOffset + calculatedFeaturesSize
                 );
-                NCB::CalcFeatures(tokens, *dictionary, *calcer, currentResult);
+                calcer->ComputeBlock(digitizedTexts, currentResult);
             }
         }
     }
@@ -27,6 +27,16 @@ namespace NCB {
         ui32 LocalId;
     };
 
+    /*
+     * Buffers for block-wise text features calculation at apply time,
+     * reuse one instance per thread to avoid allocations for every block of documents
+     */
+    struct TTextProcessingBlockBuffers {
+        TVector<TStringBuf> Texts;
+        TTokenizedTextBlock Tokens;
+        TVector<TText> DigitizedTexts;
+    };
+
     class TTextProcessingCollection : public TThrRefBase {
     public:
         TTextProcessingCollection() = default;
@@ -51,6 +61,18 @@ namespace NCB {
             TConstArrayRef<ui32> textFeatureIds,
             ui32 docCount,
             TArrayRef<float> result
+        ) const {
+            TTextProcessingBlockBuffers buffers;
+            CalcFeatures(featureAccessor, textFeatureIds, docCount, result, &buffers);
+        }
+
+        template <class TTextFeatureAccessor>
+        void CalcFeatures(
+            TTextFeatureAccessor featureAccessor,
+            TConstArrayRef<ui32> textFeatureIds,
+            ui32 docCount,
+            TArrayRef<float> result,
+            TTextProcessingBlockBuffers* buffers
         ) const {
             const ui32 totalNumberOfFeatures = TotalNumberOfOutputFeatures() * docCount;
             CB_ENSURE(
@@ -59,7 +81,7 @@ namespace NCB {
                     << ") less than text processing produce (" << totalNumberOfFeatures << ')'
             );
 
-            TVector<TStringBuf> texts;
+            auto& texts = buffers->Texts;
             texts.yresize(docCount);
 
             float* estimatedFeatureBegin = &result[0];
@@ -74,10 +96,12 @@ namespace NCB {
                 CalcFeatures(
                     MakeConstArrayRef(texts),
                     textFeatureId,
+                    docCount,
                     TArrayRef<float>(
                         estimatedFeatureBegin,
                         estimatedFeatureEnd
-                    )
+                    ),
+                    buffers
                 );
                 estimatedFeatureBegin = estimatedFeatureEnd;
             }
@@ -89,6 +113,13 @@ namespace NCB {
             size_t docCount,
             TArrayRef<float> result) const;
 
+        void CalcFeatures(
+            TConstArrayRef<TStringBuf> textFeature,
+            ui32 textFeatureIdx,
+            size_t docCount,
+            TArrayRef<float> result,
+            TTextProcessingBlockBuffers* buffers) const;
+
         ui32 GetAbsoluteCalcerOffset(const TGuid& calcerGuid) const;
         ui32 GetRelativeCalcerOffset(ui32 textFeatureIdx, const TGuid& calcerGuid) const;
 
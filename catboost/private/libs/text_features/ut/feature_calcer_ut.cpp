@@ -242,4 +242,50 @@ Y_UNIT_TEST_SUITE(TestFeatureCalcer) {
             );
         }
     }
+
+    static void CheckComputeBlock(
+        TTextFeatureCalcer* calcer,
+        ITextCalcerVisitor* visitor,
+        ui32 numClasses
+    ) {
+        const ui32 dictionarySize = 300;
+        const ui32 numSamples = 517;
+        const ui32 numTokensPerText = 13;
+
+        TVector<TText> texts;
+        for (ui32 docId : xrange(numSamples)) {
+            TVector<ui32> tokenIds;
+            for (ui32 idx : xrange(numTokensPerText)) {
+                tokenIds.push_back((docId * 7 + idx * idx) % dictionarySize);
+            }
+            texts.emplace_back(std::move(tokenIds));
+        }
+
+        for (ui32 docId : xrange(numSamples / 2)) {
+            visitor->Update(docId % numClasses, texts[docId], calcer);
+        }
+
+        const ui32 featureCount = calcer->FeatureCount();
+        TVector<float> blockFeatures(numSamples * featureCount);
+        calcer->ComputeBlock(texts, blockFeatures);
+
+        for (ui32 docId : xrange(numSamples)) {
+            const TVector<float> docFeatures = calcer->Compute(texts[docId]);
+            for (ui32 featureIdx : xrange(featureCount)) {
+                UNIT_ASSERT_EQUAL(docFeatures[featureIdx], blockFeatures[featureIdx * numSamples + docId]);
+            }
+        }
+    }
+
+    Y_UNIT_TEST(TestComputeBlock) {
+        for (ui32 numClasses : {2, 3, 150}) {
+            TBM25 bm25(CreateGuid(), numClasses);
+            TBM25Visitor bm25Visitor;
+            CheckComputeBlock(&bm25, &bm25Visitor, numClasses);
+
+            TMultinomialNaiveBayes naiveBayes(CreateGuid(), numClasses);
+            TNaiveBayesVisitor bayesVisitor;
+            CheckComputeBlock(&naiveBayes, &bayesVisitor, numClasses);
+        }
+    }
 }
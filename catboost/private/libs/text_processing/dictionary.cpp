@@ -16,6 +16,17 @@ namespace NCB {
         *text = TText{std::move(tokenIds)};
     }
 
+    void TDictionaryProxy::Apply(const TTokenizedTextBlock& tokens, TVector<TText>* texts) const {
+        const ui32 docCount = tokens.GetDocCount();
+        texts->resize(docCount);
+
+        TVector<ui32> tokenIds;
+        for (ui32 docId : xrange(docCount)) {
+            DictionaryImpl->Apply(tokens.GetTokens(docId), &tokenIds);
+            (*texts)[docId].Assign(tokenIds);
+        }
+    }
+
     ui32 TDictionaryProxy::Size() const {
         return DictionaryImpl->Size();
     }
@@ -32,6 +32,8 @@ namespace NCB {
         TTokenId Apply(TStringBuf token) const;
         TText Apply(TConstArrayRef<TStringBuf> tokens) const;
         void Apply(TConstArrayRef<TStringBuf> tokens, TText* text) const;
+        // texts storage is reused, so applying to a block of the same size doesn't allocate
+        void Apply(const TTokenizedTextBlock& tokens, TVector<TText>* texts) const;
 
         ui32 Size() const;
 
@@ -28,6 +28,21 @@ void NCB::TTokenizer::Tokenize(TStringBuf inputString, TTokensWithBuffer* tokens
     }
 }
 
+void NCB::TTokenizer::TokenizeBlock(TConstArrayRef<TStringBuf> inputStrings, TTokenizedTextBlock* tokens) {
+    tokens->Clear();
+    if (TokenizerImpl.NeedToModifyTokens()) {
+        for (TStringBuf inputString : inputStrings) {
+            TokenizerImpl.Tokenize(inputString, &tokens->DocTokens);
+            tokens->AddDocTokens(MakeConstArrayRef(tokens->DocTokens));
+        }
+    } else {
+        for (TStringBuf inputString : inputStrings) {
+            TokenizerImpl.TokenizeWithoutCopy(inputString, &tokens->DocTokenViews);
+            tokens->AddDocTokens(MakeConstArrayRef(tokens->DocTokenViews));
+        }
+    }
+}
+
 void NCB::TTokenizer::Save(IOutputStream *stream) const {
     WriteMagic(TokenizerMagic.data(), MagicSize, Alignment, stream);
     Guid.Save(stream);
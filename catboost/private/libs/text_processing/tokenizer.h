@@ -4,6 +4,9 @@
 
 #include <library/cpp/text_processing/tokenizer/tokenizer.h>
 
+#include <util/generic/array_ref.h>
+#include <util/memory/pool.h>
+
 namespace NCB {
 
     struct TTokensWithBuffer {
@@ -11,6 +14,59 @@ namespace NCB {
         TVector<TString> Data;
     };
 
+    /*
+     * Tokens of a block of texts: views for all documents are stored in one array,
+     * modified tokens (lowercased, lemmatized etc.) are copied to a memory pool.
+     * Buffers are kept between Clear() calls, so the block could be reused without allocations.
+     */
+    class TTokenizedTextBlock {
+    public:
+        TTokenizedTextBlock()
+            : TokensPool(InitialPoolSize)
+        {}
+
+        void Clear() {
+            Tokens.clear();
+            DocOffsets.assign(1, 0);
+            TokensPool.ClearKeepFirstChunk();
+        }
+
+        ui32 GetDocCount() const {
+            return DocOffsets.size() - 1;
+        }
+
+        TConstArrayRef<TStringBuf> GetTokens(ui32 docId) const {
+            Y_ASSERT(docId + 1 < DocOffsets.size());
+            return MakeArrayRef(Tokens.data() + DocOffsets[docId], Tokens.data() + DocOffsets[docId + 1]);
+        }
+
+    private:
+        void AddDocTokens(TConstArrayRef<TStringBuf> tokens) {
+            Tokens.insert(Tokens.end(), tokens.begin(), tokens.end());
+            DocOffsets.push_back(Tokens.size());
+        }
+
+        void AddDocTokens(TConstArrayRef<TString> tokens) {
+            for (const auto& token : tokens) {
+                Tokens.push_back(TokensPool.AppendString(TStringBuf(token)));
+            }
+            DocOffsets.push_back(Tokens.size());
+        }
+
+    private:
+        static constexpr size_t InitialPoolSize = 16384;
+
+        TVector<TStringBuf> Tokens;
+        TVector<size_t> DocOffsets = {0};
+        TMemoryPool TokensPool;
+
+        // per document buffers
+        TVector<TStringBuf> DocTokenViews;
+        TVector<TString> DocTokens;
+
+        friend class TTokenizer;
+    };
+
     class TTokenizer : public TThrRefBase {
     public:
         TTokenizer() = default;
@@ -19,6 +75,7 @@ namespace NCB {
         TGuid Id() const;
         NTextProcessing::NTokenizer::TTokenizerOptions Options() const;
         void Tokenize(TStringBuf inputString, TTokensWithBuffer* tokens);
+        void TokenizeBlock(TConstArrayRef<TStringBuf> inputStrings, TTokenizedTextBlock* tokens);
 
         void Save(IOutputStream* stream) const;
         void Load(IInputStream* stream);
@@ -73,4 +73,48 @@ Y_UNIT_TEST_SUITE(TestTextDataset) {
         UNIT_ASSERT_EQUAL(lastText.Find(haId), lastText.end());
         UNIT_ASSERT_EQUAL(lastText.Find(hoId), lastText.end());
     }
+
+    Y_UNIT_TEST(TestTokenizeBlock) {
+        TVector<TString> text = {
+            "hi",
+            "ha ha",
+            "",
+            "Ho ho HO",
+            "hi ha ho unknown"
+        };
+        TVector<TStringBuf> textBufs(text.begin(), text.end());
+
+        NTextProcessing::NTokenizer::TTokenizerOptions lowercasingOptions;
+        lowercasingOptions.Lowercasing = true;
+
+        for (const auto& blockTokenizer : {tokenizer, CreateTokenizer(lowercasingOptions)}) {
+            NCatboostOptions::TTextColumnDictionaryOptions options;
+            NTextProcessing::NDictionary::TDictionaryBuilderOptions builderOptions;
+            builderOptions.OccurrenceLowerBound = 2;
+            options.DictionaryBuilderOptions.Set(builderOptions);
+            TDictionaryPtr dictionary = CreateDictionary(TIterableTextFeature(text), options, blockTokenizer);
+
+            TTokenizedTextBlock tokensBlock;
+            TVector<TText> texts;
+            for (ui32 iteration : xrange(2)) {
+                Y_UNUSED(iteration);
+                blockTokenizer->TokenizeBlock(textBufs, &tokensBlock);
+                dictionary->Apply(tokensBlock, &texts);
+
+                UNIT_ASSERT_VALUES_EQUAL(tokensBlock.GetDocCount(), text.size());
+                UNIT_ASSERT_VALUES_EQUAL(texts.size(), text.size());
+
+                TTokensWithBuffer tokens;
+                for (ui32 docId : xrange(text.size())) {
+                    blockTokenizer->Tokenize(text[docId], &tokens);
+                    const auto blockTokens = tokensBlock.GetTokens(docId);
+                    UNIT_ASSERT_VALUES_EQUAL(blockTokens.size(), tokens.View.size());
+                    for (ui32 tokenIdx : xrange(blockTokens.size())) {
+                        UNIT_ASSERT_VALUES_EQUAL(blockTokens[tokenIdx], tokens.View[tokenIdx]);
+                    }
+                    UNIT_ASSERT_EQUAL(texts[docId], dictionary->Apply(tokens.View));
+                }
+            }
+        }
+    }
 }
@@ -149,6 +149,13 @@ class MultiRegressionCustomMetric:
         """
         raise CatBoostError("evaluate method is not implemented")
 
+    # Optional: if defined, it is called instead of evaluate with the same arguments
+    # passed as read-only numpy arrays over native buffers (approxes and targets are lists of 1-D arrays).
+    #
+    # def evaluate_batch(self, approxes, targets, weights):
+    #     ...
+    #     return weighted_error, total_weight
+
     def is_max_optimal(self):
         raise CatBoostError("is_max_optimal method is not implemented")
 
@@ -197,6 +204,17 @@ class MultiRegressionCustomObjective:
         """
         raise CatBoostError("calc_ders_multi method is not implemented")
 
+    # Optional: if defined, it is used instead of calc_ders_multi to compute derivatives
+    # of a whole block of instances with a single call.
+    #
+    # def calc_ders_multi_batch(self, approxes, targets, weights):
+    #     approxes : read-only numpy.ndarray of shape [n, approx_dimension]
+    #     targets : read-only numpy.ndarray of shape [n] for multiclassification
+    #         and [n, target_dimension] for multiregression
+    #     weights : read-only numpy.ndarray of shape [n] or None
+    #     returns der1 of shape [n, approx_dimension]
+    #         and der2 of shape [n, approx_dimension, approx_dimension]
+
 
 cdef extern from "catboost/libs/logging/logging.h":
     cdef void SetCustomLoggingFunction(void(*func)(const char*, size_t len) except * with gil, void(*func)(const char*, size_t len) except * with gil)
@@ -620,6 +638,18 @@ cdef extern from "catboost/private/libs/algo_helpers/custom_objective_descriptor
             void* customData
         ) with gil
 
+        void (*CalcDersMultiBatch)(
+            int count,
+            int approxDimension,
+            int targetDimension,
+            const double* approxes,
+            const float* targets,
+            const float* weights,
+            double* ders,
+            double* der2,
+            void* customData
+        ) with gil
+
 ctypedef pair[TVector[TVector[ui32]], TVector[TVector[ui32]]] TCustomTrainTestSubsets
 cdef extern from "catboost/private/libs/options/cross_validation_params.h":
     cdef cppclass TCrossValidationParams:
@@ -1063,6 +1093,27 @@ cdef extern from "catboost/private/libs/hyperparameter_tuning/hyperparameter_tun
         bool_t isReturnCvResults,
         int verbose) nogil except +ProcessException
 
+    cdef cppclass THalvingSearchParams:
+        ui32 NumberOfTries
+        ui32 MinIterations
+        ui32 ReductionFactor
+        ui32 ConcurrentTrials
+
+    cdef void SuccessiveHalvingSearch(
+        const THalvingSearchParams& halvingSearchParams,
+        const THashMap[TString, TCustomRandomDistributionGenerator]& randDistGenerators,
+        const TJsonValue& grid,
+        const TJsonValue& params,
+        const TTrainTestSplitParams& trainTestSplitParams,
+        const TCrossValidationParams& cvParams,
+        const TMaybe[TCustomObjectiveDescriptor]& objectiveDescriptor,
+        const TMaybe[TCustomMetricDescriptor]& evalMetricDescriptor,
+        TDataProviderPtr pool,
+        TBestOptionValuesWithCvResult* results,
+        TMetricsAndTimeLeftHistory* trainTestResult,
+        bool_t isReturnCvResults,
+        int verbose) nogil except +ProcessException
+
 
 cpdef run_atexit_finalizers():
     ManualRunAtExitFinalizers()
@@ -1275,6 +1326,52 @@ cdef TMetricHolder _MetricEval(
     holder.Stats[1] = weight_
     return holder
 
+cdef _read_only_double_array(const double* arr, int count):
+    if count == 0:
+        return np.empty(0, dtype=_npfloat64)
+    result = np.asarray(<double[:count]>(<double*>arr))
+    result.flags.writeable = False
+    return result
+
+cdef _read_only_float_array(const float* arr, int count):
+    if count == 0:
+        return np.empty(0, dtype=_npfloat32)
+    result = np.asarray(<float[:count]>(<float*>arr))
+    result.flags.writeable = False
+    return result
+
+cdef TMetricHolder _MetricEvalBatch(
+    const TVector[TVector[double]]& approx,
+    TConstArrayRef[float] target,
+    TConstArrayRef[float] weight,
+    int begin,
+    int end,
+    void* customData
+) with gil:
+    cdef metricObject = <object>customData
+    cdef TString errorMessage
+    cdef TMetricHolder holder
+    holder.Stats.resize(2)
+
+    approxes = [_read_only_double_array(approx[i].data() + begin, end - begin) for i in xrange(approx.size())]
+    targets = _read_only_float_array(target.data() + begin, end - begin)
+
+    if weight.size() == 0:
+        weights = None
+    else:
+        weights = _read_only_float_array(weight.data() + begin, end - begin)
+
+    try:
+        error, weight_ = metricObject.evaluate_batch(approxes, targets, weights)
+    except:
+        errorMessage = to_arcadia_string(traceback.format_exc())
+        with nogil:
+            ThrowCppExceptionWithMessage(errorMessage)
+
+    holder.Stats[0] = error
+    holder.Stats[1] = weight_
+    return holder
+
 cdef TMetricHolder _MultiregressionMetricEval(
     TConstArrayRef[TVector[double]] approx,
     TConstArrayRef[TConstArrayRef[float]] target,
@@ -1307,6 +1404,38 @@ cdef TMetricHolder _MultiregressionMetricEval(
     holder.Stats[1] = weight_
     return holder
 
+cdef TMetricHolder _MultiregressionMetricEvalBatch(
+    TConstArrayRef[TVector[double]] approx,
+    TConstArrayRef[TConstArrayRef[float]] target,
+    TConstArrayRef[float] weight,
+    int begin,
+    int end,
+    void* customData
+) with gil:
+    cdef metricObject = <object>customData
+    cdef TString errorMessage
+    cdef TMetricHolder holder
+    holder.Stats.resize(2)
+
+    approxes = [_read_only_double_array(approx[i].data() + begin, end - begin) for i in xrange(approx.size())]
+    targets = [_read_only_float_array(target[i].data() + begin, end - begin) for i in xrange(target.size())]
+
+    if weight.size() == 0:
+        weights = None
+    else:
+        weights = _read_only_float_array(weight.data() + begin, end - begin)
+
+    try:
+        error, weight_ = metricObject.evaluate_batch(approxes, targets, weights)
+    except:
+        errorMessage = to_arcadia_string(traceback.format_exc())
+        with nogil:
+            ThrowCppExceptionWithMessage(errorMessage)
+
+    holder.Stats[0] = error
+    holder.Stats[1] = weight_
+    return holder
+
 cdef double _RandomDistGen(
     void* customFunction
 ) with gil:
@@ -1413,6 +1542,46 @@ cdef void _ObjectiveCalcDersMultiRegression(
                 dereference(der2).Data[index] = num
                 index += 1
 
+cdef void _ObjectiveCalcDersMultiBatch(
+    int count,
+    int approxDimension,
+    int targetDimension,
+    const double* approxes,
+    const float* targets,
+    const float* weights,
+    double* ders,
+    double* der2,
+    void* customData
+) with gil:
+    cdef objectiveObject = <object>(customData)
+    cdef TString errorMessage
+
+    if count == 0:
+        return
+
+    approx = _read_only_double_array(approxes, count * approxDimension).reshape(count, approxDimension)
+    target = _read_only_float_array(targets, count * targetDimension)
+    if targetDimension > 1:
+        target = target.reshape(count, targetDimension)
+
+    if weights:
+        weight = _read_only_float_array(weights, count)
+    else:
+        weight = None
+
+    try:
+        ders_matrix, second_ders_tensor = objectiveObject.calc_ders_multi_batch(approx, target, weight)
+        np.asarray(<double[:count * approxDimension]>ders).reshape(count, approxDimension)[...] = ders_matrix
+        if der2:
+            upper_rows, upper_columns = np.triu_indices(approxDimension)
+            np.asarray(<double[:count * len(upper_rows)]>der2).reshape(count, len(upper_rows))[...] = (
+                np.asarray(second_ders_tensor)[:, upper_rows, upper_columns]
+            )
+    except:
+        errorMessage = to_arcadia_string(traceback.format_exc())
+        with nogil:
+            ThrowCppExceptionWithMessage(errorMessage)
+
 
 # customGenerator should have method rvs()
 cdef TCustomRandomDistributionGenerator _BuildCustomRandomDistributionGenerator(object customGenerator):
@@ -1424,10 +1593,17 @@ cdef TCustomRandomDistributionGenerator _BuildCustomRandomDistributionGenerator(
 cdef TCustomMetricDescriptor _BuildCustomMetricDescriptor(object metricObject):
     cdef TCustomMetricDescriptor descriptor
     descriptor.CustomData = <void*>metricObject
+    has_evaluate_batch = hasattr(metricObject, 'evaluate_batch')
     if (issubclass(metricObject.__class__, MultiRegressionCustomMetric)):
-        descriptor.EvalMultiregressionFunc = &_MultiregressionMetricEval
+        if has_evaluate_batch:
+            descriptor.EvalMultiregressionFunc = &_MultiregressionMetricEvalBatch
+        else:
+            descriptor.EvalMultiregressionFunc = &_MultiregressionMetricEval
     else:
-        descriptor.EvalFunc = &_MetricEval
+        if has_evaluate_batch:
+            descriptor.EvalFunc = &_MetricEvalBatch
+        else:
+            descriptor.EvalFunc = &_MetricEval
     descriptor.GetDescriptionFunc = &_MetricGetDescription
     descriptor.IsMaxOptimalFunc = &_MetricIsMaxOptimal
     descriptor.GetFinalErrorFunc = &_MetricGetFinalError
@@ -1439,6 +1615,8 @@ cdef TCustomObjectiveDescriptor _BuildCustomObjectiveDescriptor(object objective
     descriptor.CalcDersRange = &_ObjectiveCalcDersRange
     descriptor.CalcDersMultiRegression = &_ObjectiveCalcDersMultiRegression
     descriptor.CalcDersMultiClass = &_ObjectiveCalcDersMultiClass
+    if hasattr(objectiveObject, 'calc_ders_multi_batch'):
+        descriptor.CalcDersMultiBatch = &_ObjectiveCalcDersMultiBatch
     return descriptor
 
 
@@ -4668,7 +4846,7 @@ cdef class _CatBoost:
     cpdef _tune_hyperparams(self, list grids_list, _PoolBase train_pool, dict params, int n_iter,
                           int fold_count, int partition_random_seed, bool_t shuffle, bool_t stratified,
                           double train_size, bool_t choose_by_train_test_split, bool_t return_cv_results,
-                          custom_folds, int verbose):
+                          custom_folds, int verbose, halving_params=None):
 
         prep_params = _PreprocessParams(params)
         prep_grids = _PreprocessGrids(grids_list)
@@ -4697,12 +4875,36 @@ cdef class _CatBoost:
         ttParams.Stratified = False
         ttParams.TrainPart = train_size
 
+        cdef THalvingSearchParams halvingSearchParams
+        cdef bool_t use_halving_search = halving_params is not None
+        if use_halving_search:
+            halvingSearchParams.NumberOfTries = max(n_iter, 0)
+            halvingSearchParams.MinIterations = halving_params['min_iterations']
+            halvingSearchParams.ReductionFactor = halving_params['reduction_factor']
+            halvingSearchParams.ConcurrentTrials = halving_params['concurrent_trials']
+
         cdef TBestOptionValuesWithCvResult results
         cdef TMetricsAndTimeLeftHistory trainTestResults
         with nogil:
             SetPythonInterruptHandler()
             try:
-                if n_iter == -1:
+                if use_halving_search:
+                    SuccessiveHalvingSearch(
+                        halvingSearchParams,
+                        prep_grids.custom_rnd_dist_gens,
+                        prep_grids.tree,
+                        prep_params.tree,
+                        ttParams,
+                        cvParams,
+                        prep_params.customObjectiveDescriptor,
+                        prep_params.customMetricDescriptor,
+                        train_pool.__pool,
+                        &results,
+                        &trainTestResults,
+                        return_cv_results,
+                        verbose
+                    )
+                elif n_iter == -1:
                     GridSearch(
                         prep_grids.tree,
                         prep_params.tree,
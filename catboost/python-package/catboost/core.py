@@ -3354,7 +3354,8 @@ class CatBoost(_CatBoostBase):
 
     def _tune_hyperparams(self, param_grid, X, y=None, cv=3, n_iter=10, partition_random_seed=0,
                           calc_cv_statistics=True, search_by_train_test_split=True,
-                          refit=True, shuffle=True, stratified=None, train_size=0.8, verbose=1, plot=False):
+                          refit=True, shuffle=True, stratified=None, train_size=0.8, verbose=1, plot=False,
+                          halving_params=None):
 
         if refit and self.is_fitted():
             raise CatBoostError("Model was fitted before hyperparameters tuning. You can't change hyperparameters of fitted model.")
@@ -3419,7 +3420,7 @@ class CatBoost(_CatBoostBase):
             cv_result = self._object._tune_hyperparams(
                 param_grid, train_params["train_pool"], params, n_iter,
                 fold_count, partition_random_seed, shuffle, stratified, train_size,
-                search_by_train_test_split, calc_cv_statistics, custom_folds, verbose
+                search_by_train_test_split, calc_cv_statistics, custom_folds, verbose, halving_params
             )
 
         if refit:
@@ -3618,6 +3619,107 @@ class CatBoost(_CatBoostBase):
             stratified=stratified, train_size=train_size, verbose=verbose, plot=plot
         )
 
+    def successive_halving_search(self, param_distributions, X, y=None, cv=3, n_iter=0, min_iterations=100,
+                                  reduction_factor=3, concurrent_trials=1, partition_random_seed=0,
+                                  calc_cv_statistics=True, refit=True, shuffle=True, stratified=None,
+                                  train_size=0.8, verbose=True, plot=False):
+        """
+        Successive halving search on hyper parameters.
+        After calling this method model is fitted and can be used, if not specified otherwise (refit=False).
+
+        All parameter settings are trained for min_iterations iterations on the train part of the dataset and
+        compared by loss function score on the test part. The best 1/reduction_factor of them are trained
+        reduction_factor times longer, continuing from the already trained trees, and so on until one setting
+        is left or the 'iterations' parameter is reached.
+        The dataset is quantized once for every combination of quantization parameters.
+
+        Parameters
+        ----------
+        param_distributions: dict
+            Dictionary with parameters names (string) as keys and distributions or lists of parameters to try.
+            Distributions must provide a rvs method for sampling (such as those from scipy.stats.distributions).
+
+        X: numpy.ndarray or pandas.DataFrame or catboost.Pool
+            Data to compute statistics on
+
+        y: numpy.ndarray or pandas.Series or None
+            Target corresponding to data
+            Use only if data is not catboost.Pool.
+
+        cv: int, cross-validation generator or an iterable, optional (default=None)
+            Cross-validation splitting strategy for statistics of the best parameters,
+            see randomized_search for possible values.
+
+        n_iter: int, optional (default=0)
+            Number of parameter settings that are sampled. If 0, all grid points are tried.
+
+        min_iterations: int, optional (default=100)
+            Number of iterations every parameter setting is trained for in the first round.
+
+        reduction_factor: int, optional (default=3)
+            Only 1/reduction_factor best parameter settings continue to the next round.
+
+        concurrent_trials: int, optional (default=1)
+            Number of parameter settings trained concurrently, thread_count is split evenly between them.
+
+        partition_random_seed: int, optional (default=0)
+            Use this as the seed value for random permutation of the data.
+
+        calc_cv_statistics: bool, optional (default=True)
+            The parameter determines whether quality should be estimated
+            using cross-validation with the found best parameters.
+
+        refit: bool (default=True)
+            Refit an estimator using the best found parameters on the whole dataset.
+
+        shuffle: bool, optional (default=True)
+            Shuffle the dataset objects before parameters searching.
+
+        stratified: bool, optional (default=None)
+            Perform stratified sampling. True for classification and False otherwise.
+            Currently supported only for cross-validation.
+
+        train_size: float, optional (default=0.8)
+            Should be between 0.0 and 1.0 and represent the proportion of the dataset to include in the train split.
+
+        verbose: bool or int, optional (default=True)
+            When verbose==False, there is no messages
+
+        plot : bool, optional (default=False)
+            If True, draw train and eval error for every set of parameters in Jupyter notebook
+        Returns
+        -------
+        dict with two fields:
+            'params': dict of best found parameters
+            'cv_results': dict or pandas.core.frame.DataFrame with cross-validation results
+                columns are: test-error-mean  test-error-std  train-error-mean  train-error-std
+        """
+        if n_iter < 0:
+            raise CatBoostError("n_iter should be a non-negative number")
+        if min_iterations <= 0:
+            raise CatBoostError("min_iterations should be a positive number")
+        if reduction_factor <= 1:
+            raise CatBoostError("reduction_factor should be greater than 1")
+        if concurrent_trials <= 0:
+            raise CatBoostError("concurrent_trials should be a positive number")
+        if not isinstance(param_distributions, Mapping):
+            raise CatBoostError("param_distributions should be a dictionary")
+        for key in param_distributions:
+            if not isinstance(param_distributions[key], Iterable) and not hasattr(param_distributions[key], "rvs"):
+                raise TypeError('Parameter grid value is not iterable and do not have \'rvs\' method (key={!r}, value={!r})'.format(key, param_distributions[key]))
+
+        return self._tune_hyperparams(
+            param_grid=param_distributions, X=X, y=y, cv=cv, n_iter=n_iter,
+            partition_random_seed=partition_random_seed, calc_cv_statistics=calc_cv_statistics,
+            search_by_train_test_split=True, refit=refit, shuffle=shuffle,
+            stratified=stratified, train_size=train_size, verbose=verbose, plot=plot,
+            halving_params={
+                'min_iterations': min_iterations,
+                'reduction_factor': reduction_factor,
+                'concurrent_trials': concurrent_trials
+            }
+        )
+
     def _convert_to_asymmetric_representation(self):
         self._object._convert_oblivious_to_asymmetric()
 
@@ -2394,6 +2394,65 @@ def test_multilabel_custom_objective(task_type, n=10):
         assert (abs(p1 - p2) < EPS).all()
 
 
+def test_multilabel_custom_objective_batch(n=10):
+    class MultiRMSEObjective(MultiRegressionCustomObjective):
+        def calc_ders_multi(self, approxes, targets, weight):
+            grad = [(targets[index] - approxes[index]) * weight for index in xrange(len(targets))]
+            hess = [[(-weight if i == j else 0.0) for j in xrange(len(targets))] for i in xrange(len(targets))]
+            return (grad, hess)
+
+    class BatchMultiRMSEObjective(MultiRegressionCustomObjective):
+        def calc_ders_multi(self, approxes, targets, weight):
+            raise Exception('calc_ders_multi should not be called if calc_ders_multi_batch is defined')
+
+        def calc_ders_multi_batch(self, approxes, targets, weights):
+            assert approxes.shape == targets.shape
+            w = np.ones(approxes.shape[0]) if weights is None else weights
+            grad = (targets - approxes) * w[:, np.newaxis]
+            hess = -w[:, np.newaxis, np.newaxis] * np.eye(approxes.shape[1])[np.newaxis, :, :]
+            return (grad, hess)
+
+    class BatchMultiRMSEMetric(MultiRegressionCustomMetric):
+        def get_final_error(self, error, weight):
+            return 0 if weight == 0 else (error / weight) ** 0.5
+
+        def is_max_optimal(self):
+            return False
+
+        def evaluate(self, approxes, targets, weights):
+            raise Exception('evaluate should not be called if evaluate_batch is defined')
+
+        def evaluate_batch(self, approxes, targets, weights):
+            w = np.ones(len(targets[0])) if weights is None else weights
+            error_sum = sum(np.sum(w * (approx - target) ** 2) for approx, target in zip(approxes, targets))
+            return error_sum, np.sum(w)
+
+    xs = np.arange(n).reshape((-1, 1)).astype(np.float32)
+    ys = np.hstack([
+        (xs > 0.5 * n),
+        (xs < 0.5 * n)
+    ]).astype(np.float32)
+    train_pool = Pool(data=xs, label=ys)
+    test_pool = Pool(data=xs, label=ys)
+
+    params = dict(iterations=5, learning_rate=0.03, leaf_estimation_method="Newton", leaf_estimation_iterations=1)
+
+    model = CatBoostRegressor(loss_function=MultiRMSEObjective(), eval_metric="MultiRMSE", **params)
+    model.fit(train_pool, eval_set=test_pool)
+    pred1 = model.predict(test_pool, prediction_type='RawFormulaVal')
+
+    batch_model = CatBoostRegressor(loss_function=BatchMultiRMSEObjective(), eval_metric=BatchMultiRMSEMetric(), **params)
+    batch_model.fit(train_pool, eval_set=test_pool)
+    pred2 = batch_model.predict(test_pool, prediction_type='RawFormulaVal')
+
+    assert np.allclose(pred1, pred2, atol=EPS)
+    assert np.allclose(
+        model.get_evals_result()['validation']['MultiRMSE'],
+        batch_model.get_evals_result()['validation']['BatchMultiRMSEMetric'],
+        atol=EPS
+    )
+
+
 def test_pool_after_fit(task_type):
     pool1 = Pool(TRAIN_FILE, column_description=CD_FILE)
     pool2 = Pool(TRAIN_FILE, column_description=CD_FILE)
@@ -3121,6 +3180,67 @@ def test_randomized_search(task_type):
     assert results['params'].get('border_count') in border_count_list
 
 
+def test_successive_halving_search():
+    pool = Pool(TRAIN_FILE, column_description=CD_FILE)
+    model = CatBoost(
+        {
+            "learning_rate": 0.03,
+            "loss_function": "Logloss",
+            "iterations": 40,
+            "thread_count": 4
+        }
+    )
+    depth_list = [2, 4, 6]
+    l2_leaf_reg_list = [1, 3, 10]
+    border_count_list = [10, 50]
+    results = model.successive_halving_search(
+        {
+            'depth': depth_list,
+            'l2_leaf_reg': l2_leaf_reg_list,
+            'border_count': border_count_list
+        },
+        pool,
+        min_iterations=5,
+        reduction_factor=2,
+        concurrent_trials=2
+    )
+    assert "test-Logloss-mean" in results['cv_results'], '"test-Logloss-mean" not in results'
+    assert results['params'].get('depth') in depth_list
+    assert results['params'].get('l2_leaf_reg') in l2_leaf_reg_list
+    assert results['params'].get('border_count') in border_count_list
+    assert model.is_fitted()
+
+
+def test_successive_halving_search_concurrent_trials_with_cat_features():
+    pool = Pool(TRAIN_FILE, column_description=CD_FILE)
+    model = CatBoost(
+        {
+            "loss_function": "Logloss",
+            "iterations": 20,
+            "thread_count": 4,
+            "one_hot_max_size": 4,
+            "train_dir": test_output_path('catboost_info'),
+            "allow_writing_files": True
+        }
+    )
+    depth_list = [2, 4]
+    border_count_list = [10, 50]
+    results = model.successive_halving_search(
+        {
+            'depth': depth_list,
+            'border_count': border_count_list
+        },
+        pool,
+        min_iterations=5,
+        reduction_factor=2,
+        concurrent_trials=4
+    )
+    assert "test-Logloss-mean" in results['cv_results'], '"test-Logloss-mean" not in results'
+    assert results['params'].get('depth') in depth_list
+    assert results['params'].get('border_count') in border_count_list
+    assert model.is_fitted()
+
+
 def test_randomized_search_only_dist(task_type):
     pool = Pool(TRAIN_FILE, column_description=CD_FILE)
     model = CatBoost(
@@ -23,6 +23,7 @@ struct TCMDOptions {
     size_t BlockSize = Max<size_t>();
     size_t RepetitionCount = 1;
     int ThreadCount = 1;
+    bool SingleObjectLatency = false;
 };
 
 struct TTimingResult {
@@ -48,6 +49,14 @@ struct TTimingResult {
         return sum / Times.size();
     }
 
+    // nearest rank percentile, q in [0, 1]
+    double Percentile(double q) const {
+        TVector<double> sorted = Times;
+        const size_t rank = ::Min<size_t>(sorted.size() - 1, ::Max<size_t>(1, (size_t)ceil(q * sorted.size())) - 1);
+        NthElement(sorted.begin(), sorted.begin() + rank, sorted.end());
+        return sorted[rank];
+    }
+
     void Output(const TTimingResult* ref = nullptr) const {
         auto myMin = Min();
         CATBOOST_INFO_LOG << "min:\t" << myMin;
@@ -69,6 +78,15 @@ struct TTimingResult {
             CATBOOST_INFO_LOG << "\t" << mymean / ref->Mean();
         }
         CATBOOST_INFO_LOG << Endl;
+
+        for (auto [label, q] : {std::make_pair("p50", 0.5), std::make_pair("p99", 0.99)}) {
+            auto myPercentile = Percentile(q);
+            CATBOOST_INFO_LOG << label << ":\t" << myPercentile;
+            if (ref) {
+                CATBOOST_INFO_LOG << "\t" << myPercentile / ref->Percentile(q);
+            }
+            CATBOOST_INFO_LOG << Endl;
+        }
     }
 
     NJson::TJsonValue GetJsonValue() const {
@@ -76,6 +94,8 @@ struct TTimingResult {
         result["min"] = Min();
         result["max"] = Max();
         result["mean"] = Mean();
+        result["p50"] = Percentile(0.5);
+        result["p99"] = Percentile(0.99);
         return result;
     }
 };
@@ -183,6 +203,9 @@ int DoMain(int argc, char** argv) {
     parser.AddLongOption("threads")
         .StoreResult(&options.ThreadCount)
         .Optional();
+    parser.AddLongOption("single-object-latency")
+        .Help("Additionally time every object separately through the single object api (reported with p50/p99)")
+        .SetFlag(&options.SingleObjectLatency);
 
     NLastGetopt::TOptsParseResult parserResult{&parser, argc, argv};
     TFullModel model = ReadModel(options.ModelPath);
@@ -351,6 +374,21 @@ int DoMain(int argc, char** argv) {
             }
         }
     }
+    if (options.SingleObjectLatency) {
+        for (size_t i = 0; i < options.RepetitionCount; ++i) {
+            for (auto& module : modules) {
+                if (!module->SupportsSingleObject()) {
+                    continue;
+                }
+                const TString name = module->GetName() + " single object";
+                for (size_t blockId = 0; blockId < blockCount; ++blockId) {
+                    for (const auto& objectFeatures : nonTranspFactorsRef[blockId]) {
+                        results.UpdateResult(name, module->DoSingle(objectFeatures));
+                    }
+                }
+            }
+        }
+    }
     results.OutputResults();
 
     return 0;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/model/model.h>
 
 #include <library/cpp/object_factory/object_factory.h>
@@ -18,6 +19,14 @@ public:
     virtual int GetComparisonPriority(EPerftestModuleDataLayout layout) const = 0;
     virtual bool SupportsLayout(EPerftestModuleDataLayout layout) const = 0;
     virtual double Do(EPerftestModuleDataLayout layout, TConstArrayRef<TConstArrayRef<float>> features) = 0;
+    /// latency of one object evaluation through the single object api
+    virtual bool SupportsSingleObject() const {
+        return false;
+    }
+    virtual double DoSingle(TConstArrayRef<float> features) {
+        Y_UNUSED(features);
+        ythrow TCatBoostException() << "Single object evaluation is not supported by " << GetName();
+    }
     virtual TString GetName(TMaybe<EPerftestModuleDataLayout> = Nothing()) const = 0;
 
     virtual ~IPerftestModule() = default;
@@ -1,5 +1,7 @@
 #include "perftest_module.h"
 
+#include <catboost/libs/model/model_reordering.h>
+
 class TBaseCatboostModule : public TBasePerftestModule {
 public:
     TBaseCatboostModule() = default;
@@ -28,6 +30,18 @@ public:
             return Timer.Passed();
         }
     }
+
+    bool SupportsSingleObject() const override final {
+        return true;
+    }
+
+    double DoSingle(TConstArrayRef<float> features) override final {
+        ResultsHolder.resize(ModelEvaluator->GetApproxDimension());
+        Timer.Reset();
+        ModelEvaluator->CalcFlatSingle(features, ResultsHolder);
+        return Timer.Passed();
+    }
+
     TString GetName(TMaybe<EPerftestModuleDataLayout> layout) const override final {
         if (!layout.Defined()) {
             return BaseName;
@@ -55,6 +69,19 @@ public:
 
 TPerftestModuleFactory::TRegistrator<TCPUCatboostModule> CPUCatboostModuleRegistar("CPUCatboost");
 
+class TCPUCatboostCacheLocalityModule : public TBaseCatboostModule {
+public:
+    TCPUCatboostCacheLocalityModule(const TFullModel& model) {
+        CB_ENSURE(model.IsOblivious(), "cache locality reordering is supported only for symmetric trees");
+        TFullModel reorderedModel = model;
+        ReorderModelForCacheLocality(/*reorderTrees*/ true, &reorderedModel);
+        ModelEvaluator = NCB::NModelEvaluation::CreateEvaluator(EFormulaEvaluatorType::CPU, reorderedModel);
+        BaseName = "catboost cpu cache locality reordered";
+    }
+};
+
+TPerftestModuleFactory::TRegistrator<TCPUCatboostCacheLocalityModule> CPUCatboostCacheLocalityModuleRegistar("CPUCatboostCacheLocality");
+
 class TCPUCatboostAsymmetryModule : public TBaseCatboostModule {
 public:
     TCPUCatboostAsymmetryModule(const TFullModel& model) {
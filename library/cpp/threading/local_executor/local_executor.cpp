@@ -3,6 +3,7 @@
 #include <library/cpp/threading/future/future.h>
 
 #include <util/generic/utility.h>
+#include <util/generic/xrange.h>
 #include <util/system/atomic.h>
 #include <util/system/event.h>
 #include <util/system/thread.h>
@@ -10,8 +11,14 @@
 #include <util/system/yield.h>
 #include <util/thread/lfqueue.h>
 
+#include <atomic>
 #include <utility>
 
+#if defined(_linux_)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 #ifdef _win_
 static void RegularYield() {
 }
@@ -122,16 +129,108 @@ namespace {
         }
     };
 
+    // Range split into contiguous slots with separate counters: slot owner takes tasks from its own
+    // slot and then steals from the following ones, so threads touch a shared counter only at the end.
+    class TStealingRangeExecutor: public NPar::ILocallyExecutable {
+        struct alignas(64) TSlot {
+            TAtomic Next = 0;
+            int End = 0;
+        };
+
+        TIntrusivePtr<NPar::ILocallyExecutable> Exec;
+        TVector<TSlot> Slots;
+        alignas(64) TAtomic WorkerCount;
+
+        void LocalExec(int slotIdx) override {
+            AtomicAdd(WorkerCount, 1);
+            Run(slotIdx);
+            AtomicAdd(WorkerCount, -1);
+        }
+
+        bool DoSingleOp(TSlot& slot) {
+            const int id = AtomicAdd(slot.Next, 1) - 1;
+            if (id >= slot.End)
+                return false;
+            Exec->LocalExec(id);
+            RegularYield();
+            return true;
+        }
+
+    public:
+        TStealingRangeExecutor(TIntrusivePtr<ILocallyExecutable> exec, int firstId, int lastId, int slotCount)
+            : Exec(std::move(exec))
+            , Slots(slotCount)
+            , WorkerCount(0)
+        {
+            Y_ASSERT(0 < slotCount && slotCount <= lastId - firstId);
+            const i64 rangeSize = lastId - firstId;
+            for (auto slotIdx : xrange(slotCount)) {
+                Slots[slotIdx].Next = firstId + rangeSize * slotIdx / slotCount;
+                Slots[slotIdx].End = firstId + rangeSize * (slotIdx + 1) / slotCount;
+            }
+        }
+        void Run(int slotIdx) {
+            for (auto i : xrange(Slots.ysize())) {
+                TSlot& slot = Slots[(slotIdx + i) % Slots.ysize()];
+                while (DoSingleOp(slot)) {
+                }
+            }
+        }
+        void WaitComplete() {
+            while (AtomicGet(WorkerCount) > 0)
+                RegularYield();
+        }
+    };
+
+    TVector<int> GetAllowedCpus() {
+        TVector<int> cpus;
+#if defined(_linux_)
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &cpuSet)) {
+                    cpus.push_back(cpu);
+                }
+            }
+        }
+#endif
+        return cpus;
+    }
+
+    // best effort, thread just stays unpinned if it fails
+    void PinCurrentThread(int cpu) {
+#if defined(_linux_)
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(cpu, &cpuSet);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#else
+        Y_UNUSED(cpu);
+#endif
+    }
 }
 
 //////////////////////////////////////////////////////////////////////////
 class NPar::TLocalExecutor::TImpl {
 public:
+    // per-worker queues for `WorkStealing` mode, indexed by priority
+    struct TWorkerQueues {
+        TLockFreeQueue<TSingleJob> Queues[3];
+    };
+    // workers with larger ids use shared queues only
+    static constexpr int MAX_WORKER_QUEUES = 1024;
+
+    const TOptions Options;
     TLockFreeQueue<TSingleJob> JobQueue;
     TLockFreeQueue<TSingleJob> MedJobQueue;
     TLockFreeQueue<TSingleJob> LowJobQueue;
     alignas(64) TSystemEvent HasJob;
 
+    // indexed by WorkerThreadId, each worker allocates and publishes its own queues
+    TArrayHolder<std::atomic<TWorkerQueues*>> WorkerQueues;
+    TVector<int> AllowedCpus;
+
     TAtomic ThreadCount{0};
     alignas(64) TAtomic QueueSize{0};
     TAtomic MPQueueSize{0};
@@ -145,14 +244,37 @@ public:
 
     static void* HostWorkerThread(void* p);
     bool GetJob(TSingleJob* job);
+    bool GetJobWithStealing(TSingleJob* job);
     void RunNewThread();
+    void InitWorkerThread();
     void LaunchRange(TIntrusivePtr<TLocalRangeExecutor> execRange, int queueSizeLimit,
                      TAtomic* queueSize, TLockFreeQueue<TSingleJob>* jobQueue);
+    void ExecStealingRange(TIntrusivePtr<ILocallyExecutable> exec, int firstId, int lastId, int flags);
+
+    TAtomic* GetQueueSize(int priority);
+    TLockFreeQueue<TSingleJob>* GetSharedQueue(int priority);
+    TWorkerQueues* GetWorkerQueues(int workerThreadId);
+    // to the queue of the worker if it has one, to the shared queue otherwise
+    void EnqueueJob(TSingleJob job, int priority, int workerThreadId);
 
-    TImpl() = default;
+    explicit TImpl(const TOptions& options);
     ~TImpl();
 };
 
+NPar::TLocalExecutor::TImpl::TImpl(const TOptions& options)
+    : Options(options)
+{
+    if (Options.WorkStealing) {
+        WorkerQueues.Reset(new std::atomic<TWorkerQueues*>[MAX_WORKER_QUEUES]);
+        for (auto workerThreadId : xrange(MAX_WORKER_QUEUES)) {
+            WorkerQueues[workerThreadId].store(nullptr);
+        }
+    }
+    if (Options.PinThreads) {
+        AllowedCpus = GetAllowedCpus();
+    }
+}
+
 NPar::TLocalExecutor::TImpl::~TImpl() {
     AtomicAdd(QueueSize, 1);
     JobQueue.Enqueue(TSingleJob(nullptr, 0));
@@ -160,6 +282,62 @@ NPar::TLocalExecutor::TImpl::~TImpl() {
     while (AtomicGet(ThreadCount)) {
         ThreadYield();
     }
+    if (WorkerQueues) {
+        for (auto workerThreadId : xrange(MAX_WORKER_QUEUES)) {
+            delete WorkerQueues[workerThreadId].load();
+        }
+    }
+}
+
+TAtomic* NPar::TLocalExecutor::TImpl::GetQueueSize(int priority) {
+    switch (priority) {
+        case HIGH_PRIORITY:
+            return &QueueSize;
+        case MED_PRIORITY:
+            return &MPQueueSize;
+        default:
+            Y_ASSERT(priority == LOW_PRIORITY);
+            return &LPQueueSize;
+    }
+}
+
+TLockFreeQueue<TSingleJob>* NPar::TLocalExecutor::TImpl::GetSharedQueue(int priority) {
+    switch (priority) {
+        case HIGH_PRIORITY:
+            return &JobQueue;
+        case MED_PRIORITY:
+            return &MedJobQueue;
+        default:
+            Y_ASSERT(priority == LOW_PRIORITY);
+            return &LowJobQueue;
+    }
+}
+
+NPar::TLocalExecutor::TImpl::TWorkerQueues* NPar::TLocalExecutor::TImpl::GetWorkerQueues(int workerThreadId) {
+    if (!WorkerQueues || workerThreadId <= 0 || workerThreadId >= MAX_WORKER_QUEUES) {
+        return nullptr;
+    }
+    return WorkerQueues[workerThreadId].load(std::memory_order_acquire);
+}
+
+void NPar::TLocalExecutor::TImpl::EnqueueJob(TSingleJob job, int priority, int workerThreadId) {
+    AtomicAdd(*GetQueueSize(priority), 1);
+    if (TWorkerQueues* workerQueues = GetWorkerQueues(workerThreadId)) {
+        workerQueues->Queues[priority].Enqueue(std::move(job));
+    } else {
+        GetSharedQueue(priority)->Enqueue(std::move(job));
+    }
+}
+
+void NPar::TLocalExecutor::TImpl::InitWorkerThread() {
+    if (Options.PinThreads && !AllowedCpus.empty()) {
+        // the first allowed CPU is left for the thread that owns the executor
+        PinCurrentThread(AllowedCpus[WorkerThreadId % AllowedCpus.ysize()]);
+    }
+    // allocated after pinning to be first touched on the worker's NUMA node
+    if (WorkerQueues && WorkerThreadId > 0 && WorkerThreadId < MAX_WORKER_QUEUES) {
+        WorkerQueues[WorkerThreadId].store(new TWorkerQueues, std::memory_order_release);
+    }
 }
 
 void* NPar::TLocalExecutor::TImpl::HostWorkerThread(void* p) {
@@ -168,6 +346,7 @@ void* NPar::TLocalExecutor::TImpl::HostWorkerThread(void* p) {
     auto* const ctx = (TImpl*)p;
     TThread::SetCurrentThreadName("ParLocalExecutor");
     ctx->WorkerThreadId = AtomicAdd(ctx->ThreadId, 1);
+    ctx->InitWorkerThread();
     for (bool cont = true; cont;) {
         TSingleJob job;
         bool gotJob = false;
@@ -199,6 +378,9 @@ void* NPar::TLocalExecutor::TImpl::HostWorkerThread(void* p) {
 }
 
 bool NPar::TLocalExecutor::TImpl::GetJob(TSingleJob* job) {
+    if (Options.WorkStealing) {
+        return GetJobWithStealing(job);
+    }
     if (JobQueue.Dequeue(job)) {
         CurrentTaskPriority = TLocalExecutor::HIGH_PRIORITY;
         AtomicAdd(QueueSize, -1);
@@ -215,6 +397,31 @@ bool NPar::TLocalExecutor::TImpl::GetJob(TSingleJob* job) {
     return false;
 }
 
+bool NPar::TLocalExecutor::TImpl::GetJobWithStealing(TSingleJob* job) {
+    const int workerThreadId = WorkerThreadId;
+    const int workerCount = Min<int>(AtomicGet(ThreadId) + 1, MAX_WORKER_QUEUES);
+    for (int priority = HIGH_PRIORITY; priority <= LOW_PRIORITY; ++priority) {
+        TAtomic* queueSize = GetQueueSize(priority);
+        // sizes are increased before enqueueing, so no queue of this priority has jobs
+        if (AtomicGet(*queueSize) <= 0) {
+            continue;
+        }
+        TWorkerQueues* ownQueues = GetWorkerQueues(workerThreadId);
+        bool gotJob = (ownQueues && ownQueues->Queues[priority].Dequeue(job))
+            || GetSharedQueue(priority)->Dequeue(job);
+        for (int i = 1; !gotJob && i < workerCount; ++i) {
+            TWorkerQueues* victimQueues = GetWorkerQueues((workerThreadId + i) % workerCount);
+            gotJob = victimQueues && victimQueues->Queues[priority].Dequeue(job);
+        }
+        if (gotJob) {
+            CurrentTaskPriority = priority;
+            AtomicAdd(*queueSize, -1);
+            return true;
+        }
+    }
+    return false;
+}
+
 void NPar::TLocalExecutor::TImpl::RunNewThread() {
     AtomicAdd(ThreadCount, 1);
     TThread thr(HostWorkerThread, this);
@@ -235,12 +442,41 @@ void NPar::TLocalExecutor::TImpl::LaunchRange(TIntrusivePtr<TLocalRangeExecutor>
     HasJob.Signal();
 }
 
+void NPar::TLocalExecutor::TImpl::ExecStealingRange(TIntrusivePtr<ILocallyExecutable> exec, int firstId, int lastId, int flags) {
+    const int slotCount = Min<int>(AtomicGet(ThreadCount) + 1, lastId - firstId);
+    auto rangeExec = MakeIntrusive<TStealingRangeExecutor>(std::move(exec), firstId, lastId, slotCount);
+    const int prior = Max<int>(CurrentTaskPriority, flags & PRIORITY_MASK);
+    const bool waitComplete = flags & WAIT_COMPLETE;
+    if (!waitComplete || AtomicGet(*GetQueueSize(prior)) < 10000) {
+        // slot 0 is processed by the calling thread if it waits, slot k goes to the queue of worker k
+        for (int slotIdx = waitComplete ? 1 : 0; slotIdx < slotCount; ++slotIdx) {
+            EnqueueJob(TSingleJob(rangeExec, slotIdx), prior, slotIdx);
+        }
+        HasJob.Signal();
+    }
+    if (waitComplete) {
+        int keepPrior = CurrentTaskPriority;
+        CurrentTaskPriority = prior;
+        rangeExec->Run(0);
+        CurrentTaskPriority = keepPrior;
+        rangeExec->WaitComplete();
+    }
+}
+
 NPar::TLocalExecutor::TLocalExecutor()
-    : Impl_{MakeHolder<TImpl>()} {
+    : TLocalExecutor(TOptions()) {
+}
+
+NPar::TLocalExecutor::TLocalExecutor(const TOptions& options)
+    : Impl_{MakeHolder<TImpl>(options)} {
 }
 
 NPar::TLocalExecutor::~TLocalExecutor() = default;
 
+const NPar::TLocalExecutor::TOptions& NPar::TLocalExecutor::GetOptions() const noexcept {
+    return Impl_->Options;
+}
+
 void NPar::TLocalExecutor::RunAdditionalThreads(int threadCount) {
     for (int i = 0; i < threadCount; i++)
         Impl_->RunNewThread();
@@ -249,6 +485,12 @@ void NPar::TLocalExecutor::RunAdditionalThreads(int threadCount) {
 void NPar::TLocalExecutor::Exec(TIntrusivePtr<ILocallyExecutable> exec, int id, int flags) {
     Y_ASSERT((flags & WAIT_COMPLETE) == 0); // unsupported
     int prior = Max<int>(Impl_->CurrentTaskPriority, flags & PRIORITY_MASK);
+    if (Impl_->Options.WorkStealing) {
+        // task added by a worker most likely uses data the worker has just touched
+        Impl_->EnqueueJob(TSingleJob(std::move(exec), id), prior, Impl_->WorkerThreadId);
+        Impl_->HasJob.Signal();
+        return;
+    }
     switch (prior) {
         case HIGH_PRIORITY:
             AtomicAdd(Impl_->QueueSize, 1);
@@ -278,6 +520,10 @@ void NPar::TLocalExecutor::ExecRange(TIntrusivePtr<ILocallyExecutable> exec, int
     if (TryExecRangeSequentially([=] (int id) { exec->LocalExec(id); }, firstId, lastId, flags)) {
         return;
     }
+    if (Impl_->Options.WorkStealing) {
+        Impl_->ExecStealingRange(std::move(exec), firstId, lastId, flags);
+        return;
+    }
     auto rangeExec = MakeIntrusive<TLocalRangeExecutor>(std::move(exec), firstId, lastId);
     int queueSizeLimit = (flags & WAIT_COMPLETE) ? 10000 : -1;
     int prior = Max<int>(Impl_->CurrentTaskPriority, flags & PRIORITY_MASK);
@@ -343,6 +589,18 @@ void NPar::TLocalExecutor::ClearLPQueue() {
             AtomicAdd(Impl_->MPQueueSize, -1);
             cont = true;
         }
+        for (auto workerThreadId : xrange(1, Impl_->WorkerQueues ? Impl_->MAX_WORKER_QUEUES : 1)) {
+            if (auto* workerQueues = Impl_->GetWorkerQueues(workerThreadId)) {
+                while (workerQueues->Queues[LOW_PRIORITY].Dequeue(&job)) {
+                    AtomicAdd(Impl_->LPQueueSize, -1);
+                    cont = true;
+                }
+                while (workerQueues->Queues[MED_PRIORITY].Dequeue(&job)) {
+                    AtomicAdd(Impl_->MPQueueSize, -1);
+                    cont = true;
+                }
+            }
+        }
     }
 }
 
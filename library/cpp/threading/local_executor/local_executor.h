@@ -224,12 +224,32 @@ namespace NPar {
     public:
         using EFlags = ILocalExecutor::EFlags;
 
+        // Scheduling options, fixed for the executor lifetime.
+        //
+        struct TOptions {
+            // Each range is split into `GetThreadCount() + 1` contiguous slots, slot `k` is queued to
+            // worker `k` (slot 0 is processed by the calling thread for `WAIT_COMPLETE`) and a thread
+            // that has finished its own slot steals tasks from the others. Single tasks added from a
+            // worker thread go to its own queue. Threads no longer contend on shared queues and on a
+            // shared range counter, and the same blocks of a range are processed by the same threads.
+            bool WorkStealing = false;
+
+            // Bind each worker thread to one CPU (round robin over CPUs available to the process).
+            // Memory first touched by a pinned worker is placed on its NUMA node, so buffers filled
+            // block by block (e.g. by a blocked `ExecRange` in `WorkStealing` mode) stay local to the
+            // threads that process the same blocks later. Linux only, ignored elsewhere.
+            bool PinThreads = false;
+        };
+
         // Creates executor without threads. You'll need to explicitly call `RunAdditionalThreads`
         // to add threads to underlying thread pool.
         //
         TLocalExecutor();
+        explicit TLocalExecutor(const TOptions& options);
         ~TLocalExecutor();
 
+        const TOptions& GetOptions() const noexcept;
+
         int GetQueueSize() const noexcept;
         int GetMPQueueSize() const noexcept;
         int GetLPQueueSize() const noexcept;
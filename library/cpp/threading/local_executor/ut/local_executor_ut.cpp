@@ -369,3 +369,89 @@ Y_UNIT_TEST_SUITE(ExecLargeRangeWithThrow){
         );
     }
 };
+
+Y_UNIT_TEST_SUITE(WorkStealing) {
+    static TLocalExecutor::TOptions WorkStealingOptions(bool pinThreads) {
+        TLocalExecutor::TOptions options;
+        options.WorkStealing = true;
+        options.PinThreads = pinThreads;
+        return options;
+    }
+
+    void RunRangeAndCheckEachTaskOnce(int rangeSize, int threadsCount, bool pinThreads) {
+        TLocalExecutor localExecutor(WorkStealingOptions(pinThreads));
+        localExecutor.RunAdditionalThreads(threadsCount);
+        TVector<TAtomic> data(rangeSize, 0);
+        localExecutor.ExecRange([&data](int i) {
+            AtomicAdd(data[i], 1);
+        }, 0, rangeSize, TLocalExecutor::WAIT_COMPLETE);
+        UNIT_ASSERT(AllOf(data, [](TAtomic value) { return value == 1; }));
+    }
+
+    Y_UNIT_TEST(RunRangeEachTaskOnce) {
+        RunRangeAndCheckEachTaskOnce(DefaultRangeSize, DefaultThreadsCount, false);
+    }
+
+    Y_UNIT_TEST(RunRangeEachTaskOncePinned) {
+        RunRangeAndCheckEachTaskOnce(DefaultRangeSize, DefaultThreadsCount, true);
+    }
+
+    Y_UNIT_TEST(RunSmallRangeEachTaskOnce) {
+        RunRangeAndCheckEachTaskOnce(3, DefaultThreadsCount, false);
+    }
+
+    Y_UNIT_TEST(RunRangeEachTaskOnceZeroExtraThreads) {
+        RunRangeAndCheckEachTaskOnce(DefaultRangeSize, 0, false);
+    }
+
+    Y_UNIT_TEST(AsyncRunRangeAndWaitFuturesReady) {
+        TLocalExecutor localExecutor(WorkStealingOptions(false));
+        localExecutor.RunAdditionalThreads(DefaultThreadsCount);
+        TVector<int> data(DefaultRangeSize, 0);
+        TVector<NThreading::TFuture<void>> futures = localExecutor.ExecRangeWithFutures([&data](int i) {
+            data[i] += 1;
+        }, 0, DefaultRangeSize, TLocalExecutor::LOW_PRIORITY);
+        for (auto& future : futures) {
+            future.GetValueSync();
+        }
+        UNIT_ASSERT(AllOf(data, [](int value) { return value == 1; }));
+    }
+
+    Y_UNIT_TEST(ExecFromWorkers) {
+        TLocalExecutor localExecutor(WorkStealingOptions(false));
+        localExecutor.RunAdditionalThreads(DefaultThreadsCount);
+        TAtomic processed = 0;
+        TVector<NThreading::TPromise<void>> promises(DefaultRangeSize);
+        for (auto& promise : promises) {
+            promise = NThreading::NewPromise();
+        }
+        localExecutor.ExecRange([&](int i) {
+            // queued to the worker's own queue, may be stolen by others
+            localExecutor.Exec([&, i](int) {
+                AtomicAdd(processed, 1);
+                promises[i].SetValue();
+            }, 0, TLocalExecutor::MED_PRIORITY);
+        }, 0, DefaultRangeSize, TLocalExecutor::WAIT_COMPLETE);
+        for (auto& promise : promises) {
+            promise.GetFuture().GetValueSync();
+        }
+        UNIT_ASSERT_EQUAL(AtomicGet(processed), DefaultRangeSize);
+    }
+
+    Y_UNIT_TEST(NestedRangesWithThrow) {
+        TLocalExecutor localExecutor(WorkStealingOptions(true));
+        localExecutor.RunAdditionalThreads(DefaultThreadsCount);
+        TAtomic processed = 0;
+        localExecutor.ExecRangeWithThrow([&](int) {
+            localExecutor.ExecRange([&](int) {
+                AtomicAdd(processed, 1);
+            }, 0, 10, TLocalExecutor::WAIT_COMPLETE);
+            UNIT_ASSERT_EXCEPTION(
+                localExecutor.ExecRangeWithThrow([](int) {
+                    throw TTestException();
+                }, 0, 10, TLocalExecutor::WAIT_COMPLETE),
+                TTestException);
+        }, 0, DefaultRangeSize, TLocalExecutor::WAIT_COMPLETE);
+        UNIT_ASSERT_EQUAL(AtomicGet(processed), 10 * DefaultRangeSize);
+    }
+}